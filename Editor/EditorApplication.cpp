@@ -27,6 +27,7 @@
 #include "../Engine/DataLoader.h"
 #include "../Engine/Journal.h"
 #include "../Engine/Landscape.h"
+#include "../Engine/Messages.h"
 #include "../Engine/ObjectManager.h"
 #include "../Engine/database/ObjectRecord.h"
 #include "../Engine/database/ItemRecord.h"
@@ -139,6 +140,7 @@ void EditorApplication::go(void)
 
 bool EditorApplication::setup(void)
 {
+  Messages::installCrashHandler();
   Ogre::String pluginsPath;
   // only use plugins.cfg if not static
   #ifndef OGRE_STATIC_LIB
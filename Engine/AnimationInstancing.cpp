@@ -0,0 +1,196 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "AnimationInstancing.h"
+#include <cmath>
+#include <OgreException.h>
+#include <OgreSceneNode.h>
+#include "DuskFunctions.h"
+#include "Messages.h"
+
+namespace Dusk
+{
+
+AnimationInstancing& AnimationInstancing::getSingleton()
+{
+  static AnimationInstancing Instance;
+  return Instance;
+}
+
+AnimationInstancing::AnimationInstancing()
+: m_Enabled(false),
+  m_PhaseBuckets(4),
+  m_Clock(0.0),
+  m_MasterCount(0),
+  m_Buckets()
+{
+}
+
+AnimationInstancing::~AnimationInstancing()
+{
+  //The scene manager might already be gone at this point, so the master
+  // entities are left to it.
+  std::map<std::string, Bucket*>::iterator iter = m_Buckets.begin();
+  while (iter!=m_Buckets.end())
+  {
+    delete iter->second;
+    ++iter;
+  }//while
+  m_Buckets.clear();
+}
+
+void AnimationInstancing::setEnabled(const bool enable)
+{
+  m_Enabled = enable;
+}
+
+bool AnimationInstancing::isEnabled() const
+{
+  return m_Enabled;
+}
+
+void AnimationInstancing::setPhaseBuckets(const unsigned int buckets)
+{
+  if (buckets==0)
+  {
+    DuskLog(llWarning) << "AnimationInstancing::setPhaseBuckets: Warning: "
+                       << "number of buckets has to be at least one.\n";
+    m_PhaseBuckets = 1;
+    return;
+  }
+  m_PhaseBuckets = buckets;
+}
+
+unsigned int AnimationInstancing::getPhaseBuckets() const
+{
+  return m_PhaseBuckets;
+}
+
+AnimationInstancing::Bucket* AnimationInstancing::join(Ogre::Entity* ent, const std::string& mesh, const std::string& anim, const float timePosition)
+{
+  if (!m_Enabled or ent==NULL) return NULL;
+  if (!ent->hasSkeleton() or ent->sharesSkeletonInstance()) return NULL;
+  Ogre::SceneNode* node = ent->getParentSceneNode();
+  if (node==NULL) return NULL;
+  const Ogre::AnimationStateSet* states = ent->getAllAnimationStates();
+  if (states==NULL or !states->hasAnimationState(anim)) return NULL;
+  const float length = states->getAnimationState(anim)->getLength();
+  if (length<=0.0f) return NULL;
+
+  //offset of the entity's phase against the clock, in [0;length)
+  double offset = std::fmod(double(timePosition)-m_Clock, double(length));
+  if (offset<0.0) offset += length;
+  unsigned int phase = static_cast<unsigned int>(offset/length*m_PhaseBuckets);
+  if (phase>=m_PhaseBuckets) phase = m_PhaseBuckets-1;
+
+  const std::string key = mesh+"\n"+anim+"\n"+IntToString(phase);
+  Bucket* bucket = NULL;
+  std::map<std::string, Bucket*>::iterator iter = m_Buckets.find(key);
+  if (iter!=m_Buckets.end())
+  {
+    bucket = iter->second;
+  }
+  else
+  {
+    //create a master entity that is never attached to the scene; it only
+    // owns the skeleton instance and the animation states of the bucket
+    bucket = new Bucket;
+    bucket->Key = key;
+    bucket->SceneManager = node->getCreator();
+    bucket->Master = bucket->SceneManager->createEntity(
+                         "DuskAnimationInstance"+IntToString(m_MasterCount), mesh);
+    ++m_MasterCount;
+    bucket->State = bucket->Master->getAnimationState(anim);
+    bucket->State->setLoop(true);
+    bucket->State->setEnabled(true);
+    //middle of the phase bucket
+    bucket->State->setTimePosition(std::fmod(m_Clock+(phase+0.5)*length/m_PhaseBuckets,
+                                             double(length)));
+    bucket->Members = 0;
+    m_Buckets[key] = bucket;
+  }
+
+  try
+  {
+    ent->shareSkeletonInstanceWith(bucket->Master);
+  }
+  catch (Ogre::Exception& e)
+  {
+    DuskLog(llError) << "AnimationInstancing::join: ERROR: entity \""
+                     << ent->getName() << "\" cannot share the skeleton of "
+                     << "mesh \"" << mesh << "\". " << e.getDescription() << "\n";
+    if (bucket->Members==0)
+    {
+      m_Buckets.erase(key);
+      bucket->SceneManager->destroyEntity(bucket->Master);
+      delete bucket;
+    }
+    return NULL;
+  }
+  ++(bucket->Members);
+  return bucket;
+}
+
+void AnimationInstancing::leave(Bucket* bucket, Ogre::Entity* ent)
+{
+  if (bucket==NULL) return;
+  if (ent!=NULL and ent->sharesSkeletonInstance())
+  {
+    ent->stopSharingSkeletonInstance();
+  }
+  if (bucket->Members>0) --(bucket->Members);
+  if (bucket->Members==0)
+  {
+    m_Buckets.erase(bucket->Key);
+    bucket->SceneManager->destroyEntity(bucket->Master);
+    delete bucket;
+  }
+}
+
+void AnimationInstancing::injectTime(const float SecondsPassed)
+{
+  m_Clock += SecondsPassed;
+  std::map<std::string, Bucket*>::iterator iter = m_Buckets.begin();
+  while (iter!=m_Buckets.end())
+  {
+    iter->second->State->addTime(SecondsPassed);
+    ++iter;
+  }//while
+}
+
+unsigned int AnimationInstancing::getNumberOfBuckets() const
+{
+  return m_Buckets.size();
+}
+
+unsigned int AnimationInstancing::getNumberOfMembers() const
+{
+  unsigned int result = 0;
+  std::map<std::string, Bucket*>::const_iterator iter = m_Buckets.begin();
+  while (iter!=m_Buckets.end())
+  {
+    result += iter->second->Members;
+    ++iter;
+  }//while
+  return result;
+}
+
+} //namespace
@@ -0,0 +1,144 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: AnimationInstancing Singleton class
+          Lets animated objects with the same mesh that play the same looping
+          animation in roughly the same phase share one skeleton, so the pose
+          is evaluated only once per frame for all of them.
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - allow blends of two looping animations (e.g. walk + carry)
+
+ Bugs:
+     - Untested. If you find any bugs, then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef ANIMATIONINSTANCING_H
+#define ANIMATIONINSTANCING_H
+
+#include <map>
+#include <string>
+#include <OgreEntity.h>
+#include <OgreSceneManager.h>
+
+namespace Dusk
+{
+
+class AnimationInstancing
+{
+  public:
+    /* A group of entities that share the skeleton of a hidden master entity.
+       Objects should only keep the pointer and pass it back to leave().
+    */
+    struct Bucket
+    {
+      std::string Key;
+      Ogre::SceneManager* SceneManager;
+      Ogre::Entity* Master;
+      Ogre::AnimationState* State;
+      unsigned int Members;
+    };
+
+    /* singleton access method */
+    static AnimationInstancing& getSingleton();
+
+    /* destructor */
+    ~AnimationInstancing();
+
+    /* turns animation instancing on or off. Objects leave their buckets at
+       their next injectTime(), if it is turned off.
+    */
+    void setEnabled(const bool enable);
+
+    /* returns true, if animation instancing is turned on */
+    bool isEnabled() const;
+
+    /* sets the number of phase buckets per mesh and animation. More buckets
+       mean less synchronous crowds, but more skeleton evaluations.
+
+       parameters:
+           buckets - number of buckets, has to be at least one
+    */
+    void setPhaseBuckets(const unsigned int buckets);
+
+    /* returns the number of phase buckets per mesh and animation */
+    unsigned int getPhaseBuckets() const;
+
+    /* lets ent share the skeleton of the bucket for the given mesh, animation
+       and phase, creating the bucket if needed. Returns the bucket, or NULL,
+       if instancing is turned off or the entity cannot share its skeleton.
+
+       parameters:
+           ent          - the entity, has to be attached to a scene node and
+                          must not share its skeleton yet
+           mesh         - name of the entity's mesh
+           anim         - name of the (looping) animation that is played
+           timePosition - the entity's current time position in anim
+
+       remarks:
+           The animation states of ent are replaced by the ones of the bucket,
+           so all pointers to the old states become invalid.
+    */
+    Bucket* join(Ogre::Entity* ent, const std::string& mesh, const std::string& anim, const float timePosition);
+
+    /* lets ent stop sharing the skeleton of bucket. The bucket is destroyed,
+       if it has no members left.
+
+       remarks:
+           ent gets new animation states, all disabled, so the caller has to
+           enable the animation again, if it shall continue.
+    */
+    void leave(Bucket* bucket, Ogre::Entity* ent);
+
+    /* advances the animations of all buckets. Has to be called once per
+       frame; InjectionManager::injectAnimationTime() does that.
+    */
+    void injectTime(const float SecondsPassed);
+
+    /* returns the number of buckets, i.e. of skeletons evaluated per frame */
+    unsigned int getNumberOfBuckets() const;
+
+    /* returns the number of entities in all buckets */
+    unsigned int getNumberOfMembers() const;
+  private:
+    /* constructor - private, because it's a singleton */
+    AnimationInstancing();
+
+    /* empty, private copy constructor due to singleton pattern */
+    AnimationInstancing(const AnimationInstancing& op) {}
+
+    bool m_Enabled;
+    unsigned int m_PhaseBuckets;
+    //time since the start; all buckets are in phase with it (plus offset)
+    double m_Clock;
+    unsigned int m_MasterCount;
+    std::map<std::string, Bucket*> m_Buckets;
+}; //class
+
+} //namespace
+
+#endif // ANIMATIONINSTANCING_H
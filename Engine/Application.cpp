@@ -28,6 +28,11 @@
 #include "Settings.h"
 #include "DuskFunctions.h"
 #include "Messages.h"
+#include "lua/LuaEngine.h"
+#include "lua/LuaWorkerPool.h"
+#include "AnimationInstancing.h"
+#include "objects/AnimatedObject.h"
+#include <algorithm>
 #include <OgreTexture.h>
 #include <OgreRenderTexture.h>
 
@@ -68,6 +73,9 @@ namespace Dusk
     */
     bool Application::initialise(const std::string& pluginFileName)
     {
+        Messages::installCrashHandler();
+        const unsigned int logLevel = Settings::getSingleton().getSetting_uint("LogLevel", llInfo);
+        Messages::setLevel(static_cast<LogLevel>(std::min<unsigned int>(logLevel, llError)));
         DuskLog() << "Plugin file: "<<pluginFileName<<"\n";
         m_Root = new Ogre::Root(pluginFileName);
 
@@ -100,8 +108,9 @@ namespace Dusk
         //Initialize Input
         InputSystem::initializeInput(m_Window, m_Root);
 
-        //Initialize Soundsystem
-        if (Sound::get().init())
+        //Initialize Soundsystem - a loopback device needs no audio hardware
+        const bool loopback = (Settings::getSingleton().getSetting_uint("SoundLoopback", 0)!=0);
+        if (Sound::get().init("NULL", "NULL", false, loopback))
         {
           DuskLog() << "Soundsystem successfully initialised.\n";
           std::string device_name;
@@ -130,6 +139,11 @@ namespace Dusk
           DuskLog() << "ERROR: Soundsystem could not be initialised properly.\n";
         }
 
+        //time slicing for queued scripts
+        LuaEngine::getSingleton().setTimeBudget(Settings::getSingleton().getSetting_uint("ScriptTimeBudget", 5));
+        LuaEngine::getSingleton().setRunawayLimit(Settings::getSingleton().getSetting_uint("ScriptRunawayLimit", 2000));
+        LuaWorkerPool::getSingleton().setRunawayLimit(Settings::getSingleton().getSetting_uint("ScriptRunawayLimit", 2000));
+
         return true;
     }
 
@@ -199,6 +213,18 @@ namespace Dusk
         // Create the camera
         Camera::getSingleton().setupCamera(m_SceneManager);
         m_Camera = Camera::getSingleton().getOgreCamera();
+        //animation level of detail depends on the distance to the camera
+        const Settings& settings = Settings::getSingleton();
+        if (settings.getSetting_uint("AnimationLOD", 1)!=0)
+        {
+          AnimatedObject::setAnimationLOD(m_Camera,
+                settings.getSetting_uint("AnimationLODNear", 50),
+                settings.getSetting_uint("AnimationLODFar", 150));
+        }
+        AnimationInstancing::getSingleton().setPhaseBuckets(
+              settings.getSetting_uint("AnimationPhaseBuckets", 4));
+        AnimationInstancing::getSingleton().setEnabled(
+              settings.getSetting_uint("AnimationInstancing", 0)!=0);
     }
 
 //-------------------------------------------------------------------------------------
@@ -54,6 +54,7 @@
      - 2010-12-01 (rev 265) - use DuskLog/Messages class for logging
      - 2011-08-05 (rev 295) - info about sound device names added
      - 2011-08-05 (rev 296) - info about default sound device name added
+     - 2026-10-19           - initialise() installs the crash handler of the log
 
  ToDo list:
      - ???
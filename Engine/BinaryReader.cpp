@@ -0,0 +1,259 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "BinaryReader.h"
+#include <cstring>
+#include <fstream>
+
+namespace Dusk
+{
+
+BinaryReader::BinaryReader()
+: m_Storage(),
+  m_Data(NULL),
+  m_Size(0),
+  m_Position(0),
+  m_Good(true)
+{
+}
+
+BinaryReader::BinaryReader(const char* data, const std::size_t size)
+: m_Storage(),
+  m_Data(data),
+  m_Size(size),
+  m_Position(0),
+  m_Good(true)
+{
+  if (data==NULL)
+  {
+    m_Size = 0;
+  }
+}
+
+bool BinaryReader::loadFromFile(const std::string& FileName)
+{
+  std::ifstream input;
+  input.open(FileName.c_str(), std::ios::in | std::ios::binary);
+  if (!input)
+  {
+    return false;
+  }
+  input.seekg(0, std::ios::end);
+  const std::streamoff file_size = input.tellg();
+  input.seekg(0, std::ios::beg);
+  if (file_size<0)
+  {
+    input.close();
+    return false;
+  }
+  std::vector<char> content(static_cast<std::size_t>(file_size));
+  if (!content.empty())
+  {
+    //one single read for the whole file
+    input.read(&content[0], content.size());
+  }
+  const bool success = input.good();
+  input.close();
+  if (!success)
+  {
+    return false;
+  }
+  assign(content);
+  return true;
+}
+
+void BinaryReader::assign(std::vector<char>& data)
+{
+  m_Storage.swap(data);
+  m_Data = m_Storage.empty() ? NULL : &m_Storage[0];
+  m_Size = m_Storage.size();
+  m_Position = 0;
+  m_Good = true;
+}
+
+bool BinaryReader::good() const
+{
+  return m_Good;
+}
+
+void BinaryReader::clear()
+{
+  m_Good = true;
+}
+
+std::size_t BinaryReader::tell() const
+{
+  return m_Position;
+}
+
+bool BinaryReader::seek(const std::size_t pos)
+{
+  if (!m_Good or pos>m_Size)
+  {
+    m_Good = false;
+    return false;
+  }
+  m_Position = pos;
+  return true;
+}
+
+bool BinaryReader::skip(const std::size_t count)
+{
+  if (!m_Good or count>m_Size-m_Position)
+  {
+    m_Good = false;
+    return false;
+  }
+  m_Position += count;
+  return true;
+}
+
+std::size_t BinaryReader::size() const
+{
+  return m_Size;
+}
+
+std::size_t BinaryReader::remaining() const
+{
+  return m_Size-m_Position;
+}
+
+bool BinaryReader::atEnd() const
+{
+  return (m_Position>=m_Size);
+}
+
+const char* BinaryReader::current() const
+{
+  if (m_Position>=m_Size) return NULL;
+  return m_Data+m_Position;
+}
+
+bool BinaryReader::read(void* dest, const std::size_t count)
+{
+  if (!m_Good or count>m_Size-m_Position)
+  {
+    m_Good = false;
+    return false;
+  }
+  if (count!=0)
+  {
+    memcpy(dest, m_Data+m_Position, count);
+    m_Position += count;
+  }
+  return true;
+}
+
+bool BinaryReader::readUInt8(uint8_t& value)
+{
+  if (!m_Good or m_Position>=m_Size)
+  {
+    m_Good = false;
+    return false;
+  }
+  value = static_cast<uint8_t>(m_Data[m_Position]);
+  ++m_Position;
+  return true;
+}
+
+bool BinaryReader::readBool(bool& value)
+{
+  uint8_t byte = 0;
+  if (!readUInt8(byte)) return false;
+  value = (byte!=0);
+  return true;
+}
+
+bool BinaryReader::readUInt32(uint32_t& value)
+{
+  if (!m_Good or 4>m_Size-m_Position)
+  {
+    m_Good = false;
+    return false;
+  }
+  const unsigned char* ptr = reinterpret_cast<const unsigned char*>(m_Data+m_Position);
+  value = static_cast<uint32_t>(ptr[0])
+        | (static_cast<uint32_t>(ptr[1])<<8)
+        | (static_cast<uint32_t>(ptr[2])<<16)
+        | (static_cast<uint32_t>(ptr[3])<<24);
+  m_Position += 4;
+  return true;
+}
+
+bool BinaryReader::readInt32(int32_t& value)
+{
+  uint32_t temp = 0;
+  if (!readUInt32(temp)) return false;
+  value = static_cast<int32_t>(temp);
+  return true;
+}
+
+bool BinaryReader::readFloat(float& value)
+{
+  uint32_t temp = 0;
+  if (!readUInt32(temp)) return false;
+  memcpy(&value, &temp, sizeof(float));
+  return true;
+}
+
+bool BinaryReader::readFloats(float* values, const std::size_t count)
+{
+  if (!m_Good or count>(m_Size-m_Position)/4)
+  {
+    m_Good = false;
+    return false;
+  }
+  std::size_t i;
+  for (i=0; i<count; ++i)
+  {
+    readFloat(values[i]);
+  }
+  return true;
+}
+
+bool BinaryReader::readString(std::string& str, const uint32_t maxLength)
+{
+  uint32_t len = 0;
+  if (!readUInt32(len)) return false;
+  if (len>maxLength or len>m_Size-m_Position)
+  {
+    m_Good = false;
+    return false;
+  }
+  str.assign(m_Data+m_Position, len);
+  m_Position += len;
+  return true;
+}
+
+bool BinaryReader::peekUInt32(uint32_t& value) const
+{
+  if (!m_Good or 4>m_Size-m_Position)
+  {
+    return false;
+  }
+  const unsigned char* ptr = reinterpret_cast<const unsigned char*>(m_Data+m_Position);
+  value = static_cast<uint32_t>(ptr[0])
+        | (static_cast<uint32_t>(ptr[1])<<8)
+        | (static_cast<uint32_t>(ptr[2])<<16)
+        | (static_cast<uint32_t>(ptr[3])<<24);
+  return true;
+}
+
+} //namespace
@@ -0,0 +1,191 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: BinaryReader class
+          reads binary data (little endian) from a block of memory, usually
+          the complete content of a data file or save game
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_BINARYREADER_H
+#define DUSK_BINARYREADER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Dusk
+{
+
+/*class BinaryReader:
+        The BinaryReader provides the data of a complete file (or any other
+        block of memory) to the loadFromStream() functions of the various data
+        classes. The whole file is read with one single call, all further reads
+        are just copies from memory.
+        All integer and floating point values are stored in little endian byte
+        order. Every read is checked against the bounds of the memory block. If
+        a read fails, the reader enters a failure state (similar to the fail
+        bit of std::ifstream) and all subsequent reads will fail, too, until
+        clear() is called.
+*/
+class BinaryReader
+{
+  public:
+    /* constructor - creates an empty reader */
+    BinaryReader();
+
+    /* constructor - creates a reader that reads from the given memory block
+
+       parameters:
+           data - pointer to the first byte of the data
+           size - size of the data in bytes
+
+       remarks:
+           The data is NOT copied, so it has to stay valid as long as the reader
+           is used. This allows to read parts of a larger block without copies.
+    */
+    BinaryReader(const char* data, const std::size_t size);
+
+    /* Loads the complete content of the file FileName into memory and sets the
+       read position to the start of the data. Returns true on success, false
+       on failure.
+
+       parameters:
+           FileName - path of the file that shall be read
+    */
+    bool loadFromFile(const std::string& FileName);
+
+    /* Replaces the current data of the reader by the given data and sets the
+       read position to zero. The previous data is discarded.
+
+       parameters:
+           data - the new data (will be swapped into the reader, so the vector
+                  will contain the old data of the reader afterwards)
+    */
+    void assign(std::vector<char>& data);
+
+    /* returns true, if no read operation has failed so far */
+    bool good() const;
+
+    /* resets the failure state */
+    void clear();
+
+    /* returns the current read position (offset from the start of the data) */
+    std::size_t tell() const;
+
+    /* sets the current read position; fails, if pos is beyond the end
+
+       parameters:
+           pos - the new read position
+    */
+    bool seek(const std::size_t pos);
+
+    /* skips the next count bytes
+
+       parameters:
+           count - number of bytes that shall be skipped
+    */
+    bool skip(const std::size_t count);
+
+    /* returns the total size of the data in bytes */
+    std::size_t size() const;
+
+    /* returns the number of bytes that have not been read yet */
+    std::size_t remaining() const;
+
+    /* returns true, if the read position is at the end of the data */
+    bool atEnd() const;
+
+    /* returns a pointer to the data at the current read position, or NULL, if
+       there is no data left
+    */
+    const char* current() const;
+
+    /* copies the next count bytes to dest, returns true on success
+
+       parameters:
+           dest  - pointer to the destination (must be at least count bytes)
+           count - number of bytes to read
+    */
+    bool read(void* dest, const std::size_t count);
+
+    /* reads a single byte */
+    bool readUInt8(uint8_t& value);
+
+    /* reads a boolean value (one byte) */
+    bool readBool(bool& value);
+
+    /* reads a 32 bit unsigned integer */
+    bool readUInt32(uint32_t& value);
+
+    /* reads a 32 bit signed integer */
+    bool readInt32(int32_t& value);
+
+    /* reads a 32 bit float value */
+    bool readFloat(float& value);
+
+    /* reads count 32 bit float values into the array values
+
+       parameters:
+           values - pointer to the destination array
+           count  - number of float values
+    */
+    bool readFloats(float* values, const std::size_t count);
+
+    /* Reads a string that is preceded by its length as 32 bit unsigned int.
+       The function fails (and the reader enters the failure state), if the
+       length is larger than maxLength.
+
+       parameters:
+           str       - the string that will receive the data
+           maxLength - maximum length of the string that is accepted
+    */
+    bool readString(std::string& str, const uint32_t maxLength = 255);
+
+    /* reads the next 32 bit unsigned integer without moving the read position
+       (used to look at the header of the next record)
+    */
+    bool peekUInt32(uint32_t& value) const;
+  private:
+    /* copy constructor - private, because the reader may refer to its own
+       storage */
+    BinaryReader(const BinaryReader& op) {}
+
+    std::vector<char> m_Storage;
+    const char* m_Data;
+    std::size_t m_Size;
+    std::size_t m_Position;
+    bool m_Good;
+};//class
+
+} //namespace
+
+#endif // DUSK_BINARYREADER_H
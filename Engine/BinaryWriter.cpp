@@ -0,0 +1,285 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "BinaryWriter.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace Dusk
+{
+
+namespace
+{
+
+/* writes size bytes to the file FileName and flushes them to the disk, so
+   that they are stored before any later rename of the file. Returns true on
+   success.
+*/
+bool writeDurable(const std::string& FileName, const char* data, const std::size_t size)
+{
+  #if defined(_WIN32)
+  HANDLE file = CreateFileA(FileName.c_str(), GENERIC_WRITE, 0, NULL,
+                            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file==INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  bool success = true;
+  std::size_t done = 0;
+  while (success and (done<size))
+  {
+    DWORD written = 0;
+    const DWORD chunk = (size-done>0x40000000) ? 0x40000000 : static_cast<DWORD>(size-done);
+    success = (WriteFile(file, data+done, chunk, &written, NULL)!=0) and (written!=0);
+    done += written;
+  }//while
+  if (success)
+  {
+    success = (FlushFileBuffers(file)!=0);
+  }
+  return (CloseHandle(file)!=0) and success;
+  #else
+  const int fd = open(FileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd<0)
+  {
+    return false;
+  }
+  bool success = true;
+  std::size_t done = 0;
+  while (success and (done<size))
+  {
+    const ssize_t written = write(fd, data+done, size-done);
+    if (written<0)
+    {
+      success = (errno==EINTR);
+    }
+    else
+    {
+      done += written;
+    }
+  }//while
+  if (success)
+  {
+    success = (fsync(fd)==0);
+  }
+  return (close(fd)==0) and success;
+  #endif
+}
+
+#if !defined(_WIN32)
+/* flushes the directory entry of FileName to the disk, so a rename within
+   that directory survives a crash
+*/
+void syncDirectoryOf(const std::string& FileName)
+{
+  const std::string::size_type pos = FileName.rfind('/');
+  std::string dir;
+  if (pos==std::string::npos)
+  {
+    dir = ".";
+  }
+  else if (pos==0)
+  {
+    dir = "/";
+  }
+  else
+  {
+    dir = FileName.substr(0, pos);
+  }
+  const int fd = open(dir.c_str(), O_RDONLY);
+  if (fd<0)
+  {
+    return;
+  }
+  fsync(fd);
+  close(fd);
+}
+#endif
+
+} //anonymous namespace
+
+BinaryWriter::BinaryWriter(const std::size_t reserveBytes)
+: m_Buffer(),
+  m_Good(true)
+{
+  m_Buffer.reserve(reserveBytes);
+}
+
+bool BinaryWriter::good() const
+{
+  return m_Good;
+}
+
+std::size_t BinaryWriter::size() const
+{
+  return m_Buffer.size();
+}
+
+const char* BinaryWriter::data() const
+{
+  if (m_Buffer.empty()) return NULL;
+  return &m_Buffer[0];
+}
+
+void BinaryWriter::clear()
+{
+  m_Buffer.clear();
+  m_Good = true;
+}
+
+bool BinaryWriter::truncate(const std::size_t newSize)
+{
+  if (newSize>m_Buffer.size())
+  {
+    return false;
+  }
+  m_Buffer.resize(newSize);
+  return true;
+}
+
+bool BinaryWriter::write(const void* src, const std::size_t count)
+{
+  if (!m_Good) return false;
+  const char* ptr = static_cast<const char*>(src);
+  m_Buffer.insert(m_Buffer.end(), ptr, ptr+count);
+  return true;
+}
+
+bool BinaryWriter::writeUInt8(const uint8_t value)
+{
+  if (!m_Good) return false;
+  m_Buffer.push_back(static_cast<char>(value));
+  return true;
+}
+
+bool BinaryWriter::writeBool(const bool value)
+{
+  return writeUInt8(value ? 1 : 0);
+}
+
+bool BinaryWriter::writeUInt32(const uint32_t value)
+{
+  if (!m_Good) return false;
+  const char bytes[4] = { static_cast<char>(value & 0xFF),
+                          static_cast<char>((value>>8) & 0xFF),
+                          static_cast<char>((value>>16) & 0xFF),
+                          static_cast<char>((value>>24) & 0xFF)};
+  m_Buffer.insert(m_Buffer.end(), bytes, bytes+4);
+  return true;
+}
+
+bool BinaryWriter::writeInt32(const int32_t value)
+{
+  return writeUInt32(static_cast<uint32_t>(value));
+}
+
+bool BinaryWriter::writeFloat(const float value)
+{
+  uint32_t temp;
+  memcpy(&temp, &value, sizeof(float));
+  return writeUInt32(temp);
+}
+
+bool BinaryWriter::writeFloats(const float* values, const std::size_t count)
+{
+  if (!m_Good) return false;
+  m_Buffer.reserve(m_Buffer.size()+4*count);
+  std::size_t i;
+  for (i=0; i<count; ++i)
+  {
+    writeFloat(values[i]);
+  }
+  return true;
+}
+
+bool BinaryWriter::writeString(const std::string& str)
+{
+  if (!writeUInt32(str.length())) return false;
+  m_Buffer.insert(m_Buffer.end(), str.begin(), str.end());
+  return true;
+}
+
+bool BinaryWriter::patchUInt32(const std::size_t offset, const uint32_t value)
+{
+  if (!m_Good or offset+4>m_Buffer.size())
+  {
+    return false;
+  }
+  m_Buffer[offset]   = static_cast<char>(value & 0xFF);
+  m_Buffer[offset+1] = static_cast<char>((value>>8) & 0xFF);
+  m_Buffer[offset+2] = static_cast<char>((value>>16) & 0xFF);
+  m_Buffer[offset+3] = static_cast<char>((value>>24) & 0xFF);
+  return true;
+}
+
+bool BinaryWriter::saveToFile(const std::string& FileName) const
+{
+  if (!m_Good) return false;
+  std::ofstream output;
+  output.open(FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!output)
+  {
+    return false;
+  }
+  if (!m_Buffer.empty())
+  {
+    output.write(&m_Buffer[0], m_Buffer.size());
+  }
+  const bool success = output.good();
+  output.close();
+  return success;
+}
+
+bool BinaryWriter::saveToFileAtomic(const std::string& FileName) const
+{
+  if (!m_Good) return false;
+  const std::string tempName = FileName + ".tmp";
+  //The data has to be on the disk before the rename, otherwise a crash can
+  // leave a renamed, but empty or truncated file.
+  if (!writeDurable(tempName, m_Buffer.empty() ? NULL : &m_Buffer[0], m_Buffer.size()))
+  {
+    std::remove(tempName.c_str());
+    return false;
+  }
+  #if defined(_WIN32)
+  //rename() does not replace existing files on Windows
+  if (MoveFileExA(tempName.c_str(), FileName.c_str(), MOVEFILE_REPLACE_EXISTING)==0)
+  #else
+  if (std::rename(tempName.c_str(), FileName.c_str())!=0)
+  #endif
+  {
+    std::remove(tempName.c_str());
+    return false;
+  }
+  #if !defined(_WIN32)
+  syncDirectoryOf(FileName);
+  #endif
+  return true;
+}
+
+} //namespace
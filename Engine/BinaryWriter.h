@@ -0,0 +1,154 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: BinaryWriter class
+          collects binary data (little endian) in memory, so that it can be
+          written to a file with one single call
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+     - 2026-10-19 - saveToFileAtomic() added
+     - 2026-10-19 - truncate() added
+     - 2026-10-19 - saveToFileAtomic() flushes the data to the disk before the
+                    rename
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_BINARYWRITER_H
+#define DUSK_BINARYWRITER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Dusk
+{
+
+/*class BinaryWriter:
+        counterpart of BinaryReader - the saveToStream() functions of the
+        various data classes write into an in-memory buffer, which will then be
+        written to a file at once via saveToFile().
+        All integer and floating point values are stored in little endian byte
+        order.
+*/
+class BinaryWriter
+{
+  public:
+    /* constructor
+
+       parameters:
+           reserveBytes - number of bytes that will be reserved for the buffer
+    */
+    BinaryWriter(const std::size_t reserveBytes = 0);
+
+    /* returns true, if no write operation has failed so far */
+    bool good() const;
+
+    /* returns the number of bytes that have been written so far */
+    std::size_t size() const;
+
+    /* returns a pointer to the written data, or NULL, if there is no data yet */
+    const char* data() const;
+
+    /* discards all written data */
+    void clear();
+
+    /* discards all data after the first newSize bytes; fails, if newSize is
+       larger than the current size
+
+       parameters:
+           newSize - the new size of the data in bytes
+    */
+    bool truncate(const std::size_t newSize);
+
+    /* appends count bytes from src to the buffer */
+    bool write(const void* src, const std::size_t count);
+
+    /* writes a single byte */
+    bool writeUInt8(const uint8_t value);
+
+    /* writes a boolean value (one byte) */
+    bool writeBool(const bool value);
+
+    /* writes a 32 bit unsigned integer */
+    bool writeUInt32(const uint32_t value);
+
+    /* writes a 32 bit signed integer */
+    bool writeInt32(const int32_t value);
+
+    /* writes a 32 bit float value */
+    bool writeFloat(const float value);
+
+    /* writes count 32 bit float values from the array values
+
+       parameters:
+           values - pointer to the source array
+           count  - number of float values
+    */
+    bool writeFloats(const float* values, const std::size_t count);
+
+    /* writes the length of the string as 32 bit unsigned integer, followed by
+       the characters of the string (without terminating NUL character)
+    */
+    bool writeString(const std::string& str);
+
+    /* overwrites a previously written 32 bit unsigned integer at the given
+       offset, e.g. a record count that is not known in advance
+
+       parameters:
+           offset - position of the integer, counted from the start of the data
+           value  - the new value
+    */
+    bool patchUInt32(const std::size_t offset, const uint32_t value);
+
+    /* Writes all collected data to the file FileName (file will be truncated,
+       if it already exists). Returns true on success, false on failure.
+
+       parameters:
+           FileName - path of the destination file
+    */
+    bool saveToFile(const std::string& FileName) const;
+
+    /* Writes all collected data to a temporary file next to FileName and then
+       renames it to FileName, so that FileName either contains the old or the
+       complete new data, even if the program crashes while writing. The data
+       is flushed to the disk before the rename, so this holds for a power loss
+       as well. Returns true on success, false on failure.
+
+       parameters:
+           FileName - path of the destination file
+    */
+    bool saveToFileAtomic(const std::string& FileName) const;
+  private:
+    std::vector<char> m_Buffer;
+    bool m_Good;
+};//class
+
+} //namespace
+
+#endif // DUSK_BINARYWRITER_H
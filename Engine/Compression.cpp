@@ -0,0 +1,177 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "Compression.h"
+#include <new>
+#include <zlib.h>
+#include "DuskConstants.h"
+#include "Messages.h"
+
+namespace Dusk
+{
+
+//deflate cannot expand data by more than this factor
+const std::size_t cZlibMaxExpansion = 1032;
+
+bool isValidCompressionMethod(const uint32_t method)
+{
+  return (method==cmNone) or (method==cmZlib);
+}
+
+bool compressBlock(const char* data, const std::size_t size, const CompressionMethod method, std::vector<char>& output)
+{
+  switch (method)
+  {
+    case cmNone:
+         output.assign(data, data+size);
+         return true;
+    case cmZlib:
+         {
+           uLongf destLen = compressBound(size);
+           output.resize(destLen);
+           if (compress2(reinterpret_cast<Bytef*>(&output[0]), &destLen,
+                         reinterpret_cast<const Bytef*>(data), size,
+                         Z_DEFAULT_COMPRESSION)!=Z_OK)
+           {
+             DuskLog() << "compressBlock: ERROR: zlib could not compress data.\n";
+             output.clear();
+             return false;
+           }
+           output.resize(destLen);
+         }
+         return true;
+  }//switch
+  DuskLog() << "compressBlock: ERROR: unknown compression method "<<method<<".\n";
+  return false;
+}
+
+bool decompressBlock(const char* data, const std::size_t size, const CompressionMethod method,
+                     const std::size_t expectedSize, std::vector<char>& output)
+{
+  switch (method)
+  {
+    case cmNone:
+         if (size!=expectedSize)
+         {
+           DuskLog() << "decompressBlock: ERROR: size mismatch.\n";
+           return false;
+         }
+         output.assign(data, data+size);
+         return true;
+    case cmZlib:
+         {
+           //size comes from the file, so check it before allocating memory
+           if (expectedSize>cMaxPlainBlockSize
+               or expectedSize/cZlibMaxExpansion>size)
+           {
+             DuskLog() << "decompressBlock: ERROR: uncompressed size of "
+                       << expectedSize << " bytes is not possible for "
+                       << size << " bytes of compressed data.\n";
+             return false;
+           }
+           try
+           {
+             output.resize(expectedSize);
+           }
+           catch (std::bad_alloc& e)
+           {
+             DuskLog() << "decompressBlock: ERROR: could not allocate "
+                       << expectedSize << " bytes.\n";
+             output.clear();
+             return false;
+           }
+           if (expectedSize==0)
+           {
+             return true;
+           }
+           uLongf destLen = expectedSize;
+           if (uncompress(reinterpret_cast<Bytef*>(&output[0]), &destLen,
+                          reinterpret_cast<const Bytef*>(data), size)!=Z_OK
+               or destLen!=expectedSize)
+           {
+             DuskLog() << "decompressBlock: ERROR: zlib could not decompress "
+                       << "data, it's probably corrupted.\n";
+             output.clear();
+             return false;
+           }
+         }
+         return true;
+  }//switch
+  DuskLog() << "decompressBlock: ERROR: unknown compression method "<<method<<".\n";
+  return false;
+}
+
+bool writeCompressedBlock(BinaryWriter& output, const BinaryWriter& content, const CompressionMethod method)
+{
+  if (!content.good())
+  {
+    DuskLog() << "writeCompressedBlock: ERROR: content contains errors.\n";
+    return false;
+  }
+  std::vector<char> compressed;
+  if (method!=cmNone and content.size()>0)
+  {
+    if (!compressBlock(content.data(), content.size(), method, compressed))
+    {
+      return false;
+    }
+  }
+  //no compression wanted or no gain from compression
+  if (compressed.empty() or compressed.size()+16>=content.size())
+  {
+    if (content.size()==0) return output.good();
+    return output.write(content.data(), content.size());
+  }
+  output.writeUInt32(cHeaderComp);
+  output.writeUInt32(method);
+  output.writeUInt32(content.size());
+  output.writeUInt32(compressed.size());
+  output.write(&compressed[0], compressed.size());
+  return output.good();
+}
+
+bool readCompressedBlock(BinaryReader& input, std::vector<char>& content)
+{
+  uint32_t Header = 0;
+  input.readUInt32(Header);
+  if (Header!=cHeaderComp)
+  {
+    DuskLog() << "readCompressedBlock: ERROR: stream contains unexpected header!\n";
+    return false;
+  }
+  uint32_t method = 0, plainSize = 0, packedSize = 0;
+  input.readUInt32(method);
+  input.readUInt32(plainSize);
+  input.readUInt32(packedSize);
+  if (!input.good() or !isValidCompressionMethod(method)
+      or packedSize>input.remaining())
+  {
+    DuskLog() << "readCompressedBlock: ERROR: invalid block header.\n";
+    return false;
+  }
+  if (!decompressBlock(input.current(), packedSize, static_cast<CompressionMethod>(method),
+                       plainSize, content))
+  {
+    return false;
+  }
+  return input.skip(packedSize);
+}
+
+} //namespace
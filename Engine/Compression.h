@@ -0,0 +1,115 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: functions for block compression of data files and save games
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+     - 2026-10-19 - decompressBlock() rejects implausible uncompressed sizes
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_COMPRESSION_H
+#define DUSK_COMPRESSION_H
+
+#include <stdint.h>
+#include <vector>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+
+namespace Dusk
+{
+
+/* methods for block compression; the value is stored in the files, so
+   existing values must not be changed */
+enum CompressionMethod {cmNone = 0, cmZlib = 1};
+
+/* maximum uncompressed size of a block in bytes; larger sizes in a file are
+   considered to be corrupted */
+const std::size_t cMaxPlainBlockSize = 1024*1024*1024;
+
+/* returns true, if method is a compression method known to the engine
+
+   parameters:
+       method - numeric value of the compression method, as read from a file
+*/
+bool isValidCompressionMethod(const uint32_t method);
+
+/* Compresses a block of data. Returns true on success, false on failure.
+
+   parameters:
+       data   - pointer to the first byte of the uncompressed data
+       size   - size of the uncompressed data in bytes
+       method - the compression method that shall be used
+       output - vector that will receive the compressed data
+*/
+bool compressBlock(const char* data, const std::size_t size, const CompressionMethod method, std::vector<char>& output);
+
+/* Decompresses a block of data. Returns true on success, false on failure,
+   e.g. if the data is corrupted or its uncompressed size is not equal to
+   expectedSize. expectedSize is checked before any memory is allocated: it
+   must not exceed cMaxPlainBlockSize or what the method can produce from size
+   bytes at most.
+
+   parameters:
+       data         - pointer to the first byte of the compressed data
+       size         - size of the compressed data in bytes
+       method       - the compression method that was used for the data
+       expectedSize - size of the uncompressed data in bytes
+       output       - vector that will receive the uncompressed data
+*/
+bool decompressBlock(const char* data, const std::size_t size, const CompressionMethod method,
+                     const std::size_t expectedSize, std::vector<char>& output);
+
+/* Writes the data of content as compressed block record to output. Returns
+   true on success, false on failure.
+
+   parameters:
+       output  - the writer that receives the block
+       content - the data that shall be compressed
+       method  - the compression method that shall be used
+
+   remarks:
+       If method is cmNone or the compressed data would not be smaller, the
+       content is written as it is, without block header.
+*/
+bool writeCompressedBlock(BinaryWriter& output, const BinaryWriter& content, const CompressionMethod method);
+
+/* Reads a compressed block record (as written by writeCompressedBlock()) from
+   input and stores the uncompressed data in content. Returns true on success,
+   false on failure.
+
+   parameters:
+       input   - the reader, positioned at the block's header
+       content - vector that will receive the uncompressed data
+*/
+bool readCompressedBlock(BinaryReader& input, std::vector<char>& content);
+
+} //namespace
+
+#endif // DUSK_COMPRESSION_H
@@ -19,7 +19,8 @@
 */
 
 #include "DataLoader.h"
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include "InjectionManager.h"
 #include "Dialogue.h"
 #include "Journal.h"
@@ -30,18 +31,43 @@
 #include "QuestLog.h"
 #include "DuskConstants.h"
 #include "Messages.h"
+#include "SectionLoader.h"
+#include "Compression.h"
+#include "Settings.h"
+#include "ThreadPool.h"
+#include <memory>
 
 namespace Dusk
 {
 
+/* returns the compression method given by the setting setting_name, or cmNone,
+   if the setting has no valid value */
+CompressionMethod getCompressionSetting(const std::string& setting_name)
+{
+  const unsigned int method = Settings::getSingleton().getSetting_uint(setting_name, cmZlib);
+  if (!isValidCompressionMethod(method))
+  {
+    DuskLog() << "DataLoader: Warning: setting \""<<setting_name<<"\" contains "
+              << "invalid compression method "<<method<<", data will not be "
+              << "compressed.\n";
+    return cmNone;
+  }
+  return static_cast<CompressionMethod>(method);
+}
+
 DataLoader::DataLoader()
+: m_SaveWriter(NULL),
+  m_PendingSaves(0),
+  m_SaveFailed(false)
 {
-  //empty
 }
 
 DataLoader::~DataLoader()
 {
-  //empty
+  //make sure the last save game gets to the disk
+  waitForPendingSaves();
+  delete m_SaveWriter;
+  m_SaveWriter = NULL;
 }
 
 DataLoader& DataLoader::getSingleton()
@@ -52,19 +78,12 @@ DataLoader& DataLoader::getSingleton()
 
 bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits) const
 {
-  std::ofstream output;
+  //all data is collected in memory first and written to disk in one go
+  BinaryWriter output(cInitialWriteBufferSize);
   uint32_t data_records;
 
-  output.open(FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
-  if(!output)
-  {
-    DuskLog() << "DataLoader::saveToFile: Could not open file \""<<FileName
-              << "\" for writing in binary mode.\n";
-    return false;
-  }//if
-
   //write header "Dusk"
-  output.write((const char*) &cHeaderDusk, sizeof(uint32_t));
+  output.writeUInt32(cHeaderDusk);
   //determine number of records
   data_records = 0;
 
@@ -101,16 +120,29 @@ bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits
     data_records += ObjectManager::getSingleton().getNumberOfReferences();
   }
   //write number of records
-  output.write((const char*) &data_records, sizeof(uint32_t));
+  output.writeUInt32(data_records);
+
+  /* Dialogue, Journal, Landscape and Database records do not depend on each
+     other, so they are written as sections first. That way they can be read
+     concurrently by loadFromFile().
+  */
+  std::size_t section;
+  const CompressionMethod compression = getCompressionSetting("DataFileCompression");
 
   //save dialogues
   if ((bits & DIALOGUE_BIT)!=0)
   {
+    section = SectionLoader::beginSection(output, DIALOGUE_BIT, compression);
     if (!Dialogue::getSingleton().saveToStream(output))
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write Dialogue "
                 << "data to file \""<<FileName<<"\".\n";
-      output.close();
+      return false;
+    }
+    if (!SectionLoader::endSection(output, section))
+    {
+      DuskLog() << "DataLoader::saveToFile: ERROR: could not finish section "
+                << "of file \""<<FileName<<"\".\n";
       return false;
     }
   }//dialogue
@@ -118,51 +150,68 @@ bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits
   //save journal entries
   if ((bits & JOURNAL_BIT)!=0)
   {
+    section = SectionLoader::beginSection(output, JOURNAL_BIT, compression);
     if (!Journal::getSingleton().saveAllToStream(output))
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write basic "
                 << "Journal data to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }
-  }//journal entries
-
-  //save quest log
-  if ((bits & QUEST_LOG_BIT)!=0)
-  {
-    if (!QuestLog::getSingleton().saveToStream(output))
+    if (!SectionLoader::endSection(output, section))
     {
-      DuskLog() << "DataLoader::saveToFile: ERROR: could not write QuestLog "
-                << "data to file \""<<FileName<<"\".\n";
-      output.close();
+      DuskLog() << "DataLoader::saveToFile: ERROR: could not finish section "
+                << "of file \""<<FileName<<"\".\n";
       return false;
     }
-  }//quest log entries
+  }//journal entries
 
   //save landscape
   if ((bits & LANDSCAPE_BIT) !=0)
   {
+    section = SectionLoader::beginSection(output, LANDSCAPE_BIT, compression);
     if (!(Landscape::getSingleton().saveAllToStream(output)))
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write landscape "
                 << "records to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }//if
+    if (!SectionLoader::endSection(output, section))
+    {
+      DuskLog() << "DataLoader::saveToFile: ERROR: could not finish section "
+                << "of file \""<<FileName<<"\".\n";
+      return false;
+    }
   }//if landscape
 
   //save database objects
   if ((bits & DATABASE_BIT) !=0)
   {
+    section = SectionLoader::beginSection(output, DATABASE_BIT, compression);
     if (!Database::getSingleton().saveAllToStream(output))
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write database entries "
                 << "to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }//if
+    if (!SectionLoader::endSection(output, section))
+    {
+      DuskLog() << "DataLoader::saveToFile: ERROR: could not finish section "
+                << "of file \""<<FileName<<"\".\n";
+      return false;
+    }
   }//if database
 
+  //save quest log
+  if ((bits & QUEST_LOG_BIT)!=0)
+  {
+    if (!QuestLog::getSingleton().saveToStream(output))
+    {
+      DuskLog() << "DataLoader::saveToFile: ERROR: could not write QuestLog "
+                << "data to file \""<<FileName<<"\".\n";
+      return false;
+    }
+  }//quest log entries
+
   //save animated objects/ injection objects
   if ((bits & INJECTION_BIT)!=0)
   {
@@ -171,7 +220,6 @@ bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write Injection "
                 << "reference data to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }
     //save player object, too
@@ -179,7 +227,6 @@ bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write Player "
                 << "reference data to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }
   }//AnimatedObjects
@@ -191,58 +238,94 @@ bool DataLoader::saveToFile(const std::string& FileName, const unsigned int bits
     {
       DuskLog() << "DataLoader::saveToFile: ERROR: could not write object "
                 << "reference data to file \""<<FileName<<"\".\n";
-      output.close();
       return false;
     }//if
   }//if obj. references
-  output.close();
+  if (!output.saveToFile(FileName))
+  {
+    DuskLog() << "DataLoader::saveToFile: ERROR: could not write data to file \""
+              << FileName<<"\".\n";
+    return false;
+  }
   return true;
 }
 
 bool DataLoader::loadFromFile(const std::string& FileName)
 {
-  std::ifstream input;
-  input.open(FileName.c_str(), std::ios::in | std::ios::binary);
-  if(!input)
+  //read the whole file at once, records are parsed from memory afterwards
+  BinaryReader input;
+  if (!input.loadFromFile(FileName))
   {
     DuskLog() << "DataLoader::loadFromFile: Could not open file \""<<FileName
               << "\" for reading in binary mode.\n";
     return false;
   }//if
 
-  unsigned int file_size;
   uint32_t Header, data_records, records_done;
 
-  //determine file size
-  input.seekg(0, std::ios::end);
-  file_size = input.tellg();
-  input.seekg(0, std::ios::beg);
-
   //read header "Dusk"
   Header = 0;
-  input.read((char*) &Header, sizeof(uint32_t));
+  input.readUInt32(Header);
   if (Header!=cHeaderDusk)
   {
     DuskLog() << "DataLoader::loadFromFile: ERROR: File \""<<FileName
               <<"\" contains invalid file header.\n";
-    input.close();
     return false;
   }
 
   //determine number of records
   data_records = 0;
-  input.read((char*) &data_records, sizeof(uint32_t));
+  input.readUInt32(data_records);
 
   //read loop
   LandscapeRecord* land_rec = NULL;
   bool success = true;
   records_done = 0;
-  while ((records_done<data_records) && (input.tellg()<file_size))
+  /* Sections are parsed by worker threads while the main thread goes on with
+     the following data. The parsed records are added before any other record
+     is processed, because those might depend on the records of the sections.
+  */
+  SectionLoader sections;
+  uint32_t sectionKind, sectionSize;
+  while ((records_done<data_records) && !input.atEnd())
   {
     Header = 0;
-    //read next record header
-    input.read((char*) &Header, sizeof(uint32_t));
-    input.seekg(-4, std::ios::cur);
+    //peek at next record header, the record itself reads it again
+    input.peekUInt32(Header);
+    if (Header==cHeaderSect)
+    {
+      input.skip(4);
+      sectionKind = sectionSize = 0;
+      input.readUInt32(sectionKind);
+      input.readUInt32(sectionSize);
+      if (!input.good() or (sectionSize>input.remaining()))
+      {
+        DuskLog() << "DataLoader::loadFromFile: ERROR: invalid section header "
+                  << "in file \""<<FileName<<"\" at position "<<input.tell()
+                  << ".\n";
+        return false;
+      }
+      if (sectionSize!=0)
+      {
+        if (!sections.startSection(sectionKind, input.current(), sectionSize))
+        {
+          DuskLog() << "DataLoader::loadFromFile: ERROR: could not read section"
+                    << " in file \""<<FileName<<"\".\n";
+          return false;
+        }
+        input.skip(sectionSize);
+      }
+      continue;
+    }//if section
+    if (sections.hasPendingSections())
+    {
+      if (!sections.finishSections(records_done))
+      {
+        DuskLog() << "DataLoader::loadFromFile: ERROR while reading sections "
+                  << "of file \""<<FileName<<"\".\n";
+        return false;
+      }
+    }
     switch (Header)
     {
       case cHeaderDial:
@@ -264,6 +347,7 @@ bool DataLoader::loadFromFile(const std::string& FileName)
       case cHeaderLight:
       case cHeaderNPC_:
       case cHeaderObjS:
+      case cHeaderProj:
       case cHeaderRsrc:
       case cHeaderSoun:
       case cHeaderVehi:
@@ -294,7 +378,7 @@ bool DataLoader::loadFromFile(const std::string& FileName)
       default:
           DuskLog() << "DataLoader::loadFromFile: ERROR: Got unexpected header "
                     <<Header << " in file \""<<FileName<<"\" at position "
-                    <<input.tellg()<<".\n";
+                    <<input.tell()<<".\n";
           success = false;
           break;
     }//switch
@@ -302,14 +386,18 @@ bool DataLoader::loadFromFile(const std::string& FileName)
     if(!success or !input.good())
     {
       DuskLog() << "DataLoader::loadFromFile: ERROR while reading data.\n"
-                << "Position: "<<input.tellg() << " bytes.\n"
+                << "Position: "<<input.tell() << " bytes.\n"
                 << "Records read: "<<records_done<<" (excluding failure)\n";
-      input.close();
       return false;
     }
     records_done = records_done+1;
   }//while
-  input.close();
+  if (!sections.finishSections(records_done))
+  {
+    DuskLog() << "DataLoader::loadFromFile: ERROR while reading sections of "
+              << "file \""<<FileName<<"\".\n";
+    return false;
+  }
   DuskLog() << "DataLoader::loadFromFile: Info: "<<records_done<<" records "
             << "loaded from file \""<<FileName<<"\".\n";
   m_LoadedFiles.push_back(FileName);
@@ -360,9 +448,10 @@ void DataLoader::clearData(const unsigned int bits)
 
 bool DataLoader::loadSaveGame(const std::string& FileName)
 {
-  std::ifstream input;
-  input.open(FileName.c_str(), std::ios::in | std::ios::binary);
-  if(!input)
+  //the requested save game might still be on its way to the disk
+  waitForPendingSaves();
+  BinaryReader input;
+  if (!input.loadFromFile(FileName))
   {
     DuskLog() << "DataLoader::loadSaveGame: Could not open file \""<<FileName
               << "\" for reading in binary mode.\n";
@@ -371,12 +460,7 @@ bool DataLoader::loadSaveGame(const std::string& FileName)
 
   uint32_t Header, data_records;
 
-  //determine file size
-  input.seekg(0, std::ios::end);
-  const unsigned int file_size = input.tellg();
-  input.seekg(0, std::ios::beg);
-
-  if (file_size<16)
+  if (input.size()<16)
   {
     DuskLog() << "DataLoader::loadSaveGame: file \""<<FileName << "\" is to "
               << "small to contain a real save game.\n";
@@ -385,92 +469,70 @@ bool DataLoader::loadSaveGame(const std::string& FileName)
 
   //read header "Dusk"
   Header = 0;
-  input.read((char*) &Header, sizeof(uint32_t));
+  input.readUInt32(Header);
   if (Header!=cHeaderDusk)
   {
     DuskLog() << "DataLoader::loadSaveGame: ERROR: File \""<<FileName
               <<"\" contains invalid file header.\n";
-    input.close();
     return false;
   }
   //determine number of records
   data_records = 0;
-  input.read((char*) &data_records, sizeof(uint32_t));
+  input.readUInt32(data_records);
   //read header "Save"
   Header = 0;
-  input.read((char*) &Header, sizeof(uint32_t));
+  input.readUInt32(Header);
   if (Header!=cHeaderSave)
   {
     DuskLog() << "DataLoader::loadSaveGame: ERROR: File \""<<FileName
               <<"\" does not seem to be a valid save game.\n";
-    input.close();
     return false;
   }
-  /*read header "Mean" (identifies save game "version", because this should
-    be improved and get a different version later on) */
-  Header = 0;
-  input.read((char*) &Header, sizeof(uint32_t));
-  if (Header!=cHeaderMean)
+  /*read header "Mean" or "Delt" (identifies save game "version") */
+  uint32_t saveType = 0;
+  input.readUInt32(saveType);
+  if (saveType!=cHeaderMean and saveType!=cHeaderDelt)
   {
     DuskLog() << "DataLoader::loadSaveGame: ERROR: File \""<<FileName
               <<"\" does not contain a valid save game format.\n";
-    input.close();
     return false;
   }
   //read dependencies
   Header = 0;
-  input.read((char*) &Header, sizeof(uint32_t));
+  input.readUInt32(Header);
   if (Header!=cHeaderDeps)
   {
     DuskLog() << "DataLoader::loadSaveGame: ERROR: File \""<<FileName
               <<"\" does not contain a list of required data files.\n";
-    input.close();
     return false;
   }
   //read their number
   uint32_t depCount = 0;
-  input.read((char*) &depCount, sizeof(uint32_t));
+  input.readUInt32(depCount);
   if (depCount == 0 or depCount>255)
   { //no reasonable limits given
     DuskLog() << "DataLoader::loadSaveGame: ERROR: File \""<<FileName
               << "\" has a list of required data files which is too long or too"
               << " short (length: "<<depCount<<").\n";
-    input.close();
     return false;
   }
   clearData(ALL_BITS);
   m_LoadedFiles.clear();
-  uint32_t len;
-  char buffer[256];
+  std::string dataFileName;
   for (Header=0; Header<depCount; Header=Header+1)
   {
-    len = 0;
-    input.read((char*) &len, sizeof(uint32_t));
-    if (len>255)
-    {
-      DuskLog() << "DataLoader::loadSaveGame: ERROR while loading file \""
-                <<FileName<< "\": name of required data file is longer than 255"
-                <<" characters.\n";
-      input.close();
-      return false;
-    }//if
-    buffer[0]='\0';
-    input.read(buffer, len);
-    buffer[len] = '\0';
-    if (!input.good())
+    if (!input.readString(dataFileName))
     {
       DuskLog() << "DataLoader::loadSaveGame: ERROR while reading name of "
-                << "required data file.\n";
-      input.close();
+                << "required data file from file \""<<FileName<<"\" (name "
+                << "must not be longer than 255 characters).\n";
       return false;
     }
     //got name, so load it
-    const std::string dataFileName = std::string(buffer);
     if (dataFileName==FileName)
     {
       DuskLog() << "DataLoader::loadSaveGame: ERROR: SaveGame file cannot be a"
                 << "required data file of itself.\n";
-      input.close();
       return false;
     }
     if (!loadFromFile(dataFileName))
@@ -478,7 +540,6 @@ bool DataLoader::loadSaveGame(const std::string& FileName)
       DuskLog() << "DataLoader::loadSaveGame: ERROR while loading required "
                 << "data file \""<<dataFileName<<"\" of save \""<<FileName
                 <<"\".\n";
-      input.close();
       return false;
     }
     else
@@ -490,31 +551,71 @@ bool DataLoader::loadSaveGame(const std::string& FileName)
   }//for
 
   //dependencies are loaded, now clear unneeded data
-  clearData(SAVE_MEAN_BITS);
+  clearData(QUEST_LOG_BIT);
+  if (saveType==cHeaderMean)
+  {
+    /* "Mean" save games contain all references, so the references from the
+       data files are not needed. They still have to be remembered as removed,
+       because the next save game will only contain the differences. */
+    ObjectManager::getSingleton().removeAllReferences();
+    InjectionManager::getSingleton().removeAllReferences();
+  }
   //go on loading
   bool success = true;
   uint32_t records_done = 0;
-  while ((records_done<data_records) && (input.tellg()<file_size))
+  uint32_t baseIndex = cNoBaseIndex;
+  Header = 0;
+  input.peekUInt32(Header);
+  if (Header==cHeaderComp)
+  {
+    /* the records are compressed - replace the data of the reader by the
+       uncompressed records, followed by whatever comes after the block */
+    std::vector<char> records;
+    if (!readCompressedBlock(input, records))
+    {
+      DuskLog() << "DataLoader::loadSaveGame: ERROR: could not decompress data"
+                << " of file \""<<FileName<<"\".\n";
+      return false;
+    }
+    records.insert(records.end(), input.current(), input.current()+input.remaining());
+    input.assign(records);
+  }
+  while ((records_done<data_records) && !input.atEnd())
   {
     Header = 0;
-    //read next record header
-    input.read((char*) &Header, sizeof(uint32_t));
-    input.seekg(-4, std::ios::cur);
+    //peek at next record header, the record itself reads it again
+    input.peekUInt32(Header);
+    baseIndex = cNoBaseIndex;
+    if (Header==cHeaderBIdx)
+    {
+      //modified reference from data file, next record is the reference itself
+      input.skip(4);
+      input.readUInt32(baseIndex);
+      Header = 0;
+      input.peekUInt32(Header);
+    }
     switch(Header)
     {
       case cHeaderRefA:  //AnimatedObject
       case cHeaderRefN:  //NPC
       case cHeaderRefP:  //Projectiles
       case cHeaderRefR:  //Resource
+      case cHeaderRefV:  //Vehicle
       case cHeaderRfWP:  //WaypointObject
-           success = InjectionManager::getSingleton().loadNextFromStream(input, Header);
+           success = InjectionManager::getSingleton().loadSavedReferenceFromStream(input, Header, baseIndex);
            break;
       case cHeaderRefC: //Container
       case cHeaderRefI: //Item
       case cHeaderRefL: //Light
       case cHeaderRefO: //DuskObject
       case cHeaderRfWe: //Weapon
-           success = ObjectManager::getSingleton().loadNextFromStream(input, Header);
+           success = ObjectManager::getSingleton().loadSavedReferenceFromStream(input, Header, baseIndex);
+           break;
+      case cHeaderRmvI: //removed InjectionManager references
+           success = InjectionManager::getSingleton().loadRemovedReferencesFromStream(input);
+           break;
+      case cHeaderRmvO: //removed ObjectManager references
+           success = ObjectManager::getSingleton().loadRemovedReferencesFromStream(input);
            break;
       case cHeaderQLog: //questlog
            success = QuestLog::getSingleton().loadFromStream(input);
@@ -525,95 +626,122 @@ bool DataLoader::loadSaveGame(const std::string& FileName)
       default:
            DuskLog() <<"DataLoader::loadSaveGame: ERROR: Got unexpected header "
                      <<Header << " in file \""<<FileName<<"\" at position "
-                     <<input.tellg()<<".\n";
+                     <<input.tell()<<".\n";
            success = false;
            break;
     }//swi
     if(!success or !input.good())
     {
       DuskLog() << "DataLoader::loadSaveGame: ERROR while reading data.\n"
-                << "Position: "<<input.tellg() << " bytes.\n"
+                << "Position: "<<input.tell() << " bytes.\n"
                 << "Records read: "<<records_done<<" (excluding failure)\n";
-      input.close();
       return false;
     }
     records_done = records_done+1;
   }//while
-  input.close();
   DuskLog() << "DataLoader::loadSaveGame: Info: "<<records_done<<" out of "
             << data_records<< " expected records loaded.\n";
   return true;
 }
 
-bool DataLoader::saveGame(const std::string& FileName) const
+bool DataLoader::saveGame(const std::string& FileName)
 {
-  std::ofstream output;
-  output.open(FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
-  if(!output)
-  {
-    DuskLog() << "DataLoader::saveGame: Could not open file \""<<FileName
-              << "\" for writing in binary mode.\n";
-    return false;
-  }//if
+  /* collect the game state on the calling thread (i.e. between two frames),
+     the background thread only gets the finished buffers */
+  std::shared_ptr<BinaryWriter> snapshot(new BinaryWriter(cInitialWriteBufferSize));
+  BinaryWriter& output = *snapshot;
+  //records after the dependencies go into a separate buffer for compression
+  std::shared_ptr<BinaryWriter> body(new BinaryWriter(cInitialWriteBufferSize));
+  const CompressionMethod compression = getCompressionSetting("SaveGameCompression");
   //write header "Dusk"
-  output.write((const char*) &cHeaderDusk, sizeof(uint32_t));
+  output.writeUInt32(cHeaderDusk);
   //determine and write number of records
-  uint32_t data_records = 1 /*QuestLog*/ + ObjectManager::getSingleton().getNumberOfReferences()
-                              + InjectionManager::getSingleton().getNumberOfReferences()
+  uint32_t data_records = 1 /*QuestLog*/ + ObjectManager::getSingleton().getNumberOfChangedRecords()
+                              + InjectionManager::getSingleton().getNumberOfChangedRecords()
                               +1 /* Player */;
-  output.write((const char*) &data_records, sizeof(uint32_t));
+  output.writeUInt32(data_records);
   //write headers to identify file as save game
-  output.write((const char*) &cHeaderSave, sizeof(uint32_t));
-  output.write((const char*) &cHeaderMean, sizeof(uint32_t));
+  output.writeUInt32(cHeaderSave);
+  output.writeUInt32(cHeaderDelt);
   //dependencies
-  output.write((const char*) &cHeaderDeps, sizeof(uint32_t));
-  data_records = m_LoadedFiles.size();
-  output.write((const char*) &data_records, sizeof(uint32_t));
+  output.writeUInt32(cHeaderDeps);
+  output.writeUInt32(m_LoadedFiles.size());
   unsigned int i;
   for (i=0; i<m_LoadedFiles.size(); i=i+1)
   {
-    data_records = m_LoadedFiles[i].length();
-    output.write((const char*) &data_records, sizeof(uint32_t));
-    output.write(m_LoadedFiles[i].c_str(), data_records);
+    output.writeString(m_LoadedFiles[i]);
   }//for
   if(!output.good())
   {
     DuskLog() << "DataLoader::saveGame: ERROR while writing header data to "
               << "file \""<<FileName<<"\".\n";
-    output.close();
     return false;
   }
-  //write the data
-  if (!ObjectManager::getSingleton().saveAllToStream(output))
+  //write the data - only references that differ from the data files
+  if (!ObjectManager::getSingleton().saveChangesToStream(*body))
   {
     DuskLog() << "DataLoader::saveGame: ERROR while writing object data to "
               << "file \""<<FileName<<"\".\n";
-    output.close();
     return false;
   }
-  if (!InjectionManager::getSingleton().saveAllToStream(output))
+  if (!InjectionManager::getSingleton().saveChangesToStream(*body))
   {
     DuskLog() << "DataLoader::saveGame: ERROR while writing animation data to "
               << "file \""<<FileName<<"\".\n";
-    output.close();
     return false;
   }
-  if (!Player::getSingleton().saveToStream(output))
+  if (!Player::getSingleton().saveToStream(*body))
   {
     DuskLog() << "DataLoader::saveGame: ERROR while writing player data to "
               << "file \""<<FileName<<"\".\n";
-    output.close();
     return false;
   }
-  if (!QuestLog::getSingleton().saveToStream(output))
+  if (!QuestLog::getSingleton().saveToStream(*body))
   {
     DuskLog() << "DataLoader::saveGame: ERROR while writing quest log to "
               << "file \""<<FileName<<"\".\n";
-    output.close();
     return false;
   }
-  output.close();
+  //hand the buffer to the writer thread
+  if (m_SaveWriter==NULL)
+  {
+    //one thread only, so save games are written in the order of the calls
+    m_SaveWriter = new ThreadPool(1);
+  }
+  ++m_PendingSaves;
+  m_SaveWriter->enqueue([this, snapshot, body, compression, FileName]()
+    {
+      //compression is done here, too, to keep it off the main thread
+      if (!writeCompressedBlock(*snapshot, *body, compression))
+      {
+        DuskLog() << "DataLoader::saveGame: ERROR: could not compress data for "
+                  << "file \""<<FileName<<"\".\n";
+        m_SaveFailed = true;
+      }
+      else if (!snapshot->saveToFileAtomic(FileName))
+      {
+        DuskLog() << "DataLoader::saveGame: ERROR: could not write data to file \""
+                  << FileName<<"\".\n";
+        m_SaveFailed = true;
+      }
+      --m_PendingSaves;
+    });
   return true;
 }
 
+bool DataLoader::waitForPendingSaves()
+{
+  if (m_SaveWriter!=NULL)
+  {
+    m_SaveWriter->waitForAll();
+  }
+  //report failure only once
+  return !m_SaveFailed.exchange(false);
+}
+
+bool DataLoader::isSaving() const
+{
+  return (m_PendingSaves>0);
+}
+
 }//namespace
@@ -65,6 +65,11 @@
      - 2012-07-07 (rev 316) - update to use Database instead of ProjectileBase,
                               ResourceBase, VehicleBase and WeaponBase
      - 2012-07-19 (rev 321) - update to use Database instead of SoundBase
+     - 2026-10-19 - files are read/written in one go via BinaryReader and
+                    BinaryWriter instead of field by field
+     - 2026-10-19 - save games only contain references which differ from the
+                    loaded data files ("Delt" save game type)
+     - 2026-10-19 - save games are written to disk by a background thread
 
  ToDo list:
      - extend class when further classes for data management are added
@@ -77,11 +82,14 @@
 #ifndef DUSK_DATALOADER_H
 #define DUSK_DATALOADER_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 namespace Dusk
 {
+  class ThreadPool; //forward declaration
+
   //Flags to indicate which portions to load/ save
   const unsigned int DATABASE_BIT   = 1;
   const unsigned int DIALOGUE_BIT   = 1<<1;
@@ -97,6 +105,9 @@ namespace Dusk
 
   const unsigned int SAVE_MEAN_BITS = INJECTION_BIT | QUEST_LOG_BIT | REFERENCE_BIT;
 
+  //number of bytes that are reserved up front when data is saved
+  const unsigned int cInitialWriteBufferSize = 1024*1024;
+
 /*class DataLoader:
         This class is (or will be) the main entry point for loading game data
         from files and saving data to files. It calls the individual classes for
@@ -130,11 +141,37 @@ class DataLoader
     */
     void clearData(const unsigned int bits = ALL_BITS);
 
-    /* tries to load a saved game from file FileName and returns true on success */
+    /* tries to load a saved game from file FileName and returns true on success
+
+       remarks:
+           Both the old "Mean" save games (complete list of references) and the
+           "Delt" save games (only changes to the data files) can be loaded.
+    */
     bool loadSaveGame(const std::string& FileName);
 
-    /* tries to save a game to the file FileName and returns true on success */
-    bool saveGame(const std::string& FileName) const;
+    /* tries to save a game to the file FileName and returns true, if the
+       current game state could be collected successfully
+
+       remarks:
+           The save game only contains the references that were removed,
+           modified or created since the data files were loaded, plus player
+           and quest log.
+           The game state is collected into memory right away, but the file is
+           written by a background thread, so the function returns before the
+           data is on the disk. The file is written to a temporary file first
+           and then renamed, so FileName never contains a partial save game.
+           Call waitForPendingSaves() to find out whether writing succeeded.
+    */
+    bool saveGame(const std::string& FileName);
+
+    /* blocks until all save games that are written in the background are on
+       the disk. Returns false, if writing of at least one of them failed since
+       the last call of this function.
+    */
+    bool waitForPendingSaves();
+
+    /* returns true, while save games are still written in the background */
+    bool isSaving() const;
   private:
     /* private constructor (singleton pattern) */
     DataLoader();
@@ -142,6 +179,9 @@ class DataLoader
     DataLoader(const DataLoader& op){}
 
     std::vector<std::string> m_LoadedFiles;
+    ThreadPool* m_SaveWriter;
+    std::atomic<unsigned int> m_PendingSaves;
+    std::atomic<bool> m_SaveFailed;
 };//class
 
 }//namespace
@@ -41,127 +41,82 @@ Dialogue::ConditionRecord::ConditionRecord()
 }
 
 
-bool Dialogue::LineRecord::saveToStream(std::ofstream& out) const
+bool Dialogue::LineRecord::saveToStream(BinaryWriter& out) const
 {
-  unsigned int len, i;
+  unsigned int i;
   //text
-  len = Text.length();
-  out.write((const char*) &len, sizeof(unsigned int));
-  out.write(Text.c_str(), len);
+  out.writeString(Text);
   //conditions
   // -- NPC_ID
-  len = Conditions.NPC_ID.length();
-  out.write((const char*) &len, sizeof(unsigned int));
-  out.write(Conditions.NPC_ID.c_str(), len);
+  out.writeString(Conditions.NPC_ID);
   // -- ItemID
-  len = Conditions.ItemID.length();
-  out.write((const char*) &len, sizeof(unsigned int));
-  out.write(Conditions.ItemID.c_str(), len);
-  if (len>0)
+  out.writeString(Conditions.ItemID);
+  if (!Conditions.ItemID.empty())
   {
-    out.write((const char*) &(Conditions.ItemOp), sizeof(CompareOperation));
-    out.write((const char*) &(Conditions.ItemAmount), sizeof(unsigned int));
+    out.writeUInt32(static_cast<uint32_t>(Conditions.ItemOp));
+    out.writeUInt32(Conditions.ItemAmount);
   }
   // -- ScriptedCondition
   if (Conditions.ScriptedCondition==NULL)
   {
-    len = 0;
-    out.write((const char*) &len, sizeof(unsigned int));
+    out.writeUInt32(0);
   }
   else
   { //there is a script, write it out
-    len = Conditions.ScriptedCondition->getStringRepresentation().length();
-    out.write(Conditions.ScriptedCondition->getStringRepresentation().c_str(),
-              len);
+    out.writeString(Conditions.ScriptedCondition->getStringRepresentation());
   }
   //choices
-  len = Choices.size();
-  out.write((const char*) &len, sizeof(unsigned int));
+  out.writeUInt32(Choices.size());
   for (i=0; i<Choices.size(); i=i+1)
   {
-    len = Choices[i].length();
-    out.write((const char*) &len, sizeof(unsigned int));
-    out.write(Choices[i].c_str(), len);
+    out.writeString(Choices[i]);
   }
   //result script
   if (ResultScript==NULL)
   {
-    len = 0;
-    out.write((const char*) &len, sizeof(unsigned int));
+    out.writeUInt32(0);
   }
   else
   {
-    len = ResultScript->getStringRepresentation().length();
-    out.write((const char*) &len, sizeof(unsigned int));
-    out.write(ResultScript->getStringRepresentation().c_str(), len);
+    out.writeString(ResultScript->getStringRepresentation());
   }
   return out.good();
 }
 
-bool Dialogue::LineRecord::loadFromStream(std::ifstream& inp)
+bool Dialogue::LineRecord::loadFromStream(BinaryReader& inp)
 {
   if (!inp.good())
   {
     return false;
   }
-  unsigned int len;
   //text
-  inp.read((char*) &len, sizeof(unsigned int));
-  if (len>511)
-  {
-    DuskLog() << "LineRecord::loadFromStream: ERROR: Text seems to be longer "
-              << "than 511 characters.\n";
-    return false;
-  }
-  char buffer[512];
-  inp.read(buffer, len);
-  buffer[len] = '\0'; //ensure NUL-termination
-  if (!inp.good())
+  if (!inp.readString(Text, 511))
   {
     DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading Text "
-              << "from stream.\n";
+              << "from stream. (Maximum length is 511 characters.)\n";
     return false;
   }
-  Text = std::string(buffer);
   //conditions
   // -- NPC_ID
-  inp.read((char*) &len, sizeof(unsigned int));
-  if (len>511)
-  {
-    DuskLog() << "LineRecord::loadFromStream: ERROR: NPC_ID seems to be longer "
-              << "than 511 characters.\n";
-    return false;
-  }
-  inp.read(buffer, len);
-  buffer[len] = '\0'; //ensure NUL-termination
-  if (!inp.good())
+  if (!inp.readString(Conditions.NPC_ID, 511))
   {
     DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading NPC_ID"
-              << "from stream.\n";
+              << " from stream. (Maximum length is 511 characters.)\n";
     return false;
   }
-  Conditions.NPC_ID = std::string(buffer);
   // -- ItemID
-  inp.read((char*) &len, sizeof(unsigned int));
-  if (len>511)
-  {
-    DuskLog() << "LineRecord::loadFromStream: ERROR: ItemID seems to be longer "
-              << "than 511 characters.\n";
-    return false;
-  }
-  inp.read(buffer, len);
-  buffer[len] = '\0'; //ensure NUL-termination
-  if (!inp.good())
+  if (!inp.readString(Conditions.ItemID, 511))
   {
     DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading ItemID"
-              << "from stream.\n";
+              << " from stream. (Maximum length is 511 characters.)\n";
     return false;
   }
-  Conditions.ItemID = std::string(buffer);
-  if (len>0)
+  uint32_t len = 0;
+  if (!Conditions.ItemID.empty())
   {
-    inp.read((char*) &(Conditions.ItemOp), sizeof(CompareOperation));
-    inp.read((char*) &(Conditions.ItemAmount), sizeof(unsigned int));
+    inp.readUInt32(len);
+    Conditions.ItemOp = static_cast<CompareOperation>(len);
+    inp.readUInt32(Conditions.ItemAmount);
     if (!inp.good())
     {
       DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading "
@@ -175,100 +130,74 @@ bool Dialogue::LineRecord::loadFromStream(std::ifstream& inp)
     Conditions.ItemAmount = 0;
   }
   // -- ScriptedCondition
-  inp.read((char*) &len, sizeof(unsigned int));
-  if (len==0)
+  //length check to avoid allocation of to much memory and running out of memory
+  std::string scriptData;
+  if (!inp.readString(scriptData, 100 /*maximum lines*/ * 80 /*characters per line*/))
+  {
+    DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading "
+              << "Script text from stream. Maximum is 8000 characters.\n";
+    return false;
+  }//if
+  if (scriptData.empty())
   {
     Conditions.ScriptedCondition = NULL;
   }
   else
   {
-    //length check to avoid allocation of to much memory and running out of memory
-    if (len>100 /*maximum lines*/ * 80 /*characters per line*/)
-    {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: Condition Script is to "
-                << "long ("<<len<<" characters). Maximum is 8000 characters.\n";
-      return false;
-    }
-    char* scriptData = new char[len+1];
-    inp.read(scriptData, len);
-    scriptData[len] = '\0';
-    if (!inp.good())
-    {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading "
-                << "Script text from stream.\n";
-      delete[] scriptData;
-      return false;
-    }//if
     Conditions.ScriptedCondition = new Script(scriptData);
-    delete[] scriptData;
   }
 
   //choices
-  unsigned int choices_size = 0, i;
-  inp.read((char*) &choices_size, sizeof(unsigned int));
+  uint32_t choices_size = 0, i;
+  inp.readUInt32(choices_size);
   //Should do size check?
   Choices.clear();
+  std::string choiceID;
   for (i=0; i<choices_size; i=i+1)
   {
-    inp.read((char*) &len, sizeof(unsigned int));
-    if (len>511)
+    if (!inp.readString(choiceID, 511))
     {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: ID seems to be longer "
-                << "than 511 characters.\n";
+      DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading ID "
+                << "of dialogue choices from stream. (Maximum length is 511 "
+                << "characters.)\n";
       return false;
     }
-    inp.read(buffer, len);
-    buffer[len] = '\0'; //ensure NUL-termination
-    if (!inp.good())
-    {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading ID"
-                << "of dialogue choices from stream.\n";
-      return false;
-    }
-    Choices.push_back(std::string(buffer));
+    Choices.push_back(choiceID);
   }//for
 
   //result script
-  inp.read((char*) &len, sizeof(unsigned int));
-  if (len==0)
+  //length check to avoid allocation of to much memory + running out of memory
+  if (!inp.readString(scriptData, 100 /*maximum lines*/ * 80 /*characters per line*/))
+  {
+    DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading "
+              << "Result Script text from stream. Maximum is 8000 characters.\n";
+    return false;
+  }//if
+  if (scriptData.empty())
   {
     ResultScript = NULL;
   }
   else
   {
-    //length check to avoid allocation of to much memory + running out of memory
-    if (len>100 /*maximum lines*/ * 80 /*characters per line*/)
-    {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: Result Script is to "
-                << "long ("<<len<<" characters). Maximum is 8000 characters.\n";
-      return false;
-    }
-    char* scriptData = new char[len+1];
-    scriptData[0] = '\0';
-    inp.read(scriptData, len);
-    scriptData[len] = '\0';
-    if (!inp.good())
-    {
-      DuskLog() << "LineRecord::loadFromStream: ERROR: Error while reading "
-                << "Result Script text from stream.\n";
-      delete[] scriptData;
-      return false;
-    }//if
     ResultScript = new Script(scriptData);
-    delete[] scriptData;
   }
   return inp.good();
 }
 
 Dialogue::Dialogue()
+: m_GreetingIndexValid(false)
 {
   //empty
 }
 
 Dialogue::~Dialogue()
 {
-  //empty
-  clearData();
+  //no clearData() here - the Lua state may already be closed, and its
+  //references are freed with it anyway
+  m_DialogueLines.clear();
+  m_GreetingLines.clear();
+  m_ConditionFunctions.clear();
+  m_GreetingIndex.clear();
 }
 
 Dialogue& Dialogue::getSingleton()
@@ -279,8 +208,17 @@ Dialogue& Dialogue::getSingleton()
 
 void Dialogue::clearData()
 {
+  std::map<std::string, int>::const_iterator iter = m_ConditionFunctions.begin();
+  while (iter!=m_ConditionFunctions.end())
+  {
+    LuaEngine::getSingleton().releaseReference(iter->second);
+    ++iter;
+  }//while
+  m_ConditionFunctions.clear();
   m_DialogueLines.clear();
   m_GreetingLines.clear();
+  m_GreetingIndex.clear();
+  m_GreetingIndexValid = false;
 }
 
 std::string Dialogue::getText(const std::string& LineID) const
@@ -325,62 +263,103 @@ Dialogue::Handle Dialogue::getGreetingLine(const NPC* who) const
   temp.Text = "";
   temp.LineID = "";
 
-  std::map<std::string, std::vector<std::string> >::const_iterator iter;
+  if (!m_GreetingIndexValid)
+  {
+    buildGreetingIndex();
+  }
+
+  std::map<std::string, GreetingIndex>::const_iterator iter;
   if (who != NULL)
   {
-    iter = m_GreetingLines.find(who->getID());
-    if (iter == m_GreetingLines.end())
+    iter = m_GreetingIndex.find(who->getID());
+    if (iter == m_GreetingIndex.end())
     { //if there's no entry for that NPC, get the generic one
-      iter = m_GreetingLines.find("");
+      iter = m_GreetingIndex.find("");
     }
   }
   else
   { //get general entry
-    iter = m_GreetingLines.find("");
+    iter = m_GreetingIndex.find("");
   }
 
-  if (iter == m_GreetingLines.end())
+  if (iter == m_GreetingIndex.end())
   { //nothing found?
     return temp;
   }
+  const GreetingIndex& index = iter->second;
 
-  //now check each entry for conditions, and if they are met, return this entry
-  for (i=0; i<iter->second.size(); i=i+1)
+  //Greetings whose NPC ID does not match cannot be chosen, so only the
+  // greetings without NPC ID and those for this NPC are checked. Both lists
+  // are sorted, so merging them keeps the order of the greetings.
+  static const std::vector<unsigned int> cNoGreetings;
+  const std::vector<unsigned int>* forNPC = &cNoGreetings;
+  if (who != NULL)
   {
-    if (isConditionFulfilled(getCondition(iter->second.at(i)), who))
+    const std::map<std::string, std::vector<unsigned int> >::const_iterator npc_iter
+        = index.ByNPC.find(who->getID());
+    if (npc_iter != index.ByNPC.end())
+    {
+      forNPC = &(npc_iter->second);
+    }
+  }
+  const std::vector<unsigned int>& forAny = index.AnyNPC;
+
+  //now check each entry for conditions, and if they are met, return this entry
+  const IndexedGreeting* found = NULL;
+  unsigned int any_pos = 0;
+  unsigned int npc_pos = 0;
+  while ((any_pos<forAny.size()) or (npc_pos<forNPC->size()))
+  {
+    unsigned int next;
+    if ((npc_pos>=forNPC->size())
+        or ((any_pos<forAny.size()) and (forAny[any_pos]<(*forNPC)[npc_pos])))
     {
-      temp.LineID = iter->second.at(i);
+      next = forAny[any_pos];
+      ++any_pos;
+    }
+    else
+    {
+      next = (*forNPC)[npc_pos];
+      ++npc_pos;
+    }
+    const IndexedGreeting& greeting = index.Greetings[next];
+    if (greeting.Line == NULL)
+    {
+      //same as an empty condition record, will be reported below
+      found = &greeting;
       break;
     }
-  } //for
+    if (checkConditions(*greeting.Line, greeting.ScriptFunction, who))
+    {
+      found = &greeting;
+      break;
+    }
+  } //while
 
-  if (temp.LineID == "")
+  if (found == NULL)
   { //no matching entry found
     return temp;
   }
 
-  //now get the dialogue line and the choices
-  std::map<std::string, LineRecord>::const_iterator dial_iter;
-  dial_iter = m_DialogueLines.find(temp.LineID);
   //no matching dialogue entry found; should not happen in a properly set up
   // dialogue.
-  if (dial_iter == m_DialogueLines.end())
+  if (found->Line == NULL)
   {
     DuskLog() << "Dialogue::getGreetingLine: Hint: found no line entry for ID "
-              << "\""<<temp.LineID<<"\". This should not happen here, check "
-              << "your dialogue and add the line with this ID.\n";
-    temp.LineID = "";
+              << "\""<<*(found->LineID)<<"\". This should not happen here, "
+              << "check your dialogue and add the line with this ID.\n";
     return temp; //return empty record
   }
+  temp.LineID = *(found->LineID);
   //text
-  temp.Text = dial_iter->second.Text;
+  temp.Text = found->Line->Text;
 
   //now check the conditions of the choices to display and add them
-  for (i=0; i< dial_iter->second.Choices.size(); i=i+1)
+  for (i=0; i< found->Line->Choices.size(); i=i+1)
   {
-    if (isConditionFulfilled(getCondition(dial_iter->second.Choices.at(i)), who))
+    if (isConditionFulfilled(found->Line->Choices.at(i), who))
     {
-      temp.Choices.push_back(dial_iter->second.Choices.at(i));
+      temp.Choices.push_back(found->Line->Choices.at(i));
     }//if
   } //for
 
@@ -403,7 +382,7 @@ Dialogue::Handle Dialogue::getDialogueLine(const std::string& LineID, const NPC*
     //add choices
     for (i=0; i<iter->second.Choices.size(); i=i+1)
     {
-      if (isConditionFulfilled(getCondition(iter->second.Choices[i]), who))
+      if (isConditionFulfilled(iter->second.Choices[i], who))
       {
         temp.Choices.push_back(iter->second.Choices.at(i));
       }
@@ -420,14 +399,97 @@ Dialogue::Handle Dialogue::getDialogueLine(const std::string& LineID, const NPC*
 void Dialogue::addGreeting(const std::string& NPC_ID, const std::vector<std::string>& Choices)
 {
   m_GreetingLines[NPC_ID] = Choices;
+  m_GreetingIndexValid = false;
 }
 
 void Dialogue::addLine(const std::string& LineID, const LineRecord& lr)
 {
   if (LineID != "")
   {
+    releaseCondition(LineID);
     m_DialogueLines[LineID] = lr;
+    compileCondition(LineID, lr.Conditions);
+    m_GreetingIndexValid = false;
+  }
+}
+
+void Dialogue::compileCondition(const std::string& LineID, const ConditionRecord& cond)
+{
+  if ((cond.ScriptedCondition==NULL) or cond.ScriptedCondition->isEmpty())
+  {
+    return;
+  }
+  std::string errorString = "";
+  const int reference = LuaEngine::getSingleton().createFunctionReference(
+                            cond.ScriptedCondition->getStringRepresentation(),
+                            LuaDialogueConditionFunction, &errorString);
+  if (reference==LUA_NOREF)
+  {
+    DuskLog() << "Dialogue::compileCondition: ERROR while compiling the "
+              << "condition script of line \"" << LineID << "\". The condition"
+              << " will never be fulfilled.\nLua's error message is: "
+              << errorString << "\n";
+  }
+  m_ConditionFunctions[LineID] = reference;
+}
+
+void Dialogue::releaseCondition(const std::string& LineID)
+{
+  const std::map<std::string, int>::iterator iter = m_ConditionFunctions.find(LineID);
+  if (iter!=m_ConditionFunctions.end())
+  {
+    LuaEngine::getSingleton().releaseReference(iter->second);
+    m_ConditionFunctions.erase(iter);
+  }
+}
+
+int Dialogue::getConditionFunction(const std::string& LineID) const
+{
+  const std::map<std::string, int>::const_iterator iter = m_ConditionFunctions.find(LineID);
+  if (iter!=m_ConditionFunctions.end())
+  {
+    return iter->second;
   }
+  return LUA_NOREF;
+}
+
+void Dialogue::buildGreetingIndex() const
+{
+  m_GreetingIndex.clear();
+  std::map<std::string, std::vector<std::string> >::const_iterator gr_iter = m_GreetingLines.begin();
+  while (gr_iter!=m_GreetingLines.end())
+  {
+    GreetingIndex& index = m_GreetingIndex[gr_iter->first];
+    const std::vector<std::string>& lines = gr_iter->second;
+    index.Greetings.resize(lines.size());
+    unsigned int i;
+    for (i=0; i<lines.size(); ++i)
+    {
+      IndexedGreeting& greeting = index.Greetings[i];
+      greeting.LineID = &(lines[i]);
+      const std::map<std::string, LineRecord>::const_iterator line_iter = m_DialogueLines.find(lines[i]);
+      if (line_iter!=m_DialogueLines.end())
+      {
+        greeting.Line = &(line_iter->second);
+        greeting.ScriptFunction = getConditionFunction(lines[i]);
+      }
+      else
+      {
+        greeting.Line = NULL;
+        greeting.ScriptFunction = LUA_NOREF;
+      }
+      if ((greeting.Line==NULL) or greeting.Line->Conditions.NPC_ID.empty())
+      {
+        index.AnyNPC.push_back(i);
+      }
+      else
+      {
+        index.ByNPC[greeting.Line->Conditions.NPC_ID].push_back(i);
+      }
+    }//for
+    ++gr_iter;
+  }//while
+  m_GreetingIndexValid = true;
 }
 
 bool Dialogue::processResultScript(const std::string& LineID)
@@ -448,8 +510,22 @@ bool Dialogue::processResultScript(const std::string& LineID)
   return LuaEngine::getSingleton().runString( iter->second.ResultScript->getStringRepresentation());
 }
 
-bool Dialogue::isConditionFulfilled(const ConditionRecord& cond, const NPC* who) const
+bool Dialogue::isConditionFulfilled(const std::string& LineID, const NPC* who) const
 {
+  const std::map<std::string, LineRecord>::const_iterator line_iter = m_DialogueLines.find(LineID);
+  if (line_iter==m_DialogueLines.end())
+  {
+    //same as an empty condition record
+    DuskLog() << "Dialogue::isConditionFulfilled: ERROR: no line with ID \""
+              << LineID << "\" found. Assuming empty conditions.\n";
+    return true;
+  }
+  return checkConditions(line_iter->second, getConditionFunction(LineID), who);
+}
+
+bool Dialogue::checkConditions(const LineRecord& line, const int scriptFunction, const NPC* who) const
+{
+  const ConditionRecord& cond = line.Conditions;
   //only check if ID is set. Unset ID matches every NPC.
   if (!cond.NPC_ID.empty())
   {
@@ -473,41 +549,42 @@ bool Dialogue::isConditionFulfilled(const ConditionRecord& cond, const NPC* who)
     {
       return false;
     }
+    const unsigned int count = who->getConstInventory().getItemCount(cond.ItemID);
     switch (cond.ItemOp)
     {
       case copLess: //inventory count has to be less, so check for greater/equal
                     // to return false;
-           if (who->getConstInventory().getItemCount(cond.ItemID)>=cond.ItemAmount)
+           if (count>=cond.ItemAmount)
            {
              return false;
            }
            break;
       case copLessEqual:
-           if (who->getConstInventory().getItemCount(cond.ItemID)>cond.ItemAmount)
+           if (count>cond.ItemAmount)
            {
              return false;
            }
            break;
       case copEqual:
-           if (who->getConstInventory().getItemCount(cond.ItemID)!=cond.ItemAmount)
+           if (count!=cond.ItemAmount)
            {
              return false;
            }
            break;
       case copGreaterEqual:
-           if (who->getConstInventory().getItemCount(cond.ItemID)<cond.ItemAmount)
+           if (count<cond.ItemAmount)
            {
              return false;
            }
            break;
       case copGreater:
-           if (who->getConstInventory().getItemCount(cond.ItemID)<=cond.ItemAmount)
+           if (count<=cond.ItemAmount)
            {
              return false;
            }
            break;
       default:
-           DuskLog() << "Dialogue::isConditionFulfilled: ERROR: invalid or "
+           DuskLog() << "Dialogue::checkConditions: ERROR: invalid or "
                      << "unknown enumeration value ("<<(unsigned int)(cond.ItemOp)
                      << "encountered. Will return false.\n";
            return false;
@@ -515,85 +592,65 @@ bool Dialogue::isConditionFulfilled(const ConditionRecord& cond, const NPC* who)
   }//ItemID
 
   //Script
-  if (cond.ScriptedCondition!=NULL)
+  if ((cond.ScriptedCondition!=NULL) and !cond.ScriptedCondition->isEmpty())
   {
-    if (!cond.ScriptedCondition->isEmpty())
+    if (scriptFunction==LUA_NOREF)
     {
-      LuaEngine& Lua = LuaEngine::getSingleton();
-      // set function to nil to prevent call to an earlier version
-      lua_pushstring(Lua, LuaDialogueConditionFunction.c_str());
-      lua_pushnil(Lua);
-      lua_settable(Lua, LUA_GLOBALSINDEX);
-      //run the script (and thus get a new function)
-      std::string errorString = "";
-      if (Lua.runString(cond.ScriptedCondition->getStringRepresentation(), &errorString))
-      {
-        //now get the function
-        lua_getglobal(Lua, LuaDialogueConditionFunction.c_str());
-        if(lua_type(Lua,-1) != LUA_TFUNCTION)
-        {
-          lua_pop(Lua,1);
-          DuskLog() << "Dialogue::isConditionFulfilled: ERROR: Lua does not "
-                    << "have a function named \""<<LuaDialogueConditionFunction
-                    << "\"! Condition cannot be checked, assuming failure.\n";
-          return false;
-        }
-        //run the function - zero arguments, one result, no specific errorfunc
-        const int errorCode = lua_pcall(Lua, 0, 1, 0);
-        if (errorCode!=0)
-        {
-          switch (errorCode)
-          {
-            case LUA_ERRERR:
-                 DuskLog() << "Dialogue::isConditionFulfilled: ERROR while "
-                           << "calling the Lua error handler function.\n";
-                 break;
-            case LUA_ERRMEM:
-                 DuskLog() << "Dialogue::isConditionFulfilled: ERROR: memory "
-                           << "allocation failed while trying to run the Lua "
-                           << "function.\n";
-                 break;
-            case LUA_ERRRUN:
-                 DuskLog() << "Dialogue::isConditionFulfilled: ERROR: Lua "
-                           << "runtime error during lua_pcall()!\n";
-                 break;
-            default: //should never happen
-                 DuskLog() << "Dialogue::isConditionFulfilled: unknown ERROR "
-                           << "occured during lua_pcall().\n"; break;
-          }//swi
-          DuskLog() << "Lua error message: " << lua_tostring(Lua, -1) << "\n";
-          return false;
-        }//if error occured
-        //now get the result
-        if (lua_type(Lua, -1) != LUA_TBOOLEAN)
-        {
-          //function did not return a boolean
-          DuskLog() << "Dialogue::isConditionFulfilled: script function did not "
-                    << "return a boolean value.\n";
-          lua_pop(Lua, 1);
-          return false;
-        }
-        const bool scriptResult = lua_toboolean(Lua, -1);
-        lua_pop(Lua, 1);
-        if (!scriptResult)
-        {
-          return false;
-        }
-      }
-      else
+      //script could not be compiled, error was logged by compileCondition()
+      return false;
+    }
+    LuaEngine& Lua = LuaEngine::getSingleton();
+    //get the compiled function
+    lua_rawgeti(Lua, LUA_REGISTRYINDEX, scriptFunction);
+    //run the function - zero arguments, one result, no specific errorfunc
+    const int errorCode = lua_pcall(Lua, 0, 1, 0);
+    if (errorCode!=0)
+    {
+      switch (errorCode)
       {
-        DuskLog() << "Dialogue::isConditionFulfilled: ERROR while executing "
-                  << "script!\nLua's error message is: "<< errorString <<"\n";
-        return false;
-      }
-    } //if
+        case LUA_ERRERR:
+             DuskLog() << "Dialogue::checkConditions: ERROR while "
+                       << "calling the Lua error handler function.\n";
+             break;
+        case LUA_ERRMEM:
+             DuskLog() << "Dialogue::checkConditions: ERROR: memory "
+                       << "allocation failed while trying to run the Lua "
+                       << "function.\n";
+             break;
+        case LUA_ERRRUN:
+             DuskLog() << "Dialogue::checkConditions: ERROR: Lua "
+                       << "runtime error during lua_pcall()!\n";
+             break;
+        default: //should never happen
+             DuskLog() << "Dialogue::checkConditions: unknown ERROR "
+                       << "occured during lua_pcall().\n"; break;
+      }//swi
+      DuskLog() << "Lua error message: " << lua_tostring(Lua, -1) << "\n";
+      lua_pop(Lua, 1);
+      return false;
+    }//if error occured
+    //now get the result
+    if (lua_type(Lua, -1) != LUA_TBOOLEAN)
+    {
+      //function did not return a boolean
+      DuskLog() << "Dialogue::checkConditions: script function did not "
+                << "return a boolean value.\n";
+      lua_pop(Lua, 1);
+      return false;
+    }
+    const bool scriptResult = lua_toboolean(Lua, -1);
+    lua_pop(Lua, 1);
+    if (!scriptResult)
+    {
+      return false;
+    }
   } //if
   //Script
 
   return true;
 }
 
-bool Dialogue::saveToStream(std::ofstream& output) const
+bool Dialogue::saveToStream(BinaryWriter& output) const
 {
    if (!(output.good()))
    {
@@ -601,27 +658,22 @@ bool Dialogue::saveToStream(std::ofstream& output) const
      return false;
    }
 
-   unsigned int len, count;
+   unsigned int count;
    //write greetings
    std::map<std::string, std::vector<std::string> >::const_iterator gr_iter;
    gr_iter = m_GreetingLines.begin();
    while (gr_iter != m_GreetingLines.end())
    {
-     output.write((const char*) &cHeaderDial, sizeof(uint32_t));
-     output.write((const char*) &cGreetingFlag, 1);
+     output.writeUInt32(cHeaderDial);
+     output.writeUInt8(cGreetingFlag);
      //ID
-     len = gr_iter->first.length();
-     output.write((const char*) &len, sizeof(unsigned int));
-     output.write(gr_iter->first.c_str(), len);
+     output.writeString(gr_iter->first);
      //number of choices
-     len = gr_iter->second.size();
-     output.write((const char*) &len, sizeof(unsigned int));
+     output.writeUInt32(gr_iter->second.size());
      //choices
      for (count=0; count<gr_iter->second.size(); count=count+1)
      {
-       len = gr_iter->second.at(count).length();
-       output.write((const char*) &len, sizeof(unsigned int));
-       output.write(gr_iter->second.at(count).c_str(), len);
+       output.writeString(gr_iter->second[count]);
      } // for
 
      if (!output.good())
@@ -637,11 +689,9 @@ bool Dialogue::saveToStream(std::ofstream& output) const
    std::map<std::string, LineRecord>::const_iterator iter = m_DialogueLines.begin();
    while (iter!=m_DialogueLines.end())
    {
-     output.write((const char*) &cHeaderDial, sizeof(uint32_t));
-     output.write((const char*) &cDialogueFlag, 1);
-     len = iter->first.length();
-     output.write((const char*) &len, sizeof(unsigned int));
-     output.write(iter->first.c_str(), len);
+     output.writeUInt32(cHeaderDial);
+     output.writeUInt8(cDialogueFlag);
+     output.writeString(iter->first);
      if (!(iter->second.saveToStream(output)))
      {
        DuskLog() << "Dialogue::saveToStream: ERROR while writing dialogue "
@@ -653,120 +703,106 @@ bool Dialogue::saveToStream(std::ofstream& output) const
    return output.good();
 }
 
-bool Dialogue::loadNextRecordFromStream(std::ifstream& input)
+bool Dialogue::loadNextRecordFromStream(BinaryReader& input)
+{
+  StagedRecord record;
+  if (!readNextRecordFromStream(input, record))
+  {
+    return false;
+  }
+  addStagedRecord(record);
+  return true;
+}
+
+bool Dialogue::readNextRecordFromStream(BinaryReader& input, StagedRecord& record)
 {
   if (!input.good())
   {
-    DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: Bad stream.\n";
+    DuskLog() << "Dialogue::readNextRecordFromStream: ERROR: Bad stream.\n";
     return false;
   }
 
-  unsigned int i;
-  input.read((char*) &i, sizeof(unsigned int));
+  uint32_t i = 0;
+  input.readUInt32(i);
   if (i != cHeaderDial)
   {
-    DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: Unexpected header.\n";
+    DuskLog() << "Dialogue::readNextRecordFromStream: ERROR: Unexpected header.\n";
     return false;
   }
 
-  LineRecord temp_lr;
-  uint8_t flag;
-  char buffer[256];
-  input.read((char*) &flag, 1);
+  uint8_t flag = 0;
+  input.readUInt8(flag);
   if (flag == cDialogueFlag)
   {
-    i = 0;
-    input.read((char*) &i, sizeof(unsigned int));
-    if (i>255)
+    record.IsGreeting = false;
+    if (!input.readString(record.ID))
     {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: ID seems to be "
-                << "longer than 255 characters.\n";
-      return false;
-    }
-    input.read(buffer, i);
-    buffer[i] = '\0';
-    if (!input.good())
-    {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR while reading ID "
-                << "from stream.\n";
+      DuskLog() << "Dialogue::readNextRecordFromStream: ERROR while reading ID "
+                << "from stream. (ID must not be longer than 255 characters.)\n";
       return false;
     }
     //load it
-    if (!temp_lr.loadFromStream(input))
+    if (!record.Line.loadFromStream(input))
     {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR while loading "
+      DuskLog() << "Dialogue::readNextRecordFromStream: ERROR while loading "
                 << "line record.\n";
       return false;
     }
-    //add data
-    addLine(std::string(buffer), temp_lr);
   } //if cDialogueFlag
   else if (flag==cGreetingFlag)
   {
     //load it
-    i = 0;
-    input.read((char*) &i, sizeof(unsigned int));
-    if (i>255)
-    {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: NPC_ID seems to"
-                << " be longer than 255 characters.\n";
-      return false;
-    }
-    input.read(buffer, i);
-    buffer[i] = '\0';
-    if (!input.good())
+    record.IsGreeting = true;
+    if (!input.readString(record.ID))
     {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR while reading "
-                << "NPC ID from stream.\n";
+      DuskLog() << "Dialogue::readNextRecordFromStream: ERROR while reading "
+                << "NPC ID from stream. (ID must not be longer than 255 "
+                << "characters.)\n";
       return false;
     }
-    std::string NPC_ID = std::string(buffer);
     //read number of choices
-    unsigned int ChoiceCount = 0;
-    input.read((char*) &ChoiceCount, sizeof(unsigned int));
+    uint32_t ChoiceCount = 0;
+    input.readUInt32(ChoiceCount);
     if (ChoiceCount>100) //unlikely there's so much -> error
     {
-      DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: got more than"
+      DuskLog() << "Dialogue::readNextRecordFromStream: ERROR: got more than"
                 << " 100 choices for greeting list. Corrupt file?\n";
       return false;
     }
     //read choices
-    unsigned int len;
-    std::vector<std::string> temp_vec;
-    temp_vec.clear();
+    record.Choices.resize(ChoiceCount);
     for (i=0; i<ChoiceCount; i=i+1)
     {
-      //read length
-      len = 0;
-      input.read((char*) &len, sizeof(unsigned int));
-
-      if (len>255)
-      {
-        DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: LineID seems "
-                  << "to be longer than 255 characters.\n";
-        return false;
-      }
-      input.read(buffer, len);
-      buffer[len] = '\0';
-      if (!input.good())
+      if (!input.readString(record.Choices[i]))
       {
-        DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR while reading "
-                  << "LineID from stream.\n";
+        DuskLog() << "Dialogue::readNextRecordFromStream: ERROR while reading "
+                  << "LineID from stream. (LineID must not be longer than 255"
+                  << " characters.)\n";
         return false;
       }
-      temp_vec.push_back(std::string(buffer));
     } //for
-    addGreeting(NPC_ID, temp_vec);
   }
   else
   {
-    DuskLog() << "Dialogue::loadNextRecordFromStream: ERROR: unrecognized flag"
+    DuskLog() << "Dialogue::readNextRecordFromStream: ERROR: unrecognized flag"
                 << "("<<flag<<") in stream.\n";
     return false;
   }
   return input.good();
 }
 
+void Dialogue::addStagedRecord(const StagedRecord& record)
+{
+  if (record.IsGreeting)
+  {
+    addGreeting(record.ID, record.Choices);
+  }
+  else
+  {
+    addLine(record.ID, record.Line);
+  }
+}
+
 unsigned int Dialogue::numberOfLines() const
 {
   return m_GreetingLines.size() + m_DialogueLines.size();
@@ -37,6 +37,12 @@
      - 2010-08-31 (rev 239) - naming convention from coding guidelines enforced
      - 2010-11-21 (rev 257) - minor optimization
      - 2010-12-04 (rev 268) - use DuskLog/Messages class for logging
+     - 2026-10-19           - StagedRecord, readNextRecordFromStream() and
+                              addStagedRecord() added
+     - 2026-10-19           - scripted conditions are compiled once by
+                              addLine() instead of at every check
+     - 2026-10-19           - index for greetings, which skips greetings for
+                              other NPCs without checking them
 
  ToDo list:
      - extend class for more conditions
@@ -56,7 +62,8 @@
 #include <string>
 #include <map>
 #include <vector>
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 
 #include "objects/NPC.h"
 #include "Script.h"
@@ -112,7 +119,7 @@ class Dialogue
          parameters:
              out - the output stream to which the record will be saved
       */
-      bool saveToStream(std::ofstream& out) const;
+      bool saveToStream(BinaryWriter& out) const;
 
       /* Tries to load the LineRecord from the given stream and returns true on
          success, false on failure. If that function failed, the data within
@@ -121,7 +128,7 @@ class Dialogue
          parameters:
              inp - the input stream from which the record will be loaded
       */
-      bool loadFromStream(std::ifstream& inp);
+      bool loadFromStream(BinaryReader& inp);
     };
 
     /* Dialogue::Handle record. Contains all neccessary data for dialogue lines.
@@ -138,6 +145,18 @@ class Dialogue
       std::vector<std::string> Choices;
     };
 
+    /* holds one dialogue record (either a dialogue line or the greeting list
+       of an NPC) that has been read from a stream, but has not been added to
+       the Dialogue yet
+    */
+    struct StagedRecord
+    {
+      bool IsGreeting; //true for greeting lists, false for dialogue lines
+      std::string ID; //NPC ID for greetings, line ID for dialogue lines
+      LineRecord Line; //only used for dialogue lines
+      std::vector<std::string> Choices; //only used for greetings
+    };
+
     /* destructor */
     virtual ~Dialogue();
 
@@ -230,6 +249,9 @@ class Dialogue
            This function always succeeds, unless LineID is an empty string. In
            that case, nothing happens. If there already is a line with ID
            LineID, this line will be replaced.
+           The scripted condition of the line is compiled here, i.e. the
+           script is run once and the function it defines (see
+           LuaDialogueConditionFunction) is kept for all later checks.
     */
     void addLine(const std::string& LineID, const LineRecord& lr);
 
@@ -253,7 +275,7 @@ class Dialogue
            output - the output stream that will be used to save the dialogue
                     data
     */
-    bool saveToStream(std::ofstream& output) const;
+    bool saveToStream(BinaryWriter& output) const;
 
     /* tries to load the next dialogue record (dialogue or greeting) from the
        given stream. Returns true on success, false otherwise.
@@ -261,7 +283,25 @@ class Dialogue
        parameters:
            input - the input stream that will be used to read the dialogue data
     */
-    bool loadNextRecordFromStream(std::ifstream& input);
+    bool loadNextRecordFromStream(BinaryReader& input);
+
+    /* reads the next dialogue record (dialogue or greeting) from the given
+       stream without adding it to the Dialogue. Returns true on success,
+       false otherwise. Since this function does not touch the Dialogue
+       itself, it can be used by worker threads while loading data files.
+
+       parameters:
+           input  - the input stream that will be used to read the dialogue data
+           record - the record that will hold the read data
+    */
+    static bool readNextRecordFromStream(BinaryReader& input, StagedRecord& record);
+
+    /* adds a record that was read by readNextRecordFromStream()
+
+       parameters:
+           record - the dialogue record
+    */
+    void addStagedRecord(const StagedRecord& record);
 
     /* returns the number of dialogue lines, including greetings (which might
        be a bit misleading at some point)
@@ -277,14 +317,41 @@ class Dialogue
     /* private copy constructor - there can only be one */
     Dialogue(const Dialogue& op) {}
 
-    /* Checks whether all conditions in ConditionRecord cond are met by NPC who.
-       Returns true, if all conditions are met, returns false otherwise.
+    /* Checks whether all conditions of the line with ID LineID are met by NPC
+       who. Returns true, if all conditions are met, returns false otherwise.
+
+       parameters:
+           LineID - ID of the line whose conditions have to be met
+           who    - the NPC that has to fulfill the conditions
+    */
+    bool isConditionFulfilled(const std::string& LineID, const NPC* who) const;
+
+    /* Checks whether all conditions of line are met by NPC who. Returns true,
+       if all conditions are met, returns false otherwise. Static conditions
+       are checked first, the script is only run if they are met.
 
        parameters:
-           cond - the conditions that have to be met
-           who  - the NPC that has to fulfill the conditions
+           line           - the line whose conditions have to be met
+           scriptFunction - reference to the compiled scripted condition
+           who            - the NPC that has to fulfill the conditions
     */
-    bool isConditionFulfilled(const ConditionRecord& cond, const NPC* who) const;
+    bool checkConditions(const LineRecord& line, const int scriptFunction, const NPC* who) const;
+
+    /* returns the reference to the compiled scripted condition of the line
+       with ID LineID, or LUA_NOREF, if there is none
+    */
+    int getConditionFunction(const std::string& LineID) const;
+
+    /* (re-)builds m_GreetingIndex from the greetings and lines */
+    void buildGreetingIndex() const;
+
+    /* compiles the scripted condition of the line with ID LineID, if any, and
+       stores the reference to the Lua function in m_ConditionFunctions
+    */
+    void compileCondition(const std::string& LineID, const ConditionRecord& cond);
+
+    /* releases the compiled scripted condition of the line with ID LineID */
+    void releaseCondition(const std::string& LineID);
 
     /* flags to indicate type of dialogue data when reading from or writhing to
        a stream
@@ -294,6 +361,34 @@ class Dialogue
 
     std::map<std::string, std::vector<std::string> > m_GreetingLines;
     std::map<std::string, LineRecord> m_DialogueLines;
+    std::map<std::string, int> m_ConditionFunctions; //line ID -> reference to
+                            //the Lua function of the line's scripted condition
+
+    /* greeting line with everything that is needed to check its conditions */
+    struct IndexedGreeting
+    {
+      const std::string* LineID; //points into m_GreetingLines
+      const LineRecord* Line; //points into m_DialogueLines, NULL if missing
+      int ScriptFunction; //see m_ConditionFunctions
+    };
+
+    /* the greetings of one entry of m_GreetingLines, split by the NPC ID
+       condition of the lines - the greetings for a given NPC are those in
+       AnyNPC and ByNPC[ID], in the order of their indices
+    */
+    struct GreetingIndex
+    {
+      std::vector<IndexedGreeting> Greetings; //same order as m_GreetingLines
+      std::vector<unsigned int> AnyNPC; //indices of greetings without NPC ID
+      std::map<std::string, std::vector<unsigned int> > ByNPC; //indices of
+                                        //greetings for a certain NPC ID
+    };
+
+    /* built on demand by getGreetingLine(), since greetings may be added
+       before the lines they refer to
+    */
+    mutable std::map<std::string, GreetingIndex> m_GreetingIndex;
+    mutable bool m_GreetingIndexValid;
 }; //class
 
 } //namespace
@@ -46,7 +46,10 @@ namespace Dusk
     (Might not be portable for systems with different byte order.)
   */
 
+  const uint32_t cHeaderBIdx = 2019838274; //"BIdx" (for base index of following reference in save game)
+  const uint32_t cHeaderComp = 1886220099; //"Comp" (for compressed blocks)
   const uint32_t cHeaderCont = 1953394499; //"Cont" (for containers (base))
+  const uint32_t cHeaderDelt = 1953260868; //"Delt" (for "delta" save game type)
   const uint32_t cHeaderDeps = 1936745796; //"Deps" (for dependencies of save game)
   const uint32_t cHeaderDial = 1818323268; //"Dial" (for dialogue entries)
   const uint32_t cHeaderDusk = 1802728772; //"Dusk" (general file header)
@@ -72,8 +75,11 @@ namespace Dusk
   const uint32_t cHeaderRefV = 1449551186; //"RefV" (for Referenced Vehicle)
   const uint32_t cHeaderRfWe = 1700226642; //"RfWe" (for Referenced Weapon)
   const uint32_t cHeaderRfWP = 1347905106; //"RfWP" (for Referenced WaypointObject)
+  const uint32_t cHeaderRmvI = 1232498002; //"RmvI" (for removed InjectionManager references)
+  const uint32_t cHeaderRmvO = 1333161298; //"RmvO" (for removed ObjectManager references)
   const uint32_t cHeaderRsrc = 1668445010; //"Rsrc" (for ResourceBase records)
   const uint32_t cHeaderSave = 1702256979; //"Save" (for SaveGame)
+  const uint32_t cHeaderSect = 1952671059; //"Sect" (for sections of independent records)
   const uint32_t cHeaderSoun = 1853189971; //"Soun" (for SoundBase records)
   const uint32_t cHeaderVehi = 1768449366; //"Vehi" (for VehicleBase records)
   const uint32_t cHeaderWeap = 1885431127; //"Weap" (for Weapon(Base))
@@ -27,8 +27,11 @@
 #include "TriggerManager.h"
 #include "Trigger.h"
 #include "lua/LuaEngine.h"
+#include "lua/LuaWorkerPool.h"
 #include "objects/Player.h"
 #include "Weather.h"
+#include "SoundEmitterManager.h"
+#include "sound/Sound.h"
 
 namespace Dusk
 {
@@ -52,11 +55,19 @@ bool FrameListener::frameStarted(const Ogre::FrameEvent& evt)
     //process scripts of console and Lua scripts
     Console::getInstance()->processScripts();
     LuaEngine::getSingleton().processScripts();
+    //run the started scripts within their time budget
+    LuaEngine::getSingleton().injectTime(evt.timeSinceLastFrame);
+    //pass results of the Lua worker states to their callbacks
+    LuaWorkerPool::getSingleton().processResults();
     //process camera movement for the current frame
     Camera::getSingleton().move(evt);
     //process animations, movement,... of non-static objects
     InjectionManager::getSingleton().injectAnimationTime(evt.timeSinceLastFrame);
     Player::getSingleton().injectTime(evt.timeSinceLastFrame);
+    //let sounds follow the objects that emit them
+    SoundEmitterManager::getSingleton().update(evt.timeSinceLastFrame);
+    //finish media loaded in background, pass changed sources to audio thread
+    Sound::get().update();
 
     // ---- triggers ----
     if (m_TriggersActive)
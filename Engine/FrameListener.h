@@ -49,6 +49,8 @@
                             - small improvements
      - 2010-05-21 (rev 206) - adjustments for player movement
      - 2010-11-12 (rev 252) - trigger management added
+     - 2026-10-19           - buffer queues of streamed sounds are refilled
+                              each frame
 
  ToDo list:
      - ???
@@ -24,6 +24,7 @@
   #include "database/NPCRecord.h"
 #endif
 #include "Messages.h"
+#include "AnimationInstancing.h"
 
 namespace Dusk
 {
@@ -33,6 +34,7 @@ InjectionManager::InjectionManager()
   m_ReferenceMap.clear();
   m_RefCount = 0;
   m_DeletionObjects.clear();
+  m_BaseReferences.clear();
 }
 
 InjectionManager::~InjectionManager()
@@ -192,6 +194,10 @@ unsigned int InjectionManager::deleteReferencesOfAnimatedObject(const std::strin
   {
     if (iter->second.at(i)!=NULL)
     {
+      if (iter->second.at(i)->getBaseIndex()<m_BaseReferences.size())
+      {
+        m_BaseReferences[iter->second.at(i)->getBaseIndex()] = NULL;
+      }
       delete (iter->second.at(i));
       iter->second.at(i) = NULL;
       ++deletedReferences;
@@ -312,6 +318,8 @@ void InjectionManager::injectAnimationTime(const float TimePassed)
   {
     performRequestedDeletions();
   }
+  //shared animations first, objects may leave their buckets afterwards
+  AnimationInstancing::getSingleton().injectTime(TimePassed);
   unsigned int i;
   std::map<std::string, std::vector<InjectionObject*> >::const_iterator iter;
   iter = m_ReferenceMap.begin();
@@ -347,9 +355,18 @@ void InjectionManager::clearData()
     iter = m_ReferenceMap.begin();
   }//while
   m_RefCount = 0;
+  m_BaseReferences.clear();
 }//clear data
 
-bool InjectionManager::saveAllToStream(std::ofstream& output) const
+void InjectionManager::removeAllReferences()
+{
+  //clearData() would forget the base references, so keep their number
+  const unsigned int baseCount = m_BaseReferences.size();
+  clearData();
+  m_BaseReferences.resize(baseCount, NULL);
+}
+
+bool InjectionManager::saveAllToStream(BinaryWriter& output) const
 {
   if (!(output.good()))
   {
@@ -379,7 +396,196 @@ bool InjectionManager::saveAllToStream(std::ofstream& output) const
   return output.good();
 }
 
-bool InjectionManager::loadNextFromStream(std::ifstream& Stream, const unsigned int PrefetchedHeader)
+bool InjectionManager::saveChangesToStream(BinaryWriter& output) const
+{
+  if (!(output.good()))
+  {
+    DuskLog() << "InjectionManager::saveChangesToStream: ERROR: Bad stream given.\n";
+    return false;
+  }
+  //write removed references from data files
+  output.writeUInt32(cHeaderRmvI);
+  uint32_t removed = 0;
+  unsigned int i;
+  for (i=0; i<m_BaseReferences.size(); ++i)
+  {
+    if (m_BaseReferences[i]==NULL) ++removed;
+  }//for
+  output.writeUInt32(removed);
+  for (i=0; i<m_BaseReferences.size(); ++i)
+  {
+    if (m_BaseReferences[i]==NULL) output.writeUInt32(i);
+  }//for
+  //write modified and new references
+  std::map<std::string, std::vector<InjectionObject*> >::const_iterator iter;
+  iter = m_ReferenceMap.begin();
+  while (iter!=m_ReferenceMap.end())
+  {
+    const unsigned int len = iter->second.size();
+    for (i=0; i<len; i=i+1)
+    {
+      const InjectionObject* objPtr = iter->second.at(i);
+      if (objPtr!=NULL)
+      {
+        if (objPtr->getBaseIndex()!=cNoBaseIndex)
+        {
+          //unchanged references will be loaded from the data file anyway
+          if (!objPtr->isModified()) continue;
+          output.writeUInt32(cHeaderBIdx);
+          output.writeUInt32(objPtr->getBaseIndex());
+        }
+        if (!(objPtr->saveToStream(output)))
+        {
+          DuskLog() << "InjectionManager::saveChangesToStream: ERROR while "
+                    << "saving reference.\n";
+          return false;
+        } //if
+      }//if
+    }//for
+    ++iter;
+  }//while
+  return output.good();
+}
+
+unsigned int InjectionManager::getNumberOfChangedRecords() const
+{
+  //one record for the list of removed references...
+  unsigned int result = 1;
+  //...and one for every modified or new reference
+  unsigned int i;
+  std::map<std::string, std::vector<InjectionObject*> >::const_iterator iter;
+  iter = m_ReferenceMap.begin();
+  while (iter!=m_ReferenceMap.end())
+  {
+    for (i=0; i<iter->second.size(); ++i)
+    {
+      const InjectionObject* objPtr = iter->second.at(i);
+      if (objPtr!=NULL)
+      {
+        if (objPtr->getBaseIndex()==cNoBaseIndex or objPtr->isModified())
+          ++result;
+      }
+    }//for
+    ++iter;
+  }//while
+  return result;
+}
+
+bool InjectionManager::loadNextFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader)
+{
+  InjectionObject * injectPtr = createReferenceFromStream(Stream, PrefetchedHeader);
+  if (injectPtr==NULL)
+  {
+    DuskLog() << "InjectionManager::loadNextFromStream: ERROR while loading "
+              << "next object from stream.\n";
+    return false;
+  }
+  injectPtr->setBaseIndex(m_BaseReferences.size());
+  injectPtr->setModified(false);
+  m_BaseReferences.push_back(injectPtr);
+  m_ReferenceMap[injectPtr->getID()].push_back(injectPtr);
+  ++m_RefCount;
+  return true;
+}
+
+bool InjectionManager::loadSavedReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader, const uint32_t baseIndex)
+{
+  if (baseIndex!=cNoBaseIndex and baseIndex>=m_BaseReferences.size())
+  {
+    DuskLog() << "InjectionManager::loadSavedReferenceFromStream: ERROR: base "
+              << "index "<<baseIndex<<" is out of range. The save game does "
+              << "not match the loaded data files.\n";
+    return false;
+  }
+  InjectionObject * injectPtr = createReferenceFromStream(Stream, PrefetchedHeader);
+  if (injectPtr==NULL)
+  {
+    DuskLog() << "InjectionManager::loadSavedReferenceFromStream: ERROR while "
+              << "loading next object from stream.\n";
+    return false;
+  }
+  if (baseIndex!=cNoBaseIndex)
+  {
+    //replace the reference from the data file
+    if (m_BaseReferences[baseIndex]!=NULL)
+    {
+      deleteReference(m_BaseReferences[baseIndex]);
+    }
+    m_BaseReferences[baseIndex] = injectPtr;
+  }
+  injectPtr->setBaseIndex(baseIndex);
+  //keep it marked, so that it gets into the next save game, too
+  injectPtr->setModified(true);
+  m_ReferenceMap[injectPtr->getID()].push_back(injectPtr);
+  ++m_RefCount;
+  return true;
+}
+
+bool InjectionManager::loadRemovedReferencesFromStream(BinaryReader& Stream)
+{
+  uint32_t count = 0;
+  if (!Stream.readUInt32(count) or count!=cHeaderRmvI)
+  {
+    DuskLog() << "InjectionManager::loadRemovedReferencesFromStream: ERROR: "
+              << "stream contains unexpected header!\n";
+    return false;
+  }
+  if (!Stream.readUInt32(count) or count>m_BaseReferences.size())
+  {
+    DuskLog() << "InjectionManager::loadRemovedReferencesFromStream: ERROR: "
+              << "invalid number of removed references.\n";
+    return false;
+  }
+  uint32_t idx = 0;
+  unsigned int i;
+  for (i=0; i<count; ++i)
+  {
+    if (!Stream.readUInt32(idx) or idx>=m_BaseReferences.size())
+    {
+      DuskLog() << "InjectionManager::loadRemovedReferencesFromStream: ERROR: "
+                << "invalid base index. The save game does not match the "
+                << "loaded data files.\n";
+      return false;
+    }
+    if (m_BaseReferences[idx]!=NULL)
+    {
+      deleteReference(m_BaseReferences[idx]);
+    }
+  }//for
+  return true;
+}
+
+bool InjectionManager::deleteReference(InjectionObject* objPtr)
+{
+  std::map<std::string, std::vector<InjectionObject*> >::iterator iter;
+  iter = m_ReferenceMap.find(objPtr->getID());
+  if (iter!=m_ReferenceMap.end())
+  {
+    unsigned int i;
+    for (i=0; i<iter->second.size(); ++i)
+    {
+      if (iter->second.at(i)==objPtr)
+      {
+        //found it
+        //references from data files are remembered as removed
+        if (objPtr->getBaseIndex()<m_BaseReferences.size())
+        {
+          m_BaseReferences[objPtr->getBaseIndex()] = NULL;
+        }
+        objPtr->disable();
+        delete objPtr;
+        iter->second.at(i)= iter->second.at(iter->second.size()-1);
+        iter->second.at(iter->second.size()-1) = NULL;
+        iter->second.pop_back();
+        --m_RefCount;
+        return true;
+      }
+    }//for
+  }
+  return false;
+}
+
+InjectionObject* InjectionManager::createReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader)
 {
   InjectionObject * injectPtr = NULL;
   switch(PrefetchedHeader)
@@ -403,21 +609,17 @@ bool InjectionManager::loadNextFromStream(std::ifstream& Stream, const unsigned
          injectPtr = new WaypointObject;
          break;
     default:
-         DuskLog() << "InjectionManager::loadNextFromStream: ERROR: unexpected"
-                   << " header found.\n";
-         return false;
+         DuskLog() << "InjectionManager::createReferenceFromStream: ERROR: "
+                   << "unexpected header found.\n";
+         return NULL;
          break;
   }//swi
   if (injectPtr->loadFromStream(Stream))
   {
-    m_ReferenceMap[injectPtr->getID()].push_back(injectPtr);
-    ++m_RefCount;
-    return true;
+    return injectPtr;
   }
   delete injectPtr;
-  DuskLog() << "InjectionManager::loadNextFromStream: ERROR while loading next "
-            << " object from stream.\n";
-  return false;
+  return NULL;
 }
 
 void InjectionManager::requestDeletion(InjectionObject* objPtr)
@@ -439,28 +641,9 @@ void InjectionManager::requestDeletion(InjectionObject* objPtr)
 
 void InjectionManager::performRequestedDeletions()
 {
-  std::map<std::string, std::vector<InjectionObject*> >::iterator iter;
   while (!m_DeletionObjects.empty())
   {
-    iter = m_ReferenceMap.find(m_DeletionObjects.back()->getID());
-    if (iter!=m_ReferenceMap.end())
-    {
-      unsigned int i;
-      for (i=0; i<iter->second.size(); ++i)
-      {
-        if (iter->second.at(i)==m_DeletionObjects.back())
-        {
-          //found it
-          m_DeletionObjects.back()->disable();
-          delete m_DeletionObjects.back();
-          m_DeletionObjects.back() = NULL; //not really needed here
-          iter->second.at(i)= iter->second.at(iter->second.size()-1);
-          iter->second.at(iter->second.size()-1) = NULL;
-          iter->second.pop_back();
-          --m_RefCount;
-        }
-      }//for
-    }
+    deleteReference(m_DeletionObjects.back());
     m_DeletionObjects.pop_back();
   } //while
 }
@@ -55,6 +55,11 @@
      - 2010-11-20 (rev 255) - rotation is now stored as quaternion
      - 2010-12-04 (rev 268) - use DuskLog/Messages class for logging
      - 2012-06-30 (rev 307) - update for Resource class
+     - 2026-10-19           - references from data files get a base index, and
+                              save games only contain removed, modified and
+                              new references via saveChangesToStream()
+                            - injectAnimationTime() advances the animations
+                              shared by AnimationInstancing
 
  ToDo list:
      - ???
@@ -71,7 +76,8 @@
 #include "objects/NPC.h"
 #include "objects/Resource.h"
 #include "objects/Vehicle.h"
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include <vector>
 #include <map>
 
@@ -235,15 +241,59 @@ namespace Dusk
          parameters:
              output - the output stream that is used to save the data
       */
-      bool saveAllToStream(std::ofstream& output) const;
+      bool saveAllToStream(BinaryWriter& output) const;
 
       /* Tries to load the next object from stream and returns true on success
 
          parameters:
              Stream           - the input stream that is used to load the data
              PrefetchedHeader - the first four bytes of the record to come
+
+         remarks:
+             This function is meant for references from data files. The loaded
+             object gets the next free base index and is marked as unmodified.
+             Use loadSavedReferenceFromStream() for references in save games.
+      */
+      bool loadNextFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader);
+
+      /* Tries to save the removal record and all references that differ from
+         the data files, i.e. modified and newly created ones, to the stream.
+         Returns true on success.
+
+         parameters:
+             output - the output stream that is used to save the data
+      */
+      bool saveChangesToStream(BinaryWriter& output) const;
+
+      /* returns the number of records saveChangesToStream() would write */
+      unsigned int getNumberOfChangedRecords() const;
+
+      /* Tries to load the next reference from a save game and returns true on
+         success.
+
+         parameters:
+             Stream           - the input stream that is used to load the data
+             PrefetchedHeader - the first four bytes of the record to come
+             baseIndex        - base index of the reference from the data files
+                                that shall be replaced by the loaded reference,
+                                or cNoBaseIndex for references that were created
+                                during the game
+      */
+      bool loadSavedReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader, const uint32_t baseIndex);
+
+      /* Tries to load the list of removed references (as written by
+         saveChangesToStream()) from the stream and removes those references.
+         Returns true on success.
+
+         parameters:
+             Stream - the input stream that is used to load the data
       */
-      bool loadNextFromStream(std::ifstream& Stream, const unsigned int PrefetchedHeader);
+      bool loadRemovedReferencesFromStream(BinaryReader& Stream);
+
+      /* deletes all referenced objects, but (unlike clearData()) keeps track of
+         the references from data files as removed ones
+      */
+      void removeAllReferences();
 
       /* deletes all referenced objects */
       void clearData();
@@ -277,8 +327,21 @@ namespace Dusk
       /* empty, private copy constructor due to singleton pattern*/
       InjectionManager(const InjectionManager& op) {}
 
+      /* creates an object of the type indicated by header and loads its data
+         from the stream. Returns NULL on failure.
+      */
+      static InjectionObject* createReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader);
+
+      /* removes the object from the reference map and deletes it. Returns true
+         on success, i.e. if the object was found.
+      */
+      bool deleteReference(InjectionObject* objPtr);
+
       std::map<std::string, std::vector<InjectionObject*> > m_ReferenceMap;
       unsigned int m_RefCount;
+      /* references from data files, indexed by their base index; entries of
+         removed references are NULL */
+      std::vector<InjectionObject*> m_BaseReferences;
 
       /* vector to hold the objects which requested to be deleted */
       std::vector<InjectionObject*> m_DeletionObjects;
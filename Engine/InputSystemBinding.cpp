@@ -140,16 +140,20 @@ bool InputSystemBinding::keyPressed (const OIS::KeyEvent &arg)
 
     //temporary bindings to toggle rain, fog and snow
     // for quick enabling/ disabling weather effects; should be removed later!
+    // (The scripts are static, so the Console parses them only once.)
+    static const Script cToggleRain("toggle_rain");
+    static const Script cToggleFog("toggle_fog");
+    static const Script cToggleSnow("toggle_snow");
     switch (arg.key)
     {
       case OIS::KC_R: // R like rain
-           Console::getInstance()->addScript(Script("toggle_rain"));
+           Console::getInstance()->addScript(cToggleRain);
            break;
       case OIS::KC_F:
-           Console::getInstance()->addScript(Script("toggle_fog"));
+           Console::getInstance()->addScript(cToggleFog);
            break;
       case OIS::KC_V: // S like snow is already occupied for movement
-           Console::getInstance()->addScript(Script("toggle_snow"));
+           Console::getInstance()->addScript(cToggleSnow);
            break;
       default: break;
     }//swi
@@ -178,14 +182,16 @@ InputSystemBinding& InputSystemBinding::get()
 
 bool InputSystemBinding::mouseMoved( const OIS::MouseEvent &arg )
 {
+    static const Script cZoomIn("ZoomIn");
+    static const Script cZoomOut("ZoomOut");
     //Movement of the mouse wheel is considered movement of the z-axis in OIS.
     if (arg.state.Z.rel>0)
     {
-      Console::getInstance()->addScript(Script("ZoomIn"));
+      Console::getInstance()->addScript(cZoomIn);
     }
     else if (arg.state.Z.rel<0)
     {
-      Console::getInstance()->addScript(Script("ZoomOut"));
+      Console::getInstance()->addScript(cZoomOut);
     }
     //check left/right movement
     if (arg.state.X.rel!=0)
@@ -204,7 +210,8 @@ bool InputSystemBinding::mousePressed( const OIS::MouseEvent &arg, OIS::MouseBut
 {
     if (id==OIS::MB_Left)
     {
-      Console::getInstance()->addScript(Script("StartAttack"));
+      static const Script cStartAttack("StartAttack");
+      Console::getInstance()->addScript(cStartAttack);
     }
     return true;
 }
@@ -213,7 +220,8 @@ bool InputSystemBinding::mouseReleased( const OIS::MouseEvent &arg, OIS::MouseBu
 {
     if (id==OIS::MB_Left)
     {
-      Console::getInstance()->addScript(Script("StopAttack"));
+      static const Script cStopAttack("StopAttack");
+      Console::getInstance()->addScript(cStopAttack);
     }
     return true;
 }
@@ -171,77 +171,64 @@ int Inventory::getTotalValue() const
   return sum;
 }
 
-bool Inventory::saveToStream(std::ofstream& OutStream) const
+bool Inventory::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
     DuskLog() << "Inventory::saveToStream: ERROR: stream contains errors!\n";
     return false;
   }
-  OutStream.write((char*) &cHeaderInve, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderInve);
   //write number of items
-  unsigned int len = m_Items.size();
-  OutStream.write((char*) &len, sizeof(unsigned int));
+  OutStream.writeUInt32(m_Items.size());
   //write items (ID and amount)
   std::map<std::string, unsigned int>::const_iterator traverse;
   traverse = m_Items.begin();
   while (traverse != m_Items.end())
   {
     //ID
-    len = traverse->first.length();
-    OutStream.write((char*) &len, sizeof(unsigned int));
-    OutStream.write(traverse->first.c_str(), len);
+    OutStream.writeString(traverse->first);
     //amount
-    OutStream.write((char*) &(traverse->second), sizeof(unsigned int));
+    OutStream.writeUInt32(traverse->second);
     ++traverse;
   }//while
   return OutStream.good();
 }
 
-bool Inventory::loadFromStream(std::ifstream& InStream)
+bool Inventory::loadFromStream(BinaryReader& InStream)
 {
   if (!InStream.good())
   {
     DuskLog() << "Inventory::loadFromStream: ERROR: stream contains errors!\n";
     return false;
   }
-  unsigned int len=0, i, count=0;
-  InStream.read((char*) &len, sizeof(unsigned int));
+  uint32_t len=0, i, count=0;
+  InStream.readUInt32(len);
   if (len!=cHeaderInve)
   {
     DuskLog() << "Inventory::loadFromStream: ERROR: stream contains unexpected header!\n";
     return false;
   }
   //read number of items
-  InStream.read((char*) &count, sizeof(unsigned int));
+  InStream.readUInt32(count);
   makeEmpty();
-  char ID_Buffer[256];
-  ID_Buffer[0] = ID_Buffer[255] = '\0';
+  std::string itemID;
   for (i=0; i<count; i++)
   { //read loop
     //ID
-    len=0;
-    InStream.read((char*) &len, sizeof(unsigned int));
-    if (len>255)
+    if (!InStream.readString(itemID))
     {
-      DuskLog() << "Inventory::loadFromStream: ERROR: ID is longer than 255 characters!\n";
+      DuskLog() << "Inventory::loadFromStream: ERROR while reading item ID! "
+                << "(ID must not be longer than 255 characters.)\n";
       return false;
     }
-    InStream.read(ID_Buffer, len);
-    if (!InStream.good())
-    {
-      DuskLog() << "Inventory::loadFromStream: ERROR while reading item ID!\n";
-      return false;
-    }
-    ID_Buffer[len] = '\0';
     //amount
-    InStream.read((char*) &len, sizeof(unsigned int));
-    if (!InStream.good())
+    if (!InStream.readUInt32(len))
     {
       DuskLog() << "Inventory::loadFromStream: ERROR while reading item amount!\n";
       return false;
     }
-    addItem(std::string(ID_Buffer), len);
+    addItem(itemID, len);
   }//for
   return InStream.good();
 }
@@ -58,7 +58,8 @@
 
 #include <string>
 #include <map>
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 
 namespace Dusk
 {
@@ -137,7 +138,7 @@ class Inventory
        parameters:
            OutStream - the output stream that will be used to save the inventory
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Loads contents of inventory from stream and returns true on success,
        false otherwise. The Inventory content is probably inconsistent after
@@ -146,7 +147,7 @@ class Inventory
        parameters:
            InStream - the input stream that will be used to load the inventory
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
 
     /* utility function to get iterator to the beginning of the internal map */
     ConstInventoryIterator getFirst() const;
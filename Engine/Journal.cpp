@@ -362,7 +362,7 @@ unsigned int Journal::getMaximumAvailabeIndex(const std::string& jID) const
   return index_iter->first;
 }
 
-bool Journal::saveAllToStream(std::ofstream& output) const
+bool Journal::saveAllToStream(BinaryWriter& output) const
 {
   if (!output.good())
   {
@@ -371,173 +371,150 @@ bool Journal::saveAllToStream(std::ofstream& output) const
   }
   std::map<const std::string, QuestRecord>::const_iterator iter;
   std::map<const unsigned int, JournalRecord>::const_iterator index_iter;
-  unsigned int len;
   iter = m_Entries.begin();
   while (iter!=m_Entries.end())
   {
     //write header
-    output.write((const char*) &cHeaderJour, sizeof(cHeaderJour));
+    output.writeUInt32(cHeaderJour);
     //write quest ID
-    len = iter->first.length();
-    output.write((const char*) &len, sizeof(unsigned int));
-    output.write(iter->first.c_str(), len);
-    if (!output.good())
-    {
-      DuskLog() << "Journal::saveAllToStream: ERROR while writing quest ID!\n";
-      return false;
-    }
+    output.writeString(iter->first);
     //write quest name
-    len = iter->second.QuestName.length();
-    output.write((const char*) &len, sizeof(unsigned int));
-    output.write(iter->second.QuestName.c_str(), len);
+    output.writeString(iter->second.QuestName);
     if (!output.good())
     {
-      DuskLog() << "Journal::saveAllToStream: ERROR while writing quest name!\n";
+      DuskLog() << "Journal::saveAllToStream: ERROR while writing quest ID or "
+                << "quest name!\n";
       return false;
     }
 
     //now write all subordinated index records
     // --- write number of records
-    len = iter->second.Indices.size();
-    output.write((const char*) &len, sizeof(unsigned int));
+    output.writeUInt32(iter->second.Indices.size());
     // --- write records
     index_iter = iter->second.Indices.begin();
     while (index_iter!=iter->second.Indices.end())
     {
       //write index
-      len = index_iter->first;
-      output.write((const char*) &len, sizeof(unsigned int));
+      output.writeUInt32(index_iter->first);
       //write text
-      len = index_iter->second.Text.length();
-      output.write((const char*) &len, sizeof(unsigned int));
-      output.write(index_iter->second.Text.c_str(), len);
+      output.writeString(index_iter->second.Text);
       //write flags
-      output.write((const char*) &(index_iter->second.Flags), 1);
-      if (!output.good())
-      {
-        DuskLog() << "Journal::saveAllToStream: ERROR while writing "
-                  << "JournalRecord!\n";
-        return false;
-      }
+      output.writeUInt8(index_iter->second.Flags);
       ++index_iter;
     } //while (inner loop)
+    if (!output.good())
+    {
+      DuskLog() << "Journal::saveAllToStream: ERROR while writing "
+                << "JournalRecord!\n";
+      return false;
+    }
     ++iter;
   } //while (outer loop)
   return output.good();
 }
 
-bool Journal::loadNextFromStream(std::ifstream& input)
+bool Journal::loadNextFromStream(BinaryReader& input)
 {
-  if (!input.good())
+  StagedQuest quest;
+  if (!readNextFromStream(input, quest))
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR: bad stream!\n";
     return false;
   }
-  unsigned int len = 0;
-  input.read((char*) &len, sizeof(unsigned int));
-  if (len != cHeaderJour)
+  addStagedQuest(quest);
+  return true;
+}
+
+bool Journal::readNextFromStream(BinaryReader& input, StagedQuest& quest)
+{
+  if (!input.good())
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR: invalid record header!\n";
+    DuskLog() << "Journal::readNextFromStream: ERROR: bad stream!\n";
     return false;
   }
-  //read quest ID
-  input.read((char*) &len, sizeof(unsigned int));
-  if (len>511)
+  uint32_t len = 0;
+  input.readUInt32(len);
+  if (len != cHeaderJour)
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR: quest ID seems to be "
-              << "longer than 511 characters!\n";
+    DuskLog() << "Journal::readNextFromStream: ERROR: invalid record header!\n";
     return false;
   }
-  char buffer[512];
-  buffer[0] = buffer[511] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!(input.good()))
+  //read quest ID
+  if (!input.readString(quest.QuestID, 511))
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR while reading quest ID!\n";
+    DuskLog() << "Journal::readNextFromStream: ERROR while reading quest ID! "
+              << "(It must not be longer than 511 characters.)\n";
     return false;
   }
-  const std::string QuestID = std::string(buffer);
   //read quest name
-  input.read((char*) &len, sizeof(unsigned int));
-  if (len>511)
-  {
-    DuskLog() << "Journal::loadNextFromStream: ERROR: quest name of quest \""
-              <<QuestID <<"\" seems to be longer than 511 characters!\n";
-    return false;
-  }
-  buffer[0] = buffer[511] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
+  if (!input.readString(quest.QuestName, 511))
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR while reading quest name!\n";
+    DuskLog() << "Journal::readNextFromStream: ERROR while reading quest name "
+              << "of quest \""<<quest.QuestID <<"\"! (It must not be longer than 511"
+              << " characters.)\n";
     return false;
   }
-  setQuestName(QuestID, std::string(buffer));
   //now read the index subrecords
   // -- read their number
-  unsigned int indexCount = 0;
-  input.read((char*) &indexCount, sizeof(unsigned int));
+  uint32_t indexCount = 0;
+  input.readUInt32(indexCount);
   if (indexCount==0)
   {
-    DuskLog() << "Journal::loadNextFromStream: Hint: there are no records! "
+    DuskLog() << "Journal::readNextFromStream: Hint: there are no records! "
               << "Aborting.\n";
     return true;
   }
   if (indexCount>100) //can there really be so much for one single(!) quest?
   {
-    DuskLog() << "Journal::loadNextFromStream: ERROR: there seem to be more "
-              << "than 100 subrecords for quest \""<<QuestID<<"\", which is "
+    DuskLog() << "Journal::readNextFromStream: ERROR: there seem to be more "
+              << "than 100 subrecords for quest \""<<quest.QuestID<<"\", which is "
               << "most likely too much. Aborting.\n";
     return false;
   }
   //now read the records
   JournalRecord tempRec;
-  unsigned int i, curIndex=0;
+  uint32_t i, curIndex=0;
   for (i=0; i<indexCount; i=i+1)
   {
     //read index
-    input.read((char*) &curIndex, sizeof(unsigned int));
+    curIndex = 0;
+    input.readUInt32(curIndex);
     if (curIndex==0)
     {
-      DuskLog() << "Journal::loadNextFromStream: ERROR: got zero as journal "
-                << "index for one subrecord of quest \""<<QuestID<<"\", but "
+      DuskLog() << "Journal::readNextFromStream: ERROR: got zero as journal "
+                << "index for one subrecord of quest \""<<quest.QuestID<<"\", but "
                 << "zero is not a valid index. Aborting.\n";
       return false;
     }
     //read text
-    len = 0;
-    input.read((char*) &len, sizeof(unsigned int));
-    if (len>511)
+    if (!input.readString(tempRec.Text, 511))
     {
-      DuskLog() << "Journal::loadNextFromStream: ERROR: text for quest \""
-                << QuestID<<"\", index "<<curIndex<<", seems to be longer than"
-                << " 511 characters!\n";
+      DuskLog() << "Journal::readNextFromStream: ERROR while reading journal "
+                << "text for quest \""<<quest.QuestID<<"\", index "<<curIndex<<". "
+                << "(Text must not be longer than 511 characters.)\n";
       return false;
     }
-    input.read(buffer, len);
-    buffer[len] = '\0';
-    if (!input.good())
-    {
-      DuskLog() << "Journal::loadNextFromStream: ERROR while reading journal "
-                << "text for quest \""<<QuestID<<"\", index "<<curIndex<<".\n";
-      return false;
-    }
-    tempRec.Text = std::string(buffer);
     //read flags
-    input.read((char*) &(tempRec.Flags), 1);
-    if (!input.good())
+    if (!input.readUInt8(tempRec.Flags))
     {
-      DuskLog() << "Journal::loadNextFromStream: ERROR while reading journal "
-                << "flags of quest \""<<QuestID<<"\", index "<<curIndex<<".\n";
+      DuskLog() << "Journal::readNextFromStream: ERROR while reading journal "
+                << "flags of quest \""<<quest.QuestID<<"\", index "<<curIndex<<".\n";
       return false;
     }
-    addEntry(QuestID, curIndex, tempRec);
+    quest.Entries.push_back(std::pair<unsigned int, JournalRecord>(curIndex, tempRec));
   }//for
   return input.good();
 }
 
+void Journal::addStagedQuest(const StagedQuest& quest)
+{
+  setQuestName(quest.QuestID, quest.QuestName);
+  unsigned int i;
+  for (i=0; i<quest.Entries.size(); ++i)
+  {
+    addEntry(quest.QuestID, quest.Entries[i].first, quest.Entries[i].second);
+  }//for
+}
+
 void Journal::clearAllEntries()
 {
   m_Entries.clear();
@@ -40,6 +40,8 @@
      - 2011-02-05 (rev 278) - flag for quest failure added
      - 2012-04-06 (rev 304) - non-existent IDs in get-function will now throw
                               exceptions
+     - 2026-10-19           - StagedQuest, readNextFromStream() and
+                              addStagedQuest() added
 
  ToDo list:
      - ???
@@ -52,7 +54,8 @@
 #ifndef JOURNAL_H
 #define JOURNAL_H
 
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include <map>
 #include <string>
 #include <vector>
@@ -278,12 +281,40 @@ class Journal
     unsigned int getMaximumAvailabeIndex(const std::string& jID) const;
 
     /* tries to save all data to the stream and returns true on success */
-    bool saveAllToStream(std::ofstream& output) const;
+    bool saveAllToStream(BinaryWriter& output) const;
 
     /* tries to load the next Journal entries from the stream and returns true
        on success, false on failure
     */
-    bool loadNextFromStream(std::ifstream& input);
+    bool loadNextFromStream(BinaryReader& input);
+
+    /* holds the data of one quest that has been read from a stream, but has
+       not been added to the Journal yet
+    */
+    struct StagedQuest
+    {
+      std::string QuestID;
+      std::string QuestName;
+      std::vector<std::pair<unsigned int, JournalRecord> > Entries;
+    };
+
+    /* reads the next quest from the stream without adding it to the Journal
+       and returns true on success, false on failure. Since this function does
+       not touch the Journal itself, it can be used by worker threads while
+       loading data files.
+
+       parameters:
+           input - the input stream
+           quest - the structure that will hold the read quest data
+    */
+    static bool readNextFromStream(BinaryReader& input, StagedQuest& quest);
+
+    /* adds a quest that was read by readNextFromStream()
+
+       parameters:
+           quest - the quest data
+    */
+    void addStagedQuest(const StagedQuest& quest);
 
     /* deletes ALL entries - use with caution */
     void clearAllEntries();
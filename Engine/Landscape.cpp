@@ -25,6 +25,7 @@
 #include <cmath>
 #include <sstream>
 #include <limits>
+#include <atomic>
 #ifndef NO_OGRE_IN_LANDSCAPE
   #include <OgreMath.h>
 #endif
@@ -41,7 +42,8 @@ namespace Dusk
 
 unsigned int GenerateUniqueID()
 {
-  static unsigned int m_genID = 0;
+  //records may be created by the worker threads of DataLoader, too
+  static std::atomic<unsigned int> m_genID(0);
   return m_genID++;
 }
 
@@ -101,7 +103,7 @@ float LandscapeRecord::getStride() const
   return m_Stride;
 }
 
-bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
+bool LandscapeRecord::loadFromStream(BinaryReader& AStream)
 {
   if (m_Loaded)
   {
@@ -116,10 +118,9 @@ bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
     return false;
   }
 
-  unsigned int Land;
-  Land = 0;
+  uint32_t Land = 0;
   //read header "Land"
-  AStream.read((char*) &Land, sizeof(unsigned int));
+  AStream.readUInt32(Land);
   if (Land!=cHeaderLand)
   {
     DuskLog() << "LandscapeRecord::loadFromStream: Stream contains invalid "
@@ -127,10 +128,10 @@ bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
     return false;
   }
   //read offsets
-  AStream.read((char*) &m_OffsetX, sizeof(float));
-  AStream.read((char*) &m_OffsetY, sizeof(float));
+  AStream.readFloat(m_OffsetX);
+  AStream.readFloat(m_OffsetY);
   //stride
-  AStream.read((char*) &m_Stride, sizeof(float));
+  AStream.readFloat(m_Stride);
   if (!AStream.good())
   {
     DuskLog() << "LandscapeRecord::loadFromStream: ERROR: Stream seems to "
@@ -146,8 +147,7 @@ bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
   }//if
 
   //read the height data
-  AStream.read((char*) &Height[0][0], cRecordWidth*cRecordWidth*sizeof(float));
-  if (!AStream.good())
+  if (!AStream.readFloats(&Height[0][0], cRecordWidth*cRecordWidth))
   {
     DuskLog() << "LandscapeRecord::loadFromStream: ERROR: Stream seems to have"
               << " invalid Land record height data.\n";
@@ -155,8 +155,7 @@ bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
   }
 
   //colour data
-  AStream.read((char*) &Colour[0][0][0], cRecordWidth*cRecordWidth*3);
-  if (!AStream.good())
+  if (!AStream.read(&Colour[0][0][0], cRecordWidth*cRecordWidth*3))
   {
     DuskLog() << "LandscapeRecord::loadFromStream: ERROR: Stream seems to "
               << "have invalid Land record colour data.\n";
@@ -186,7 +185,7 @@ bool LandscapeRecord::loadFromStream(std::ifstream &AStream)
   return true;
 }//LoadFromStream
 
-bool LandscapeRecord::saveToStream(std::ofstream &AStream) const
+bool LandscapeRecord::saveToStream(BinaryWriter& AStream) const
 {
   if (!m_Loaded)
   {
@@ -200,16 +199,16 @@ bool LandscapeRecord::saveToStream(std::ofstream &AStream) const
     return false;
   }
   //write header "Land"
-  AStream.write((const char*) &cHeaderLand, sizeof(unsigned int));
+  AStream.writeUInt32(cHeaderLand);
   //write offsets
-  AStream.write((const char*) &m_OffsetX, sizeof(float));
-  AStream.write((const char*) &m_OffsetY, sizeof(float));
+  AStream.writeFloat(m_OffsetX);
+  AStream.writeFloat(m_OffsetY);
   //stride
-  AStream.write((const char*) &m_Stride, sizeof(float));
+  AStream.writeFloat(m_Stride);
   //height data
-  AStream.write((const char*) &Height[0][0], cRecordWidth*cRecordWidth*sizeof(float));
+  AStream.writeFloats(&Height[0][0], cRecordWidth*cRecordWidth);
   //colour data
-  AStream.write((const char*) &Colour[0][0][0], cRecordWidth*cRecordWidth*3);
+  AStream.write(&Colour[0][0][0], cRecordWidth*cRecordWidth*3);
   if (!AStream.good())
   {
     DuskLog() << "LandscapeRecord::saveToStream: Error while writing record to"
@@ -492,7 +491,7 @@ bool LandscapeRecord::setColour(const float x, const float z, const unsigned cha
     unsigned int x_idx, y_idx;
     x_idx = (unsigned int)((x-m_OffsetX)/m_Stride);
     y_idx = (unsigned int)((z-m_OffsetY)/m_Stride);
-    DuskLog() << "DEBUG: LandscapeRecord::setColour(): x_idx="<<x_idx<<", y_idx="<<y_idx<<"\n";
+    DUSK_LOG(llDebug) << "DEBUG: LandscapeRecord::setColour(): x_idx="<<x_idx<<", y_idx="<<y_idx<<"\n";
     Colour[x_idx][y_idx][0] = r;
     Colour[x_idx][y_idx][1] = g;
     Colour[x_idx][y_idx][2] = b;
@@ -504,7 +503,7 @@ bool LandscapeRecord::setColour(const float x, const float z, const unsigned cha
     #endif
     return true;
   }
-  DuskLog() << "DEBUG: LandscapeRecord::setColour(): call with x or z value out of range.\n";
+  DUSK_LOG(llDebug) << "DEBUG: LandscapeRecord::setColour(): call with x or z value out of range.\n";
   return false;
 }
 
@@ -545,7 +544,7 @@ bool LandscapeRecord::setColourRadial(const float x, const float z, const unsign
       y_max = cRecordWidth-1;
     }
     else y_max = y_idx+range;
-    DuskLog() << "DEBUG: LandscapeRecord::setColourRadial(): call with: x_idx: "
+    DUSK_LOG(llDebug) << "DEBUG: LandscapeRecord::setColourRadial(): call with: x_idx: "
               <<x_idx<<"; x_min: "<<x_min<<"; x_max: "<<x_max<<"\n"
               <<"y_idx: "<<y_idx<<"; y_min: "<<y_min<<"; y_max: "<<y_max<<"\n"
               <<"range: "<<range<<"\n";
@@ -568,7 +567,7 @@ bool LandscapeRecord::setColourRadial(const float x, const float z, const unsign
     #endif
     return true;
   }
-  DuskLog() << "DEBUG: LandscapeRecord::setColourRadial(): call with x, z or radius value out of range.\n";
+  DUSK_LOG(llDebug) << "DEBUG: LandscapeRecord::setColourRadial(): call with x, z or radius value out of range.\n";
   return false;
 }
 
@@ -897,35 +896,31 @@ bool Landscape::loadFromFile(const std::string& FileName)
     return false;
   }
 
-  unsigned int numRecords, i;
-  unsigned int Header;
-  std::ifstream input;
+  uint32_t numRecords, i;
+  uint32_t Header;
+  BinaryReader input;
 
-  input.open(FileName.c_str(), std::ios::in | std::ios::binary);
-  if(!input)
+  if (!input.loadFromFile(FileName))
   {
-    DuskLog() << "Landscape::loadFromFile: Could not open file \""<<FileName
-              << "\" for reading in binary mode.\n";
+    DuskLog() << "Landscape::loadFromFile: Could not read file \""<<FileName
+              << "\".\n";
     return false;
   }//if
 
   //read header "Dusk"
   Header = 0;
-  input.read((char*) &Header, sizeof(unsigned int));
+  input.readUInt32(Header);
   if (Header!=cHeaderDusk)
   {
     DuskLog() << "Landscape::loadFromFile: File \""<<FileName<< "\" has "
               << "invalid header.\n";
-    input.close();
     return false;
   }
   //read total number of records in file
-  input.read((char*) &numRecords, sizeof(unsigned int));
-  if (!input.good())
+  if (!input.readUInt32(numRecords))
   {
     DuskLog() << "Landscape::loadFromFile: File \""<<FileName<< "\" has "
               << "invalid, (short?) header.\n";
-    input.close();
     return false;
   }
 
@@ -933,7 +928,6 @@ bool Landscape::loadFromFile(const std::string& FileName)
   {
     DuskLog() << "Landscape::loadFromFile: File \""<<FileName<< "\" has "
               << "more than "<<cMaxLandRecords<<" records.\n";
-    input.close();
     return false;
   }
 
@@ -953,11 +947,9 @@ bool Landscape::loadFromFile(const std::string& FileName)
       //m_RecordList= NULL;
       //m_numRec = 0;
       changeListSize(0);
-      input.close();
       return false;
     }
   }//for
-  input.close();
   return true;
 }
 
@@ -969,19 +961,11 @@ bool Landscape::saveToFile(const std::string& FileName) const
     return false;
   }
 
-  std::ofstream output;
-
-  output.open(FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
-  if(!output)
-  {
-    DuskLog() << "Landscape::saveToFile: Could not open file \""<<FileName
-              << "\" for writing in binary mode.\n";
-    return false;
-  }//if
+  BinaryWriter output(8+m_numRec*(16+cRecordWidth*cRecordWidth*7));
 
   //write header "Dusk"
-  output.write((const char*) &cHeaderDusk, sizeof(unsigned int));
-  output.write((const char*) &m_numRec, sizeof(unsigned int));
+  output.writeUInt32(cHeaderDusk);
+  output.writeUInt32(m_numRec);
 
   unsigned int i;
 
@@ -991,15 +975,19 @@ bool Landscape::saveToFile(const std::string& FileName) const
     {
       DuskLog() << "Landscape::saveToFile: Error while writing record "<<i+1
                 << " to file \"" <<FileName<<"\".\n";
-      output.close();
       return false;
     }
   }//for
-  output.close();
+  if (!output.saveToFile(FileName))
+  {
+    DuskLog() << "Landscape::saveToFile: Could not write data to file \""
+              << FileName << "\".\n";
+    return false;
+  }
   return true;
 }//SaveToFile
 
-bool Landscape::saveAllToStream(std::ofstream& AStream) const
+bool Landscape::saveAllToStream(BinaryWriter& AStream) const
 {
   if (!AStream.good())
   {
@@ -1061,6 +1049,14 @@ void Landscape::changeListSize(const unsigned int new_size)
 
 LandscapeRecord* Landscape::createRecord()
 {
+  LandscapeRecord* record = new LandscapeRecord;
+  addRecord(record);
+  return record;
+}
+
+void Landscape::addRecord(LandscapeRecord* record)
+{
+  if (record==NULL) return;
   //check for insufficient list length
   if (m_numRec == m_Capacity)
   {
@@ -1075,9 +1071,8 @@ LandscapeRecord* Landscape::createRecord()
     }
   }//if
 
-  m_RecordList[m_numRec] = new LandscapeRecord;
+  m_RecordList[m_numRec] = record;
   m_numRec = m_numRec +1;
-  return m_RecordList[m_numRec-1];
 }
 
 void Landscape::destroyRecord(const LandscapeRecord* recPtr)
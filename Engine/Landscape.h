@@ -52,6 +52,8 @@
      - 2011-08-28 (rev 298) - function generateByDiamondSquare() added to
                               LandscapeRecord to allow random terrain generation
      - 2013-05-30           - minor fixes to eliminate some compiler warnings
+     - 2026-10-19           - addRecord() added, record IDs are generated in a
+                              thread-safe way
 
  ToDo list:
      - implement loadRecordFromStream() for Landscape class
@@ -68,7 +70,8 @@
 #ifndef LANDSCAPE_H
 #define LANDSCAPE_H
 
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include <string>
 #ifndef NO_OGRE_IN_LANDSCAPE
   #include <OgreRay.h>
@@ -137,10 +140,10 @@ namespace Dusk
              If the functions fails, the record may possibly contain incon-
              sistent data and therefore should not be used any more.
       */
-      bool loadFromStream(std::ifstream& AStream);
+      bool loadFromStream(BinaryReader& AStream);
 
       /* tries to save landscape data to stream and returns true on success */
-      bool saveToStream(std::ofstream& AStream) const;
+      bool saveToStream(BinaryWriter& AStream) const;
 
       /*function for determining whether data is loaded or not - returns true,
         if the record contains valid landscape data. However, only the height
@@ -366,11 +369,20 @@ namespace Dusk
       /* tries to save all records to the given stream and returns true on
          success
       */
-      bool saveAllToStream(std::ofstream& AStream) const;
+      bool saveAllToStream(BinaryWriter& AStream) const;
 
       /* creates a new landscape record and returns a pointer to it */
       LandscapeRecord* createRecord();
 
+      /* adds an already existing landscape record to the list of records and
+         takes ownership of it, i.e. the record will be deleted by Landscape
+
+         parameters:
+             record - the record that shall be added (must not be NULL and
+                      must have been allocated with new)
+      */
+      void addRecord(LandscapeRecord* record);
+
       /* deletes the landscape record pointed to be recPtr
 
          remarks:
@@ -0,0 +1,179 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "MappedFile.h"
+#include "Messages.h"
+
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace Dusk
+{
+
+MappedFile::MappedFile()
+: m_Data(NULL),
+  m_Size(0)
+  #if defined(_WIN32)
+  , m_File(INVALID_HANDLE_VALUE),
+  m_Mapping(NULL)
+  #endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+#if defined(_WIN32)
+bool MappedFile::open(const std::string& FileName)
+{
+  close();
+  HANDLE file = CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file==INVALID_HANDLE_VALUE)
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not open file \""<<FileName
+              << "\".\n";
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if ((GetFileSizeEx(file, &fileSize)==0) || (fileSize.QuadPart<=0))
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not get size of file \""
+              << FileName << "\", or file is empty.\n";
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping==NULL)
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not create mapping of file \""
+              << FileName << "\".\n";
+    CloseHandle(file);
+    return false;
+  }
+  const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view==NULL)
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not map view of file \""
+              << FileName << "\".\n";
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_File = file;
+  m_Mapping = mapping;
+  m_Data = static_cast<const char*>(view);
+  m_Size = fileSize.QuadPart;
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (m_Data!=NULL)
+  {
+    UnmapViewOfFile(m_Data);
+    m_Data = NULL;
+  }
+  if (m_Mapping!=NULL)
+  {
+    CloseHandle(m_Mapping);
+    m_Mapping = NULL;
+  }
+  if (m_File!=INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(m_File);
+    m_File = INVALID_HANDLE_VALUE;
+  }
+  m_Size = 0;
+}
+#else
+bool MappedFile::open(const std::string& FileName)
+{
+  close();
+  const int fd = ::open(FileName.c_str(), O_RDONLY);
+  if (fd<0)
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not open file \""<<FileName
+              << "\".\n";
+    return false;
+  }
+  struct stat fileInfo;
+  if ((fstat(fd, &fileInfo)!=0) || (fileInfo.st_size<=0))
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not get size of file \""
+              << FileName << "\", or file is empty.\n";
+    ::close(fd);
+    return false;
+  }
+  int flags = MAP_PRIVATE;
+  #if defined(MAP_POPULATE)
+  //read the pages right now instead of on first access, so the I/O happens in
+  //the thread which maps the file (e.g. a loader thread)
+  flags = flags | MAP_POPULATE;
+  #endif
+  void* view = mmap(NULL, fileInfo.st_size, PROT_READ, flags, fd, 0);
+  //the mapping stays valid after the descriptor is closed
+  ::close(fd);
+  if (view==MAP_FAILED)
+  {
+    DuskLog() << "MappedFile::open: ERROR: Could not map file \"" << FileName
+              << "\" into memory.\n";
+    return false;
+  }
+  m_Data = static_cast<const char*>(view);
+  m_Size = fileInfo.st_size;
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (m_Data!=NULL)
+  {
+    munmap(const_cast<char*>(m_Data), m_Size);
+    m_Data = NULL;
+  }
+  m_Size = 0;
+}
+#endif
+
+bool MappedFile::isOpen() const
+{
+  return (m_Data!=NULL);
+}
+
+const char* MappedFile::data() const
+{
+  return m_Data;
+}
+
+std::size_t MappedFile::size() const
+{
+  return m_Size;
+}
+
+} //namespace
@@ -0,0 +1,98 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: MappedFile class
+          maps a complete file read-only into memory
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_MAPPEDFILE_H
+#define DUSK_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Dusk
+{
+
+/*class MappedFile:
+        maps the content of a file into the address space of the process
+        (mmap() or CreateFileMapping(), respectively), so that it can be used
+        in place without reading it into a buffer first. The content is
+        read-only and stays valid until close() is called or the object is
+        destroyed.
+*/
+class MappedFile
+{
+  public:
+    /* constructor */
+    MappedFile();
+
+    /* destructor - unmaps the file */
+    ~MappedFile();
+
+    /* Maps the complete file FileName into memory and returns true on
+       success. A previously mapped file will be unmapped first.
+
+       parameters:
+           FileName - path of the file
+
+       remarks:
+           Empty files cannot be mapped.
+    */
+    bool open(const std::string& FileName);
+
+    /* unmaps the file, if one is mapped */
+    void close();
+
+    /* returns true, if a file is currently mapped */
+    bool isOpen() const;
+
+    /* returns a pointer to the mapped content, or NULL, if no file is mapped */
+    const char* data() const;
+
+    /* returns the size of the mapped file in bytes */
+    std::size_t size() const;
+  private:
+    /* empty copy constructor - mappings cannot be copied */
+    MappedFile(const MappedFile& op) {}
+
+    const char* m_Data;
+    std::size_t m_Size;
+    #if defined(_WIN32)
+    void* m_File; //HANDLE of the file
+    void* m_Mapping; //HANDLE of the file mapping
+    #endif
+};//class
+
+} //namespace
+
+#endif // DUSK_MAPPEDFILE_H
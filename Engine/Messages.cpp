@@ -20,21 +20,49 @@
 
 #include "Messages.h"
 #include <iostream>
+#include <chrono>
+#include <csignal>
+#include <cstring>
 #include "DuskFunctions.h"
 
 namespace Dusk
 {
 
+/* how long the writer thread sleeps, if nobody wakes it up (milliseconds) */
+const unsigned int cWriterInterval = 20;
+/* how often a producer yields to the writer before dropping a line */
+const unsigned int cFullRetries = 1000;
+
+std::atomic<int> Messages::s_Level(llInfo);
+std::atomic<bool> Messages::s_Destroyed(false);
+
 Messages::Messages(const std::string& LogFile, const bool out)
+: mOutput(out), mRing(new LogRecord[cRingSize]), mHead(0), mTail(0),
+  mDropped(0), mStop(false)
 {
   mStream.open(LogFile.c_str());
-  mOutput = out;
+  unsigned int i;
+  for (i=0; i<cRingSize; ++i)
+  {
+    mRing[i].Sequence.store(i, std::memory_order_relaxed);
+    mRing[i].Length = 0;
+    mRing[i].Overflow = NULL;
+  }//for
+  mWriter = std::thread(&Messages::writerLoop, this);
 }
 
 Messages::~Messages()
 {
-  mStream.flush();
+  mStop = true;
+  mWake.notify_one();
+  if (mWriter.joinable())
+    mWriter.join();
+  flush();
+  s_Destroyed = true;
   mStream.close();
+  //flush() has written all records, so only the ring itself is left
+  delete[] mRing;
+  mRing = NULL;
 }
 
 Messages& Messages::getSingleton()
@@ -45,12 +73,10 @@ Messages& Messages::getSingleton()
 
 void Messages::Log(const std::string& msg)
 {
-  mStream << msg;
-  mStream.flush();
-  if (mOutput)
-  {
-    std::cout << msg;
-  }
+  if (msg.length()<=cRecordLength)
+    push(llInfo, msg.data(), msg.length(), NULL);
+  else
+    push(llInfo, NULL, 0, new std::string(msg));
 }
 
 void Messages::setOutput(const bool b)
@@ -63,28 +89,267 @@ bool Messages::isOutput() const
   return mOutput;
 }
 
-Messages& Messages::operator<<(const float f)
+void Messages::setLevel(const LogLevel level)
+{
+  s_Level.store(level, std::memory_order_relaxed);
+}
+
+LogLevel Messages::getLevel()
+{
+  return static_cast<LogLevel>(s_Level.load(std::memory_order_relaxed));
+}
+
+void Messages::flush()
+{
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  drain();
+  mStream.flush();
+  if (mOutput)
+    std::cout.flush();
+}
+
+void Messages::push(const LogLevel level, const char* text, const unsigned int length, std::string* overflow)
+{
+  unsigned int retries = 0;
+  size_t pos = mHead.load(std::memory_order_relaxed);
+  LogRecord* record = NULL;
+  while (record==NULL)
+  {
+    LogRecord& candidate = mRing[pos & (cRingSize-1)];
+    const size_t seq = candidate.Sequence.load(std::memory_order_acquire);
+    const long int diff = static_cast<long int>(seq) - static_cast<long int>(pos);
+    if (diff==0)
+    {
+      if (mHead.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+        record = &candidate;
+    }
+    else if (diff<0)
+    {
+      //buffer is full, give the writer thread some time
+      if (retries>=cFullRetries)
+      {
+        ++mDropped;
+        delete overflow;
+        return;
+      }
+      ++retries;
+      mWake.notify_one();
+      std::this_thread::yield();
+      pos = mHead.load(std::memory_order_relaxed);
+    }
+    else
+    {
+      pos = mHead.load(std::memory_order_relaxed);
+    }
+  }//while
+  if (overflow==NULL)
+    memcpy(record->Text, text, length);
+  record->Length = length;
+  record->Overflow = overflow;
+  record->Sequence.store(pos+1, std::memory_order_release);
+  //errors should not wait for the next regular wake-up of the writer
+  if (level>=llError)
+    mWake.notify_one();
+}
+
+void Messages::commit(const LogLevel level, const char* text, const unsigned int length, std::string* overflow)
+{
+  if (s_Destroyed)
+  {
+    //someone logs during the destruction of static objects
+    if (overflow!=NULL)
+      std::cout << *overflow;
+    else
+      std::cout.write(text, length);
+    delete overflow;
+    return;
+  }
+  getSingleton().push(level, text, length, overflow);
+}
+
+void Messages::drain()
+{
+  const bool toConsole = mOutput;
+  while (true)
+  {
+    LogRecord& record = mRing[mTail & (cRingSize-1)];
+    if (record.Sequence.load(std::memory_order_acquire)!=mTail+1)
+      break;
+    if (record.Overflow!=NULL)
+    {
+      mStream << *record.Overflow;
+      if (toConsole)
+        std::cout << *record.Overflow;
+      delete record.Overflow;
+      record.Overflow = NULL;
+    }
+    else
+    {
+      mStream.write(record.Text, record.Length);
+      if (toConsole)
+        std::cout.write(record.Text, record.Length);
+    }
+    record.Sequence.store(mTail+cRingSize, std::memory_order_release);
+    ++mTail;
+  }//while
+  const unsigned int dropped = mDropped.exchange(0);
+  if (dropped!=0)
+  {
+    mStream << "Messages: " << dropped << " log line(s) dropped, because the "
+            << "log buffer was full.\n";
+  }
+}
+
+void Messages::writerLoop()
+{
+  while (!mStop)
+  {
+    {
+      std::unique_lock<std::mutex> wakeLock(mWakeMutex);
+      mWake.wait_for(wakeLock, std::chrono::milliseconds(cWriterInterval));
+    }
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+    drain();
+  }//while
+}
+
+void Messages::installCrashHandler()
+{
+  //create the log now, a signal handler is no place to open files
+  getSingleton();
+  //write what is still in the buffer, if the program crashes
+  std::signal(SIGSEGV, crashHandler);
+  std::signal(SIGABRT, crashHandler);
+  std::signal(SIGFPE, crashHandler);
+  std::signal(SIGILL, crashHandler);
+}
+
+void Messages::crashHandler(int sig)
+{
+  //Not async-signal-safe, but the program is about to die anyway, and the
+  // last messages before a crash are the most interesting ones.
+  if (!s_Destroyed)
+  {
+    Messages& log = getSingleton();
+    //If the crash happened while the writer thread was busy, then drain()
+    // might be where it crashed, so don't touch the ring in that case.
+    if (log.mWriteMutex.try_lock())
+    {
+      log.drain();
+      log.mWriteMutex.unlock();
+    }
+    log.mStream.flush();
+  }
+  std::cout.flush();
+  std::signal(sig, SIG_DFL);
+  std::raise(sig);
+}
+
+/* LogLine functions */
+
+LogLine::LogLine(LogLine&& op)
+: m_Level(op.m_Level), m_Enabled(op.m_Enabled), m_Length(op.m_Length),
+  m_Overflow(op.m_Overflow)
+{
+  memcpy(m_Text, op.m_Text, m_Length);
+  op.m_Enabled = false;
+  op.m_Overflow = NULL;
+}
+
+void LogLine::append(const char* data, const unsigned int length)
+{
+  if (m_Overflow!=NULL)
+  {
+    m_Overflow->append(data, length);
+  }
+  else if (m_Length+length<=Messages::cRecordLength)
+  {
+    memcpy(m_Text+m_Length, data, length);
+    m_Length += length;
+  }
+  else
+  {
+    //line is too long for a record of the ring buffer
+    m_Overflow = new std::string(m_Text, m_Length);
+    m_Overflow->append(data, length);
+  }
+}
+
+LogLine& LogLine::operator<<(const char* c_str)
 {
-  Log(FloatToString(f));
+  if (m_Enabled and (c_str!=NULL))
+    append(c_str, strlen(c_str));
   return *this;
 }
 
-Messages& Messages::operator<<(const double d)
+LogLine& LogLine::operator<<(const std::string& str)
 {
-  Log(FloatToString(d));
+  if (m_Enabled)
+    append(str);
   return *this;
 }
 
-Messages& Messages::operator<<(const std::string& str)
+LogLine& LogLine::operator<<(const char c)
 {
-  Log(str);
+  if (m_Enabled)
+    append(&c, 1);
   return *this;
 }
 
-Messages& Messages::operator<<(const char* c_str)
+LogLine& LogLine::operator<<(const float f)
 {
-  Log(std::string(c_str));
+  if (m_Enabled)
+    append(FloatToString(f));
   return *this;
 }
 
+LogLine& LogLine::operator<<(const double d)
+{
+  if (m_Enabled)
+    append(FloatToString(d));
+  return *this;
+}
+
+LogLine& LogLine::appendSigned(const long long int i)
+{
+  if (m_Enabled)
+  {
+    if (i<0)
+    {
+      append("-", 1);
+      //works for the smallest value, too, because the cast comes first
+      return appendUnsigned(0ULL-static_cast<unsigned long long int>(i));
+    }
+    return appendUnsigned(i);
+  }
+  return *this;
+}
+
+LogLine& LogLine::appendUnsigned(const unsigned long long int u)
+{
+  if (m_Enabled)
+  {
+    char digits[24];
+    unsigned int pos = sizeof(digits);
+    unsigned long long int value = u;
+    do
+    {
+      --pos;
+      digits[pos] = '0' + (value % 10);
+      value = value / 10;
+    } while (value!=0);
+    append(digits+pos, sizeof(digits)-pos);
+  }
+  return *this;
+}
+
+void LogLine::commit()
+{
+  if (m_Overflow!=NULL)
+    Messages::commit(m_Level, NULL, 0, m_Overflow);
+  else if (m_Length!=0)
+    Messages::commit(m_Level, m_Text, m_Length, NULL);
+  m_Overflow = NULL;
+}
+
 } //namespace
@@ -31,6 +31,17 @@
                             - operator << overloaded for use with Messages
      - 2011-02-06 (rev 279) - minor error fixed
      - 2013-05-30/31        - better operator << for int types
+     - 2026-10-19           - writing to the log is guarded by a mutex, so
+                              that worker threads can log, too
+     - 2026-10-19           - asynchronous logging: DuskLog() collects a line
+                              in a LogLine, which is passed to a writer thread
+                              through a lock-free ring buffer
+                            - severity levels with compile-time and run-time
+                              filtering
+     - 2026-10-19           - DUSK_LOG() macro, which skips the arguments of
+                              filtered lines
+                            - crash handler is installed explicitly by
+                              installCrashHandler()
 
  ToDo list:
      - ???
@@ -44,16 +55,37 @@
 #define MESSAGES_H
 
 #include <string>
-#include <iostream>
+#include <sstream>
 #include <fstream>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/* Log lines below this level are removed at compile time. Define it (e.g. as
+   2 to keep only warnings and errors) to override the default, which drops
+   debug lines in builds with NDEBUG.
+*/
+#ifndef DUSK_LOG_MIN_LEVEL
+  #ifdef NDEBUG
+    #define DUSK_LOG_MIN_LEVEL 1
+  #else
+    #define DUSK_LOG_MIN_LEVEL 0
+  #endif
+#endif
 
 namespace Dusk
 {
 
+/* severity of log messages */
+enum LogLevel {llDebug=0, llInfo=1, llWarning=2, llError=3};
+
+class LogLine;
+
 class Messages
 {
   public:
-    /* destructor */
+    /* destructor - writes all pending messages and flushes the log file */
     ~Messages();
 
     /* singleton access method */
@@ -63,6 +95,9 @@ class Messages
 
        parameters:
            msg - the string that has to be written to the file
+
+       remarks:
+           The string is written asynchronously by the writer thread.
     */
     void Log(const std::string& msg);
 
@@ -77,16 +112,63 @@ class Messages
     /* returns true, if logged messages are also written to standard output */
     bool isOutput() const;
 
-    template<typename MrT>
-    Messages& operator<<(const MrT& n);
-    Messages& operator<<(const float f);
-    Messages& operator<<(const double d);
-    Messages& operator<<(const std::string& str);
-    Messages& operator<<(const char* c_str);
+    /* sets the minimum level of messages that are logged. Messages below
+       DUSK_LOG_MIN_LEVEL are never logged, no matter what level is set here.
+    */
+    static void setLevel(const LogLevel level);
+
+    /* returns the minimum level of messages that are logged */
+    static LogLevel getLevel();
+
+    /* returns true, if messages of the given level are logged */
+    static bool isEnabled(const LogLevel level)
+    {
+      return ((level>=DUSK_LOG_MIN_LEVEL)
+          and (level>=s_Level.load(std::memory_order_relaxed)));
+    }
+
+    /* writes all pending messages to the log file and flushes it. Called
+       automatically at exit and when the program crashes, so there is usually
+       no need to call it.
+    */
+    void flush();
 
+    /* installs signal handlers for SIGSEGV, SIGABRT, SIGFPE and SIGILL that
+       write pending messages to the log before the program dies. Should be
+       called once at startup by the application, not by libraries or tools
+       that might have handlers of their own.
+    */
+    static void installCrashHandler();
   private:
+    friend class LogLine;
+
+    /* maximum number of lines waiting for the writer thread */
+    static const unsigned int cRingSize = 1024;
+    /* longer lines are stored outside of the ring buffer */
+    static const unsigned int cRecordLength = 240;
+
+    struct LogRecord
+    {
+      std::atomic<size_t> Sequence;
+      unsigned int Length;
+      std::string* Overflow; //text of long lines, or NULL
+      char Text[cRecordLength];
+    };
+
     std::ofstream mStream;
-    bool mOutput;
+    std::atomic<bool> mOutput;
+    LogRecord* mRing;
+    std::atomic<size_t> mHead; //next record for producers
+    size_t mTail; //next record for the writer, guarded by mWriteMutex
+    std::atomic<unsigned int> mDropped;
+    std::mutex mWriteMutex;
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;
+    std::atomic<bool> mStop;
+    std::thread mWriter;
+
+    static std::atomic<int> s_Level;
+    static std::atomic<bool> s_Destroyed;
 
     /* constructor
 
@@ -99,30 +181,119 @@ class Messages
 
     /* empty copy constructor due to singleton pattern */
     Messages(const Messages& op) {}
+
+    /* adds a line to the ring buffer; waits a bit for the writer thread, if
+       the buffer is full, and drops the line, if it is still full then.
+       Either text or overflow is used, overflow is deleted by the writer.
+    */
+    void push(const LogLevel level, const char* text, const unsigned int length, std::string* overflow);
+
+    /* passes a line to the log, or writes it to standard output, if the log
+       has already been destroyed at exit
+    */
+    static void commit(const LogLevel level, const char* text, const unsigned int length, std::string* overflow);
+
+    /* writes all records in the ring buffer; mWriteMutex has to be locked */
+    void drain();
+
+    /* function of the writer thread */
+    void writerLoop();
+
+    /* signal handler that writes pending lines before the program dies */
+    static void crashHandler(int sig);
 };//class
 
-template<typename MrT>
-Messages& Messages::operator<<(const MrT& n)
+
+/* A single line of the log, collected by the operator << chain that follows
+   DuskLog() and passed to the writer thread as a whole at the end of the
+   statement. If its level is filtered, the operators do nothing.
+*/
+class LogLine
 {
-  mStream<<n;
-  mStream.flush();
-  if (mOutput)
-  {
-    std::cout << n;
-  }
-  return *this;
-}
+  public:
+    explicit LogLine(const LogLevel level)
+    : m_Level(level), m_Enabled(Messages::isEnabled(level)), m_Length(0),
+      m_Overflow(NULL)
+    { }
+
+    /* move constructor, so DuskLog() can return a LogLine */
+    LogLine(LogLine&& op);
+
+    /* destructor - passes the line to the log */
+    ~LogLine()
+    {
+      if (m_Enabled)
+        commit();
+    }
+
+    template<typename MrT>
+    LogLine& operator<<(const MrT& n)
+    {
+      if (m_Enabled)
+      {
+        std::ostringstream stream;
+        stream << n;
+        append(stream.str());
+      }
+      return *this;
+    }
+
+    LogLine& operator<<(const char* c_str);
+    LogLine& operator<<(const std::string& str);
+    LogLine& operator<<(const char c);
+    LogLine& operator<<(const float f);
+    LogLine& operator<<(const double d);
+    LogLine& operator<<(const int i) { return appendSigned(i); }
+    LogLine& operator<<(const long int i) { return appendSigned(i); }
+    LogLine& operator<<(const long long int i) { return appendSigned(i); }
+    LogLine& operator<<(const unsigned int u) { return appendUnsigned(u); }
+    LogLine& operator<<(const unsigned long int u) { return appendUnsigned(u); }
+    LogLine& operator<<(const unsigned long long int u) { return appendUnsigned(u); }
+  private:
+    /* no copies, a line is logged only once */
+    LogLine(const LogLine& op);
+
+    LogLine& appendSigned(const long long int i);
+    LogLine& appendUnsigned(const unsigned long long int u);
+    void append(const char* data, const unsigned int length);
+    void append(const std::string& str)
+    {
+      append(str.data(), str.length());
+    }
+    void commit();
+
+    LogLevel m_Level;
+    bool m_Enabled;
+    unsigned int m_Length;
+    std::string* m_Overflow; //used instead of m_Text for long lines
+    char m_Text[Messages::cRecordLength];
+};//class
 
 inline void DuskLog(const std::string& text)
 {
-  Messages::getSingleton().Log(text);
+  if (Messages::isEnabled(llInfo))
+    Messages::getSingleton().Log(text);
 }
 
-inline Messages& DuskLog()
+/* returns a line for the log, which can be filled by operator <<.
+   Plain DuskLog() logs at level llInfo. The arguments of the operators are
+   evaluated even if the level is filtered, so use DUSK_LOG() for lines below
+   llInfo, especially on per-frame paths.
+*/
+inline LogLine DuskLog(const LogLevel level = llInfo)
 {
-  return Messages::getSingleton();
+  return LogLine(level);
 }
 
 } //namespace
 
+/* like DuskLog(level), but the rest of the statement is not evaluated at all,
+   if the level is filtered at compile time or run time, e.g. in
+       DUSK_LOG(llDebug) << "position: " << expensiveToString(pos) << "\n";
+   The if-else form is safe within an if statement without braces.
+*/
+#define DUSK_LOG(level) \
+  if (!Dusk::Messages::isEnabled(level)) ; \
+  else Dusk::LogLine(level)
+
 #endif // MESSAGES_H
@@ -31,6 +31,7 @@ ObjectManager::ObjectManager()
 {
   m_ReferenceMap.clear();
   m_RefCount = 0;
+  m_BaseReferences.clear();
 }
 
 ObjectManager::~ObjectManager()
@@ -122,19 +123,29 @@ bool ObjectManager::isObjectPresent(const std::string& ID) const
 bool ObjectManager::removeItemReference(Item* pItem)
 {
   if (pItem==NULL) return false;
+  return deleteReference(pItem);
+}
+
+bool ObjectManager::deleteReference(DuskObject* objPtr)
+{
   std::map<std::string, std::vector<DuskObject*> >::iterator iter;
-  iter = m_ReferenceMap.find(pItem->getID());
+  iter = m_ReferenceMap.find(objPtr->getID());
   if (iter!=m_ReferenceMap.end())
   {
     unsigned int i;
     for (i=0; i<iter->second.size(); ++i)
     {
-      if (iter->second.at(i)==pItem)
+      if (iter->second.at(i)==objPtr)
       {
         //found it
-        pItem->disable();
-        delete pItem;
-        pItem = NULL; //not really needed here
+        //references from data files are remembered as removed
+        if (objPtr->getBaseIndex()<m_BaseReferences.size())
+        {
+          m_BaseReferences[objPtr->getBaseIndex()] = NULL;
+        }
+        objPtr->disable();
+        delete objPtr;
+        objPtr = NULL; //not really needed here
         iter->second.at(i)= iter->second.at(iter->second.size()-1);
         iter->second.at(iter->second.size()-1) = NULL;
         iter->second.pop_back();
@@ -146,7 +157,7 @@ bool ObjectManager::removeItemReference(Item* pItem)
   return false;
 }
 
-bool ObjectManager::saveAllToStream(std::ofstream& Stream) const
+bool ObjectManager::saveAllToStream(BinaryWriter& Stream) const
 {
   unsigned int i;
   std::map<std::string, std::vector<DuskObject*> >::const_iterator iter;
@@ -169,66 +180,192 @@ bool ObjectManager::saveAllToStream(std::ofstream& Stream) const
   return true;
 }
 
-bool ObjectManager::loadNextFromStream(std::ifstream& Stream, const unsigned int PrefetchedHeader)
+bool ObjectManager::saveChangesToStream(BinaryWriter& Stream) const
+{
+  //write removed references from data files
+  Stream.writeUInt32(cHeaderRmvO);
+  uint32_t removed = 0;
+  unsigned int i;
+  for (i=0; i<m_BaseReferences.size(); ++i)
+  {
+    if (m_BaseReferences[i]==NULL) ++removed;
+  }//for
+  Stream.writeUInt32(removed);
+  for (i=0; i<m_BaseReferences.size(); ++i)
+  {
+    if (m_BaseReferences[i]==NULL) Stream.writeUInt32(i);
+  }//for
+  //write modified and new references
+  std::map<std::string, std::vector<DuskObject*> >::const_iterator iter;
+  iter = m_ReferenceMap.begin();
+  while (iter!=m_ReferenceMap.end())
+  {
+    for (i=0; i<iter->second.size(); i++)
+    {
+      const DuskObject* objPtr = iter->second.at(i);
+      if (objPtr!=NULL)
+      {
+        if (objPtr->getBaseIndex()!=cNoBaseIndex)
+        {
+          //unchanged references will be loaded from the data file anyway
+          if (!objPtr->isModified()) continue;
+          Stream.writeUInt32(cHeaderBIdx);
+          Stream.writeUInt32(objPtr->getBaseIndex());
+        }
+        if (!(objPtr->saveToStream(Stream)) or (!Stream.good()))
+        {
+          DuskLog() << "ObjectManager::saveChangesToStream: ERROR while writing reference data.\n";
+          return false;
+        }
+      }//if
+    }//for
+    ++iter;
+  }//while
+  return Stream.good();
+}
+
+unsigned int ObjectManager::getNumberOfChangedRecords() const
+{
+  //one record for the list of removed references...
+  unsigned int result = 1;
+  //...and one for every modified or new reference
+  unsigned int i;
+  std::map<std::string, std::vector<DuskObject*> >::const_iterator iter;
+  iter = m_ReferenceMap.begin();
+  while (iter!=m_ReferenceMap.end())
+  {
+    for (i=0; i<iter->second.size(); i++)
+    {
+      const DuskObject* objPtr = iter->second.at(i);
+      if (objPtr!=NULL)
+      {
+        if (objPtr->getBaseIndex()==cNoBaseIndex or objPtr->isModified())
+          ++result;
+      }
+    }//for
+    ++iter;
+  }//while
+  return result;
+}
+
+DuskObject* ObjectManager::createReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader)
 {
   DuskObject * objPtr = NULL;
   switch(PrefetchedHeader)
   {
     case cHeaderRefO:
          objPtr = new DuskObject;
-         if (objPtr->loadFromStream(Stream))
-         {
-           m_ReferenceMap[objPtr->getID()].push_back(objPtr);
-           ++m_RefCount;
-           return true;
-         }
-         delete objPtr;
          break;
     case cHeaderRefL:
          objPtr = new Light;
-         if (objPtr->loadFromStream(Stream))
-         {
-           m_ReferenceMap[objPtr->getID()].push_back(objPtr);
-           ++m_RefCount;
-           return true;
-         }
-         delete objPtr;
          break;
     case cHeaderRefC:
          objPtr = new Container;
-         if (objPtr->loadFromStream(Stream))
-         {
-           m_ReferenceMap[objPtr->getID()].push_back(objPtr);
-           ++m_RefCount;
-           return true;
-         }
-         delete objPtr;
          break;
     case cHeaderRefI:
          objPtr = new Item;
-         if (objPtr->loadFromStream(Stream))
-         {
-           m_ReferenceMap[objPtr->getID()].push_back(objPtr);
-           ++m_RefCount;
-           return true;
-         }
-         delete objPtr;
          break;
     case cHeaderRfWe:
          objPtr = new Weapon;
-         if (objPtr->loadFromStream(Stream))
-         {
-           m_ReferenceMap[objPtr->getID()].push_back(objPtr);
-           ++m_RefCount;
-           return true;
-         }
-         delete objPtr;
          break;
     default:
-         DuskLog() << "ObjectManager::loadNextFromStream: ERROR: unexpected header.\n";
-         break;
+         DuskLog() << "ObjectManager::createReferenceFromStream: ERROR: unexpected header.\n";
+         return NULL;
   }//swi
-  return false;
+  if (objPtr->loadFromStream(Stream))
+  {
+    return objPtr;
+  }
+  delete objPtr;
+  return NULL;
+}
+
+bool ObjectManager::loadNextFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader)
+{
+  DuskObject * objPtr = createReferenceFromStream(Stream, PrefetchedHeader);
+  if (objPtr==NULL)
+  {
+    return false;
+  }
+  objPtr->setBaseIndex(m_BaseReferences.size());
+  objPtr->setModified(false);
+  m_BaseReferences.push_back(objPtr);
+  m_ReferenceMap[objPtr->getID()].push_back(objPtr);
+  ++m_RefCount;
+  return true;
+}
+
+bool ObjectManager::loadSavedReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader, const uint32_t baseIndex)
+{
+  if (baseIndex!=cNoBaseIndex and baseIndex>=m_BaseReferences.size())
+  {
+    DuskLog() << "ObjectManager::loadSavedReferenceFromStream: ERROR: base "
+              << "index "<<baseIndex<<" is out of range. The save game does "
+              << "not match the loaded data files.\n";
+    return false;
+  }
+  DuskObject * objPtr = createReferenceFromStream(Stream, PrefetchedHeader);
+  if (objPtr==NULL)
+  {
+    return false;
+  }
+  if (baseIndex!=cNoBaseIndex)
+  {
+    //replace the reference from the data file
+    if (m_BaseReferences[baseIndex]!=NULL)
+    {
+      deleteReference(m_BaseReferences[baseIndex]);
+    }
+    m_BaseReferences[baseIndex] = objPtr;
+  }
+  objPtr->setBaseIndex(baseIndex);
+  //keep it marked, so that it gets into the next save game, too
+  objPtr->setModified(true);
+  m_ReferenceMap[objPtr->getID()].push_back(objPtr);
+  ++m_RefCount;
+  return true;
+}
+
+bool ObjectManager::loadRemovedReferencesFromStream(BinaryReader& Stream)
+{
+  uint32_t count = 0;
+  if (!Stream.readUInt32(count) or count!=cHeaderRmvO)
+  {
+    DuskLog() << "ObjectManager::loadRemovedReferencesFromStream: ERROR: "
+              << "stream contains unexpected header!\n";
+    return false;
+  }
+  if (!Stream.readUInt32(count) or count>m_BaseReferences.size())
+  {
+    DuskLog() << "ObjectManager::loadRemovedReferencesFromStream: ERROR: "
+              << "invalid number of removed references.\n";
+    return false;
+  }
+  uint32_t idx = 0;
+  unsigned int i;
+  for (i=0; i<count; ++i)
+  {
+    if (!Stream.readUInt32(idx) or idx>=m_BaseReferences.size())
+    {
+      DuskLog() << "ObjectManager::loadRemovedReferencesFromStream: ERROR: "
+                << "invalid base index. The save game does not match the "
+                << "loaded data files.\n";
+      return false;
+    }
+    if (m_BaseReferences[idx]!=NULL)
+    {
+      deleteReference(m_BaseReferences[idx]);
+    }
+  }//for
+  return true;
+}
+
+void ObjectManager::removeAllReferences()
+{
+  //clearData() would forget the base references, so keep their number
+  const unsigned int baseCount = m_BaseReferences.size();
+  clearData();
+  m_BaseReferences.resize(baseCount, NULL);
 }
 
 void ObjectManager::enableAllObjects(Ogre::SceneManager * scm)
@@ -288,6 +425,10 @@ unsigned int ObjectManager::deleteReferencesOfObject(const std::string& ID)
   {
     if (iter->second.at(i)!=NULL)
     {
+      if (iter->second.at(i)->getBaseIndex()<m_BaseReferences.size())
+      {
+        m_BaseReferences[iter->second.at(i)->getBaseIndex()] = NULL;
+      }
       delete (iter->second.at(i));
       iter->second.at(i) = NULL;
       ++deletedReferences;
@@ -420,6 +561,7 @@ void ObjectManager::clearData()
   }//while
   m_ReferenceMap.clear();
   m_RefCount = 0;
+  m_BaseReferences.clear();
 }//clear data
 
 }//namespace
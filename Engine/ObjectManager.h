@@ -59,6 +59,9 @@
      - 2011-05-11 (rev 287) - renamed numberOfReferences() to getNumberOfReferences()
      - 2012-07-02 (rev 310) - update to use Database instead of ItemBase,
                               LightBase and ObjectBase
+     - 2026-10-19           - references from data files get a base index, and
+                              save games only contain removed, modified and
+                              new references via saveChangesToStream()
 
  ToDo list:
      - extend class when further classes for non-animated objects are added
@@ -79,7 +82,8 @@
 #include "objects/Weapon.h"
 #include <vector>
 #include <map>
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 
 namespace Dusk
 {
@@ -161,15 +165,65 @@ namespace Dusk
          parameters:
              Stream - the output stream that is used to save the object
       */
-      bool saveAllToStream(std::ofstream& Stream) const;
+      bool saveAllToStream(BinaryWriter& Stream) const;
 
       /* Tries to load the next object from stream and returns true on success
 
          parameters:
              Stream           - input stream that will be used to read the data
              PrefetchedHeader - the first four bytes of the record to come
+
+         remarks:
+             This function is meant for references from data files. The loaded
+             object gets the next free base index and is marked as unmodified.
+             Use loadSavedReferenceFromStream() for references in save games.
       */
-      bool loadNextFromStream(std::ifstream& Stream, const unsigned int PrefetchedHeader);
+      bool loadNextFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader);
+
+      /* Tries to save the removal record and all references that differ from
+         the data files, i.e. modified and newly created ones, to the stream.
+         Returns true on success.
+
+         parameters:
+             Stream - the output stream that is used to save the references
+
+         remarks:
+             Modified references are preceded by a "BIdx" record that holds
+             their base index, so that they can replace the reference from the
+             data file during loading.
+      */
+      bool saveChangesToStream(BinaryWriter& Stream) const;
+
+      /* returns the number of records saveChangesToStream() would write */
+      unsigned int getNumberOfChangedRecords() const;
+
+      /* Tries to load the next reference from a save game and returns true on
+         success.
+
+         parameters:
+             Stream           - input stream that will be used to read the data
+             PrefetchedHeader - the first four bytes of the record to come
+             baseIndex        - base index of the reference from the data files
+                                that shall be replaced by the loaded reference,
+                                or cNoBaseIndex for references that were created
+                                during the game
+      */
+      bool loadSavedReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader, const uint32_t baseIndex);
+
+      /* Tries to load the list of removed references (as written by
+         saveChangesToStream()) from the stream and removes those references.
+         Returns true on success.
+
+         parameters:
+             Stream - input stream that will be used to read the data
+      */
+      bool loadRemovedReferencesFromStream(BinaryReader& Stream);
+
+      /* deletes all objects, but (unlike clearData()) keeps track of the
+         references from data files as removed ones, so that the next save game
+         still contains the complete set of references
+      */
+      void removeAllReferences();
 
       /* Tries to enable all objects, i.e. display them in the scene
 
@@ -220,8 +274,21 @@ namespace Dusk
       /* empty copy constructor (singleton pattern) */
       ObjectManager(const ObjectManager& op){}
       //std::vector<DuskObject*> m_ReferenceList;
+      /* creates an object of the type indicated by header and loads its data
+         from the stream. Returns NULL on failure.
+      */
+      static DuskObject* createReferenceFromStream(BinaryReader& Stream, const unsigned int PrefetchedHeader);
+
+      /* removes the object from the reference map and deletes it. Returns true
+         on success, i.e. if the object was found.
+      */
+      bool deleteReference(DuskObject* objPtr);
+
       std::map<std::string, std::vector<DuskObject*> > m_ReferenceMap;
       unsigned int m_RefCount;
+      /* references from data files, indexed by their base index; entries of
+         removed references are NULL */
+      std::vector<DuskObject*> m_BaseReferences;
   };//class
 
 }//namespace
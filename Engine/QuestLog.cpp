@@ -212,7 +212,7 @@ unsigned int QuestLog::getNumberOfQuestEntries() const
   return m_TimeLine.size();
 }
 
-bool QuestLog::saveToStream(std::ofstream& output) const
+bool QuestLog::saveToStream(BinaryWriter& output) const
 {
   if (!(output.good()))
   {
@@ -220,77 +220,62 @@ bool QuestLog::saveToStream(std::ofstream& output) const
     return false;
   }
   //write herader
-  output.write((char*) &cHeaderQLog, sizeof(cHeaderQLog));
+  output.writeUInt32(cHeaderQLog);
   //write length
-  unsigned int len = 0;
-  len = m_TimeLine.size();
-  output.write((char*) &len, sizeof(unsigned int));
+  output.writeUInt32(m_TimeLine.size());
   unsigned int i;
   //write data
   for (i=0; i<m_TimeLine.size(); i=i+1)
   {
     //write questID
-    len = m_TimeLine[i].questID.length();
-    output.write((char*) &len, sizeof(unsigned int));
-    output.write(m_TimeLine[i].questID.c_str(), len);
+    output.writeString(m_TimeLine[i].questID);
     //write index
-    output.write((char*) &(m_TimeLine[i].index), sizeof(unsigned int));
-    if (!(output.good()))
-    {
-      DuskLog() << "QuestLog::saveToStream: ERROR while writing entries!\n";
-      return false;
-    }
+    output.writeUInt32(m_TimeLine[i].index);
   }//for
-  return output.good();
+  if (!(output.good()))
+  {
+    DuskLog() << "QuestLog::saveToStream: ERROR while writing entries!\n";
+    return false;
+  }
+  return true;
 }
 
-bool QuestLog::loadFromStream(std::ifstream& input)
+bool QuestLog::loadFromStream(BinaryReader& input)
 {
   if (!(input.good()))
   {
     DuskLog() << "QuestLog::loadFromStream: ERROR: bad stream!\n";
     return false;
   }
-  unsigned int len = 0;
+  uint32_t len = 0;
   //read header
-  input.read((char*) &len, sizeof(unsigned int));
+  input.readUInt32(len);
   if (len!=cHeaderQLog)
   {
     DuskLog() << "QuestLog::loadFromStream: ERROR: invalid record header!\n";
     return false;
   }
-  unsigned int count = 0;
-  input.read((char*) &count, sizeof(unsigned int));
+  uint32_t count = 0;
+  input.readUInt32(count);
   unsigned int i;
-  char buffer[256];
+  std::string questID;
   for (i=0; i<count; i=i+1)
   {
-    //read string length
-    len = 0;
-    input.read((char*) &len, sizeof(unsigned int));
-    if (len>255)
-    {
-      DuskLog() << "QuestLog::loadFromStream: ERROR: questID seems to be longer"
-                << " than 255 characters!\n";
-      return false;
-    }
-    buffer[0] = '\0';
-    input.read(buffer, len);
-    buffer[len] = '\0';
-    if (!(input.good()))
+    //read questID
+    if (!input.readString(questID))
     {
-      DuskLog() << "QuestLog::loadFromStream: ERROR while reading questID!\n";
+      DuskLog() << "QuestLog::loadFromStream: ERROR while reading questID! "
+                << "(It must not be longer than 255 characters.)\n";
       return false;
     }
     //read index
-    input.read((char*) &len, sizeof(unsigned int));
-    if (!(input.good()))
+    if (!input.readUInt32(len))
     {
       DuskLog() << "QuestLog::loadFromStream: ERROR while reading quest index!\n";
       return false;
     }
     //add it
-    addQuestEntry(std::string(buffer), len);
+    addQuestEntry(questID, len);
   }//for
   return input.good();
 }
@@ -43,7 +43,8 @@
 #ifndef QUESTLOG_H
 #define QUESTLOG_H
 
-#include <fstream>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include <map>
 #include <string>
 #include <vector>
@@ -126,7 +127,7 @@ namespace Dusk
          parameters:
              output - the output stream that is used to save the quest log
       */
-      bool saveToStream(std::ofstream& output) const;
+      bool saveToStream(BinaryWriter& output) const;
 
       /* tries to load all data from stream and returns true on success, false
          otherwise
@@ -134,7 +135,7 @@ namespace Dusk
          parameters:
              input - the input stream that is used to load the quest log
       */
-      bool loadFromStream(std::ifstream& input);
+      bool loadFromStream(BinaryReader& input);
     private:
       /* constructor - private due to singleton pattern */
       QuestLog();
@@ -0,0 +1,137 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: SPSCQueue class template
+          lock-free queue with a fixed capacity for exactly one producer
+          thread and one consumer thread
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_SPSCQUEUE_H
+#define DUSK_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Dusk
+{
+
+/*class SPSCQueue:
+        ring buffer for passing items from one thread (the producer, which
+        calls push()) to another thread (the consumer, which calls pop())
+        without locks. Neither push() nor pop() ever block; push() fails if the
+        queue is full, pop() fails if it is empty.
+        Using more than one producer or more than one consumer thread is not
+        allowed.
+*/
+template<typename T>
+class SPSCQueue
+{
+  public:
+    /* constructor
+
+       parameters:
+           capacity - maximum number of items in the queue, will be rounded up
+                      to the next power of two
+    */
+    SPSCQueue(const std::size_t capacity)
+    : m_Items(std::vector<T>()),
+      m_Mask(0),
+      m_Head(0),
+      m_Tail(0)
+    {
+      std::size_t size = 2;
+      while (size<capacity)
+      {
+        size = size*2;
+      }
+      m_Items.resize(size);
+      m_Mask = size-1;
+    }
+
+    /* returns the maximum number of items in the queue */
+    std::size_t capacity() const
+    {
+      return m_Items.size();
+    }
+
+    /* Appends a copy of item to the queue and returns true, or returns false,
+       if the queue is full. May only be called by the producer thread.
+    */
+    bool push(const T& item)
+    {
+      const std::size_t tail = m_Tail.load(std::memory_order_relaxed);
+      if (tail-m_Head.load(std::memory_order_acquire)==m_Items.size())
+      {
+        return false;
+      }
+      m_Items[tail & m_Mask] = item;
+      m_Tail.store(tail+1, std::memory_order_release);
+      return true;
+    }
+
+    /* Moves the oldest item of the queue into item and returns true, or
+       returns false, if the queue is empty. May only be called by the consumer
+       thread.
+    */
+    bool pop(T& item)
+    {
+      const std::size_t head = m_Head.load(std::memory_order_relaxed);
+      if (head==m_Tail.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+      //moving leaves no references (e.g. shared pointers) in the slot
+      item = std::move(m_Items[head & m_Mask]);
+      m_Head.store(head+1, std::memory_order_release);
+      return true;
+    }
+
+    /* returns true, if the queue is empty (exact for the consumer thread only) */
+    bool empty() const
+    {
+      return m_Head.load(std::memory_order_acquire)==m_Tail.load(std::memory_order_acquire);
+    }
+  private:
+    /* private copy constructor - queues cannot be copied */
+    SPSCQueue(const SPSCQueue& op) {}
+
+    std::vector<T> m_Items;
+    std::size_t m_Mask;
+    std::atomic<std::size_t> m_Head; //index of next item to pop, written by consumer
+    std::atomic<std::size_t> m_Tail; //index of next free slot, written by producer
+}; //class
+
+} //namespace
+
+#endif // DUSK_SPSCQUEUE_H
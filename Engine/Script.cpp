@@ -77,6 +77,36 @@ std::vector<std::string> Script::explodeCommands() const
     return pieces;
 }
 
+const std::vector<CommandLine>& Script::getCommandLines() const
+{
+    if (m_CommandLines.get() == NULL)
+    {
+        std::shared_ptr<std::vector<CommandLine> > lines(new std::vector<CommandLine>());
+        const std::vector<std::string> commands = explodeCommands();
+        lines->reserve(commands.size());
+        std::vector<std::string>::const_iterator it;
+        for (it = commands.begin(); it != commands.end(); ++it)
+        {
+            if (it->empty())
+                continue;
+            //divide command into words, every space starts a new word
+            CommandLine words;
+            std::string::size_type start = 0;
+            std::string::size_type space = it->find(' ');
+            while (space != std::string::npos)
+            {
+                words.push_back(it->substr(start, space - start));
+                start = space + 1;
+                space = it->find(' ', start);
+            }
+            words.push_back(it->substr(start));
+            lines->push_back(words);
+        }
+        m_CommandLines = lines;
+    }
+    return *m_CommandLines;
+}
+
 Script Script::getStartScript() const
 {
     return Script(std::string("start {") + m_string + std::string("}"));
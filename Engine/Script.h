@@ -35,6 +35,8 @@
      - 2010-02-08 (rev 168) - trim() moved to DuskFunctions.h, because this is
                               not dependant on Script class
      - 2010-11-10 (rev 250) - minor optimizations
+     - 2026-10-19           - getCommandLines() added, caches the tokenized
+                              commands
 
  ToDo list:
      - ???
@@ -46,11 +48,15 @@
 #ifndef SCRIPT_H_INCLUDED
 #define SCRIPT_H_INCLUDED
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace Dusk
 {
+    /* a single command of a script, split into its words */
+    typedef std::vector<std::string> CommandLine;
+
     /**
      * This class represents a script which will be processed
      * by the console to create one or multiple commands.
@@ -78,6 +84,17 @@ namespace Dusk
          */
         std::vector<std::string> explodeCommands() const;
 
+        /**
+         * Returns the commands of the script (see explodeCommands()), each one
+         * split at spaces into the command name and its parameters.
+         *
+         * @return  the tokenized commands
+         * @remarks The result is computed on the first call only and is shared
+         *          with all copies of the Script made after that call, so e.g.
+         *          the scripts of key bindings are only parsed once.
+         */
+        const std::vector<CommandLine>& getCommandLines() const;
+
         /**
          * Returns a copy of the Script with a start command
          *
@@ -103,6 +120,11 @@ namespace Dusk
          * Holds the string representation of the script.
          */
         std::string m_string;
+
+        /**
+         * Holds the tokenized commands, NULL until getCommandLines() is called.
+         */
+        mutable std::shared_ptr<const std::vector<CommandLine> > m_CommandLines;
     };
 }
 #endif // SCRIPT_H_INCLUDED
@@ -0,0 +1,331 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "SectionLoader.h"
+#include <functional>
+#include <new>
+#include "BinaryReader.h"
+#include "DataLoader.h"
+#include "DuskConstants.h"
+#include "Landscape.h"
+#include "Messages.h"
+#include "ThreadPool.h"
+#include "database/Database.h"
+
+namespace Dusk
+{
+
+SectionJob::SectionJob(const uint32_t kind, const CompressionMethod compression, const char* data, const uint32_t size)
+: m_Kind(kind),
+  m_Compression(compression),
+  m_Data(data),
+  m_Size(size),
+  m_Success(false),
+  m_Records(0),
+  m_DatabaseRecords(),
+  m_DialogueRecords(),
+  m_Quests(),
+  m_LandscapeRecords(),
+  m_Uncompressed()
+{
+}
+
+SectionJob::~SectionJob()
+{
+  unsigned int i;
+  for (i=0; i<m_DatabaseRecords.size(); ++i)
+  {
+    delete m_DatabaseRecords[i];
+  }//for
+  m_DatabaseRecords.clear();
+  for (i=0; i<m_LandscapeRecords.size(); ++i)
+  {
+    delete m_LandscapeRecords[i];
+  }//for
+  m_LandscapeRecords.clear();
+}
+
+void SectionJob::run()
+{
+  //run() is executed by a pool thread, so nothing may escape from here
+  try
+  {
+    readSection();
+  }
+  catch (std::bad_alloc& e)
+  {
+    DuskLog() << "SectionJob::run: ERROR: out of memory while reading "
+              << "section, it's probably corrupted.\n";
+    m_Success = false;
+  }
+  catch (std::exception& e)
+  {
+    DuskLog() << "SectionJob::run: ERROR while reading section: "
+              << e.what() << "\n";
+    m_Success = false;
+  }
+}
+
+void SectionJob::readSection()
+{
+  if (m_Compression!=cmNone)
+  {
+    //decompress here, so decompression happens on the worker thread, too
+    BinaryReader sizeReader(m_Data, m_Size);
+    uint32_t plainSize = 0;
+    if (!sizeReader.readUInt32(plainSize)
+        or !decompressBlock(m_Data+4, m_Size-4, m_Compression, plainSize, m_Uncompressed))
+    {
+      DuskLog() << "SectionJob::run: ERROR: could not decompress section.\n";
+      m_Success = false;
+      return;
+    }
+    m_Data = m_Uncompressed.empty() ? NULL : &m_Uncompressed[0];
+    m_Size = m_Uncompressed.size();
+    m_Compression = cmNone;
+  }
+  BinaryReader input(m_Data, m_Size);
+  uint32_t Header = 0;
+  DataRecord* dataRec = NULL;
+  LandscapeRecord* landRec = NULL;
+  m_Success = true;
+  m_Records = 0;
+  while (m_Success and !input.atEnd())
+  {
+    switch (m_Kind)
+    {
+      case DATABASE_BIT:
+           input.peekUInt32(Header);
+           dataRec = Database::readRecordFromStream(input, Header);
+           if (dataRec!=NULL)
+           {
+             m_DatabaseRecords.push_back(dataRec);
+           }
+           else m_Success = false;
+           break;
+      case DIALOGUE_BIT:
+           m_DialogueRecords.push_back(Dialogue::StagedRecord());
+           m_Success = Dialogue::readNextRecordFromStream(input, m_DialogueRecords.back());
+           break;
+      case JOURNAL_BIT:
+           m_Quests.push_back(Journal::StagedQuest());
+           m_Success = Journal::readNextFromStream(input, m_Quests.back());
+           break;
+      case LANDSCAPE_BIT:
+           landRec = new LandscapeRecord;
+           if (landRec->loadFromStream(input))
+           {
+             m_LandscapeRecords.push_back(landRec);
+           }
+           else
+           {
+             delete landRec;
+             m_Success = false;
+           }
+           break;
+      default:
+           DuskLog() << "SectionJob::run: ERROR: unknown section kind "
+                     << m_Kind << ".\n";
+           m_Success = false;
+           break;
+    }//switch
+    m_Success = m_Success and input.good();
+    if (m_Success)
+    {
+      ++m_Records;
+    }
+    else
+    {
+      DuskLog() << "SectionJob::run: ERROR while reading record "<<m_Records
+                << " of section at position " << input.tell() << ".\n";
+    }
+  }//while
+}
+
+bool SectionJob::succeeded() const
+{
+  return m_Success;
+}
+
+unsigned int SectionJob::getNumberOfRecords() const
+{
+  return m_Records;
+}
+
+void SectionJob::commit()
+{
+  unsigned int i;
+  for (i=0; i<m_DatabaseRecords.size(); ++i)
+  {
+    Database::getSingleton().addRecord(m_DatabaseRecords[i]);
+  }//for
+  m_DatabaseRecords.clear();
+  for (i=0; i<m_DialogueRecords.size(); ++i)
+  {
+    Dialogue::getSingleton().addStagedRecord(m_DialogueRecords[i]);
+  }//for
+  m_DialogueRecords.clear();
+  for (i=0; i<m_Quests.size(); ++i)
+  {
+    Journal::getSingleton().addStagedQuest(m_Quests[i]);
+  }//for
+  m_Quests.clear();
+  for (i=0; i<m_LandscapeRecords.size(); ++i)
+  {
+    Landscape::getSingleton().addRecord(m_LandscapeRecords[i]);
+  }//for
+  m_LandscapeRecords.clear();
+}
+
+/* **** SectionLoader functions **** */
+
+SectionLoader::SectionLoader()
+: m_Pool(NULL),
+  m_Jobs()
+{
+}
+
+SectionLoader::~SectionLoader()
+{
+  //deleting the pool waits for all jobs that are still queued or running
+  delete m_Pool;
+  m_Pool = NULL;
+  clearJobs();
+}
+
+bool SectionLoader::hasPendingSections() const
+{
+  return !m_Jobs.empty();
+}
+
+bool SectionLoader::startSection(const uint32_t kind, const char* data, const uint32_t size)
+{
+  const uint32_t compression = kind >> cSectionCompressionShift;
+  if (!isValidCompressionMethod(compression))
+  {
+    DuskLog() << "SectionLoader::startSection: ERROR: unknown compression "
+              << "method " << compression << ".\n";
+    return false;
+  }
+  switch (kind & cSectionKindMask)
+  {
+    case DATABASE_BIT:
+    case DIALOGUE_BIT:
+    case JOURNAL_BIT:
+    case LANDSCAPE_BIT:
+         break;
+    default:
+         DuskLog() << "SectionLoader::startSection: ERROR: sections of kind "
+                   << kind << " are not supported.\n";
+         return false;
+  }//switch
+  if (m_Pool==NULL)
+  {
+    //one thread per section kind is enough
+    unsigned int threads = std::thread::hardware_concurrency();
+    if ((threads==0) or (threads>4)) threads = 4;
+    m_Pool = new ThreadPool(threads);
+  }
+  SectionJob* job = new SectionJob(kind & cSectionKindMask,
+                      static_cast<CompressionMethod>(compression), data, size);
+  m_Jobs.push_back(job);
+  m_Pool->enqueue(std::bind(&SectionJob::run, job));
+  return true;
+}
+
+bool SectionLoader::finishSections(uint32_t& records_done)
+{
+  if (m_Jobs.empty()) return true;
+  m_Pool->waitForAll();
+  unsigned int i;
+  for (i=0; i<m_Jobs.size(); ++i)
+  {
+    if (!m_Jobs[i]->succeeded())
+    {
+      DuskLog() << "SectionLoader::finishSections: ERROR: section "<<i
+                << " could not be read.\n";
+      clearJobs();
+      return false;
+    }
+  }//for
+  //commit in file order, so that later records replace earlier ones as usual
+  for (i=0; i<m_Jobs.size(); ++i)
+  {
+    m_Jobs[i]->commit();
+    records_done += m_Jobs[i]->getNumberOfRecords();
+  }//for
+  clearJobs();
+  return true;
+}
+
+std::size_t SectionLoader::beginSection(BinaryWriter& output, const uint32_t kind,
+                                        const CompressionMethod compression)
+{
+  output.writeUInt32(cHeaderSect);
+  output.writeUInt32(kind | (static_cast<uint32_t>(compression) << cSectionCompressionShift));
+  const std::size_t pos = output.size();
+  //size is not known yet, endSection() will set it
+  output.writeUInt32(0);
+  return pos;
+}
+
+bool SectionLoader::endSection(BinaryWriter& output, const std::size_t pos)
+{
+  //get the kind that was written by beginSection()
+  uint32_t kind = 0;
+  BinaryReader kindReader(output.data()+pos-4, 4);
+  kindReader.readUInt32(kind);
+  const CompressionMethod compression = static_cast<CompressionMethod>(kind >> cSectionCompressionShift);
+  const std::size_t plainSize = output.size()-pos-4;
+  if (compression!=cmNone and plainSize>0)
+  {
+    std::vector<char> compressed;
+    if (!compressBlock(output.data()+pos+4, plainSize, compression, compressed))
+    {
+      DuskLog() << "SectionLoader::endSection: ERROR: could not compress section.\n";
+      return false;
+    }
+    if (compressed.size()+4<plainSize)
+    {
+      //replace the records by their compressed version
+      output.truncate(pos+4);
+      output.writeUInt32(plainSize);
+      output.write(&compressed[0], compressed.size());
+      output.patchUInt32(pos, compressed.size()+4);
+      return output.good();
+    }
+  }
+  //store section uncompressed
+  output.patchUInt32(pos-4, kind & cSectionKindMask);
+  return output.patchUInt32(pos, plainSize);
+}
+
+void SectionLoader::clearJobs()
+{
+  unsigned int i;
+  for (i=0; i<m_Jobs.size(); ++i)
+  {
+    delete m_Jobs[i];
+  }//for
+  m_Jobs.clear();
+}
+
+} //namespace
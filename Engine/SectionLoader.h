@@ -0,0 +1,202 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: SectionJob and SectionLoader classes
+          parse sections of independent records (database, dialogue, journal
+          and landscape) of a data file on worker threads
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+     - 2026-10-19 - SectionJob::run() catches allocation failures
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_SECTIONLOADER_H
+#define DUSK_SECTIONLOADER_H
+
+#include <stdint.h>
+#include <vector>
+#include "BinaryWriter.h"
+#include "Compression.h"
+#include "Dialogue.h"
+#include "Journal.h"
+
+namespace Dusk
+{
+
+/* The lower 24 bits of a section's kind hold the kind of its records, the
+   upper eight bits hold the CompressionMethod of the section. Compressed
+   sections start with the uncompressed size as 32 bit integer, followed by the
+   compressed records.
+*/
+const uint32_t cSectionKindMask = 0x00FFFFFF;
+const unsigned int cSectionCompressionShift = 24;
+
+//forward declarations
+struct DataRecord;
+class LandscapeRecord;
+class ThreadPool;
+
+/*class SectionJob:
+        holds the data of one section of a data file. run() reads all records
+        of the section into the staging containers without touching any of the
+        singleton classes, so it can be called by a worker thread. commit()
+        moves the staged records into Database, Dialogue, Journal or Landscape
+        and must only be called by the main thread.
+*/
+class SectionJob
+{
+  public:
+    /* constructor
+
+       parameters:
+           kind        - kind of records in this section, i.e. DATABASE_BIT,
+                         DIALOGUE_BIT, JOURNAL_BIT or LANDSCAPE_BIT
+           compression - compression method of the section's data
+           data        - pointer to the first byte of the section's data (must
+                         stay valid until the job has finished)
+           size        - size of the section's data in bytes
+    */
+    SectionJob(const uint32_t kind, const CompressionMethod compression, const char* data, const uint32_t size);
+
+    /* destructor - deletes all records that have not been committed */
+    ~SectionJob();
+
+    /* decompresses the section, if necessary, and reads all its records into
+       the staging containers. Errors, including failed allocations, are
+       logged and make succeeded() return false; run() does not throw.
+    */
+    void run();
+
+    /* returns true, if all records were read successfully by run() */
+    bool succeeded() const;
+
+    /* returns the number of records that have been read by run() */
+    unsigned int getNumberOfRecords() const;
+
+    /* adds all staged records to the corresponding singleton classes */
+    void commit();
+  private:
+    /* private copy constructor - jobs own their staged records */
+    SectionJob(const SectionJob& op) {}
+
+    /* does the actual work of run() */
+    void readSection();
+
+    uint32_t m_Kind;
+    CompressionMethod m_Compression;
+    const char* m_Data;
+    uint32_t m_Size;
+    bool m_Success;
+    unsigned int m_Records;
+    std::vector<DataRecord*> m_DatabaseRecords;
+    std::vector<Dialogue::StagedRecord> m_DialogueRecords;
+    std::vector<Journal::StagedQuest> m_Quests;
+    std::vector<LandscapeRecord*> m_LandscapeRecords;
+    std::vector<char> m_Uncompressed;
+}; //class SectionJob
+
+
+/*class SectionLoader:
+        starts one SectionJob per section on a thread pool and commits the
+        results in the order the sections appeared in the file. The destructor
+        waits for all jobs that are still running, so a SectionLoader must be
+        destroyed before the data its jobs read from.
+*/
+class SectionLoader
+{
+  public:
+    /* constructor */
+    SectionLoader();
+
+    /* destructor - waits for running jobs and discards uncommitted data */
+    ~SectionLoader();
+
+    /* returns true, if sections have been started, but are not finished yet */
+    bool hasPendingSections() const;
+
+    /* starts parsing a section on a worker thread. Returns false, if the kind
+       of the section is not one that can be parsed on its own.
+
+       parameters:
+           kind - kind of the section as read from the file, including the
+                  compression method (see cSectionKindMask)
+           data - pointer to the first byte of the section's data
+           size - size of the section's data in bytes
+    */
+    bool startSection(const uint32_t kind, const char* data, const uint32_t size);
+
+    /* waits until all started sections are parsed and commits them. Returns
+       true, if all sections were read successfully. If one section failed,
+       nothing is committed at all.
+
+       parameters:
+           records_done - will be increased by the number of committed records
+    */
+    bool finishSections(uint32_t& records_done);
+
+    /* writes the header of a new section to output and returns the position
+       that has to be passed to endSection() after the section's records are
+       written
+
+       parameters:
+           output      - the writer for the data file
+           kind        - kind of records in the section (see SectionJob)
+           compression - compression method that shall be used for the records
+    */
+    static std::size_t beginSection(BinaryWriter& output, const uint32_t kind,
+                                    const CompressionMethod compression = cmNone);
+
+    /* compresses the records of a section that was started by beginSection()
+       (if requested there) and sets the section's size. Returns true on
+       success.
+
+       parameters:
+           output - the writer for the data file
+           pos    - the value returned by beginSection()
+
+       remarks:
+           If compression does not make the section smaller, the section is
+           stored uncompressed.
+    */
+    static bool endSection(BinaryWriter& output, const std::size_t pos);
+  private:
+    /* private copy constructor - loaders cannot be copied */
+    SectionLoader(const SectionLoader& op) {}
+
+    /* deletes all jobs */
+    void clearJobs();
+
+    ThreadPool* m_Pool;
+    std::vector<SectionJob*> m_Jobs;
+}; //class SectionLoader
+
+} //namespace
+
+#endif // DUSK_SECTIONLOADER_H
@@ -100,6 +100,27 @@ void Settings::initialSettings()
   addSetting_uint("HealthVitalityFactor", 3);
   addSetting_uint("HealthLevelFactor", 2);
   addSetting_uint("CriticalDamageFactor", 2);
+  //compression of data files and save games (0 = none, 1 = zlib)
+  addSetting_uint("DataFileCompression", 1);
+  addSetting_uint("SaveGameCompression", 1);
+  //1 = render sound into a loopback device instead of the speakers
+  addSetting_uint("SoundLoopback", 0);
+  //milliseconds per frame for queued Lua scripts, and maximum time a script
+  // or a worker job may run without waiting
+  addSetting_uint("ScriptTimeBudget", 5);
+  addSetting_uint("ScriptRunawayLimit", 2000);
+  //animation level of detail: 1 = on, 0 = off; objects within the near
+  // distance are animated every frame, within the far distance every second
+  // frame, and every fourth frame otherwise
+  addSetting_uint("AnimationLOD", 1);
+  addSetting_uint("AnimationLODNear", 50);
+  addSetting_uint("AnimationLODFar", 150);
+  //animation instancing: 1 = objects with the same mesh that play the same
+  // looping animation in one of the phase buckets share their skeleton
+  addSetting_uint("AnimationInstancing", 0);
+  addSetting_uint("AnimationPhaseBuckets", 4);
+  //minimum level of log messages (0 = debug, 1 = info, 2 = warning, 3 = error)
+  addSetting_uint("LogLevel", 1);
   addSetting_string("ScreenshotPrefix", "Screenshot");
   addSetting_string("ScreenshotFormat", "PNG");
 }
@@ -46,6 +46,8 @@
      - 2010-12-04 (rev 268) - use DuskLog/Messages class for logging
      - 2011-01-26 (rev 277) - fixed handling of carriage return characters at
                               the end of lines in loadFromFile()
+     - 2026-10-19           - initial settings for compression of data files
+                              and save games added
 
  ToDo list:
      - ???
@@ -0,0 +1,160 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "SoundEmitterManager.h"
+#include "objects/DuskObject.h"
+#include "Messages.h"
+#include "sound/Sound.h"
+
+namespace Dusk
+{
+
+//the living instance, or NULL before construction and after destruction
+static SoundEmitterManager* s_EmitterInstance = NULL;
+
+SoundEmitterManager::SoundEmitterManager()
+{
+  s_EmitterInstance = this;
+}
+
+SoundEmitterManager::~SoundEmitterManager()
+{
+  m_Emitters.clear();
+  s_EmitterInstance = NULL;
+}
+
+SoundEmitterManager& SoundEmitterManager::getSingleton()
+{
+  static SoundEmitterManager Instance;
+  return Instance;
+}
+
+bool SoundEmitterManager::bind(const std::string& sourceIdentifier, const DuskObject* owner)
+{
+  if ((NULL==owner) or !Sound::get().isSourcePresent(sourceIdentifier))
+  {
+    DuskLog() << "SoundEmitterManager::bind: ERROR: there is no source named \""
+              << sourceIdentifier << "\" or no object was given.\n";
+    return false;
+  }
+  Emitter& e = m_Emitters[sourceIdentifier];
+  e.owner = owner;
+  e.lastPosition = owner->getPosition();
+  e.lastVelocity = Ogre::Vector3::ZERO;
+  e.pending = true;
+  return true;
+}
+
+bool SoundEmitterManager::unbind(const std::string& sourceIdentifier)
+{
+  return m_Emitters.erase(sourceIdentifier)!=0;
+}
+
+unsigned int SoundEmitterManager::unbindOwner(const DuskObject* owner)
+{
+  unsigned int removed = 0;
+  std::map<std::string, Emitter>::iterator iter = m_Emitters.begin();
+  while (iter!=m_Emitters.end())
+  {
+    if (iter->second.owner==owner)
+    {
+      m_Emitters.erase(iter++);
+      ++removed;
+    }
+    else
+    {
+      ++iter;
+    }
+  }//while
+  return removed;
+}
+
+bool SoundEmitterManager::isBound(const std::string& sourceIdentifier) const
+{
+  return m_Emitters.find(sourceIdentifier)!=m_Emitters.end();
+}
+
+const DuskObject* SoundEmitterManager::getOwner(const std::string& sourceIdentifier) const
+{
+  const std::map<std::string, Emitter>::const_iterator iter = m_Emitters.find(sourceIdentifier);
+  if (iter!=m_Emitters.end())
+    return iter->second.owner;
+  return NULL;
+}
+
+unsigned int SoundEmitterManager::getNumberOfBindings() const
+{
+  return m_Emitters.size();
+}
+
+void SoundEmitterManager::clearData()
+{
+  m_Emitters.clear();
+}
+
+void SoundEmitterManager::update(const float SecondsPassed)
+{
+  Sound& snd = Sound::get();
+  std::map<std::string, Emitter>::iterator iter = m_Emitters.begin();
+  while (iter!=m_Emitters.end())
+  {
+    Emitter& e = iter->second;
+    const Ogre::Vector3& pos = e.owner->getPosition();
+    //skip owners that did not move and whose sources are already at rest
+    if (!e.pending and (pos==e.lastPosition) and (e.lastVelocity==Ogre::Vector3::ZERO))
+    {
+      ++iter;
+      continue;
+    }
+    if (!snd.isSourcePresent(iter->first))
+    {
+      //source was destroyed in the meantime
+      m_Emitters.erase(iter++);
+      continue;
+    }
+    Ogre::Vector3 velocity = Ogre::Vector3::ZERO;
+    if (!e.pending and (SecondsPassed>0.0f))
+    {
+      velocity = (pos-e.lastPosition)/SecondsPassed;
+    }
+    //The setters only mark the values as changed. Sound::update() sends all
+    //changes of the frame to the audio thread at once.
+    Source& src = snd.getSource(iter->first);
+    src.setPosition(pos.x, pos.y, pos.z);
+    if (e.pending or (velocity!=e.lastVelocity))
+    {
+      src.setVelocity(velocity.x, velocity.y, velocity.z);
+    }
+    e.lastPosition = pos;
+    e.lastVelocity = velocity;
+    e.pending = false;
+    ++iter;
+  }//while
+}
+
+void SoundEmitterManager::ownerDestroyed(const DuskObject* owner)
+{
+  if ((s_EmitterInstance!=NULL) and !s_EmitterInstance->m_Emitters.empty())
+  {
+    s_EmitterInstance->unbindOwner(owner);
+  }
+}
+
+} //namespace
@@ -0,0 +1,142 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: SoundEmitterManager Singleton class
+          binds sound sources to objects, so that the sources follow the
+          position of their owners automatically
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_SOUNDEMITTERMANAGER_H
+#define DUSK_SOUNDEMITTERMANAGER_H
+
+#include <map>
+#include <string>
+#include <OgreVector3.h>
+
+namespace Dusk
+{
+
+class DuskObject; //forward declaration
+
+/*class SoundEmitterManager:
+        holds the bindings between sound sources and their owners (objects in
+        the game). update() is called once per frame after the objects have
+        been moved, and passes the new positions and velocities of all bound
+        sources to the sound system in one go. Sources whose owners did not
+        move since the last frame are skipped.
+*/
+class SoundEmitterManager
+{
+  public:
+    /* destructor */
+    ~SoundEmitterManager();
+
+    /* singleton access method */
+    static SoundEmitterManager& getSingleton();
+
+    /* binds the source named sourceIdentifier to the object owner, i.e. the
+       source will be moved along with the object. Returns true on success.
+
+       parameters:
+           sourceIdentifier - name of the source
+           owner            - the object that emits the sound
+
+       remarks:
+           A source can only have one owner. If the source is already bound to
+           another object, the old binding is replaced. An object can own any
+           number of sources, though.
+    */
+    bool bind(const std::string& sourceIdentifier, const DuskObject* owner);
+
+    /* removes the binding of the source named sourceIdentifier and returns
+       true, if there was such a binding. The source keeps its last position.
+    */
+    bool unbind(const std::string& sourceIdentifier);
+
+    /* removes all bindings of sources to the given object and returns the
+       number of removed bindings
+    */
+    unsigned int unbindOwner(const DuskObject* owner);
+
+    /* returns true, if the source named sourceIdentifier is bound to an object */
+    bool isBound(const std::string& sourceIdentifier) const;
+
+    /* returns the object the source named sourceIdentifier is bound to, or
+       NULL, if the source is not bound
+    */
+    const DuskObject* getOwner(const std::string& sourceIdentifier) const;
+
+    /* returns the number of bound sources */
+    unsigned int getNumberOfBindings() const;
+
+    /* removes all bindings */
+    void clearData();
+
+    /* passes the current position and velocity of the owners to their bound
+       sources. Bindings of sources that no longer exist are removed.
+
+       parameters:
+           SecondsPassed - time since the last call, used to calculate the
+                           velocity of the owners
+
+       remarks:
+           This function should be called once per frame, after all objects
+           have been moved and before Sound::update().
+    */
+    void update(const float SecondsPassed);
+
+    /* called by the destructor of DuskObject to remove all bindings of the
+       object; safe to call even after the singleton itself has been destroyed
+       during program exit
+    */
+    static void ownerDestroyed(const DuskObject* owner);
+  private:
+    /* constructor - private due to singleton pattern */
+    SoundEmitterManager();
+
+    /* empty, private copy constructor - no copy constructor (singleton) */
+    SoundEmitterManager(const SoundEmitterManager& op) {}
+
+    struct Emitter
+    {
+      const DuskObject* owner;
+      Ogre::Vector3 lastPosition;
+      Ogre::Vector3 lastVelocity;
+      bool pending; //true, if the source has not been updated since binding
+    };//struct
+
+    std::map<std::string, Emitter> m_Emitters;
+};//class
+
+} //namespace
+
+#endif // DUSK_SOUNDEMITTERMANAGER_H
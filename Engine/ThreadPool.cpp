@@ -0,0 +1,116 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "ThreadPool.h"
+
+namespace Dusk
+{
+
+ThreadPool::ThreadPool(const unsigned int threads)
+: m_Workers(),
+  m_Jobs(),
+  m_Mutex(),
+  m_JobAvailable(),
+  m_AllDone(),
+  m_Running(0),
+  m_Stop(false)
+{
+  unsigned int count = threads;
+  if (count==0)
+  {
+    count = std::thread::hardware_concurrency();
+    //hardware_concurrency() may return zero, if it cannot tell
+    if (count==0) count = 2;
+  }
+  unsigned int i;
+  for (i=0; i<count; ++i)
+  {
+    m_Workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+  }//for
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_JobAvailable.notify_all();
+  unsigned int i;
+  for (i=0; i<m_Workers.size(); ++i)
+  {
+    m_Workers[i].join();
+  }//for
+}
+
+unsigned int ThreadPool::getNumberOfThreads() const
+{
+  return m_Workers.size();
+}
+
+void ThreadPool::enqueue(const std::function<void()>& job)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.push_back(job);
+  }
+  m_JobAvailable.notify_one();
+}
+
+void ThreadPool::waitForAll()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (!m_Jobs.empty() or (m_Running!=0))
+  {
+    m_AllDone.wait(lock);
+  }//while
+}
+
+void ThreadPool::workerLoop()
+{
+  std::function<void()> job;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      while (m_Jobs.empty() and !m_Stop)
+      {
+        m_JobAvailable.wait(lock);
+      }
+      //queued jobs are finished before the thread stops
+      if (m_Jobs.empty()) return;
+      job = m_Jobs.front();
+      m_Jobs.pop_front();
+      ++m_Running;
+    }
+    job();
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      --m_Running;
+      if (m_Jobs.empty() and (m_Running==0))
+      {
+        m_AllDone.notify_all();
+      }
+    }
+  }//while
+}
+
+} //namespace
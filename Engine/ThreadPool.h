@@ -0,0 +1,102 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: ThreadPool class
+          small pool of worker threads that process queued jobs
+
+ History:
+     - 2026-10-19 - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - No known bugs. If you find one (or more), then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef DUSK_THREADPOOL_H
+#define DUSK_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dusk
+{
+
+/*class ThreadPool:
+        starts a fixed number of worker threads which take jobs from a queue
+        and run them. Jobs must not throw exceptions and must not touch Ogre,
+        OpenAL or Lua, because none of those are used in a thread-safe way by
+        the engine.
+        The destructor waits until all queued jobs are done.
+*/
+class ThreadPool
+{
+  public:
+    /* constructor
+
+       parameters:
+           threads - number of worker threads; zero means one thread per
+                     hardware thread of the machine
+    */
+    ThreadPool(const unsigned int threads = 0);
+
+    /* destructor - finishes all queued jobs and stops the worker threads */
+    ~ThreadPool();
+
+    /* returns the number of worker threads */
+    unsigned int getNumberOfThreads() const;
+
+    /* adds a job to the queue; it will be run by the next free worker thread
+
+       parameters:
+           job - the function that shall be run
+    */
+    void enqueue(const std::function<void()>& job);
+
+    /* blocks until the queue is empty and no job is running any more */
+    void waitForAll();
+  private:
+    /* the function each worker thread runs */
+    void workerLoop();
+
+    /* private copy constructor - pools cannot be copied */
+    ThreadPool(const ThreadPool& op) {}
+
+    std::vector<std::thread> m_Workers;
+    std::deque<std::function<void()> > m_Jobs;
+    std::mutex m_Mutex;
+    std::condition_variable m_JobAvailable;
+    std::condition_variable m_AllDone;
+    unsigned int m_Running;
+    bool m_Stop;
+}; //class
+
+} //namespace
+
+#endif // DUSK_THREADPOOL_H
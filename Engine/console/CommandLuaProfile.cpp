@@ -0,0 +1,70 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "CommandLuaProfile.h"
+#include "../lua/LuaEngine.h"
+#include "../lua/LuaProfiler.h"
+#include "../DuskFunctions.h"
+#include "../Messages.h"
+
+namespace Dusk
+{
+
+CommandLuaProfile::CommandLuaProfile(const ProfileOperation op, const std::string& param)
+: Command(),
+  m_Operation(op),
+  m_Param(param)
+{
+}
+
+CommandLuaProfile::~CommandLuaProfile()
+{
+  //empty
+}
+
+bool CommandLuaProfile::execute(Dusk::Scene* scene, int count)
+{
+  LuaProfiler& profiler = LuaProfiler::getSingleton();
+  switch (m_Operation)
+  {
+    case lpoStart:
+         profiler.start(LuaEngine::getSingleton(),
+             m_Param.empty() ? LuaProfiler::cDefaultInstructions
+                             : StringToInt(m_Param, LuaProfiler::cDefaultInstructions));
+         break;
+    case lpoStop:
+         profiler.stop(LuaEngine::getSingleton());
+         break;
+    case lpoReset:
+         profiler.reset();
+         break;
+    case lpoDump:
+         profiler.logProfile();
+         if (!profiler.writeFoldedStacks(m_Param.empty() ? "lua_profile.folded" : m_Param))
+           return false;
+         break;
+    default: //should never happen
+         throw 42;
+  }//swi
+  return true;
+}
+
+} //namespace
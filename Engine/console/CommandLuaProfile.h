@@ -0,0 +1,74 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: CommandLuaProfile class
+          Command for controlling the Lua profiler via Console
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - If you find one (or more), then tell me please. I'll try to fix it as
+       soon as possible.
+ --------------------------------------------------------------------------*/
+
+#ifndef COMMANDLUAPROFILE_H
+#define COMMANDLUAPROFILE_H
+
+#include "Command.h"
+#include <string>
+
+namespace Dusk
+{
+
+  class CommandLuaProfile: public Command
+  {
+    public:
+      /* enumeration value to identify operation */
+      enum ProfileOperation {lpoStart, lpoStop, lpoReset, lpoDump};
+
+      /* constructor
+
+         parameters:
+             op    - the operation
+             param - for lpoStart: number of instructions between two samples
+                     (empty for the default), for lpoDump: name of the file for
+                     the folded stacks (empty for "lua_profile.folded")
+      */
+      CommandLuaProfile(const ProfileOperation op, const std::string& param="");
+
+      /* destructor */
+      virtual ~CommandLuaProfile();
+      virtual bool execute(Dusk::Scene* scene, int count = 1);
+    protected:
+      ProfileOperation m_Operation;
+      std::string m_Param;
+  };//class
+
+}//namespace
+
+#endif // COMMANDLUAPROFILE_H
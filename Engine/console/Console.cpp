@@ -38,6 +38,7 @@
 #include "CommandQuestLog.h"
 #include "CommandScreenshot.h"
 #include "CommandBindKey.h"
+#include "CommandLuaProfile.h"
 #include "../DuskFunctions.h"
 #include "../DuskTypes.h"
 #include "../Messages.h"
@@ -47,14 +48,247 @@
 namespace Dusk
 {
 
+namespace
+{
+
+/* handlers for the console commands, see Console::registerDefaultCommands()
+   for the command names and options
+*/
+
+void runQuit(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    DuskLog() << "Thee wants to quit?\n";
+    CommandQuit com;
+    dispatcher.executeCommand(&com);
+}
+
+void runBindKey(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    std::cout << "Bind a key!" << std::endl;
+    CommandBindKey com(command[1], command[2]);
+    dispatcher.executeCommand(&com);
+}
+
+void runUnbindKey(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    std::cout << "Delete a key binding!" << std::endl;
+    CommandUnbindKey com(command[1]);
+    dispatcher.executeCommand(&com);
+}
+
+void runListKeys(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    std::cout << "List key bindings!" << std::endl;
+    CommandListKeys com;
+    dispatcher.executeCommand(&com);
+}
+
+/* commands without implementation, option is the index of the message */
+void runPlaceholder(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    const char* const cMessages[] = {"A variable to set", "Starting something",
+                                     "Bring it to an end", "Move Mouse"};
+    std::cout << cMessages[option] << std::endl;
+}
+
+/* option is the DIRECTION */
+void runMove(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandMove com(static_cast<DIRECTION>(option));
+    dispatcher.executeCommand(&com);
+    switch (option)
+    {
+      case FORWARD:
+           std::cout << "One step forward" << std::endl;
+           break;
+      case BACKWARD:
+           std::cout << "One step back" << std::endl;
+           break;
+      case LEFT:
+           std::cout << "to the left" << std::endl;
+           break;
+      case RIGHT:
+           std::cout << "to the right" << std::endl;
+           break;
+      case TURN_LEFT:
+           std::cout << "Take a look to the left" << std::endl;
+           break;
+      case TURN_RIGHT:
+           std::cout << "Take a look to the right" << std::endl;
+           break;
+      case JUMP_UP:
+           std::cout << "up, up!" << std::endl;
+           break;
+      default:
+           break;
+    }//swi
+}
+
+void runPickUp(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandPickUp com;
+    dispatcher.executeCommand(&com);
+    DuskLog() << "pick something up!\n";
+}
+
+/* option is 1 for start, 0 for stop */
+void runAttack(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandAttack com(option != 0);
+    dispatcher.executeCommand(&com);
+    if (option != 0)
+        DuskLog() << "attack started!\n";
+    else
+        DuskLog() << "attack stopped!\n";
+}
+
+void runCreateNoise(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandCreateNoise com(command[1]);
+    dispatcher.executeCommand(&com);
+}
+
+void runDestroyNoise(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandDestroyNoise com(command[1]);
+    dispatcher.executeCommand(&com);
+}
+
+void runCreateMedia(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandCreateMedia com(command[1], command[2]);
+    dispatcher.executeCommand(&com);
+}
+
+void runDestroyMedia(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandDestroyMedia com(command[1]);
+    dispatcher.executeCommand(&com);
+}
+
+void runAssociateSoundMedia(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandAssociateSoundMedia com(command[1], command[2]);
+    dispatcher.executeCommand(&com);
+}
+
+void runDeassociateSoundMedia(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandDeassociateSoundMedia com(command[1]);
+    dispatcher.executeCommand(&com);
+}
+
+/* option is the SoundOpCode */
+void runPlaySound(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandPlaySound com(command[1], static_cast<SoundOpCode>(option));
+    dispatcher.executeCommand(&com);
+}
+
+void runLoopSound(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    /*Note on second parameter (bool): all strings except "1" will
+      be interpreted as false. Maybe we should change that later.*/
+    CommandLoopSound com(command[1], command[2].compare("1")==0);
+    dispatcher.executeCommand(&com);
+}
+
+void runSoundVolume(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    //predefined volume value is 1.0, if second param is not a float
+    CommandSoundVolume com(command[1], StringToFloat(command[2], 1.0f));
+    dispatcher.executeCommand(&com);
+}
+
+/* option is 1 for zooming in, 0 for zooming out */
+void runZoom(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandZoom com(option != 0);
+    dispatcher.executeCommand(&com);
+    if (option != 0)
+        std::cout << "Zoom in" << std::endl;
+    else
+        std::cout << "Zoom out" << std::endl;
+}
+
+/* option is the WeatherType */
+void runWeather(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandWeather com(static_cast<CommandWeather::WeatherType>(option), true);
+    dispatcher.executeCommand(&com);
+    switch (option)
+    {
+      case CommandWeather::wtFog:
+           DuskLog() << "Fog toggled.\n";
+           break;
+      case CommandWeather::wtRain:
+           DuskLog() << "Rain toggled.\n";
+           break;
+      case CommandWeather::wtSnow:
+           DuskLog() << "Snow toggled.\n";
+           break;
+    }//swi
+}
+
+/* option is the QuestLogOperation */
+void runQuestLog(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandQuestLog com(static_cast<CommandQuestLog::QuestLogOperation>(option));
+    dispatcher.executeCommand(&com);
+    switch (option)
+    {
+      case CommandQuestLog::qloToggle:
+           std::cout << "QuestLog's visibility toggled." << std::endl;
+           break;
+      case CommandQuestLog::qloNext:
+           std::cout << "Next QuestLog page." << std::endl;
+           break;
+      case CommandQuestLog::qloPrev:
+           std::cout << "Previous QuestLog page." << std::endl;
+           break;
+    }//swi
+}
+
+void runScreenshot(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    CommandScreenshot com;
+    dispatcher.executeCommand(&com);
+    DuskLog() << "Screenshot command executed.\n";
+}
+
+void runLuaProfile(const CommandLine& command, Dispatcher& dispatcher, const int option)
+{
+    const std::string param = (command.size()>2) ? command[2] : "";
+    CommandLuaProfile::ProfileOperation op;
+    if (command[1] == "start")
+        op = CommandLuaProfile::lpoStart;
+    else if (command[1] == "stop")
+        op = CommandLuaProfile::lpoStop;
+    else if (command[1] == "reset")
+        op = CommandLuaProfile::lpoReset;
+    else if (command[1] == "dump")
+        op = CommandLuaProfile::lpoDump;
+    else
+    {
+        DuskLog()<<"Console::executeCommand: Error: unknown operation \""
+                 <<command[1]<<"\" for lua_profile.\n";
+        return;
+    }
+    CommandLuaProfile com(op, param);
+    dispatcher.executeCommand(&com);
+}
+
+} //namespace
 
 Console* Console::s_console = 0;
 
 Console::Console()
 : m_Dispatcher (&(Dispatcher::get())),
   m_scriptQueue(std::deque<Dusk::Script>()),
-  m_repeatedCommands(std::list<std::string>())
+  m_repeatedCommands(std::list<std::string>()),
+  m_Commands(std::unordered_map<std::string, CommandEntry>())
 {
+  registerDefaultCommands();
 }
 
 Console::~Console()
@@ -71,6 +305,9 @@ Console* Console::getInstance()
 
 bool Console::addScript(const Dusk::Script& p_script)
 {
+    //Tokenize the original, not just the copy in the queue: key bindings keep
+    // their Script, so they are parsed on the first key press only.
+    p_script.getCommandLines();
     m_scriptQueue.push_back(p_script);
     return true;
 }
@@ -85,419 +322,108 @@ int Console::processScripts (int maxEntries)
 
     while (maxEntries > 0)
     {
-        Script script = m_scriptQueue.front();
-        m_scriptQueue.pop_front();
-
-        std::vector<std::string> lines = script.explodeCommands();
+        //references to elements of a deque stay valid when commands add
+        // new scripts, so the script is removed after its execution
+        const std::vector<CommandLine>& lines = m_scriptQueue.front().getCommandLines();
 
-        std::vector<std::string>::iterator it;
+        std::vector<CommandLine>::const_iterator it;
         for (it = lines.begin(); it != lines.end(); ++it)
             executeCommand(*it);
+        m_scriptQueue.pop_front();
         maxEntries--;
     }
 
     return size;
 }
 
-int Console::executeCommand(const std::string& p_string)
+void Console::registerCommand(const std::string& name, CommandHandler handler,
+                              const int option, const unsigned int parameters,
+                              const char* usage)
 {
-    std::vector<std::string> command;
-    std::string::const_iterator iter;
-    std::string tmp;
-    Command* com = NULL;
+    CommandEntry entry;
+    entry.Handler = handler;
+    entry.Option = option;
+    entry.Parameters = parameters;
+    entry.Usage = usage;
+    m_Commands[name] = entry;
+}
 
-    //divide string into vector of strings
-    if(p_string != "")
-    {
-        for(iter = p_string.begin(); iter != p_string.end(); ++iter)
-        {
-            if(*iter != ' ')
-                tmp += *iter;
-            else
-            {
-                command.push_back(tmp);
-                tmp = "";
-            }
-        }
-        command.push_back(tmp);
-    }
-    else
-    {
+void Console::registerDefaultCommands()
+{
+    registerCommand("quit", runQuit);
+    registerCommand("bind", runBindKey, 0, 2, "key and key string");
+    registerCommand("unbind", runUnbindKey, 0, 1, "key");
+    registerCommand("bind_list", runListKeys);
+    registerCommand("set", runPlaceholder, 0);
+    registerCommand("start", runPlaceholder, 1);
+    registerCommand("stop", runPlaceholder, 2);
+    //---------------------------------------------------------
+    //Movement Commands
+    registerCommand("move_forward", runMove, FORWARD);
+    registerCommand("move_backward", runMove, BACKWARD);
+    registerCommand("step_left", runMove, LEFT);
+    registerCommand("step_right", runMove, RIGHT);
+    registerCommand("turn_left", runMove, TURN_LEFT);
+    registerCommand("turn_right", runMove, TURN_RIGHT);
+    registerCommand("jump", runMove, JUMP_UP);
+    registerCommand("pick_up", runPickUp);
+    registerCommand("MoveMouse", runPlaceholder, 3);
+    //-------------------------------------------------------
+    // attack commands
+    registerCommand("StartAttack", runAttack, 1);
+    registerCommand("StopAttack", runAttack, 0);
+    //-------------------------------------------------------
+    // Sound Commands
+    registerCommand("CreateSound", runCreateNoise, 0, 1, "noise ID");
+    registerCommand("DestroySound", runDestroyNoise, 0, 1, "noise ID");
+    registerCommand("CreateMedia", runCreateMedia, 0, 2, "media ID and file path");
+    registerCommand("DestroyMedia", runDestroyMedia, 0, 1, "media ID");
+    registerCommand("AssociateSoundMedia", runAssociateSoundMedia, 0, 2, "noise ID and media ID");
+    registerCommand("DeassociateSoundMedia", runDeassociateSoundMedia, 0, 1, "noise ID");
+    registerCommand("PlaySound", runPlaySound, sopPlay, 1, "noise ID");
+    registerCommand("PauseSound", runPlaySound, sopPause, 1, "noise ID");
+    registerCommand("StopSound", runPlaySound, sopStop, 1, "noise ID");
+    registerCommand("UnPauseSound", runPlaySound, sopUnPause, 1, "noise ID");
+    registerCommand("ResumeSound", runPlaySound, sopUnPause, 1, "noise ID");
+    registerCommand("ReplaySound", runPlaySound, sopReplay, 1, "noise ID");
+    registerCommand("LoopSound", runLoopSound, 0, 2, "noise ID and 1 or 0");
+    registerCommand("SoundVolume", runSoundVolume, 0, 2, "noise ID and volume");
+    // --- Zoom commands ---
+    registerCommand("ZoomIn", runZoom, 1);
+    registerCommand("ZoomOut", runZoom, 0);
+    // --- weather commands ---
+    registerCommand("toggle_fog", runWeather, CommandWeather::wtFog);
+    registerCommand("toggle_rain", runWeather, CommandWeather::wtRain);
+    registerCommand("toggle_snow", runWeather, CommandWeather::wtSnow);
+    // --- QuestLog commands ---
+    registerCommand("toggle_questlog", runQuestLog, CommandQuestLog::qloToggle);
+    registerCommand("questlog_increase", runQuestLog, CommandQuestLog::qloNext);
+    registerCommand("questlog_decrease", runQuestLog, CommandQuestLog::qloPrev);
+    // --- Screenshot command ---
+    registerCommand("screenshot", runScreenshot);
+    // --- Lua profiler command ---
+    registerCommand("lua_profile", runLuaProfile, 0, 1, "start, stop, reset or dump");
+}
+
+int Console::executeCommand(const CommandLine& command)
+{
+    if (command.empty())
         return 1; // Error
+    std::unordered_map<std::string, CommandEntry>::const_iterator iter = m_Commands.find(command[0]);
+    if (iter == m_Commands.end())
+    {
+        DuskLog() << "Console::executeCommand: Parser error.\n";
+        return 1;
     }
-    if(!command.empty())
+    const CommandEntry& entry = iter->second;
+    if (command.size() <= entry.Parameters)
     {
-        //this is going to get big :/
-        if (command[0] == "quit")
-        {
-            DuskLog() << "Thee wants to quit?\n";
-            com = new CommandQuit();
-            m_Dispatcher->executeCommand(com); // Object will be destroyed after being executed by the Dispatcher
-        }
-        else if (command[0] == "bind")
-        {
-            std::cout << "Bind a key!" << std::endl;
-            if(command.size()< 3)
-            {
-                DuskLog()<<"Console::executeCommand: Error: Not enough "
-                         <<"parameters for bind command.\n";
-            }
-            else
-            {
-                com  = new CommandBindKey(command[1], command[2]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "unbind")
-        {
-            std::cout << "Delete a key binding!" << std::endl;
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: Not enough "
-                         <<"parameters for unbind command.\n";
-            }
-            else
-            {
-                com  = new CommandUnbindKey(command[1]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "bind_list")
-        {
-            std::cout << "List key bindings!" << std::endl;
-            com  = new CommandListKeys();
-            m_Dispatcher->executeCommand(com);
-        }
-        else if (command[0] == "set")
-        {
-            std::cout << "A variable to set" << std::endl;
-        }
-        else if (command[0] == "start")
-        {
-            std::cout << "Starting something" << std::endl;
-        }
-        else if (command[0] == "stop")
-        {
-            std::cout << "Bring it to an end" << std::endl;
-        }
-        //---------------------------------------------------------
-        //Movement Commands
-        else if (command[0] == "move_forward")
-        {
-            com = new CommandMove(FORWARD);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "One step forward" << std::endl;
-        }
-        else if (command[0] == "move_backward")
-        {
-            com = new CommandMove(BACKWARD);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "One step back" << std::endl;
-        }
-        else if (command[0] == "step_left")
-        {
-            com = new CommandMove(LEFT);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "to the left" << std::endl;
-        }
-        else if (command[0] == "step_right")
-        {
-            com = new CommandMove(RIGHT);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "to the right" << std::endl;
-        }
-        else if (command[0] == "turn_left")
-        {
-            com = new CommandMove(TURN_LEFT);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Take a look to the left" << std::endl;
-        }
-        else if (command[0] == "turn_right")
-        {
-            com = new CommandMove(TURN_RIGHT);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Take a look to the right" << std::endl;
-        }
-        else if (command[0] == "jump")
-        {
-            com = new CommandMove(JUMP_UP);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "up, up!" << std::endl;
-        }
-        else if (command[0] == "pick_up")
-        {
-            com = new CommandPickUp();
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "pick something up!\n";
-        }
-        else if (command[0] == "MoveMouse")
-        {
-
-            std::cout<<"Move Mouse"<<std::endl;
-        }
-
-        //-------------------------------------------------------
-        // attack commands
-        else if (command[0] == "StartAttack")
-        {
-            com = new CommandAttack(true);
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "attack started!\n";
-        }
-        else if (command[0] == "StopAttack")
-        {
-            com = new CommandAttack(false);
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "attack stopped!\n";
-        }
-
-        //-------------------------------------------------------
-        // Sound Commands
-
-        else if (command[0] == "CreateSound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"for CreateSound.\n";
-            }
-            else
-            {
-                com  = new CommandCreateNoise(command[1]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "DestroySound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"for DestroySound.\n";
-            }
-            else
-            {
-                com  = new CommandDestroyNoise(command[1]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "CreateMedia")
-        {
-            if(command.size()< 3)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No media ID parameter "
-                         <<"or no file path for CreateMedia.\n";
-            }
-            else
-            {
-                com  = new CommandCreateMedia(command[1], command[2]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "DestroyMedia")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No media ID parameter "
-                         <<"for DestroyMedia.\n";
-            }
-            else
-            {
-                com  = new CommandDestroyMedia(command[1]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "AssociateSoundMedia")
-        {
-            if(command.size()< 3)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"or no media ID for AssociateSoundMedia.\n";
-            }
-            else
-            {
-                com  = new CommandAssociateSoundMedia(command[1], command[2]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "DeassociateSoundMedia")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"for DeassociateSoundMedia.\n";
-            }
-            else
-            {
-                com  = new CommandDeassociateSoundMedia(command[1]);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "PlaySound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"for PlaySound.\n";
-            }
-            else
-            {
-                com  = new CommandPlaySound(command[1], sopPlay);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "PauseSound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID parameter "
-                         <<"for PauseSound.\n";
-            }
-            else
-            {
-                com  = new CommandPlaySound(command[1], sopPause);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "StopSound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID "
-                         <<"for StopSound.\n";
-            }
-            else
-            {
-                com  = new CommandPlaySound(command[1], sopStop);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "UnPauseSound" || command[0] == "ResumeSound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID "
-                         <<"for UnPauseSound.\n";
-            }
-            else
-            {
-                com  = new CommandPlaySound(command[1], sopUnPause);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "ReplaySound")
-        {
-            if(command.size()< 2)
-            {
-                DuskLog()<<"Console::executeCommand: Error: No noise ID "
-                         <<"for ReplaySound.\n";
-            }
-            else
-            {
-                com  = new CommandPlaySound(command[1], sopReplay);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "LoopSound")
-        {
-            if(command.size()< 3)
-            {
-                DuskLog()<<"Console::executeCommand: Error: Not enough "
-                         <<"parameters for LoopSound (2 needed).\n";
-            }
-            else
-            {
-                /*Note on second parameter (bool): all strings except "1" will
-                  be interpreted as false. Maybe we should change that later.*/
-                com  = new CommandLoopSound(command[1], command[2].compare("1")==0);
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        else if (command[0] == "SoundVolume")
-        {
-            if(command.size()< 3)
-            {
-                DuskLog()<<"Console::executeCommand: Error: Not enough "
-                         <<"parameters for SoundVolume (2 needed).\n";
-            }
-            else
-            {
-                //predefined volume value is 1.0, if second param is not a float
-                com  = new CommandSoundVolume(command[1], StringToFloat(command[2], 1.0f));
-                m_Dispatcher->executeCommand(com);
-            }
-        }
-        // --- Zoom commands ---
-        else if (command[0] == "ZoomIn")
-        {
-            com = new CommandZoom(true);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Zoom in" << std::endl;
-        }
-        else if (command[0] == "ZoomOut")
-        {
-            com = new CommandZoom(false);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Zoom out" << std::endl;
-        }
-        //fog command
-        else if (command[0] == "toggle_fog")
-        {
-            com = new CommandWeather(CommandWeather::wtFog, true);
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "Fog toggled.\n";
-        }
-        //rain command
-        else if (command[0] == "toggle_rain")
-        {
-            com = new CommandWeather(CommandWeather::wtRain, true);
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "Rain toggled.\n";
-        }
-        //snow command
-        else if (command[0] == "toggle_snow")
-        {
-            com = new CommandWeather(CommandWeather::wtSnow, true);
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "Snow toggled.\n";
-        }
-        // --- QuestLog commands ---
-        //toggle visibility
-        else if (command[0] == "toggle_questlog")
-        {
-            com = new CommandQuestLog(CommandQuestLog::qloToggle);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "QuestLog's visibility toggled." << std::endl;
-        }
-        //next page
-        else if (command[0] == "questlog_increase")
-        {
-            com = new CommandQuestLog(CommandQuestLog::qloNext);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Next QuestLog page." << std::endl;
-        }
-        //previous page
-        else if (command[0] == "questlog_decrease")
-        {
-            com = new CommandQuestLog(CommandQuestLog::qloPrev);
-            m_Dispatcher->executeCommand(com);
-            std::cout << "Previous QuestLog page." << std::endl;
-        }
-        // --- Screenshot command ---
-        else if (command[0] == "screenshot")
-        {
-            com = new CommandScreenshot();
-            m_Dispatcher->executeCommand(com);
-            DuskLog() << "Screenshot command executed.\n";
-        }
-        // --- no command recognised ---
-        else
-        {
-            DuskLog() << "Console::executeCommand: Parser error.\n";
-        }
+        DuskLog() << "Console::executeCommand: Error: Not enough parameters for "
+                  << command[0] << " (" << entry.Parameters << " needed: "
+                  << entry.Usage << ").\n";
+        return 1;
     }
-    if(com) delete com;
-
-    // we should still return something; here
+    entry.Handler(command, *m_Dispatcher, entry.Option);
     return 0;
 }
 
@@ -57,6 +57,8 @@
      - 2010-12-04 (rev 268) - use DuskLog/Messages class for logging
      - 2010-12-19 (rev 273) - adjustments for CommandBindKey and CommandUnbindKey
      - 2010-12-21 (rev 274) - adjustments for CommandListKeys
+     - 2026-10-19           - commands are looked up in a hash map instead of
+                              an if/else chain; scripts are tokenized once
 
  ToDo list:
      - update Console as soon as new commands are available
@@ -71,6 +73,8 @@
 
 #include <deque>
 #include <list>
+#include <string>
+#include <unordered_map>
 
 #include "../Script.h"
 #include "Dispatcher.h"
@@ -107,6 +111,31 @@ namespace Dusk
          */
         int processScripts (int maxEntries = 0);
 
+        /**
+         * Function that executes a console command.
+         *
+         * @param command       The command name and its parameters.
+         * @param dispatcher    The dispatcher that shall execute the Command.
+         * @param option        The Option value of the command's entry.
+         */
+        typedef void (*CommandHandler)(const CommandLine& command, Dispatcher& dispatcher, const int option);
+
+        /**
+         * Adds a command to the console or replaces an existing one.
+         *
+         * @param name          The name of the command, i.e. its first word.
+         * @param handler       The function that executes the command.
+         * @param option        A value passed to handler, so that one handler
+         *                      can serve several similar commands.
+         * @param parameters    The minimum number of parameters.
+         * @param usage         Description of the parameters for the error
+         *                      message, if there are not enough of them.
+         */
+        void registerCommand(const std::string& name, CommandHandler handler,
+                             const int option = 0,
+                             const unsigned int parameters = 0,
+                             const char* usage = "");
+
     private:
         /**
          * Standard constructor
@@ -123,7 +152,32 @@ namespace Dusk
          */
         virtual ~Console();
 
-        int executeCommand(const std::string&);
+        /**
+         * Executes a tokenized command.
+         *
+         * @param command       The command name and its parameters.
+         * @return 0 for success, 1 if the command is empty or unknown or has
+         *         not enough parameters
+         */
+        int executeCommand(const CommandLine& command);
+
+        /**
+         * Registers all of Dusk's commands. Called by the constructor.
+         */
+        void registerDefaultCommands();
+
+        struct CommandEntry
+        {
+            CommandHandler Handler;
+            int Option;
+            unsigned int Parameters;
+            const char* Usage;
+        };
+
+        /**
+         * Holds the known commands, key is the command name.
+         */
+        std::unordered_map<std::string, CommandEntry> m_Commands;
 
         /**
          * Holds the instance of the dispatcher.
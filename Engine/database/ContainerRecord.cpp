@@ -21,29 +21,22 @@
 #include "ContainerRecord.h"
 #include "../DuskConstants.h"
 #include "../Messages.h"
-#include <cstring>
 
 namespace Dusk{
 
-bool ContainerRecord::saveToStream(std::ofstream& outStream) const
+bool ContainerRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
     DuskLog() << "ContainerRecord::saveToStream: ERROR: stream contains errors!\n";
     return false;
   }
-
-  uint32_t len = 0;
   //header "Cont"
-  outStream.write((const char*) &cHeaderCont, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderCont);
   //ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //Mesh
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
   //Inventory
   if (!ContainerInventory.saveToStream(outStream))
   {
@@ -54,7 +47,7 @@ bool ContainerRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool ContainerRecord::loadFromStream(std::ifstream& inStream)
+bool ContainerRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
@@ -62,46 +55,26 @@ bool ContainerRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   uint32_t len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
+  inStream.readUInt32(len);
   if (len != cHeaderCont)
   {
     DuskLog() << "ContainerRecord::loadFromStream: ERROR: stream contains unexpected header!\n";
     return false;
   }
-  char ID_Buffer[256];
-  memset(ID_Buffer, 0, 256);
   //read ID
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ContainerRecord::loadFromStream: ERROR: ID is "
-              << "longer than 255 characters!\n";
-    return false;
-  }
-  inStream.read(ID_Buffer, len);
-  if (!inStream.good())
+  std::string newID;
+  if (!inStream.readString(newID))
   {
     DuskLog() << "ContainerRecord::loadFromStream: ERROR while "
-              << "reading ID from stream!\n";
+              << "reading ID from stream (or ID is longer than 255 characters)!\n";
     return false;
   }
   //read Mesh
-  char Mesh_Buffer[256];
-  memset(Mesh_Buffer, 0, 256);
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  std::string newMesh;
+  if (!inStream.readString(newMesh))
   {
-    DuskLog() << "ContainerRecord::loadFromStream: ERROR: mesh path "
-              << "is longer than 255 characters!\n";
-    return false;
-  }
-  inStream.read(Mesh_Buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "ContainerRecord::loadFromStream: ERROR while "
-              << "reading mesh path from stream!\n";
+    DuskLog() << "ContainerRecord::loadFromStream: ERROR while reading mesh "
+              << "path from stream (or path is longer than 255 characters)!\n";
     return false;
   }
   Inventory temp;
@@ -112,6 +85,9 @@ bool ContainerRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   //all right so far
+  ID = newID;
+  Mesh = newMesh;
+  ContainerInventory = temp;
   return inStream.good();
 }
 
@@ -51,7 +51,8 @@
 #ifndef DUSK_CONTAINERRECORD_H
 #define DUSK_CONTAINERRECORD_H
 
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include "DataRecord.h"
 #include "../Inventory.h"
 
@@ -74,7 +75,7 @@ namespace Dusk
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -85,7 +86,7 @@ namespace Dusk
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
   };
 
 }//namespace
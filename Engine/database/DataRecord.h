@@ -40,6 +40,8 @@
 
 #include <stdint.h>
 #include <string>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 
 namespace Dusk
 {
@@ -64,7 +66,7 @@ struct DataRecord
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const = 0;
+    virtual bool saveToStream(BinaryWriter& outStream) const = 0;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -75,7 +77,7 @@ struct DataRecord
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream) = 0;
+    virtual bool loadFromStream(BinaryReader& inStream) = 0;
 };//struct
 
 } //namespace
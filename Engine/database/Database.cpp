@@ -122,7 +122,7 @@ unsigned int Database::getNumberOfRecords() const
   return m_Records.size();
 }
 
-bool Database::saveAllToStream(std::ofstream& outStream) const
+bool Database::saveAllToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -142,12 +142,24 @@ bool Database::saveAllToStream(std::ofstream& outStream) const
   return true;
 }
 
-bool Database::loadNextRecordFromStream(std::ifstream& inStream, const uint32_t header)
+bool Database::loadNextRecordFromStream(BinaryReader& inStream, const uint32_t header)
 {
-  if (!inStream.good())
+  DataRecord* recordPtr = readRecordFromStream(inStream, header);
+  if (recordPtr==NULL)
   {
-    DuskLog() << "Database::loadNextRecordFromStream: ERROR: bad stream.\n";
+    DuskLog() << "Database::loadNextRecordFromStream: ERROR while reading data.\n";
     return false;
+  }
+  addRecord(recordPtr);
+  return true;
+}
+
+DataRecord* Database::readRecordFromStream(BinaryReader& inStream, const uint32_t header)
+{
+  if (!inStream.good())
+  {
+    DuskLog() << "Database::readRecordFromStream: ERROR: bad stream.\n";
+    return NULL;
   }//if
 
   DataRecord* recordPtr = NULL;
@@ -190,20 +202,19 @@ bool Database::loadNextRecordFromStream(std::ifstream& inStream, const uint32_t
          recordPtr = new WeaponRecord;
          break;
     default:
-         DuskLog() << "Database::loadNextRecordFromStream: ERROR: unexpected header.\n";
-         return false;
+         DuskLog() << "Database::readRecordFromStream: ERROR: unexpected header.\n";
+         return NULL;
          break;
   }//swi
 
   if (recordPtr->loadFromStream(inStream))
   {
-    addRecord(recordPtr);
-    return true;
+    return recordPtr;
   }
   delete recordPtr;
   recordPtr = NULL;
-  DuskLog() << "Database::loadNextRecordFromStream: ERROR while reading data.\n";
-  return false;
+  DuskLog() << "Database::readRecordFromStream: ERROR while reading data.\n";
+  return NULL;
 }
 
 #ifdef DUSK_EDITOR
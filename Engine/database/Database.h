@@ -35,6 +35,7 @@
      - 2012-07-08 (rev 318) - removed two-parameter version of hasTypedRecord()
      - 2012-07-11 (rev 320) - getNumberOfTypedRecords() added
      - 2012-07-19 (rev 321) - update for SoundRecord
+     - 2026-10-19           - readRecordFromStream() added
 
  ToDo list:
      - ???
@@ -153,7 +154,7 @@ namespace Dusk
          parameters:
              outStream - the output stream to which the records will be saved
       */
-      bool saveAllToStream(std::ofstream& outStream) const;
+      bool saveAllToStream(BinaryWriter& outStream) const;
 
       /* Loads one(!) single record from the stream; returns true on success,
          false otherwise. The data of the last loaded record is probably
@@ -164,7 +165,19 @@ namespace Dusk
              inStream - the input stream from which the record will be read
              header   - header of the record
       */
-      bool loadNextRecordFromStream(std::ifstream& inStream, const uint32_t header);
+      bool loadNextRecordFromStream(BinaryReader& inStream, const uint32_t header);
+
+      /* Reads one(!) single record from the stream without adding it to the
+         database. Returns a pointer to the new record on success, or NULL on
+         failure. The caller takes ownership of the returned record. Since
+         this function does not touch the database itself, it can be used by
+         worker threads while loading data files.
+
+         parameters:
+             inStream - the input stream from which the record will be read
+             header   - header of the record
+      */
+      static DataRecord* readRecordFromStream(BinaryReader& inStream, const uint32_t header);
 
       #ifdef DUSK_EDITOR
       //iterator type for iterating through the records
@@ -19,7 +19,6 @@
 */
 
 #include "ItemRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -33,7 +32,7 @@ uint32_t ItemRecord::getRecordType() const
   return cHeaderItem;
 }
 
-bool ItemRecord::saveToStream(std::ofstream& outStream) const
+bool ItemRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -42,23 +41,17 @@ bool ItemRecord::saveToStream(std::ofstream& outStream) const
   }
 
   //write header "Item"
-  outStream.write((const char*) &cHeaderItem, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderItem);
   //write ID
-  uint32_t len = ID.length();
-  outStream.write((const char*) &len, sizeof(unsigned int));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //write name
-  len = Name.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Name.c_str(), len);
+  outStream.writeString(Name);
   //write value
-  outStream.write((const char*) &value, sizeof(int));
+  outStream.writeInt32(value);
   //write weight
-  outStream.write((const char*) &weight, sizeof(float));
+  outStream.writeFloat(weight);
   //write Mesh name
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
 
   if (!outStream.good())
   {
@@ -68,7 +61,7 @@ bool ItemRecord::saveToStream(std::ofstream& outStream) const
   return true;
 }
 
-bool ItemRecord::loadFromStream(std::ifstream& inStream)
+bool ItemRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
@@ -76,10 +69,9 @@ bool ItemRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }//if
 
-  char ID_Buffer[256];
   //read header "Item"
   uint32_t Header = 0;
-  inStream.read((char*) &Header, sizeof(uint32_t));
+  inStream.readUInt32(Header);
   if (Header!=cHeaderItem)
   {
     DuskLog() << "ItemRecord::loadFromStream: ERROR: Stream contains invalid "
@@ -87,67 +79,38 @@ bool ItemRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }//if
 
-  uint32_t len;
-  //read length of ID
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR: ID cannot be longer than "
-              << "255 characters.\n";
-    return false;
-  }
   //read ID
-  memset(ID_Buffer, 0, 256);
-  inStream.read(ID_Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(ID))
   {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (ID).\n";
-    return false;
-  }
-  ID = std::string(ID_Buffer);
-
-  //read length of item name
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR: item name cannot be "
-              << "longer than 255 characters.\n";
+    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (ID). "
+              << "ID cannot be longer than 255 characters.\n";
     return false;
   }
   //read item name
-  memset(ID_Buffer, 0, len+1);
-  inStream.read(ID_Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(Name))
   {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (name).\n";
+    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (name)."
+              << " Item name cannot be longer than 255 characters.\n";
     return false;
   }
-  Name = std::string(ID_Buffer);
 
   //read value
-  inStream.read((char*) &value, sizeof(int));
+  int32_t temp_value = 0;
+  inStream.readInt32(temp_value);
+  value = temp_value;
   //read weight
-  inStream.read((char*) &weight, sizeof(float));
+  inStream.readFloat(weight);
   if (!inStream.good())
   {
     DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data.\n";
     return false;
   }
 
-  //read length of mesh name
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR: mesh name cannot be longer"
-              << " than 255 characters.\n";
-    return false;
-  }
   //read mesh name
-  memset(ID_Buffer, 0, len+1);
-  inStream.read(ID_Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(Mesh))
   {
-    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (mesh).\n";
+    DuskLog() << "ItemRecord::loadFromStream: ERROR while reading data (mesh)."
+              << " Mesh name cannot be longer than 255 characters.\n";
     return false;
   }
   return true;
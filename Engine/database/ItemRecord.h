@@ -58,7 +58,8 @@
 #ifndef DUSK_ITEMRECORD_H
 #define DUSK_ITEMRECORD_H
 
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include "DataRecord.h"
 
 namespace Dusk
@@ -83,7 +84,7 @@ namespace Dusk
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -94,7 +95,7 @@ namespace Dusk
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
   }; //struct
 
   //const ItemRecord cEmptyItemRecord = { "", 0, 0.0, ""};
@@ -19,7 +19,6 @@
 */
 
 #include "LightRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -114,7 +113,7 @@ uint32_t LightRecord::getRecordType() const
 //record type identifier
 const uint32_t LightRecord::RecordType = cHeaderLight;
 
-bool LightRecord::saveToStream(std::ofstream& outStream) const
+bool LightRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -122,18 +121,16 @@ bool LightRecord::saveToStream(std::ofstream& outStream) const
     return false;
   }
   //write header Light
-  outStream.write((const char*) &cHeaderLight, sizeof(unsigned int));
+  outStream.writeUInt32(cHeaderLight);
   //write ID
-  const unsigned int len = ID.length();
-  outStream.write((const char*) &len, sizeof(unsigned int));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //write colour data
-  outStream.write((const char*) &red, sizeof(float));
-  outStream.write((const char*) &green, sizeof(float));
-  outStream.write((const char*) &blue, sizeof(float));
-  outStream.write((const char*) &radius, sizeof(float));
+  outStream.writeFloat(red);
+  outStream.writeFloat(green);
+  outStream.writeFloat(blue);
+  outStream.writeFloat(radius);
   //write light type
-  outStream.write((const char*) &type, sizeof(Ogre::Light::LightTypes));
+  outStream.writeUInt32(static_cast<uint32_t>(type));
   //check
   if (!outStream.good())
   {
@@ -144,54 +141,42 @@ bool LightRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool LightRecord::loadFromStream(std::ifstream& inStream)
+bool LightRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
     DuskLog() << "LightRecord::loadFromStream: ERROR: stream contains errors.\n";
     return false;
   }
-  char ID_Buffer[256];
   uint32_t Header = 0;
-  inStream.read((char*) &Header, sizeof(uint32_t));
+  inStream.readUInt32(Header);
   if (Header != cHeaderLight)
   {
     DuskLog() << "LightRecord::loadFromStream: ERROR: invalid record header.\n";
     return false;
   }
-  //read ID length
-  Header = 0;
-  inStream.read((char*) &Header, sizeof(uint32_t));
-  if (Header>255)
-  {
-    DuskLog() << "LightRecord::loadFromStream: ERROR: ID is longer than 255"
-              << "characters.\n";
-    return false;
-  }
   //read ID
-  memset(ID_Buffer, 0, Header+1);
-  inStream.read(ID_Buffer, Header);
-  if (!inStream.good())
+  if (!inStream.readString(ID))
   {
     DuskLog() << "LightRecord::loadFromStream: ERROR while reading light's"
-              << " ID from stream.\n";
+              << " ID from stream. ID must not be longer than 255 characters.\n";
     return false;
   }
-  ID_Buffer[Header] = '\0'; //make sure it's NUL-terminated
-  ID = std::string(ID_Buffer);
   //read RGB and radius
-  inStream.read((char*) &red, sizeof(float));
-  inStream.read((char*) &green, sizeof(float));
-  inStream.read((char*) &blue, sizeof(float));
-  inStream.read((char*) &radius, sizeof(float));
+  inStream.readFloat(red);
+  inStream.readFloat(green);
+  inStream.readFloat(blue);
+  inStream.readFloat(radius);
   //read light type
-  inStream.read((char*) &type, sizeof(Ogre::Light::LightTypes));
+  Header = 0;
+  inStream.readUInt32(Header);
   if (!inStream.good())
   {
     DuskLog() << "LightRecord::loadFromStream: ERROR while reading light's"
               << " colour values from stream.\n";
     return false;
   }
+  type = static_cast<Ogre::Light::LightTypes>(Header);
   //normalise values, just to be safe
   normalise();
   return true;
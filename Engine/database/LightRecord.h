@@ -54,7 +54,8 @@
 #ifndef DUSK_LIGHTRECORD_H
 #define DUSK_LIGHTRECORD_H
 
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include <OgreLight.h>
 #include "DataRecord.h"
 
@@ -124,7 +125,7 @@ namespace Dusk
          parameters:
              outStream - the output stream to which the data will be saved
       */
-      virtual bool saveToStream(std::ofstream& outStream) const;
+      virtual bool saveToStream(BinaryWriter& outStream) const;
 
       /* Tries to load the data record from stream inStream and returns true on
          success, false otherwise.
@@ -135,7 +136,7 @@ namespace Dusk
          remarks:
              The record may have inconsistent data, if the function fails.
       */
-      virtual bool loadFromStream(std::ifstream& inStream);
+      virtual bool loadFromStream(BinaryReader& inStream);
   };
 
   /* overloaded equality operator for light records */
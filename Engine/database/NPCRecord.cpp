@@ -56,42 +56,34 @@ uint32_t NPCRecord::getRecordType() const
   return cHeaderNPC_;
 }
 
-bool NPCRecord::saveToStream(std::ofstream& output) const
+bool NPCRecord::saveToStream(BinaryWriter& output) const
 {
   if (!(output.good()))
   {
     DuskLog() << "NPCRecord::saveToStream: ERROR: Bad stream.\n";
     return false;
   }
-  uint32_t len;
-
   //header
-  output.write((const char*) &cHeaderNPC_, sizeof(uint32_t));
+  output.writeUInt32(cHeaderNPC_);
   //ID
-  len = ID.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(ID.c_str(), len);
+  output.writeString(ID);
   //NPC data
   // -- name
-  len = Name.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Name.c_str(), len);
+  output.writeString(Name);
   // -- mesh
-  len = Mesh.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Mesh.c_str(), len);
+  output.writeString(Mesh);
   // -- level
-  output.write((const char*) &Level, 1);
+  output.writeUInt8(Level);
   // -- attributes
-  output.write((const char*) &(Attributes.Str), 1);
-  output.write((const char*) &(Attributes.Agi), 1);
-  output.write((const char*) &(Attributes.Vit), 1);
-  output.write((const char*) &(Attributes.Int), 1);
-  output.write((const char*) &(Attributes.Will), 1);
-  output.write((const char*) &(Attributes.Cha), 1);
-  output.write((const char*) &(Attributes.Luck), 1);
+  output.writeUInt8(Attributes.Str);
+  output.writeUInt8(Attributes.Agi);
+  output.writeUInt8(Attributes.Vit);
+  output.writeUInt8(Attributes.Int);
+  output.writeUInt8(Attributes.Will);
+  output.writeUInt8(Attributes.Cha);
+  output.writeUInt8(Attributes.Luck);
   // -- female flag
-  output.write((const char*) &Female, sizeof(bool));
+  output.writeBool(Female);
   //inventory
   if (!InventoryAtStart.saveToStream(output))
   {
@@ -100,47 +92,17 @@ bool NPCRecord::saveToStream(std::ofstream& output) const
     return false;
   }
   // -- animations
-  // ---- idle
-  len = Animations.Idle.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.Idle.c_str(), len);
-  // ---- walk
-  len = Animations.Walk.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.Walk.c_str(), len);
-  // ---- melee
-  len = Animations.MeleeAttack.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.MeleeAttack.c_str(), len);
-  // ---- projectile
-  len = Animations.ProjectileAttack.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.ProjectileAttack.c_str(), len);
-  // ---- jump
-  len = Animations.Jump.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.Jump.c_str(), len);
-  // ---- death
-  len = Animations.Death.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(Animations.Death.c_str(), len);
+  output.writeString(Animations.Idle);
+  output.writeString(Animations.Walk);
+  output.writeString(Animations.MeleeAttack);
+  output.writeString(Animations.ProjectileAttack);
+  output.writeString(Animations.Jump);
+  output.writeString(Animations.Death);
   // -- tag points
-  // ---- left hand
-  len = TagPoints.HandLeft.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(TagPoints.HandLeft.c_str(), len);
-  // ---- right hand
-  len = TagPoints.HandRight.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(TagPoints.HandRight.c_str(), len);
-  // ---- left sheath
-  len = TagPoints.SheathLeft.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(TagPoints.SheathLeft.c_str(), len);
-  // ---- right sheath
-  len = TagPoints.SheathRight.length();
-  output.write((const char*) &len, sizeof(uint32_t));
-  output.write(TagPoints.SheathRight.c_str(), len);
+  output.writeString(TagPoints.HandLeft);
+  output.writeString(TagPoints.HandRight);
+  output.writeString(TagPoints.SheathLeft);
+  output.writeString(TagPoints.SheathRight);
   if (!output.good())
   {
     DuskLog() << "NPCRecord::saveToStream: ERROR while writing animations and "
@@ -150,7 +112,7 @@ bool NPCRecord::saveToStream(std::ofstream& output) const
   return output.good();
 }
 
-bool NPCRecord::loadFromStream(std::ifstream& input)
+bool NPCRecord::loadFromStream(BinaryReader& input)
 {
   if (!(input.good()))
   {
@@ -159,81 +121,45 @@ bool NPCRecord::loadFromStream(std::ifstream& input)
   }
   uint32_t len = 0;
   //header
-  input.read((char*) &len, sizeof(uint32_t));
+  input.readUInt32(len);
   if (len != cHeaderNPC_)
   {
     DuskLog() << "NPCRecord::loadFromStream: ERROR: Invalid header.\n";
     return false;
   }
   //ID
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC ID seems to be"
-              << " longer than 255 characters.\n";
-    return false;
-  }
-  char buffer[256];
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!(input.good()))
+  if (!input.readString(ID))
   {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC ID.\n";
+    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC ID. ID "
+              << "must not be longer than 255 characters.\n";
     return false;
   }
-  ID = std::string(buffer);
   //name
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC name seems to "
-              << "be longer than 255 characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!(input.good()))
+  if (!input.readString(Name))
   {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "name from stream.\n";
+    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading name of NPC \""
+              << ID << "\" from stream.\n";
     return false;
   }
-  Name = std::string(buffer);
   //mesh
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
+  if (!input.readString(Mesh))
   {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC mesh seems to "
-              << "be longer than 255 characters.\n";
+    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading mesh location "
+              << "of NPC \""<<ID<<"\" from stream.\n";
     return false;
   }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "mesh location from stream.\n";
-    return false;
-  }
-  Mesh = std::string(buffer);
   //level
-  input.read((char*) &Level, 1);
+  input.readUInt8(Level);
   //attributes
-  input.read((char*) &(Attributes.Str), 1);
-  input.read((char*) &(Attributes.Agi), 1);
-  input.read((char*) &(Attributes.Vit), 1);
-  input.read((char*) &(Attributes.Int), 1);
-  input.read((char*) &(Attributes.Will), 1);
-  input.read((char*) &(Attributes.Cha), 1);
-  input.read((char*) &(Attributes.Luck), 1);
+  input.readUInt8(Attributes.Str);
+  input.readUInt8(Attributes.Agi);
+  input.readUInt8(Attributes.Vit);
+  input.readUInt8(Attributes.Int);
+  input.readUInt8(Attributes.Will);
+  input.readUInt8(Attributes.Cha);
+  input.readUInt8(Attributes.Luck);
   //female?
-  input.read((char*) &Female, sizeof(bool));
+  input.readBool(Female);
   if (!input.good())
   {
     DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
@@ -248,209 +174,32 @@ bool NPCRecord::loadFromStream(std::ifstream& input)
     return false;
   }
   //animations
-  // -- idle
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC idle animation"
-              << " name of \""<<ID<<"\" seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
+  input.readString(Animations.Idle);
+  input.readString(Animations.Walk);
+  input.readString(Animations.MeleeAttack);
+  input.readString(Animations.ProjectileAttack);
+  input.readString(Animations.Jump);
+  input.readString(Animations.Death);
   if (!input.good())
   {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "idle animation name from stream.\n";
+    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading animation "
+              << "names of NPC \""<<ID<<"\" from stream. Names must not be "
+              << "longer than 255 characters.\n";
     return false;
   }
-  Animations.Idle = std::string(buffer);
-  // -- walk
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC walk animation "
-              << " name of \""<<ID<<"\" seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "walk animation name from stream.\n";
-    return false;
-  }
-  Animations.Walk = std::string(buffer);
-  // -- melee
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC melee animation"
-              << " name of \""<<ID<<"\" seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "melee animation name from stream.\n";
-    return false;
-  }
-  Animations.MeleeAttack = std::string(buffer);
-  // -- projectile
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC projectile "
-              << "animation name of\""<<ID<< " seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "projectile attack animation name from stream.\n";
-    return false;
-  }
-  Animations.ProjectileAttack = std::string(buffer);
-  // -- jump
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC jum animation "
-              << "name of \""<<ID<<"\" seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "jump animation name from stream.\n";
-    return false;
-  }
-  Animations.Jump = std::string(buffer);
-  // -- death
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC death animation"
-              << " name of \""<<ID<<"\" seems to be longer than 255 "
-              << "characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "death animation name from stream.\n";
-    return false;
-  }
-  Animations.Death = std::string(buffer);
-
   //tag points
-  // -- left hand
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC TagPoint name"
-              << " (left hand) of \""<<ID<<"\" seems to be longer than 255"
-              << " characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "TagPoint name (left hand) of \""<<ID<<"\" from stream.\n";
-    return false;
-  }
-  TagPoints.HandLeft = std::string(buffer);
-  // -- right hand
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC TagPoint name"
-              << " seems to be longer than 255 characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "TagPoint name (right hand) of \""<<ID<<"\" from stream.\n";
-    return false;
-  }
-  TagPoints.HandRight = std::string(buffer);
-  // -- left sheath
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC TagPoint name"
-              << " (left sheath) of \""<<ID<<"\" seems to be longer than "
-              << "255 characters.\n";
-    return false;
-  }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
+  input.readString(TagPoints.HandLeft);
+  input.readString(TagPoints.HandRight);
+  input.readString(TagPoints.SheathLeft);
+  input.readString(TagPoints.SheathRight);
   if (!input.good())
   {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "TagPoint name (left sheath) of \""<<ID<<"\" from stream.\n";
-    return false;
-  }
-  TagPoints.SheathLeft = std::string(buffer);
-  // -- righ sheath
-  len = 0;
-  input.read((char*) &len, sizeof(uint32_t));
-  if (len > 255)
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR: NPC TagPoint name"
-              << " (left sheath) of \""<<ID<<"\" seems to be longer than "
-              << "255 characters.\n";
+    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading TagPoint "
+              << "names of NPC \""<<ID<<"\" from stream. Names must not be "
+              << "longer than 255 characters.\n";
     return false;
   }
-  buffer[0] = '\0';
-  input.read(buffer, len);
-  buffer[len] = '\0';
-  if (!input.good())
-  {
-    DuskLog() << "NPCRecord::loadFromStream: ERROR while reading NPC "
-              << "TagPoint name (right sheath) of \""<<ID<<"\" from stream.\n";
-    return false;
-  }
-  TagPoints.SheathRight = std::string(buffer);
-
-  return input.good();
+  return true;
 }
 
 }//namespace
@@ -19,7 +19,6 @@
 */
 
 #include "ObjectRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -33,7 +32,7 @@ uint32_t ObjectRecord::getRecordType() const
 
 const uint32_t ObjectRecord::RecordType = cHeaderObjS;
 
-bool ObjectRecord::saveToStream(std::ofstream& outStream) const
+bool ObjectRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -41,19 +40,14 @@ bool ObjectRecord::saveToStream(std::ofstream& outStream) const
      return false;
   }
 
-  unsigned int len;
   //write header "ObjS"
-  outStream.write((const char*) &cHeaderObjS, sizeof(uint32_t)); //Object, Static
+  outStream.writeUInt32(cHeaderObjS); //Object, Static
   //write ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(unsigned int));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //write mesh
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(unsigned int));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
   //write collision flag
-  outStream.write((const char*) &collide, sizeof(bool));
+  outStream.writeBool(collide);
   //check
   if (!outStream.good())
   {
@@ -64,60 +58,45 @@ bool ObjectRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool ObjectRecord::loadFromStream(std::ifstream& inStream)
+bool ObjectRecord::loadFromStream(BinaryReader& inStream)
 {
-  unsigned int len;
   uint32_t Header = 0;
-  char ID_Buffer[256], Mesh_Buffer[256];
 
   //read header "ObjS" (Object, Static)
-  inStream.read((char*) &Header, sizeof(uint32_t));
+  inStream.readUInt32(Header);
   if (Header!=cHeaderObjS)
   {
     DuskLog() << "ObjectRecord::loadFromStream: ERROR: Stream contains invalid "
               << "record header.\n";
     return false;
   }//if
-  //read length of ID
-  inStream.read((char*) &len, sizeof(unsigned int));
-  if (len>255)
-  {
-    DuskLog() << "ObjectRecord::loadFromStream: ERROR: ID cannot be longer than "
-              << "255 characters.\n";
-    return false;
-  }
   //read ID
-  memset(ID_Buffer, 0, 256);
-  inStream.read(ID_Buffer, len);
-  ID_Buffer[len] = '\0'; //add terminating null character
-  if (!inStream.good())
+  std::string newID;
+  if (!inStream.readString(newID))
   {
-    DuskLog() << "ObjectRecord::loadFromStream: ERROR while reading data.\n";
+    DuskLog() << "ObjectRecord::loadFromStream: ERROR while reading data. ID "
+              << "cannot be longer than 255 characters.\n";
     return false;
   }
-  //read length of mesh name
-  inStream.read((char*) &len, sizeof(unsigned int));
-  if (len>255)
+  //read mesh
+  std::string newMesh;
+  if (!inStream.readString(newMesh))
   {
-    DuskLog() << "ObjectRecord::loadFromStream: ERROR: Name of Mesh cannot be "
-              << "longer than 255 characters.\n";
+    DuskLog() << "ObjectRecord::loadFromStream: ERROR while reading data. Name"
+              << " of Mesh cannot be longer than 255 characters.\n";
     return false;
   }
-  //read mesh
-  memset(Mesh_Buffer, 0, 256);
-  inStream.read(Mesh_Buffer, len);
-  Mesh_Buffer[len] = '\0'; //add terminating null character
   //read collision flag
   bool collision_flag = true;
-  inStream.read((char*) &collision_flag, sizeof(bool));
+  inStream.readBool(collision_flag);
   if (!inStream.good())
   {
     DuskLog() << "ObjectRecord::loadFromStream: ERROR while reading data.\n";
     return false;
   }
   //now set the data
-  ID = std::string(ID_Buffer);
-  Mesh = std::string(Mesh_Buffer);
+  ID = newID;
+  Mesh = newMesh;
   collide = collision_flag;
   return true;
 }
@@ -59,7 +59,8 @@
 #ifndef DUSK_OBJECTRECORD_H
 #define DUSK_OBJECTRECORD_H
 
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include "DataRecord.h"
 
 namespace Dusk
@@ -101,7 +102,7 @@ namespace Dusk
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -112,7 +113,7 @@ namespace Dusk
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
   }; //struct
 
 }//namespace
@@ -19,7 +19,6 @@
 */
 
 #include "ProjectileRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -34,7 +33,7 @@ uint32_t ProjectileRecord::getRecordType() const
 //record type identifier
 const uint32_t ProjectileRecord::RecordType = cHeaderProj;
 
-bool ProjectileRecord::saveToStream(std::ofstream& outStream) const
+bool ProjectileRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -42,26 +41,20 @@ bool ProjectileRecord::saveToStream(std::ofstream& outStream) const
     return false;
   }
 
-  uint32_t len = 0;
-
   //header "Proj"
-  outStream.write((const char*) &cHeaderProj, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderProj);
   //ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //Mesh
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
   //TTL
-  outStream.write((const char*) &DefaultTTL, sizeof(float));
+  outStream.writeFloat(DefaultTTL);
   //velocity
-  outStream.write((const char*) &DefaultVelocity, sizeof(float));
+  outStream.writeFloat(DefaultVelocity);
   //times
-  outStream.write((const char*) &times, sizeof(uint8_t));
+  outStream.writeUInt8(times);
   //dice
-  outStream.write((const char*) &dice, sizeof(uint8_t));
+  outStream.writeUInt8(dice);
   //check
   if (!outStream.good())
   {
@@ -73,7 +66,7 @@ bool ProjectileRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool ProjectileRecord::loadFromStream(std::ifstream& inStream)
+bool ProjectileRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
@@ -81,61 +74,35 @@ bool ProjectileRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   uint32_t len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
+  inStream.readUInt32(len);
   if (len != cHeaderProj)
   {
     DuskLog() << "ProjectileRecord::loadFromStream: ERROR: stream "
               << "contains unexpected header!\n";
     return false;
   }
-  char Buffer[256];
-  memset(Buffer, 0, 256);
   //read ID
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(ID))
   {
-    DuskLog() << "ProjectileRecord::loadFromStream: ERROR: ID is "
-              << "longer than 255 characters!\n";
-    return false;
-  }
-  inStream.read(Buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "ProjectileRecord::loadFromStream: ERROR while "
-              << "reading ID from stream!\n";
+    DuskLog() << "ProjectileRecord::loadFromStream: ERROR while reading ID "
+              << "from stream (or ID is longer than 255 characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  ID = std::string(Buffer);
-
   //read Mesh
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(Mesh))
   {
-    DuskLog() << "ProjectileRecord::loadFromStream: ERROR: mesh "
-              << "path is longer than 255 characters!\n";
+    DuskLog() << "ProjectileRecord::loadFromStream: ERROR while reading mesh "
+              << "path from stream (or path is longer than 255 characters)!\n";
     return false;
   }
-  inStream.read(Buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "ProjectileRecord::loadFromStream: ERROR while "
-              << "reading mesh path from stream!\n";
-    return false;
-  }
-  Buffer[len] = '\0';
-
-  Mesh = std::string(Buffer);
   //TTL
-  inStream.read((char*) &DefaultTTL, sizeof(float));
+  inStream.readFloat(DefaultTTL);
   //velocity
-  inStream.read((char*) &DefaultVelocity, sizeof(float));
+  inStream.readFloat(DefaultVelocity);
   //times
-  inStream.read((char*) &times, sizeof(uint8_t));
+  inStream.readUInt8(times);
   //dice
-  inStream.read((char*) &dice, sizeof(uint8_t));
+  inStream.readUInt8(dice);
   if (!inStream.good())
   {
     DuskLog() << "ProjectileRecord::loadFromStream: ERROR while "
@@ -21,7 +21,6 @@
 #include "ResourceRecord.h"
 #include "../DuskConstants.h"
 #include "../Messages.h"
-#include <cstring>
 
 namespace Dusk
 {
@@ -35,7 +34,7 @@ uint32_t ResourceRecord::getRecordType() const
 const uint32_t ResourceRecord::RecordType = cHeaderRsrc;
 
 
-bool ResourceRecord::saveToStream(std::ofstream& outStream) const
+bool ResourceRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -43,32 +42,20 @@ bool ResourceRecord::saveToStream(std::ofstream& outStream) const
      return false;
   }
 
-  uint32_t len = 0;
-
   //write header "Rsrc"
-  outStream.write((const char*) &cHeaderRsrc, 4); //Resource
+  outStream.writeUInt32(cHeaderRsrc); //Resource
   //write ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //write mesh (spawned state)
-  len = meshSpawned.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(meshSpawned.c_str(), len);
+  outStream.writeString(meshSpawned);
   //write mesh (harvested state)
-  len = meshHarvested.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(meshHarvested.c_str(), len);
+  outStream.writeString(meshHarvested);
   //write item ID
-  len = harvestItem.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(harvestItem.c_str(), len);
+  outStream.writeString(harvestItem);
   //write respawn interval
-  outStream.write((const char*) &respawnInterval, sizeof(float));
+  outStream.writeFloat(respawnInterval);
   //write harvest sound
-  len = harvestSound.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(harvestSound.c_str(), len);
+  outStream.writeString(harvestSound);
   //check
   if (!outStream.good())
   {
@@ -80,117 +67,59 @@ bool ResourceRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool ResourceRecord::loadFromStream(std::ifstream& inStream)
+bool ResourceRecord::loadFromStream(BinaryReader& inStream)
 {
   uint32_t Header = 0;
 
   //read header "Rsrc" (Resource)
-  inStream.read((char*) &Header, sizeof(uint32_t));
+  inStream.readUInt32(Header);
   if (Header!=cHeaderRsrc)
   {
     DuskLog() << "ResourceRecord::loadFromStream: ERROR: Stream contains invalid "
               << "record header.\n";
     return false;
   }//if
-  //read length of ID
-  uint32_t len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR: ID cannot be longer than "
-              << "255 characters.\n";
-    return false;
-  }
   //read ID
-  char buffer[256];
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(ID))
   {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
-    return false;
-  }
-  ID = std::string(buffer);
-  //read length of mesh (spawned)
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR: Mesh path cannot "
-              << "be longer than 255 characters.\n";
+    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading ID. ID "
+              << "cannot be longer than 255 characters.\n";
     return false;
   }
   //read mesh (spawned)
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
-    return false;
-  }
-  meshSpawned = std::string(buffer);
-
-  //read length of mesh (harvested)
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(meshSpawned))
   {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR: Mesh path cannot "
-              << "be longer than 255 characters.\n";
+    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading mesh "
+              << "path. Mesh path cannot be longer than 255 characters.\n";
     return false;
   }
   //read mesh (harvested)
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(meshHarvested))
   {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
-    return false;
-  }
-  meshHarvested = std::string(buffer);
-
-  //read length of item ID
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR: Item ID cannot "
-              << "be longer than 255 characters.\n";
+    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading mesh "
+              << "path. Mesh path cannot be longer than 255 characters.\n";
     return false;
   }
   //read item ID
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(harvestItem))
   {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
+    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading item ID."
+              << " Item ID cannot be longer than 255 characters.\n";
     return false;
   }
-  harvestItem = std::string(buffer);
-
   //read respawn interval
-  inStream.read((char*) &respawnInterval, sizeof(float));
-  if (!inStream.good())
+  if (!inStream.readFloat(respawnInterval))
   {
     DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
     return false;
   }
-
-  //read length of sound ID
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR: Sound ID cannot "
-              << "be longer than 255 characters.\n";
-    return false;
-  }
   //read sound ID
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(harvestSound))
   {
-    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading data.\n";
+    DuskLog() << "ResourceRecord::loadFromStream: ERROR while reading sound "
+              << "ID. Sound ID cannot be longer than 255 characters.\n";
     return false;
   }
-  harvestSound = std::string(buffer);
-
   return true;
 }
 
@@ -19,7 +19,6 @@
 */
 
 #include "SoundRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -34,7 +33,7 @@ uint32_t SoundRecord::getRecordType() const
 //record type identifier (usually the value returned by the above function)
 const uint32_t SoundRecord::RecordType = cHeaderSoun;
 
-bool SoundRecord::saveToStream(std::ofstream& outStream) const
+bool SoundRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -43,15 +42,11 @@ bool SoundRecord::saveToStream(std::ofstream& outStream) const
   }
 
   //write header "Soun"
-  outStream.write((const char*) &cHeaderSoun, sizeof(uint32_t)); //Sound
+  outStream.writeUInt32(cHeaderSoun); //Sound
   //write ID
-  uint32_t len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //write path
-  len = filePath.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(filePath.c_str(), len);
+  outStream.writeString(filePath);
   //check
   if (!outStream.good())
   {
@@ -63,52 +58,31 @@ bool SoundRecord::saveToStream(std::ofstream& outStream) const
   return outStream.good();
 }
 
-bool SoundRecord::loadFromStream(std::ifstream& inStream)
+bool SoundRecord::loadFromStream(BinaryReader& inStream)
 {
   uint32_t len = 0;
   //read header "Soun" (Sound)
-  inStream.read((char*) &len, sizeof(uint32_t));
+  inStream.readUInt32(len);
   if (len!=cHeaderSoun)
   {
     DuskLog() << "SoundRecord::loadFromStream: ERROR: Stream contains invalid "
               << "record header.\n";
     return false;
   }//if
-  //read length of ID
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "SoundRecord::loadFromStream: ERROR: ID cannot be longer than "
-              << "255 characters.\n";
-    return false;
-  }
   //read ID
-  char buffer[256];
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "SoundRecord::loadFromStream: ERROR while reading ID.\n";
-    return false;
-  }
-  ID = std::string(buffer);
-  //read length of path
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(ID))
   {
-    DuskLog() << "SoundRecord::loadFromStream: ERROR: File path cannot "
-              << "be longer than 255 characters.\n";
+    DuskLog() << "SoundRecord::loadFromStream: ERROR while reading ID. ID "
+              << "cannot be longer than 255 characters.\n";
     return false;
   }
-  //read mesh
-  memset(buffer, 0, 256);
-  inStream.read(buffer, len);
-  if (!inStream.good())
+  //read path
+  if (!inStream.readString(filePath))
   {
-    DuskLog() << "SoundRecord::loadFromStream: ERROR while reading path data.\n";
+    DuskLog() << "SoundRecord::loadFromStream: ERROR while reading path data."
+              << " File path cannot be longer than 255 characters.\n";
     return false;
   }
-  filePath = std::string(buffer);
 
   return (!filePath.empty() and !ID.empty());
 }
@@ -37,7 +37,7 @@ uint32_t VehicleRecord::getRecordType() const
 const uint32_t VehicleRecord::RecordType = cHeaderVehi;
 
 
-bool VehicleRecord::saveToStream(std::ofstream& outStream) const
+bool VehicleRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -45,53 +45,37 @@ bool VehicleRecord::saveToStream(std::ofstream& outStream) const
     return false;
   }
 
-  uint32_t len = 0;
-  float temp;
-
   //header "Vehi"
-  outStream.write((const char*) &cHeaderVehi, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderVehi);
   //ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //Mesh
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
   //Name
-  len = Name.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Name.c_str(), len);
+  outStream.writeString(Name);
   //MaxSpeed
-  outStream.write((const char*) &MaxSpeed, sizeof(MaxSpeed));
+  outStream.writeFloat(MaxSpeed);
   //number of Mountpoints
-  len = Mountpoints.size();
-  outStream.write((const char*) &len, sizeof(len));
+  outStream.writeUInt32(Mountpoints.size());
   //write mountpoint data
-  for (len=0; len<Mountpoints.size(); ++len)
+  unsigned int i;
+  for (i=0; i<Mountpoints.size(); ++i)
   {
     // -- offset
-    temp = Mountpoints.at(len).offset.x;
-    outStream.write((const char*) &temp, sizeof(float));
-    temp = Mountpoints.at(len).offset.y;
-    outStream.write((const char*) &temp, sizeof(float));
-    temp = Mountpoints.at(len).offset.z;
-    outStream.write((const char*) &temp, sizeof(float));
+    outStream.writeFloat(Mountpoints[i].offset.x);
+    outStream.writeFloat(Mountpoints[i].offset.y);
+    outStream.writeFloat(Mountpoints[i].offset.z);
     // -- rotation
-    temp = Mountpoints.at(len).rotation.w;
-    outStream.write((const char*) &temp, sizeof(float));
-    temp = Mountpoints.at(len).rotation.x;
-    outStream.write((const char*) &temp, sizeof(float));
-    temp = Mountpoints.at(len).rotation.y;
-    outStream.write((const char*) &temp, sizeof(float));
-    temp = Mountpoints.at(len).rotation.z;
-    outStream.write((const char*) &temp, sizeof(float));
+    outStream.writeFloat(Mountpoints[i].rotation.w);
+    outStream.writeFloat(Mountpoints[i].rotation.x);
+    outStream.writeFloat(Mountpoints[i].rotation.y);
+    outStream.writeFloat(Mountpoints[i].rotation.z);
   }//for
 
   return outStream.good();
 }
 
-bool VehicleRecord::loadFromStream(std::ifstream& inStream)
+bool VehicleRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
@@ -100,72 +84,38 @@ bool VehicleRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   uint32_t len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
+  inStream.readUInt32(len);
   if (len != cHeaderVehi)
   {
     DuskLog() << "VehicleRecord::loadFromStream: ERROR: stream "
               << "contains unexpected header!\n";
     return false;
   }
-  char Buffer[256];
-  memset(Buffer, 0, 256);
   //read ID
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "VehicleRecord::loadFromStream: ERROR: ID is longer "
-              << "than 255 characters!\n";
-    return false;
-  }
-  inStream.read(Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(ID))
   {
     DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading "
-              << "ID from stream!\n";
+              << "ID from stream (or ID is longer than 255 characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  ID = std::string(Buffer);
   //read mesh
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "VehicleRecord::loadFromStream: ERROR: mesh path of "
-              << "vehicle \""<<ID<<"\" is longer than 255 characters!\n";
-    return false;
-  }
-  memset(Buffer, 0, 256);
-  inStream.read(Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(Mesh))
   {
-    DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading "
-              << "mesh path from stream!\n";
+    DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading mesh path"
+              << " of vehicle \""<<ID<<"\" from stream (or path is longer than"
+              << " 255 characters)!\n";
     return false;
   }
-  Mesh = std::string(Buffer);
   //read name
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(Name))
   {
-    DuskLog() << "VehicleRecord::loadFromStream: ERROR: name of vehicle \""
-              << ID <<"\" is longer than 255 characters!\n";
-    return false;
-  }
-  memset(Buffer, 0, 256);
-  inStream.read(Buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading "
-              << "name from stream!\n";
+    DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading name of "
+              << "vehicle \""<<ID<<"\" from stream (or name is longer than 255"
+              << " characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  Name = std::string(Buffer);
   //MaxSpeed
-  inStream.read((char*) &MaxSpeed, sizeof(MaxSpeed));
+  inStream.readFloat(MaxSpeed);
   if (MaxSpeed<0.0f)
   {
     DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading "
@@ -174,7 +124,7 @@ bool VehicleRecord::loadFromStream(std::ifstream& inStream)
   }
   //number of Mountpoints
   len = 0;
-  inStream.read((char*) &len, sizeof(len));
+  inStream.readUInt32(len);
   if (!inStream.good())
   {
     DuskLog() << "VehicleRecord::loadFromStream: ERROR while reading "
@@ -197,15 +147,15 @@ bool VehicleRecord::loadFromStream(std::ifstream& inStream)
   for (i=0; i<len; ++i)
   {
     // -- offset first
-    inStream.read((char*) &x, sizeof(float));
-    inStream.read((char*) &y, sizeof(float));
-    inStream.read((char*) &z, sizeof(float));
+    inStream.readFloat(x);
+    inStream.readFloat(y);
+    inStream.readFloat(z);
     mpd.offset = Ogre::Vector3(x,y,z);
     // -- rotation
-    inStream.read((char*) &w, sizeof(float));
-    inStream.read((char*) &x, sizeof(float));
-    inStream.read((char*) &y, sizeof(float));
-    inStream.read((char*) &z, sizeof(float));
+    inStream.readFloat(w);
+    inStream.readFloat(x);
+    inStream.readFloat(y);
+    inStream.readFloat(z);
     mpd.rotation = Ogre::Quaternion(w,x,y,z);
     if (!inStream.good())
     {
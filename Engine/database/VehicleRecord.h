@@ -49,7 +49,8 @@
 #define DUSK_VEHICLERECORD_H
 
 #include <vector>
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include <OgreVector3.h>
 #include "DataRecord.h"
 
@@ -81,7 +82,7 @@ namespace Dusk
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -92,7 +93,7 @@ namespace Dusk
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
 }; //struct
 
 } //namespace
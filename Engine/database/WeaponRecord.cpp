@@ -19,7 +19,6 @@
 */
 
 #include "WeaponRecord.h"
-#include <cstring>
 #include "../DuskConstants.h"
 #include "../Messages.h"
 
@@ -34,7 +33,7 @@ uint32_t WeaponRecord::getRecordType() const
 //record type identifier
 const uint32_t WeaponRecord::RecordType = cHeaderWeap;
 
-bool WeaponRecord::saveToStream(std::ofstream& outStream) const
+bool WeaponRecord::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -42,44 +41,34 @@ bool WeaponRecord::saveToStream(std::ofstream& outStream) const
     return false;
   }
 
-  uint32_t len = 0;
-
   //header "Weap"
-  outStream.write((const char*) &cHeaderWeap, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderWeap);
   //ID
-  len = ID.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(ID.c_str(), len);
+  outStream.writeString(ID);
   //Mesh
-  len = Mesh.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Mesh.c_str(), len);
+  outStream.writeString(Mesh);
   //Name
-  len = Name.length();
-  outStream.write((const char*) &len, sizeof(uint32_t));
-  outStream.write(Name.c_str(), len);
+  outStream.writeString(Name);
   //value
-  outStream.write((const char*) &value, sizeof(value));
+  outStream.writeInt32(value);
   //weight
-  outStream.write((const char*) &weight, sizeof(float));
+  outStream.writeFloat(weight);
   //type
-  outStream.write((const char*) &Type, sizeof(WeaponType));
+  outStream.writeUInt32(static_cast<uint32_t>(Type));
   //range
-  outStream.write((const char*) &Range, sizeof(float));
+  outStream.writeFloat(Range);
   //time between attacks
-  outStream.write((const char*) &TimeBetweenAttacks, sizeof(float));
+  outStream.writeFloat(TimeBetweenAttacks);
   //projectile ID
-  len = ProjectileID.length();
-  outStream.write((const char*) &len, sizeof(len));
-  outStream.write(ProjectileID.c_str(), len);
+  outStream.writeString(ProjectileID);
   //damage
-  outStream.write((const char*) &DamageTimes, sizeof(uint8_t));
-  outStream.write((const char*) &DamageDice, sizeof(uint8_t));
+  outStream.writeUInt8(DamageTimes);
+  outStream.writeUInt8(DamageDice);
 
   return outStream.good();
 }
 
-bool WeaponRecord::loadFromStream(std::ifstream& inStream)
+bool WeaponRecord::loadFromStream(BinaryReader& inStream)
 {
   if (!inStream.good())
   {
@@ -88,81 +77,46 @@ bool WeaponRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   uint32_t len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
+  inStream.readUInt32(len);
   if (len != cHeaderWeap)
   {
     DuskLog() << "WeaponRecord::loadFromStream: ERROR: stream contains"
               << " unexpected header!\n";
     return false;
   }
-  char Buffer[256];
-  memset(Buffer, 0, 256);
   //read ID
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR: ID is longer "
-              << "than 255 characters!\n";
-    return false;
-  }
-  inStream.read(Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(ID))
   {
     DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading "
-              << "ID from stream!\n";
+              << "ID from stream (or ID is longer than 255 characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  ID = std::string(Buffer);
   //read mesh
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR: mesh path is "
-              << "longer than 255 characters!\n";
-    return false;
-  }
-  memset(Buffer, 0, 256);
-  inStream.read(Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(Mesh))
   {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading "
-              << "mesh path from stream!\n";
+    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading mesh path "
+              << "from stream (or path is longer than 255 characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  Mesh = std::string(Buffer);
   //read name
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!inStream.readString(Name))
   {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR: name is longer"
-              << " than 255 characters!\n";
+    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading name "
+              << "from stream (or name is longer than 255 characters)!\n";
     return false;
   }
-  memset(Buffer, 0, 256);
-  inStream.read(Buffer, len);
-  if (!inStream.good())
-  {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading "
-              << "name from stream!\n";
-    return false;
-  }
-  Buffer[len] = '\0';
-  Name = std::string(Buffer);
   //value
-  inStream.read((char*) &value, sizeof(value));
+  inStream.readInt32(value);
   //weight
-  inStream.read((char*) &weight, sizeof(float));
+  inStream.readFloat(weight);
   //type
-  inStream.read((char*) &Type, sizeof(WeaponType));
+  len = 0;
+  inStream.readUInt32(len);
+  Type = static_cast<WeaponType>(len);
   //range
-  inStream.read((char*) &Range, sizeof(float));
+  inStream.readFloat(Range);
   //time between attacks
-  inStream.read((char*) &TimeBetweenAttacks, sizeof(float));
+  inStream.readFloat(TimeBetweenAttacks);
   if (!inStream.good())
   {
     DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading "
@@ -176,27 +130,15 @@ bool WeaponRecord::loadFromStream(std::ifstream& inStream)
     return false;
   }
   //projectile ID
-  len = 0;
-  inStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
-  {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR: projectile ID is"
-              << " longer than 255 characters!\n";
-    return false;
-  }
-  memset(Buffer, 0, 256);
-  inStream.read(Buffer, len);
-  if (!inStream.good())
+  if (!inStream.readString(ProjectileID))
   {
-    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading "
-              << "projectile from stream!\n";
+    DuskLog() << "WeaponRecord::loadFromStream: ERROR while reading projectile"
+              << " from stream (or its ID is longer than 255 characters)!\n";
     return false;
   }
-  Buffer[len] = '\0';
-  ProjectileID = std::string(Buffer);
   //damage
-  inStream.read((char*) &DamageTimes, sizeof(uint8_t));
-  inStream.read((char*) &DamageDice, sizeof(uint8_t));
+  inStream.readUInt8(DamageTimes);
+  inStream.readUInt8(DamageDice);
   return inStream.good();
 }
 
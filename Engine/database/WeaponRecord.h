@@ -51,7 +51,8 @@
 #define DUSK_WEAPONRECORD_H
 
 #include <string>
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include "DataRecord.h"
 
 namespace Dusk
@@ -94,7 +95,7 @@ struct WeaponRecord: public DataRecord
        parameters:
            outStream - the output stream to which the data will be saved
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load the data record from stream inStream and returns true on
        success, false otherwise.
@@ -105,7 +106,7 @@ struct WeaponRecord: public DataRecord
        remarks:
            The record may have inconsistent data, if the function fails.
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
 }; //struct
 
 } //namespace
@@ -19,6 +19,7 @@
 */
 
 #include "LuaBindingsAnimated.h"
+#include "LuaObjectHandles.h"
 #include "../InjectionManager.h"
 #include "../objects/Player.h"
 
@@ -32,8 +33,7 @@ int GetPlayer(lua_State *L)
 {
   if (lua_gettop(L)==0)
   {
-    AnimatedObject* a = &(Player::getSingleton());
-    lua_pushlightuserdata(L, a);
+    pushNPC(L, &(Player::getSingleton()));
     return 1;
   }
   lua_pushstring(L, "GetPlayer does not expect any arguments!\n");
@@ -45,7 +45,7 @@ int GetAnimated(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    lua_pushlightuserdata(L, InjectionManager::getSingleton().getAnimatedObjectReference(lua_tostring(L, 1)));
+    pushAnimated(L, InjectionManager::getSingleton().getAnimatedObjectReference(lua_tostring(L, 1)));
     return 1;
   }
   lua_pushstring(L, "GetAnimated expects exactly one argument!\n");
@@ -57,7 +57,7 @@ int GetAnimatedLoop(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    const AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    const AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       if (aniPtr->getLoopState(lua_tostring(L, 2)))
@@ -83,7 +83,7 @@ int GetAnimatedAnimations(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    const AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       const std::vector<std::string> result = aniPtr->getCurrentAnimations();
@@ -107,7 +107,7 @@ int AnimatedStartAnimation(lua_State *L)
 {
   if (lua_gettop(L)==3)
   {
-    AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       if (aniPtr->startAnimation(lua_tostring(L, 2), lua_toboolean(L, 3)))
@@ -128,7 +128,7 @@ int AnimatedStopAnimation(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       if (aniPtr->stopAnimation(lua_tostring(L, 2)))
@@ -149,7 +149,7 @@ int AnimatedStopAllAnimations(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       lua_pushnumber(L, aniPtr->stopAllAnimations());
@@ -168,7 +168,7 @@ int AnimatedIsAnimationActive(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    const AnimatedObject* aniPtr = static_cast<AnimatedObject*> (lua_touserdata(L, 1));
+    const AnimatedObject* aniPtr = toAnimated(L, 1);
     if (aniPtr!=NULL)
     {
       if (aniPtr->isAnimationActive(lua_tostring(L, 2)))
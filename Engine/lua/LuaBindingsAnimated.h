@@ -27,6 +27,7 @@
      - 2010-05-21 (rev 206) - initial version (by thoronador)
      - 2010-05-27 (rev 209) - bindings for new methods of AnimatedObject
      - 2010-07-31 (rev 219) - update to reflect changes of AnimatedObject
+     - 2026-10-19           - objects are passed as typed handles
 
  ToDo list:
      - ???
@@ -45,20 +46,21 @@ namespace Dusk
 
 namespace Lua
 {
-  /* returns the Player
+  /* returns the Player as NPC handle
 
      return value(s) on stack: 1
-         #1 (userdata) - pointer to the Player object
+         #1 (userdata) - handle of the Player object
 
      expected stack parameters: 0
          nothing/ nil
   */
   int GetPlayer(lua_State *L);
 
-  /* returns the requested AnimatedObject as pointer/light userdata
+  /* returns the requested AnimatedObject as handle, or nil, if there is no
+     such object
 
      return value(s) on stack: 1
-         #1 (userdata) - pointer to the AnimatedObject
+         #1 (userdata) - handle of the AnimatedObject
 
      expected stack parameters: 1
          #1 (string) - ID of the AnimatedObject
@@ -19,6 +19,7 @@
 */
 
 #include "LuaBindingsNPC.h"
+#include "LuaObjectHandles.h"
 #include "../objects/NPC.h"
 #include "../InjectionManager.h"
 
@@ -31,7 +32,7 @@ int GetNPC(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    lua_pushlightuserdata(L, InjectionManager::getSingleton().getNPCReference(lua_tostring(L, 1)));
+    pushNPC(L, InjectionManager::getSingleton().getNPCReference(lua_tostring(L, 1)));
     return 1;
   }
   lua_pushstring(L, "GetNPC expects exactly one argument!\n");
@@ -43,7 +44,7 @@ int GetHealth(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float health = npcPtr->getHealth();
@@ -62,7 +63,7 @@ int SetHealth(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       npcPtr->setHealth(lua_tonumber(L, 2));
@@ -78,7 +79,7 @@ int GetLevel(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getLevel());
@@ -96,7 +97,7 @@ int GetStrength(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getStrength());
@@ -114,7 +115,7 @@ int GetAgility(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getAgility());
@@ -132,7 +133,7 @@ int GetVitality(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getVitality());
@@ -150,7 +151,7 @@ int GetIntelligence(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getIntelligence());
@@ -168,7 +169,7 @@ int GetWillpower(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getWillpower());
@@ -186,7 +187,7 @@ int GetCharisma(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getCharisma());
@@ -204,7 +205,7 @@ int GetLuck(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       lua_pushnumber(L, npcPtr->getLuck());
@@ -222,7 +223,7 @@ int SetLevel(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float level = lua_tonumber(L, 2);
@@ -250,7 +251,7 @@ int SetStrength(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float str = lua_tonumber(L, 2);
@@ -278,7 +279,7 @@ int SetAgility(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float agi = lua_tonumber(L, 2);
@@ -306,7 +307,7 @@ int SetVitality(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float vit = lua_tonumber(L, 2);
@@ -334,7 +335,7 @@ int SetIntelligence(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float intelligence = lua_tonumber(L, 2);
@@ -362,7 +363,7 @@ int SetWillpower(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float will = lua_tonumber(L, 2);
@@ -390,7 +391,7 @@ int SetCharisma(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float cha = lua_tonumber(L, 2);
@@ -418,7 +419,7 @@ int SetLuck(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const float luck = lua_tonumber(L, 2);
@@ -446,7 +447,7 @@ int IsFemale(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->isFemale())
@@ -465,7 +466,7 @@ int AddItem(lua_State *L)
 {
   if (lua_gettop(L)==3)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (lua_type(L, 2)!=LUA_TSTRING)
@@ -482,7 +483,7 @@ int AddItem(lua_State *L)
       }
       const std::string itemID = lua_tostring(L, 2);
       const unsigned int amount = static_cast<unsigned int>(lua_tonumber(L, 3));
-      npcPtr->getInventory().addItem(itemID, amount);
+      npcPtr->addItem(itemID, amount);
     }
     return 0;
   }
@@ -496,12 +497,12 @@ int RemoveItem(lua_State *L)
 {
   if (lua_gettop(L)==3)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const std::string itemID = lua_tostring(L, 2);
       const unsigned int amount = static_cast<unsigned int> (lua_tonumber(L, 3));
-      lua_pushnumber(L, npcPtr->getInventory().removeItem(itemID, amount));
+      lua_pushnumber(L, npcPtr->removeItem(itemID, amount));
       return 1;
     }
     return 0;
@@ -515,7 +516,7 @@ int GetItemCount(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       const std::string itemID = lua_tostring(L, 2);
@@ -533,7 +534,7 @@ int NPCEquip(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->equip(lua_tostring(L, 2)))
@@ -554,7 +555,7 @@ int NPCUnequip(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->unequip(lua_tostring(L, 2)))
@@ -575,7 +576,7 @@ int NPCHasEquipped(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    const NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    const NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->hasEquipped(lua_tostring(L, 2)))
@@ -596,7 +597,7 @@ int NPCAttack(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->startAttack())
@@ -617,7 +618,7 @@ int NPCStopAttack(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    NPC* npcPtr = static_cast<NPC*> (lua_touserdata(L, 1));
+    NPC* npcPtr = toNPC(L, 1);
     if (npcPtr!=NULL)
     {
       if (npcPtr->stopAttack())
@@ -29,6 +29,7 @@
      - 2010-05-21 (rev 206) - documentation updated and small improvements
      - 2010-06-03 (rev 214) - small improvement to get rid of compiler warnings
      - 2010-06-11 (rev 218) - functions for equipped items and attack added
+     - 2026-10-19           - NPCs are passed as typed handles
 
  ToDo list:
      - ???
@@ -47,10 +48,10 @@ namespace Dusk
 
 namespace Lua
 {
-  /* returns the requested NPC as pointer/light userdata
+  /* returns the requested NPC as handle, or nil, if there is no such NPC
 
      return value(s) on stack: 1
-         #1 (userdata) - pointer to the NPC
+         #1 (userdata) - handle of the NPC
 
      expected stack parameters: 1
          #1 (string) - ID of the NPC
@@ -19,6 +19,7 @@
 */
 
 #include "LuaBindingsObject.h"
+#include "LuaObjectHandles.h"
 #include "../objects/DuskObject.h"
 #include "../ObjectManager.h"
 #include "../API.h"
@@ -33,7 +34,7 @@ int GetObject(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    lua_pushlightuserdata(L, ObjectManager::getSingleton().getObjectByID(lua_tostring(L, 1)));
+    pushObject(L, ObjectManager::getSingleton().getObjectByID(lua_tostring(L, 1)));
     return 1;
   }
   lua_pushstring(L, "GetObject expects exactly one argument!\n");
@@ -45,18 +46,11 @@ int IsValidObject(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const int lt = lua_type(L, 1);
-    if ((lt == LUA_TLIGHTUSERDATA) or (lt == LUA_TUSERDATA))
-    {
-      const void* p = lua_touserdata(L, 1);
-      //const DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
-      if (p!=NULL)
-      {
-        lua_pushboolean(L, 1);
-        return 1;
-      }
-    }//if userdata
-    lua_pushboolean(L, 0);
+    //handles of destroyed objects are not valid
+    if (toObject(L, 1)!=NULL)
+      lua_pushboolean(L, 1);
+    else
+      lua_pushboolean(L, 0);
     return 1;
   }
   lua_pushstring(L, "IsValidObject expects exactly one argument!\n");
@@ -82,7 +76,7 @@ int Enable(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       if (objPtr->enable(getAPI().getOgreSceneManager()))
@@ -104,7 +98,7 @@ int Disable(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       if (objPtr->disable())
@@ -126,7 +120,7 @@ int IsEnabled(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    const DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       if (objPtr->isEnabled())
@@ -148,7 +142,7 @@ int GetObjectPosition(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    const DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       const Ogre::Vector3 vec = objPtr->getPosition();
@@ -170,7 +164,7 @@ int SetObjectPosition(lua_State *L)
 {
   if (lua_gettop(L)==4)
   {
-    DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       objPtr->setPosition(Ogre::Vector3(lua_tonumber(L, 2), lua_tonumber(L, 3),
@@ -192,7 +186,7 @@ int GetObjectRotation(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    const DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       const Ogre::Quaternion quat = objPtr->getRotation();
@@ -215,7 +209,7 @@ int SetObjectRotation(lua_State *L)
 {
   if (lua_gettop(L)==5)
   {
-    DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       objPtr->setRotation(Ogre::Quaternion(lua_tonumber(L, 2), lua_tonumber(L, 3),
@@ -237,7 +231,7 @@ int GetScale(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    const DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       lua_pushnumber(L, objPtr->getScale());
@@ -256,7 +250,7 @@ int SetScale(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    DuskObject* objPtr = static_cast<DuskObject*> (lua_touserdata(L, 1));
+    DuskObject* objPtr = toObject(L, 1);
     if (objPtr!=NULL)
     {
       if (objPtr->setScale(lua_tonumber(L, 2)))
@@ -32,6 +32,8 @@
                               a DuskObject
      - 2010-05-21 (rev 207) - documentation updated; Lua namespace added
      - 2010-11-20 (rev 255) - rotation is now stored as Quaternion
+     - 2026-10-19           - objects are passed as typed handles, so
+                              IsValidObject() detects destroyed objects
 
  ToDo list:
      - ???
@@ -51,17 +53,19 @@ namespace Dusk
 
 namespace Lua
 {
-  /* returns the object with the given ID, if present
+  /* returns the object with the given ID as handle, or nil, if there is no
+     such object
 
      return value(s) on stack: 1
-         #1 (userdata) - pointer to the static object
+         #1 (userdata) - handle of the static object
 
      expected stack parameters: 0
          #1 (string) - ID of the object
   */
   int GetObject(lua_State *L);
 
-  /* returns true, if the passed parameter is a valid object
+  /* returns true, if the passed parameter is a valid object, i.e. a handle of
+     an object that still exists
 
      return value(s) on stack: 1
          #1 (boolean) - true, if parameter #1 is a valid object,
@@ -0,0 +1,94 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "LuaBindingsScheduler.h"
+#include "LuaEngine.h"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+
+int Wait(lua_State *L)
+{
+  if (lua_gettop(L)==1)
+  {
+    const float seconds = lua_tonumber(L, 1);
+    if (LuaEngine::getSingleton().suspendScript(L, seconds, 0))
+    {
+      return lua_yield(L, 0);
+    }
+    lua_pushstring(L, "Wait() can only be used in scripts that were started by the script queue!\n");
+    lua_error(L);
+    return 0;
+  }
+  lua_pushstring(L, "Wait expects exactly one argument!\n");
+  lua_error(L);
+  return 0;
+}
+
+int WaitFrames(lua_State *L)
+{
+  if (lua_gettop(L)==1)
+  {
+    const lua_Number frames = lua_tonumber(L, 1);
+    if (LuaEngine::getSingleton().suspendScript(L, 0.0f,
+            (frames>0) ? static_cast<unsigned int>(frames) : 0))
+    {
+      return lua_yield(L, 0);
+    }
+    lua_pushstring(L, "WaitFrames() can only be used in scripts that were started by the script queue!\n");
+    lua_error(L);
+    return 0;
+  }
+  lua_pushstring(L, "WaitFrames expects exactly one argument!\n");
+  lua_error(L);
+  return 0;
+}
+
+int Yield(lua_State *L)
+{
+  if (lua_gettop(L)==0)
+  {
+    if (LuaEngine::getSingleton().suspendScript(L, 0.0f, 1))
+    {
+      return lua_yield(L, 0);
+    }
+    lua_pushstring(L, "Yield() can only be used in scripts that were started by the script queue!\n");
+    lua_error(L);
+    return 0;
+  }
+  lua_pushstring(L, "Yield does not expect any arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
+void registerScheduler(lua_State *L)
+{
+  lua_register(L, "Wait", Wait);
+  lua_register(L, "WaitFrames", WaitFrames);
+  lua_register(L, "Yield", Yield);
+}
+
+} //namespace Lua
+
+} //namespace Dusk
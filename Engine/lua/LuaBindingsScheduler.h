@@ -0,0 +1,89 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: Lua functions/bindings that let scripts wait
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - Untested. If you find any bugs, then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUABINDINGSSCHEDULER_H
+#define LUABINDINGSSCHEDULER_H
+
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+  /* All of these functions can only be used in scripts that were started by
+     LuaEngine::processScripts(), e.g. scripts from the console. Other code,
+     like dialogue conditions, is run to completion and cannot wait.
+  */
+
+  /* lets the script wait for the given time
+
+     return value(s) on stack: 0
+         nothing / nil
+
+     expected stack parameters: 1
+         #1 (number) - time to wait, in seconds
+  */
+  int Wait(lua_State *L);
+
+  /* lets the script wait for the given number of frames
+
+     return value(s) on stack: 0
+         nothing / nil
+
+     expected stack parameters: 1
+         #1 (number) - number of frames to wait
+  */
+  int WaitFrames(lua_State *L);
+
+  /* lets the script continue in the next frame
+
+     return value(s) on stack: 0
+         nothing / nil
+
+     expected stack parameters: 0
+         nothing / nil
+  */
+  int Yield(lua_State *L);
+
+  /* registers the above functions in Lua */
+  void registerScheduler(lua_State *L);
+
+} //namespace Lua
+
+} //namespace Dusk
+
+#endif // LUABINDINGSSCHEDULER_H
@@ -19,7 +19,11 @@
 */
 
 #include "LuaBindingsSound.h"
+#include "LuaObjectHandles.h"
 #include "../sound/Sound.h"
+#include "../sound/SoundStatistics.h"
+#include "../SoundEmitterManager.h"
+#include "../objects/DuskObject.h"
 
 namespace Dusk
 {
@@ -72,9 +76,11 @@ int DestroyNoise(lua_State *L)
 int CreateMedia(lua_State *L)
 {
   const int top = lua_gettop(L);
-  if (top==2)
+  if ((top==2) or (top==3))
   {
-    const bool success = Sound::get().createMedia(lua_tostring(L, 1), lua_tostring(L, 2));
+    //optional third argument: stream the file instead of decoding it at once
+    const bool streamed = (top==3) and (lua_toboolean(L, 3)!=0);
+    const bool success = Sound::get().createMedia(lua_tostring(L, 1), lua_tostring(L, 2), streamed);
     //push result
     if (success)
     {
@@ -86,7 +92,7 @@ int CreateMedia(lua_State *L)
     }
     return 1;
   }
-  lua_pushstring(L, "CreateMedia expects exactly two arguments!\n");
+  lua_pushstring(L, "CreateMedia expects two or three arguments!\n");
   lua_error(L);
   return 0;
 }
@@ -113,6 +119,37 @@ int DestroyMedia(lua_State *L)
   return 0;
 }
 
+int CreateMediaAsync(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==2)
+  {
+    const bool success = Sound::get().createMediaAsync(lua_tostring(L, 1), lua_tostring(L, 2));
+    //push result
+    lua_pushboolean(L, success ? 1 : 0);
+    return 1;
+  }
+  lua_pushstring(L, "CreateMediaAsync expects exactly two arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
+int PlayMediaWhenReady(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==2)
+  {
+    //attaches media to noise and plays it, once the media is loaded
+    const bool success = Sound::get().attachWhenReady(lua_tostring(L, 1), lua_tostring(L, 2), true);
+    //push result
+    lua_pushboolean(L, success ? 1 : 0);
+    return 1;
+  }
+  lua_pushstring(L, "PlayMediaWhenReady expects exactly two arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
 int AttachMediaToNoise(lua_State *L)
 {
   const int top = lua_gettop(L);
@@ -144,6 +181,43 @@ int DetachMediaFromNoise(lua_State *L)
   return 0;
 }
 
+int AttachNoiseToObject(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==2)
+  {
+    const DuskObject* objPtr = toObject(L, 2);
+    if (objPtr==NULL)
+    {
+      lua_pushstring(L, "AttachNoiseToObject() got NULL for object pointer!\n");
+      lua_error(L);
+      return 0;
+    }
+    const bool success = SoundEmitterManager::getSingleton().bind(lua_tostring(L, 1), objPtr);
+    //push result
+    lua_pushboolean(L, success ? 1 : 0);
+    return 1;
+  }
+  lua_pushstring(L, "AttachNoiseToObject expects exactly two arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
+int DetachNoiseFromObject(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==1)
+  {
+    const bool success = SoundEmitterManager::getSingleton().unbind(lua_tostring(L, 1));
+    //push result
+    lua_pushboolean(L, success ? 1 : 0);
+    return 1;
+  }
+  lua_pushstring(L, "DetachNoiseFromObject expects exactly one argument!\n");
+  lua_error(L);
+  return 0;
+}
+
 int PlaySound(lua_State *L)
 {
   const int top = lua_gettop(L);
@@ -296,15 +370,73 @@ int GetSoundVolume(lua_State *L)
   return 0;
 }
 
+int SetSoundPriority(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==2)
+  {
+    Sound::get().getSource(lua_tostring(L, 1)).setPriority(lua_tonumber(L, 2));
+    return 0;
+  }
+  lua_pushstring(L, "SetSoundPriority expects exactly two arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
+int SetMediaCacheBudget(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==1)
+  {
+    //budget is given in MB
+    const double megabytes = lua_tonumber(L, 1);
+    Sound::get().setCacheBudget(megabytes>0.0 ? (std::size_t)(megabytes*1024.0*1024.0) : 0);
+    return 0;
+  }
+  lua_pushstring(L, "SetMediaCacheBudget expects exactly one argument!\n");
+  lua_error(L);
+  return 0;
+}
+
+int SetSoundStatistics(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==1)
+  {
+    SoundStatistics::get().setEnabled(lua_toboolean(L, 1)!=0);
+    return 0;
+  }
+  lua_pushstring(L, "SetSoundStatistics expects exactly one argument!\n");
+  lua_error(L);
+  return 0;
+}
+
+int LogSoundStatistics(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if (top==0)
+  {
+    Sound::get().logStatistics();
+    return 0;
+  }
+  lua_pushstring(L, "LogSoundStatistics expects no arguments!\n");
+  lua_error(L);
+  return 0;
+}
+
 void registerSound(lua_State *L)
 {
   lua_register(L, "CreateNoise", CreateNoise);
   lua_register(L, "DestroyNoise", DestroyNoise);
   lua_register(L, "CreateMedia", CreateMedia);
   lua_register(L, "DestroyMedia", DestroyMedia);
+  lua_register(L, "CreateMediaAsync", CreateMediaAsync);
+  lua_register(L, "PlayMediaWhenReady", PlayMediaWhenReady);
 
   lua_register(L, "AttachMediaToNoise", AttachMediaToNoise);
   lua_register(L, "DetachMediaFromNoise", DetachMediaFromNoise);
+  lua_register(L, "AttachNoiseToObject", AttachNoiseToObject);
+  lua_register(L, "DetachNoiseFromObject", DetachNoiseFromObject);
 
   lua_register(L, "PlaySound", PlaySound);
   lua_register(L, "PauseSound", PauseSound);
@@ -318,6 +450,10 @@ void registerSound(lua_State *L)
 
   lua_register(L, "SetSoundVolume", SetSoundVolume);
   lua_register(L, "GetSoundVolume", GetSoundVolume);
+  lua_register(L, "SetSoundPriority", SetSoundPriority);
+  lua_register(L, "SetMediaCacheBudget", SetMediaCacheBudget);
+  lua_register(L, "SetSoundStatistics", SetSoundStatistics);
+  lua_register(L, "LogSoundStatistics", LogSoundStatistics);
 }
 
 } //namespace Lua
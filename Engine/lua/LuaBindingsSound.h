@@ -26,6 +26,11 @@
  History:
      - 2010-02-09 (rev 170) - initial version (by thoronador)
      - 2010-11-10 (rev 250) - update for corrected function names in Sound
+     - 2026-10-19           - CreateMediaAsync() and PlayMediaWhenReady() added
+     - 2026-10-19           - AttachNoiseToObject() and DetachNoiseFromObject()
+                              added
+     - 2026-10-19           - SetSoundStatistics() and LogSoundStatistics()
+                              added
 
  ToDo list:
      - ???
@@ -49,8 +54,12 @@ int CreateNoise(lua_State *L);
 int DestroyNoise(lua_State *L);
 int CreateMedia(lua_State *L);
 int DestroyMedia(lua_State *L);
+int CreateMediaAsync(lua_State *L);
+int PlayMediaWhenReady(lua_State *L);
 int AttachMediaToNoise(lua_State *L);
 int DetachMediaFromNoise(lua_State *L);
+int AttachNoiseToObject(lua_State *L);
+int DetachNoiseFromObject(lua_State *L);
 
 int PlaySound(lua_State *L);
 int PauseSound(lua_State *L);
@@ -65,6 +74,13 @@ int SoundIsLooping(lua_State *L);
 int SetSoundVolume(lua_State *L);
 int GetSoundVolume(lua_State *L);
 
+int SetSoundPriority(lua_State *L);
+
+int SetMediaCacheBudget(lua_State *L);
+
+int SetSoundStatistics(lua_State *L);
+int LogSoundStatistics(lua_State *L);
+
 //called to register all of the above functions
 void registerSound(lua_State *L);
 
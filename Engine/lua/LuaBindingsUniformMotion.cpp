@@ -19,6 +19,7 @@
 */
 
 #include "LuaBindingsUniformMotion.h"
+#include "LuaObjectHandles.h"
 #include "../objects/UniformMotionObject.h"
 
 namespace Dusk
@@ -31,7 +32,7 @@ int GetDirection(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    const UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       const Ogre::Vector3 vec = umPtr->getDirection();
@@ -53,7 +54,7 @@ int SetDirection(lua_State *L)
 {
   if (lua_gettop(L)==4)
   {
-    UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       umPtr->setDirection(Ogre::Vector3(lua_tonumber(L, 2), lua_tonumber(L, 3),
@@ -73,7 +74,7 @@ int GetSpeed(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    const UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       lua_pushnumber(L, umPtr->getSpeed());
@@ -92,7 +93,7 @@ int SetSpeed(lua_State *L)
 {
   if (lua_gettop(L)==2)
   {
-    UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       umPtr->setSpeed(lua_tonumber(L, 2));
@@ -111,7 +112,7 @@ int GetDestination(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    const UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       const Ogre::Vector3 vec = umPtr->getDestination();
@@ -133,7 +134,7 @@ int TravelToDestination(lua_State *L)
 {
   if (lua_gettop(L)==4)
   {
-    UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       umPtr->travelToDestination(Ogre::Vector3(lua_tonumber(L, 2), lua_tonumber(L, 3),
@@ -153,7 +154,7 @@ int IsOnTravel(lua_State *L)
 {
   if (lua_gettop(L)==1)
   {
-    const UniformMotionObject* umPtr = static_cast<UniformMotionObject*> (lua_touserdata(L, 1));
+    const UniformMotionObject* umPtr = toUniformMotion(L, 1);
     if (umPtr!=NULL)
     {
       if (umPtr->isOnTravel())
@@ -27,6 +27,7 @@
  History:
      - 2010-05-21 (rev 207) - initial version (by thoronador)
      - 2010-08-31 (rev 239) - naming convention enforced
+     - 2026-10-19           - objects are passed as typed handles
 
  ToDo list:
      - ???
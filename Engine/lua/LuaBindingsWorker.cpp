@@ -0,0 +1,92 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "LuaBindingsWorker.h"
+#include "LuaEngine.h"
+#include "LuaWorkerPool.h"
+#include "../Messages.h"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+
+/* calls the Lua function with the given registry reference on the main state
+   and releases the reference
+*/
+void callWorkerCallback(const int reference, const bool success, const std::vector<LuaValue>& results)
+{
+  lua_State* L = LuaEngine::getSingleton();
+  const int top = lua_gettop(L);
+  lua_rawgeti(L, LUA_REGISTRYINDEX, reference);
+  lua_pushboolean(L, success ? 1 : 0);
+  unsigned int i;
+  for (i=0; i<results.size(); ++i)
+  {
+    results[i].push(L);
+  }//for
+  if (lua_pcall(L, results.size()+1, 0, 0)!=0)
+  {
+    DuskLog() << "Lua::callWorkerCallback: ERROR while calling the callback "
+              << "of RunOnWorker(). Lua's error message: \""
+              << lua_tostring(L, -1) << "\"\n";
+  }
+  lua_settop(L, top);
+  LuaEngine::getSingleton().releaseReference(reference);
+}
+
+int RunOnWorker(lua_State *L)
+{
+  const int top = lua_gettop(L);
+  if ((top>=2) and (lua_type(L, 1)==LUA_TSTRING) and (lua_type(L, 2)==LUA_TFUNCTION))
+  {
+    std::vector<LuaValue> input(top-2);
+    int i;
+    for (i=3; i<=top; ++i)
+    {
+      if (!input[i-3].read(L, i))
+      {
+        lua_pushstring(L, "RunOnWorker() can only pass nil, boolean, number and string values!\n");
+        lua_error(L);
+        return 0;
+      }
+    }//for
+    const std::string code(lua_tostring(L, 1), lua_strlen(L, 1));
+    lua_pushvalue(L, 2);
+    const int reference = luaL_ref(L, LUA_REGISTRYINDEX);
+    LuaWorkerPool::getSingleton().run(code, input,
+        std::bind(callWorkerCallback, reference, std::placeholders::_1, std::placeholders::_2));
+    return 0;
+  }
+  lua_pushstring(L, "RunOnWorker expects at least two arguments: code (string) and callback (function)!\n");
+  lua_error(L);
+  return 0;
+}
+
+void registerWorker(lua_State *L)
+{
+  lua_register(L, "RunOnWorker", RunOnWorker);
+}
+
+} //namespace Lua
+
+} //namespace Dusk
@@ -0,0 +1,71 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: Lua functions/bindings for running code on the Lua worker states
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - Untested. If you find any bugs, then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUABINDINGSWORKER_H
+#define LUABINDINGSWORKER_H
+
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+  /* runs Lua code on a worker state in another thread (see LuaWorkerPool)
+     and calls a function with the results in a later frame. The code cannot
+     use any of Dusk's functions, it only gets the values in the global table
+     input. The callback can then apply the results to the game.
+
+     return value(s) on stack: 0
+         nothing / nil
+
+     expected stack parameters: 2 or more
+         #1 (string)   - Lua code that shall be run on the worker state
+         #2 (function) - callback, gets a boolean that indicates success and
+                         the values returned by the code (or the error message)
+         #3, #4, ...   - (optional) nil, boolean, number or string values that
+                         will be available as input[1], input[2], ...
+  */
+  int RunOnWorker(lua_State *L);
+
+  /* registers the above function in Lua */
+  void registerWorker(lua_State *L);
+
+} //namespace Lua
+
+} //namespace Dusk
+
+#endif // LUABINDINGSWORKER_H
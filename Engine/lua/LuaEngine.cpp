@@ -19,7 +19,9 @@
 */
 
 #include "LuaEngine.h"
+#include <algorithm>
 #include <iostream>
+#include <set>
 #include "LuaBindingsSound.h"
 #include "LuaBindingsWeather.h"
 #include "LuaBindingsObject.h"
@@ -27,28 +29,89 @@
 #include "LuaBindingsAnimated.h"
 #include "LuaBindingsNPC.h"
 #include "LuaBindingsQuestLog.h"
+#include "LuaObjectHandles.h"
+#include "LuaBindingsScheduler.h"
+#include "LuaBindingsWorker.h"
+#include "LuaFFI.h"
+#include "LuaProfiler.h"
+#include "LuaTimeSlice.h"
 #include "../Messages.h"
 
 namespace Dusk
 {
 
+/* returns a short name for a chunk of Lua code, for the profiler */
+std::string getChunkName(const std::string& line)
+{
+  const std::string::size_type cMaxLength = 40;
+  const std::string::size_type len = std::min(line.find('\n'), cMaxLength);
+  if (len<line.length())
+    return line.substr(0, len)+"...";
+  return line;
+}
+
+#ifdef DUSK_LUAJIT
+void openJITLibraries(lua_State *L, const luaL_Reg* libraries)
+{
+  for (const luaL_Reg* lib = libraries; lib->func!=NULL; ++lib)
+  {
+    lua_pushcfunction(L, lib->func);
+    lua_pushstring(L, lib->name);
+    lua_call(L, 1, 0);
+  }//for
+}
+#endif
+
 LuaEngine::LuaEngine()
 {
   //empty
   m_Lua = NULL;
+  m_ChunkCache = LUA_NOREF;
+  m_CachedChunks = 0;
+  m_Tasks.clear();
+  m_NextTask = 0;
+  m_TimeBudget = 5.0f;
+  m_RunawayLimit = 2000.0f;
+  m_Preempted = false;
+  m_CurrentThread = NULL;
   m_Lua = lua_open();
   if (m_Lua!=NULL)
   {
+    //table for compiled chunks, keys are the source strings
+    lua_newtable(m_Lua);
+    m_ChunkCache = luaL_ref(m_Lua, LUA_REGISTRYINDEX);
+    #ifdef DUSK_LUAJIT
+    //the libraries that Dusk uses plus LuaJIT's own ones
+    const luaL_Reg cLibraries[] = {
+      {"", luaopen_base},
+      {LUA_LOADLIBNAME, luaopen_package},
+      {LUA_IOLIBNAME, luaopen_io},
+      {LUA_STRLIBNAME, luaopen_string},
+      {LUA_MATHLIBNAME, luaopen_math},
+      {LUA_BITLIBNAME, luaopen_bit},
+      {LUA_JITLIBNAME, luaopen_jit},
+      {NULL, NULL}
+    };
+    openJITLibraries(m_Lua, cLibraries);
+    //the ffi module is only loaded on require("ffi"), like luaL_openlibs()
+    // does it
+    luaL_findtable(m_Lua, LUA_REGISTRYINDEX, "_PRELOAD", 1);
+    lua_pushcfunction(m_Lua, luaopen_ffi);
+    lua_setfield(m_Lua, -2, LUA_FFILIBNAME);
+    lua_pop(m_Lua, 1);
+    DuskLog() << "LuaEngine: using " << LUAJIT_VERSION << ".\n";
+    #else
     luaopen_base(m_Lua);
     luaopen_io(m_Lua);
     luaopen_string(m_Lua);
     luaopen_math(m_Lua);
-    #ifdef DUSK_LUA50
-    luaopen_loadlib(m_Lua);
-    #elif defined(DUSK_LUA51)
-    luaopen_package(m_Lua);
-    #else
-      #error "Could not detect a supported Lua version!"
+      #ifdef DUSK_LUA50
+      luaopen_loadlib(m_Lua);
+      #elif defined(DUSK_LUA51)
+      luaopen_package(m_Lua);
+      #else
+        #error "Could not detect a supported Lua version!"
+      #endif
     #endif
     DuskLog() << "LuaEngine started, running " << LUA_VERSION << ".\n";
     runString("io.write('Lua says: this is ',_VERSION,'!\\n')");
@@ -64,6 +127,8 @@ LuaEngine::LuaEngine()
 LuaEngine::~LuaEngine()
 {
   //empty
+  //threads of running scripts are closed with the main state
+  m_Tasks.clear();
   lua_close(m_Lua);
   m_ScriptQueue.clear();
   DuskLog() << "LuaEngine stopped.\n";
@@ -75,18 +140,71 @@ LuaEngine& LuaEngine::getSingleton()
   return Instance;
 }
 
-bool LuaEngine::runString(const std::string& line, std::string* err_msg)
+int LuaEngine::loadChunk(const std::string& line)
 {
+  //Lua strings are hashed, so the source itself is a fast key
+  lua_rawgeti(m_Lua, LUA_REGISTRYINDEX, m_ChunkCache);
+  lua_pushlstring(m_Lua, line.c_str(), line.length());
+  lua_rawget(m_Lua, -2);
+  if (lua_isfunction(m_Lua, -1))
+  {
+    //cache hit - remove the table, keep the function
+    lua_remove(m_Lua, -2);
+    return 0;
+  }
+  lua_pop(m_Lua, 1);
+  if (m_CachedChunks>=cMaxCachedChunks)
+  {
+    //start over with a new, empty table
+    lua_pop(m_Lua, 1);
+    clearChunkCache();
+    lua_rawgeti(m_Lua, LUA_REGISTRYINDEX, m_ChunkCache);
+  }
+
   //load chunk and push it onto stack
   #ifdef DUSK_LUA51
   //Lua 5.1 stuff
-  int errCode = luaL_loadstring(m_Lua, line.c_str());
+  const int errCode = luaL_loadstring(m_Lua, line.c_str());
   #elif defined(DUSK_LUA50)
   //Lua 5.0 stuff
-  int errCode = luaL_loadbuffer(m_Lua, line.c_str(), line.length(), line.c_str());
+  const int errCode = luaL_loadbuffer(m_Lua, line.c_str(), line.length(), line.c_str());
   #else
     #error "LuaEngine could not detect a known Lua version!"
   #endif
+  if (errCode==0)
+  {
+    //stack: table, function
+    lua_pushlstring(m_Lua, line.c_str(), line.length());
+    lua_pushvalue(m_Lua, -2);
+    lua_rawset(m_Lua, -4);
+    ++m_CachedChunks;
+  }
+  //remove the table, keep the function or error message
+  lua_remove(m_Lua, -2);
+  return errCode;
+}
+
+void LuaEngine::clearChunkCache()
+{
+  if (m_Lua==NULL)
+    return;
+  luaL_unref(m_Lua, LUA_REGISTRYINDEX, m_ChunkCache);
+  lua_newtable(m_Lua);
+  m_ChunkCache = luaL_ref(m_Lua, LUA_REGISTRYINDEX);
+  m_CachedChunks = 0;
+}
+
+unsigned int LuaEngine::getNumberOfCachedChunks() const
+{
+  return m_CachedChunks;
+}
+
+bool LuaEngine::runString(const std::string& line, std::string* err_msg)
+{
+  //results and error messages are removed again, so the stack does not grow
+  const int top = lua_gettop(m_Lua);
+  //get the compiled chunk onto the stack
+  int errCode = loadChunk(line);
   switch (errCode)
   {
     case 0: //all went fine here
@@ -113,16 +231,27 @@ bool LuaEngine::runString(const std::string& line, std::string* err_msg)
     {
       *err_msg = std::string(lua_tostring(m_Lua, -1));
     }
+    lua_settop(m_Lua, top);
     return false;
   }//if
 
   //call/execute the loaded chunk
   // call with zero arguments (0), push all results (MULTRET), and use the
   //  standard error function (0)
+  const bool profiling = LuaProfiler::getSingleton().isRunning();
+  std::chrono::steady_clock::time_point start;
+  if (profiling)
+    start = std::chrono::steady_clock::now();
   errCode = lua_pcall(m_Lua, 0, LUA_MULTRET, 0);
+  if (profiling)
+  {
+    LuaProfiler::getSingleton().recordChunk(getChunkName(line),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count());
+  }
   switch (errCode)
   {
     case 0: //all went fine here
+         lua_settop(m_Lua, top);
          return true;
          break;
     case LUA_ERRRUN:
@@ -148,6 +277,7 @@ bool LuaEngine::runString(const std::string& line, std::string* err_msg)
   {
     *err_msg = std::string(lua_tostring(m_Lua, -1));
   }
+  lua_settop(m_Lua, top);
   return false;
 }
 
@@ -187,7 +317,16 @@ bool LuaEngine::runFile(const std::string& FileName, std::string* err_msg)
   //call/execute the loaded chunk
   // call with zero arguments (0), push all results (MULTRET), and use the
   //  standard error function (0)
+  const bool profiling = LuaProfiler::getSingleton().isRunning();
+  std::chrono::steady_clock::time_point start;
+  if (profiling)
+    start = std::chrono::steady_clock::now();
   errCode = lua_pcall(m_Lua, 0, LUA_MULTRET, 0);
+  if (profiling)
+  {
+    LuaProfiler::getSingleton().recordChunk(FileName,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count());
+  }
   switch (errCode)
   {
     case 0: //all went fine here
@@ -218,6 +357,47 @@ bool LuaEngine::runFile(const std::string& FileName, std::string* err_msg)
   return false;
 }
 
+int LuaEngine::createFunctionReference(const std::string& line, const std::string& functionName, std::string* err_msg)
+{
+  if (m_Lua==NULL)
+    return LUA_NOREF;
+  //set function to nil to prevent getting an earlier version
+  lua_pushstring(m_Lua, functionName.c_str());
+  lua_pushnil(m_Lua);
+  lua_settable(m_Lua, LUA_GLOBALSINDEX);
+  if (!runString(line, err_msg))
+  {
+    return LUA_NOREF;
+  }
+  lua_pushstring(m_Lua, functionName.c_str());
+  lua_gettable(m_Lua, LUA_GLOBALSINDEX);
+  if (lua_type(m_Lua, -1)!=LUA_TFUNCTION)
+  {
+    lua_pop(m_Lua, 1);
+    DuskLog() << "LuaEngine::createFunctionReference: ERROR: the code did not "
+              << "define a function named \"" << functionName << "\".\n";
+    if (err_msg!=NULL)
+    {
+      *err_msg = "no function named "+functionName;
+    }
+    return LUA_NOREF;
+  }
+  const int reference = luaL_ref(m_Lua, LUA_REGISTRYINDEX);
+  //the reference keeps the function, the global variable is not needed
+  lua_pushstring(m_Lua, functionName.c_str());
+  lua_pushnil(m_Lua);
+  lua_settable(m_Lua, LUA_GLOBALSINDEX);
+  return reference;
+}
+
+void LuaEngine::releaseReference(const int reference)
+{
+  if (m_Lua!=NULL)
+  {
+    luaL_unref(m_Lua, LUA_REGISTRYINDEX, reference);
+  }
+}
+
 void LuaEngine::addScript(const Dusk::Script& theScript)
 {
   m_ScriptQueue.push_back(theScript);
@@ -233,21 +413,202 @@ unsigned int LuaEngine::processScripts(unsigned int maxEntries)
   maxEntries = toDo;
   while (maxEntries>0)
   {
-    if (!runString(m_ScriptQueue.front().getStringRepresentation()))
+    //compiled chunk (or error message) is on top of the stack
+    if (loadChunk(m_ScriptQueue.front().getStringRepresentation())!=0)
     {
+      DuskLog() << "Lua's error message: \"" << lua_tostring(m_Lua, -1) <<"\"\n";
+      lua_pop(m_Lua, 1);
       m_ScriptQueue.pop_front();
       DuskLog() << "LuaEngine::processScripts: ERROR while processing script "
                 << toDo-maxEntries << " of " << toDo << ". Aborting.\n";
       return toDo-maxEntries;
     }
+    ScriptTask task;
+    task.Thread = lua_newthread(m_Lua);
+    task.Reference = luaL_ref(m_Lua, LUA_REGISTRYINDEX);
+    //move the chunk to the new thread
+    lua_xmove(m_Lua, task.Thread, 1);
+    lua_sethook(task.Thread, scheduleHook, LUA_MASKCOUNT, cHookInstructions);
+    task.WaitSeconds = 0.0f;
+    task.WaitFrames = 0;
+    task.RunTime = 0.0f;
+    m_Tasks.push_back(task);
     m_ScriptQueue.pop_front();
     --maxEntries;
   } //while
   return toDo;
 }
 
+void LuaEngine::injectTime(const float SecondsPassed)
+{
+  if (m_Tasks.empty())
+    return;
+  unsigned int i;
+  for (i=0; i<m_Tasks.size(); ++i)
+  {
+    ScriptTask& task = m_Tasks[i];
+    if (task.WaitFrames>0)
+      --task.WaitFrames;
+    if (task.WaitSeconds>0.0f)
+      task.WaitSeconds -= SecondsPassed;
+  }//for
+
+  m_SliceDeadline = std::chrono::steady_clock::now()
+                  + std::chrono::microseconds(static_cast<long>(m_TimeBudget*1000.0f));
+  //continue where the last frame stopped, so every script gets its turn
+  const unsigned int count = m_Tasks.size();
+  unsigned int checked = 0;
+  while ((checked<count) and !m_Tasks.empty())
+  {
+    if (m_NextTask>=m_Tasks.size())
+      m_NextTask = 0;
+    ++checked;
+    const ScriptTask& task = m_Tasks[m_NextTask];
+    if ((task.WaitFrames>0) or (task.WaitSeconds>0.0f))
+    {
+      ++m_NextTask;
+      continue;
+    }
+    if (resumeTask(m_NextTask))
+      ++m_NextTask;
+    if (std::chrono::steady_clock::now()>=m_SliceDeadline)
+      break;
+  }//while
+}
+
+bool LuaEngine::resumeTask(const unsigned int index)
+{
+  ScriptTask& task = m_Tasks[index];
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  m_RunawayDeadline = start
+      + std::chrono::microseconds(static_cast<long>((m_RunawayLimit-task.RunTime)*1000.0f));
+  m_Preempted = false;
+  m_CurrentThread = task.Thread;
+  const int status = lua_resume(task.Thread, 0);
+  m_CurrentThread = NULL;
+  const float elapsed = std::chrono::duration<float, std::milli>(
+                            std::chrono::steady_clock::now()-start).count();
+  #ifdef DUSK_LUA51
+  const bool failed = ((status!=0) and (status!=LUA_YIELD));
+  const bool finished = (status==0);
+  #elif defined(DUSK_LUA50)
+  //Lua 5.0 returns zero for yield and return, but a finished thread has no
+  // active function left
+  lua_Debug ar;
+  const bool failed = (status!=0);
+  const bool finished = (!failed and (lua_getstack(task.Thread, 0, &ar)==0));
+  #else
+    #error "LuaEngine could not detect a known Lua version!"
+  #endif
+  if (failed)
+  {
+    DuskLog() << "LuaEngine::resumeTask: ERROR while running a script. Lua's "
+              << "error message: \"" << lua_tostring(task.Thread, -1) << "\"\n";
+  }
+  if (failed or finished)
+  {
+    luaL_unref(m_Lua, LUA_REGISTRYINDEX, task.Reference);
+    m_Tasks.erase(m_Tasks.begin()+index);
+    return false;
+  }
+  //values passed to yield are not used
+  lua_settop(task.Thread, 0);
+  if (m_Preempted)
+  {
+    task.RunTime += elapsed;
+  }
+  else
+  {
+    task.RunTime = 0.0f;
+  }
+  return true;
+}
+
+void LuaEngine::scheduleHook(lua_State* L, lua_Debug* ar)
+{
+  LuaEngine& engine = getSingleton();
+  //the hook of the main state is not called for this thread
+  if (LuaProfiler::getSingleton().isRunning())
+  {
+    LuaProfiler::getSingleton().sample(L, cHookInstructions);
+  }
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (now>=engine.m_RunawayDeadline)
+  {
+    luaL_error(L, "script ran for more than %d ms without waiting and was stopped",
+               static_cast<int>(engine.m_RunawayLimit));
+    return;
+  }
+  #ifdef DUSK_LUA51
+  //Coroutines created by the script inherit the hook, but a yield there
+  // would return to the script's own resume call instead of the scheduler.
+  // Only the script's own top-level code can yield (see canYieldFromHook()),
+  // otherwise the next hook tries again; scripts that never get back there
+  // are left to the runaway limit.
+  if ((now>=engine.m_SliceDeadline) and (L==engine.m_CurrentThread)
+      and canYieldFromHook(L))
+  {
+    //continue in the next frame
+    engine.m_Preempted = true;
+    lua_yield(L, 0);
+  }
+  #endif
+}
+
+void LuaEngine::setTimeBudget(const float milliseconds)
+{
+  if (milliseconds>0.0f)
+    m_TimeBudget = milliseconds;
+}
+
+float LuaEngine::getTimeBudget() const
+{
+  return m_TimeBudget;
+}
+
+void LuaEngine::setRunawayLimit(const float milliseconds)
+{
+  if (milliseconds>0.0f)
+    m_RunawayLimit = milliseconds;
+}
+
+float LuaEngine::getRunawayLimit() const
+{
+  return m_RunawayLimit;
+}
+
+unsigned int LuaEngine::getNumberOfScheduledScripts() const
+{
+  return m_Tasks.size();
+}
+
+bool LuaEngine::suspendScript(lua_State* L, const float seconds, const unsigned int frames)
+{
+  unsigned int i;
+  for (i=0; i<m_Tasks.size(); ++i)
+  {
+    if (m_Tasks[i].Thread==L)
+    {
+      m_Tasks[i].WaitSeconds = seconds;
+      m_Tasks[i].WaitFrames = frames;
+      return true;
+    }
+  }//for
+  return false;
+}
+
 void LuaEngine::registerDusk()
 {
+  //remember the functions of Lua's own libraries, they are not instrumented
+  std::set<std::string> libraryNames;
+  lua_pushnil(m_Lua);
+  while (lua_next(m_Lua, LUA_GLOBALSINDEX)!=0)
+  {
+    if (lua_type(m_Lua, -2)==LUA_TSTRING)
+      libraryNames.insert(lua_tostring(m_Lua, -2));
+    lua_pop(m_Lua, 1);
+  }//while
+
   Lua::registerSound(m_Lua);
   Lua::registerWeather(m_Lua);
   Lua::registerObject(m_Lua);
@@ -255,6 +616,16 @@ void LuaEngine::registerDusk()
   Lua::registerAnimated(m_Lua);
   Lua::registerNPC(m_Lua);
   Lua::registerQuestLog(m_Lua);
+  Lua::registerScheduler(m_Lua);
+  Lua::registerWorker(m_Lua);
+  //let the profiler count and time calls of Dusk's functions
+  LuaProfiler::getSingleton().instrumentTable(m_Lua, LUA_GLOBALSINDEX, "", &libraryNames);
+  //needs the functions of the other bindings
+  Lua::registerHandles(m_Lua);
+  #ifdef DUSK_LUAJIT
+  //not instrumented, the profiler's wrappers would defeat the point of it
+  Lua::registerFFI(m_Lua);
+  #endif
 }
 
 } //namespace
@@ -42,6 +42,23 @@
      - 2010-12-17 (rev 270) - new version of runFile() now uses no more macros
      - 2010-12-17 (rev 271) - new version of constructor now uses no more macros
      - 2010-12-17 (rev 272) - minor fix (spelling for Lua 5.1)
+     - 2026-10-19           - runString() keeps compiled chunks in a cache
+     - 2026-10-19           - createFunctionReference() and releaseReference()
+                              added
+     - 2026-10-19           - queued scripts run as coroutines within a time
+                              budget per frame, see injectTime()
+     - 2026-10-19           - runString(), runFile() and the Dusk functions
+                              are timed while LuaProfiler is running
+     - 2026-10-19           - bindings for LuaWorkerPool added
+     - 2026-10-19           - LuaJIT's libraries and the FFI declarations are
+                              loaded in builds with DUSK_LUAJIT
+     - 2026-10-19           - scheduleHook() only pre-empts scripts where Lua
+                              can yield, i.e. not within C functions or
+                              metamethods
+     - 2026-10-19           - openJITLibraries() is available to other Lua
+                              states, e.g. the ones of LuaWorkerPool
+     - 2026-10-19           - scripts are only pre-empted in their top-level
+                              code, see LuaTimeSlice.h
 
  ToDo list:
      - ???
@@ -58,11 +75,24 @@
 
 #include <string>
 #include <deque>
+#include <vector>
+#include <chrono>
 #include "../Script.h"
 
 namespace Dusk
 {
 
+#ifdef DUSK_LUAJIT
+/* opens the given libraries. LuaJIT expects the luaopen_* functions to be
+   called through Lua, not directly like Lua 5.0 and 5.1 allow it.
+
+   parameters:
+       L         - the Lua state
+       libraries - names and luaopen_* functions, terminated by {NULL, NULL}
+*/
+void openJITLibraries(lua_State *L, const luaL_Reg* libraries);
+#endif
+
 class LuaEngine
 {
   public:
@@ -83,9 +113,44 @@ class LuaEngine
        remarks:
            The parameter err_msg can be set to NULL (default), if no error
            message is required.
+           The compiled chunk is kept in a cache (see cMaxCachedChunks), so
+           running the same code again does not need to parse it again.
     */
     bool runString(const std::string& line, std::string* err_msg=NULL);
 
+    /* runs the Lua code in line, which has to define a global function named
+       functionName, and returns a reference to that function in the Lua
+       registry, or LUA_NOREF, if an error occured. The global variable is set
+       to nil before and after, so only the reference keeps the function.
+
+       parameters:
+           line         - Lua code that defines the function
+           functionName - name of the function
+           err_msg      - pointer to a string which will contain the error
+                          message in case of an error (may be NULL)
+
+       remarks:
+           The function can be called by pushing it with
+           lua_rawgeti(L, LUA_REGISTRYINDEX, reference). Use releaseReference()
+           when it is not needed any more.
+    */
+    int createFunctionReference(const std::string& line, const std::string& functionName, std::string* err_msg=NULL);
+
+    /* releases a reference that was created by createFunctionReference() */
+    void releaseReference(const int reference);
+
+    /* removes all compiled chunks from the cache of runString() */
+    void clearChunkCache();
+
+    /* returns the number of compiled chunks in the cache of runString() */
+    unsigned int getNumberOfCachedChunks() const;
+
+    /* maximum number of chunks in the cache - if there are more, the cache is
+       cleared, because it is most likely filled with code that is generated
+       on the fly and will never run again
+    */
+    static const unsigned int cMaxCachedChunks = 256;
+
     /* runs the Lua script in file FileName and returns true on success
 
        parameters:
@@ -107,7 +172,9 @@ class LuaEngine
     */
     void addScript(const Dusk::Script& theScript);
 
-   /* Processes the scripts on the internal queue
+   /* Processes the scripts on the internal queue, i.e. compiles them and
+      starts them as coroutines. The scripts run during the next call of
+      injectTime().
 
       parameters:
           maxEntries - The number of maximal entries to process. 0 means all.
@@ -117,6 +184,49 @@ class LuaEngine
     */
     unsigned int processScripts(unsigned int maxEntries = 0);
 
+    /* resumes the scripts started by processScripts() which are not waiting,
+       until all of them yielded or the time budget for this frame is used up
+
+       parameters:
+           SecondsPassed - time since the last call of injectTime(), in seconds
+
+       remarks:
+           Scripts that run longer than the time budget are pre-empted (only
+           with Lua 5.1, Lua 5.0 cannot yield from a hook) and continue in the
+           next frame. Scripts that run longer than the runaway limit without
+           waiting are stopped with an error.
+    */
+    void injectTime(const float SecondsPassed);
+
+    /* sets the time that scripts may run per frame, in milliseconds */
+    void setTimeBudget(const float milliseconds);
+
+    /* returns the time that scripts may run per frame, in milliseconds */
+    float getTimeBudget() const;
+
+    /* sets the time that a script may run without waiting before it is
+       stopped, in milliseconds
+    */
+    void setRunawayLimit(const float milliseconds);
+
+    /* returns the time that a script may run without waiting before it is
+       stopped, in milliseconds
+    */
+    float getRunawayLimit() const;
+
+    /* returns the number of running or waiting scripts */
+    unsigned int getNumberOfScheduledScripts() const;
+
+    /* lets the script running in thread L wait for the given time and number
+       of frames, whatever takes longer, and returns true. Returns false, if L
+       is not the thread of a script started by processScripts().
+
+       remarks:
+           The caller has to yield afterwards, i.e. a binding returns
+           lua_yield(L, 0).
+    */
+    bool suspendScript(lua_State* L, const float seconds, const unsigned int frames);
+
     // implicitly act as a lua_State pointer - not sure, if we will ever need this
     inline operator lua_State*()
     {
@@ -134,11 +244,58 @@ class LuaEngine
     */
     void registerDusk();
 
+    /* pushes the compiled chunk for line onto the stack, either from the
+       cache or by compiling it, and returns zero. In case of an error the
+       error code of the Lua loader is returned and Lua's error message is
+       pushed instead.
+    */
+    int loadChunk(const std::string& line);
+
+    /* resumes the script at position index in m_Tasks and returns true, if
+       it is still running afterwards. Finished or failed scripts are removed
+       from m_Tasks.
+    */
+    bool resumeTask(const unsigned int index);
+
+    /* count hook for the threads of scripts, which pre-empts or stops scripts
+       that run too long
+    */
+    static void scheduleHook(lua_State* L, lua_Debug* ar);
+
+    /* number of instructions between two calls of scheduleHook() */
+    static const int cHookInstructions = 1000;
+
     /* the Lua interpreter */
     lua_State * m_Lua;
 
+    /* registry reference of the table that maps source code to compiled chunks */
+    int m_ChunkCache;
+
+    /* number of chunks in the cache table */
+    unsigned int m_CachedChunks;
+
     /* Holds the queue of scripts to process. */
     std::deque<Script> m_ScriptQueue;
+
+    /* a script started by processScripts() */
+    struct ScriptTask
+    {
+      lua_State* Thread;
+      int Reference; //registry reference that keeps the thread alive
+      float WaitSeconds; //time left to wait
+      unsigned int WaitFrames; //frames left to wait
+      float RunTime; //milliseconds run since the script waited the last time
+    };
+
+    std::vector<ScriptTask> m_Tasks;
+    unsigned int m_NextTask; //task to resume first in the next frame
+    float m_TimeBudget; //milliseconds per frame
+    float m_RunawayLimit; //milliseconds without waiting
+    //end of time slice and runaway limit of the currently resumed script
+    std::chrono::steady_clock::time_point m_SliceDeadline;
+    std::chrono::steady_clock::time_point m_RunawayDeadline;
+    bool m_Preempted; //whether the current script was pre-empted by the hook
+    lua_State* m_CurrentThread; //thread of the script that is resumed, or NULL
 }; //class
 
 } //namespace
@@ -0,0 +1,270 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "LuaFFI.h"
+#include <cstring>
+#include "LuaObjectHandles.h"
+#include "../objects/NPC.h"
+#include "../Messages.h"
+
+using namespace Dusk;
+
+namespace
+{
+  /* returns the DuskObject of the handle, or NULL */
+  inline DuskObject* ffiObject(const void* handle)
+  {
+    return Lua::resolveObject(static_cast<const Lua::ObjectHandle*>(handle));
+  }
+
+  /* returns the NPC of the handle, or NULL */
+  inline NPC* ffiNPC(const void* handle)
+  {
+    return Lua::resolveNPC(static_cast<const Lua::ObjectHandle*>(handle));
+  }
+} //namespace
+
+extern "C"
+{
+
+int DuskFFI_IsValid(const void* handle)
+{
+  return (ffiObject(handle)!=NULL) ? 1 : 0;
+}
+
+int DuskFFI_GetPosition(const void* handle, float* xyz)
+{
+  const DuskObject* obj = ffiObject(handle);
+  if ((obj==NULL) or (xyz==NULL))
+  {
+    return 0;
+  }
+  const Ogre::Vector3& pos = obj->getPosition();
+  xyz[0] = pos.x;
+  xyz[1] = pos.y;
+  xyz[2] = pos.z;
+  return 1;
+}
+
+int DuskFFI_SetPosition(const void* handle, const float x, const float y, const float z)
+{
+  DuskObject* obj = ffiObject(handle);
+  if (obj==NULL)
+  {
+    return 0;
+  }
+  obj->setPosition(Ogre::Vector3(x, y, z));
+  return 1;
+}
+
+float DuskFFI_GetHealth(const void* handle)
+{
+  const NPC* npc = ffiNPC(handle);
+  if (npc==NULL)
+  {
+    return -1.0f;
+  }
+  return npc->getHealth();
+}
+
+int DuskFFI_SetHealth(const void* handle, const float health)
+{
+  NPC* npc = ffiNPC(handle);
+  if (npc==NULL)
+  {
+    return 0;
+  }
+  npc->setHealth(health);
+  return 1;
+}
+
+int DuskFFI_GetStats(const void* handle, uint8_t* stats)
+{
+  const NPC* npc = ffiNPC(handle);
+  if ((npc==NULL) or (stats==NULL))
+  {
+    return 0;
+  }
+  stats[Lua::fsLevel] = npc->getLevel();
+  stats[Lua::fsStrength] = npc->getStrength();
+  stats[Lua::fsAgility] = npc->getAgility();
+  stats[Lua::fsVitality] = npc->getVitality();
+  stats[Lua::fsIntelligence] = npc->getIntelligence();
+  stats[Lua::fsWillpower] = npc->getWillpower();
+  stats[Lua::fsCharisma] = npc->getCharisma();
+  stats[Lua::fsLuck] = npc->getLuck();
+  return 1;
+}
+
+int DuskFFI_GetStat(const void* handle, const int stat)
+{
+  const NPC* npc = ffiNPC(handle);
+  if (npc==NULL)
+  {
+    return -1;
+  }
+  switch (stat)
+  {
+    case Lua::fsLevel:
+         return npc->getLevel();
+    case Lua::fsStrength:
+         return npc->getStrength();
+    case Lua::fsAgility:
+         return npc->getAgility();
+    case Lua::fsVitality:
+         return npc->getVitality();
+    case Lua::fsIntelligence:
+         return npc->getIntelligence();
+    case Lua::fsWillpower:
+         return npc->getWillpower();
+    case Lua::fsCharisma:
+         return npc->getCharisma();
+    case Lua::fsLuck:
+         return npc->getLuck();
+    default:
+         return -1;
+  }//swi
+}
+
+int DuskFFI_SetStat(const void* handle, const int stat, const uint8_t value)
+{
+  NPC* npc = ffiNPC(handle);
+  if (npc==NULL)
+  {
+    return 0;
+  }
+  switch (stat)
+  {
+    case Lua::fsLevel:
+         npc->setLevel(value);
+         break;
+    case Lua::fsStrength:
+         npc->setStrength(value);
+         break;
+    case Lua::fsAgility:
+         npc->setAgility(value);
+         break;
+    case Lua::fsVitality:
+         npc->setVitality(value);
+         break;
+    case Lua::fsIntelligence:
+         npc->setIntelligence(value);
+         break;
+    case Lua::fsWillpower:
+         npc->setWillpower(value);
+         break;
+    case Lua::fsCharisma:
+         npc->setCharisma(value);
+         break;
+    case Lua::fsLuck:
+         npc->setLuck(value);
+         break;
+    default:
+         return 0;
+  }//swi
+  return 1;
+}
+
+int DuskFFI_GetItemCount(const void* handle, const char* itemID)
+{
+  const NPC* npc = ffiNPC(handle);
+  if ((npc==NULL) or (itemID==NULL))
+  {
+    return -1;
+  }
+  return npc->getConstInventory().getItemCount(itemID);
+}
+
+} //extern "C"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+
+#ifdef DUSK_LUAJIT
+/* Lua code that declares the entry points for the FFI and wraps them in the
+   table DuskFFI. The buffers for positions and stats are reused, so the
+   wrappers do not create any garbage.
+*/
+const char* const cFFISetup =
+  "local ffi = require(\"ffi\")\n"
+  "ffi.cdef[[\n"
+  "int DuskFFI_IsValid(const void* handle);\n"
+  "int DuskFFI_GetPosition(const void* handle, float* xyz);\n"
+  "int DuskFFI_SetPosition(const void* handle, float x, float y, float z);\n"
+  "float DuskFFI_GetHealth(const void* handle);\n"
+  "int DuskFFI_SetHealth(const void* handle, float health);\n"
+  "int DuskFFI_GetStats(const void* handle, uint8_t* stats);\n"
+  "int DuskFFI_GetStat(const void* handle, int stat);\n"
+  "int DuskFFI_SetStat(const void* handle, int stat, uint8_t value);\n"
+  "int DuskFFI_GetItemCount(const void* handle, const char* itemID);\n"
+  "]]\n"
+  "local C = ffi.C\n"
+  "local position = ffi.new(\"float[3]\")\n"
+  "local stats = ffi.new(\"uint8_t[8]\")\n"
+  "-- the chunk gets the metatables of the handle types as arguments\n"
+  "local handleMetatables = {}\n"
+  "for _, mt in ipairs({...}) do handleMetatables[mt] = true end\n"
+  "local getmetatable = getmetatable\n"
+  "-- only handles are passed on; other userdata (e.g. files), strings and\n"
+  "-- cdata become NULL, because the C functions would read past their data\n"
+  "local function handle(h)\n"
+  "  if type(h)==\"userdata\" and handleMetatables[getmetatable(h)] then return h end\n"
+  "  return nil\n"
+  "end\n"
+  "DuskFFI = {\n"
+  "  Level = 0, Strength = 1, Agility = 2, Vitality = 3, Intelligence = 4,\n"
+  "  Willpower = 5, Charisma = 6, Luck = 7,\n"
+  "  isValid = function(h) return C.DuskFFI_IsValid(handle(h))~=0 end,\n"
+  "  getPosition = function(h)\n"
+  "    if C.DuskFFI_GetPosition(handle(h), position)==0 then return nil end\n"
+  "    return position[0], position[1], position[2]\n"
+  "  end,\n"
+  "  setPosition = function(h, x, y, z) return C.DuskFFI_SetPosition(handle(h), x, y, z)~=0 end,\n"
+  "  getHealth = function(h) return C.DuskFFI_GetHealth(handle(h)) end,\n"
+  "  setHealth = function(h, health) return C.DuskFFI_SetHealth(handle(h), health)~=0 end,\n"
+  "  getStats = function(h)\n"
+  "    if C.DuskFFI_GetStats(handle(h), stats)==0 then return nil end\n"
+  "    return stats[0], stats[1], stats[2], stats[3], stats[4], stats[5], stats[6], stats[7]\n"
+  "  end,\n"
+  "  getStat = function(h, stat) return C.DuskFFI_GetStat(handle(h), stat) end,\n"
+  "  setStat = function(h, stat, value) return C.DuskFFI_SetStat(handle(h), stat, value)~=0 end,\n"
+  "  getItemCount = function(h, itemID) return C.DuskFFI_GetItemCount(handle(h), itemID) end\n"
+  "}\n";
+
+bool registerFFI(lua_State *L)
+{
+  if (luaL_loadbuffer(L, cFFISetup, strlen(cFFISetup), "=DuskFFI")!=0
+      or lua_pcall(L, pushHandleMetatables(L), 0, 0)!=0)
+  {
+    DuskLog() << "Lua::registerFFI: ERROR: could not declare the FFI functions: "
+              << lua_tostring(L, -1) << "\n";
+    lua_pop(L, 1);
+    return false;
+  }
+  return true;
+}
+#endif
+
+} //namespace Lua
+
+} //namespace Dusk
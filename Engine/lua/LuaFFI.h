@@ -0,0 +1,123 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: C entry points for LuaJIT's FFI
+          The functions below can be called by scripts through ffi.C, which
+          avoids the Lua C API and its stack for the most frequently used
+          getters and setters, and allows LuaJIT to compile the calls into
+          its traces. The functions are only declared for scripts in builds
+          with DUSK_LUAJIT (see LuaIncludes.h), where they are available in
+          the global table DuskFFI.
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+     - 2026-10-19           - wrappers in DuskFFI only pass handles to the
+                              C functions
+
+ ToDo list:
+     - more accessors, if scripts need them (direction, speed, animations)
+
+ Bugs:
+     - Untested. If you find any bugs, then tell me please.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUAFFI_H
+#define LUAFFI_H
+
+#include <stdint.h>
+#include "LuaIncludes.h"
+
+/* The functions have to be exported from the executable, or ffi.C will not
+   find them. (On Linux, the executable has to be linked with -rdynamic, too.)
+*/
+#if defined(_WIN32)
+  #define DUSK_FFI_API __declspec(dllexport)
+#else
+  #define DUSK_FFI_API __attribute__((visibility("default")))
+#endif
+
+/* All functions take the handle of an object as first parameter. Scripts can
+   pass the handles they got from GetObject(), GetNPC() etc. directly, because
+   the FFI passes the data of a userdata as pointer. Handles of destroyed
+   objects are detected, but the functions cannot check whether a pointer
+   really belongs to a handle. The wrappers in DuskFFI check the metatable of
+   the userdata and pass NULL for everything else, so scripts should use them
+   instead of calling ffi.C directly.
+
+   Getters return -1, setters return 0, if the handle is invalid or the object
+   is not of the required class.
+*/
+extern "C"
+{
+  /* returns 1, if the handle's object still exists, or 0 otherwise */
+  DUSK_FFI_API int DuskFFI_IsValid(const void* handle);
+
+  /* writes the position of the object to xyz[0..2]; returns 1 on success */
+  DUSK_FFI_API int DuskFFI_GetPosition(const void* handle, float* xyz);
+
+  /* sets the position of the object; returns 1 on success */
+  DUSK_FFI_API int DuskFFI_SetPosition(const void* handle, const float x, const float y, const float z);
+
+  /* health of an NPC */
+  DUSK_FFI_API float DuskFFI_GetHealth(const void* handle);
+  DUSK_FFI_API int DuskFFI_SetHealth(const void* handle, const float health);
+
+  /* writes level and attributes of an NPC to stats[0..7], in the order of
+     enum FFIStat below; returns 1 on success
+  */
+  DUSK_FFI_API int DuskFFI_GetStats(const void* handle, uint8_t* stats);
+
+  /* single level or attribute of an NPC, stat is a value of enum FFIStat */
+  DUSK_FFI_API int DuskFFI_GetStat(const void* handle, const int stat);
+  DUSK_FFI_API int DuskFFI_SetStat(const void* handle, const int stat, const uint8_t value);
+
+  /* number of items with the given ID in the inventory of an NPC */
+  DUSK_FFI_API int DuskFFI_GetItemCount(const void* handle, const char* itemID);
+}
+
+namespace Dusk
+{
+
+namespace Lua
+{
+  /* indices for DuskFFI_GetStats(), DuskFFI_GetStat() and DuskFFI_SetStat() */
+  enum FFIStat {fsLevel=0, fsStrength, fsAgility, fsVitality, fsIntelligence,
+                fsWillpower, fsCharisma, fsLuck};
+
+  /* declares the above functions with ffi.cdef and creates the global table
+     DuskFFI with Lua wrappers for them; has to be called after
+     registerHandles()
+
+     remarks:
+         Needs LuaJIT's ffi module, so this is only available in builds with
+         DUSK_LUAJIT.
+  */
+  #ifdef DUSK_LUAJIT
+  bool registerFFI(lua_State *L);
+  #endif
+
+} //namespace Lua
+
+} //namespace Dusk
+
+#endif // LUAFFI_H
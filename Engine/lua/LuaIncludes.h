@@ -37,6 +37,7 @@
      - 2010-12-17 (rev 270) - obsolete macro removed
      - 2010-12-17 (rev 271) - last obsolete compatibility macro removed
      - 2013-05-31           - adjust includes for Windows
+     - 2026-10-19           - LuaJIT can be used instead with DUSK_LUAJIT
 
  ToDo list:
      - ???
@@ -51,7 +52,24 @@
 #define LUAINCLUDES_H
 
 extern "C" {
-  #if defined(_WIN32)
+  #if defined(DUSK_LUAJIT)
+    /* LuaJIT has the API of Lua 5.1, so everything that works with Lua 5.1
+       works with LuaJIT, too. Additionally, scripts can use LuaJIT's FFI to
+       call the functions in LuaFFI.h.
+       The build system has to add LuaJIT's include directory (usually
+       /usr/include/luajit-2.1 or /usr/include/luajit-2.0) to the include
+       paths, because the headers have the same names as the ones of Lua.
+       (CMake does that with -DDUSK_LUAJIT=ON.)
+       Note that LuaJIT does not call hooks within compiled code, so time
+       slices and the profiler only see the parts of a script that run in
+       LuaJIT's interpreter.
+    */
+    #include <lua.h>
+    #include <lualib.h>
+    #include <lauxlib.h>
+    #include <luajit.h>
+    #define DUSK_LUA51
+  #elif defined(_WIN32)
     /* We use Lua 5.1 on Windows platforms, since 5.0 does not seem to be
        available for download on SF any more.
     */
@@ -0,0 +1,465 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "LuaObjectHandles.h"
+#include "LuaBindingsObject.h"
+#include "LuaBindingsUniformMotion.h"
+#include "LuaBindingsAnimated.h"
+#include "LuaBindingsNPC.h"
+#include "LuaProfiler.h"
+#include "../objects/NPC.h"
+
+namespace Dusk
+{
+
+namespace Lua
+{
+
+/* ObjectHandleTable functions */
+
+ObjectHandleTable* ObjectHandleTable::s_HandleInstance = NULL;
+
+ObjectHandleTable::ObjectHandleTable()
+{
+  m_Slots.clear();
+  m_FreeSlots.clear();
+  m_SlotOfObject.clear();
+  s_HandleInstance = this;
+}
+
+ObjectHandleTable::~ObjectHandleTable()
+{
+  //objects destroyed after this must not access the table
+  s_HandleInstance = NULL;
+  m_Slots.clear();
+  m_FreeSlots.clear();
+  m_SlotOfObject.clear();
+}
+
+ObjectHandleTable& ObjectHandleTable::getSingleton()
+{
+  static ObjectHandleTable Instance;
+  return Instance;
+}
+
+uint32_t ObjectHandleTable::acquire(DuskObject* obj, uint32_t& generation)
+{
+  const std::map<const DuskObject*, uint32_t>::const_iterator iter = m_SlotOfObject.find(obj);
+  if (iter!=m_SlotOfObject.end())
+  {
+    generation = m_Slots[iter->second].Generation;
+    return iter->second;
+  }
+  uint32_t slot;
+  if (!m_FreeSlots.empty())
+  {
+    slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+  }
+  else
+  {
+    slot = m_Slots.size();
+    HandleSlot hs;
+    hs.Object = NULL;
+    hs.Generation = 1;
+    m_Slots.push_back(hs);
+  }
+  m_Slots[slot].Object = obj;
+  m_SlotOfObject[obj] = slot;
+  generation = m_Slots[slot].Generation;
+  return slot;
+}
+
+DuskObject* ObjectHandleTable::resolve(const uint32_t slot, const uint32_t generation) const
+{
+  if ((slot>=m_Slots.size()) or (m_Slots[slot].Generation!=generation))
+  {
+    return NULL;
+  }
+  return m_Slots[slot].Object;
+}
+
+unsigned int ObjectHandleTable::getNumberOfObjects() const
+{
+  return m_SlotOfObject.size();
+}
+
+void ObjectHandleTable::release(const DuskObject* obj)
+{
+  const std::map<const DuskObject*, uint32_t>::iterator iter = m_SlotOfObject.find(obj);
+  if (iter==m_SlotOfObject.end())
+  {
+    return;
+  }
+  HandleSlot& hs = m_Slots[iter->second];
+  hs.Object = NULL;
+  //all existing handles of that slot are invalid from now on
+  ++hs.Generation;
+  m_FreeSlots.push_back(iter->second);
+  m_SlotOfObject.erase(iter);
+}
+
+void ObjectHandleTable::objectDestroyed(const DuskObject* obj)
+{
+  if (s_HandleInstance!=NULL)
+  {
+    s_HandleInstance->release(obj);
+  }
+}
+
+/* handle functions */
+
+//names of the metatables in the registry, order as in HandleType
+const char* const cHandleMetatables[] = {"Dusk.Object", "Dusk.UniformMotion",
+                                         "Dusk.Animated", "Dusk.NPC"};
+//index in the metatables that holds the address of cHandleMarker
+const int cHandleMarkerIndex = 1;
+const char cHandleMarker = 0;
+
+void pushHandle(lua_State *L, DuskObject* base, void* typed, const HandleType type)
+{
+  if (base==NULL)
+  {
+    lua_pushnil(L);
+    return;
+  }
+  ObjectHandle* handle = static_cast<ObjectHandle*>(lua_newuserdata(L, sizeof(ObjectHandle)));
+  handle->Magic = cHandleMagic;
+  handle->Pointer = typed;
+  handle->Slot = ObjectHandleTable::getSingleton().acquire(base, handle->Generation);
+  handle->Type = type;
+  luaL_getmetatable(L, cHandleMetatables[type]);
+  lua_setmetatable(L, -2);
+}
+
+void pushObject(lua_State *L, DuskObject* obj)
+{
+  pushHandle(L, obj, obj, htObject);
+}
+
+void pushUniformMotion(lua_State *L, UniformMotionObject* obj)
+{
+  pushHandle(L, obj, obj, htUniformMotion);
+}
+
+void pushAnimated(lua_State *L, AnimatedObject* obj)
+{
+  pushHandle(L, obj, obj, htAnimated);
+}
+
+void pushNPC(lua_State *L, NPC* obj)
+{
+  pushHandle(L, obj, obj, htNPC);
+}
+
+/* returns the handle at index, if the value there is a handle, or NULL
+   otherwise. The handle's object might not exist any more.
+*/
+const ObjectHandle* toHandle(lua_State *L, const int index)
+{
+  if (lua_type(L, index)!=LUA_TUSERDATA)
+  {
+    return NULL;
+  }
+  if (lua_getmetatable(L, index)==0)
+  {
+    return NULL;
+  }
+  lua_rawgeti(L, -1, cHandleMarkerIndex);
+  const bool isHandle = (lua_touserdata(L, -1)==&cHandleMarker);
+  lua_pop(L, 2);
+  if (!isHandle)
+  {
+    return NULL;
+  }
+  return static_cast<const ObjectHandle*>(lua_touserdata(L, index));
+}
+
+/* returns true, if handle is a handle and its object still exists */
+bool isAlive(const ObjectHandle* handle)
+{
+  return ((handle!=NULL) and (handle->Magic==cHandleMagic)
+      and (handle->Type>=htObject) and (handle->Type<=htNPC)
+      and (ObjectHandleTable::getSingleton().resolve(handle->Slot, handle->Generation)!=NULL));
+}
+
+/* returns the object of a valid handle as DuskObject */
+DuskObject* baseOf(const ObjectHandle& handle)
+{
+  switch (handle.Type)
+  {
+    case htUniformMotion:
+         return static_cast<UniformMotionObject*>(handle.Pointer);
+    case htAnimated:
+         return static_cast<AnimatedObject*>(handle.Pointer);
+    case htNPC:
+         return static_cast<NPC*>(handle.Pointer);
+    default:
+         return static_cast<DuskObject*>(handle.Pointer);
+  }//swi
+}
+
+DuskObject* resolveObject(const ObjectHandle* handle)
+{
+  if (!isAlive(handle))
+  {
+    return NULL;
+  }
+  return baseOf(*handle);
+}
+
+UniformMotionObject* resolveUniformMotion(const ObjectHandle* handle)
+{
+  if (!isAlive(handle))
+  {
+    return NULL;
+  }
+  switch (handle->Type)
+  {
+    case htUniformMotion:
+         return static_cast<UniformMotionObject*>(handle->Pointer);
+    case htNPC:
+         return static_cast<NPC*>(handle->Pointer);
+    default:
+         //virtual inheritance, so only dynamic_cast can do that
+         return dynamic_cast<UniformMotionObject*>(baseOf(*handle));
+  }//swi
+}
+
+AnimatedObject* resolveAnimated(const ObjectHandle* handle)
+{
+  if (!isAlive(handle))
+  {
+    return NULL;
+  }
+  switch (handle->Type)
+  {
+    case htAnimated:
+         return static_cast<AnimatedObject*>(handle->Pointer);
+    case htNPC:
+         return static_cast<NPC*>(handle->Pointer);
+    default:
+         return dynamic_cast<AnimatedObject*>(baseOf(*handle));
+  }//swi
+}
+
+NPC* resolveNPC(const ObjectHandle* handle)
+{
+  if (!isAlive(handle))
+  {
+    return NULL;
+  }
+  if (handle->Type==htNPC)
+  {
+    return static_cast<NPC*>(handle->Pointer);
+  }
+  return dynamic_cast<NPC*>(baseOf(*handle));
+}
+
+/* raises a Lua error, if the value at index is light userdata - raw object
+   pointers are not accepted, because their type and lifetime are unknown */
+void rejectLightUserdata(lua_State *L, const int index)
+{
+  if (lua_type(L, index)==LUA_TLIGHTUSERDATA)
+  {
+    luaL_argerror(L, index, "object handle expected, got light userdata");
+  }
+}
+
+DuskObject* toObject(lua_State *L, const int index)
+{
+  rejectLightUserdata(L, index);
+  return resolveObject(toHandle(L, index));
+}
+
+UniformMotionObject* toUniformMotion(lua_State *L, const int index)
+{
+  rejectLightUserdata(L, index);
+  return resolveUniformMotion(toHandle(L, index));
+}
+
+AnimatedObject* toAnimated(lua_State *L, const int index)
+{
+  rejectLightUserdata(L, index);
+  return resolveAnimated(toHandle(L, index));
+}
+
+NPC* toNPC(lua_State *L, const int index)
+{
+  rejectLightUserdata(L, index);
+  return resolveNPC(toHandle(L, index));
+}
+
+/* __eq metamethod: handles are equal, if they refer to the same object */
+int HandleEqual(lua_State *L)
+{
+  const ObjectHandle* a = static_cast<const ObjectHandle*>(lua_touserdata(L, 1));
+  const ObjectHandle* b = static_cast<const ObjectHandle*>(lua_touserdata(L, 2));
+  if ((a!=NULL) and (b!=NULL) and (a->Slot==b->Slot) and (a->Generation==b->Generation))
+    lua_pushboolean(L, 1);
+  else
+    lua_pushboolean(L, 0);
+  return 1;
+}
+
+/* methods of the handles */
+
+struct HandleMethod
+{
+  const char* Name;
+  lua_CFunction Function;
+};
+
+const HandleMethod cObjectMethods[] = {
+  {"isValid", IsValidObject},
+  {"enable", Enable},
+  {"disable", Disable},
+  {"isEnabled", IsEnabled},
+  {"getPosition", GetObjectPosition},
+  {"setPosition", SetObjectPosition},
+  {"getRotation", GetObjectRotation},
+  {"setRotation", SetObjectRotation},
+  {"getScale", GetScale},
+  {"setScale", SetScale},
+  {NULL, NULL}
+};
+
+const HandleMethod cUniformMotionMethods[] = {
+  {"getDirection", GetDirection},
+  {"setDirection", SetDirection},
+  {"getSpeed", GetSpeed},
+  {"setSpeed", SetSpeed},
+  {"getDestination", GetDestination},
+  {"travelToDestination", TravelToDestination},
+  {"isOnTravel", IsOnTravel},
+  {NULL, NULL}
+};
+
+const HandleMethod cAnimatedMethods[] = {
+  {"getLoopState", GetAnimatedLoop},
+  {"getAnimations", GetAnimatedAnimations},
+  {"startAnimation", AnimatedStartAnimation},
+  {"stopAnimation", AnimatedStopAnimation},
+  {"stopAllAnimations", AnimatedStopAllAnimations},
+  {"isAnimationActive", AnimatedIsAnimationActive},
+  {NULL, NULL}
+};
+
+const HandleMethod cNPCMethods[] = {
+  {"getHealth", GetHealth},
+  {"setHealth", SetHealth},
+  {"getLevel", GetLevel},
+  {"getStrength", GetStrength},
+  {"getAgility", GetAgility},
+  {"getVitality", GetVitality},
+  {"getIntelligence", GetIntelligence},
+  {"getWillpower", GetWillpower},
+  {"getCharisma", GetCharisma},
+  {"getLuck", GetLuck},
+  {"setLevel", SetLevel},
+  {"setStrength", SetStrength},
+  {"setAgility", SetAgility},
+  {"setVitality", SetVitality},
+  {"setIntelligence", SetIntelligence},
+  {"setWillpower", SetWillpower},
+  {"setCharisma", SetCharisma},
+  {"setLuck", SetLuck},
+  {"isFemale", IsFemale},
+  {"equip", NPCEquip},
+  {"unequip", NPCUnequip},
+  {"hasEquipped", NPCHasEquipped},
+  {"attack", NPCAttack},
+  {"stopAttack", NPCStopAttack},
+  {"getItemCount", GetItemCount},
+  {"addItem", AddItem},
+  {"removeItem", RemoveItem},
+  {NULL, NULL}
+};
+
+/* adds the methods to the table on top of the stack */
+void addMethods(lua_State *L, const HandleMethod* methods)
+{
+  while (methods->Name!=NULL)
+  {
+    lua_pushstring(L, methods->Name);
+    lua_pushcfunction(L, methods->Function);
+    lua_rawset(L, -3);
+    ++methods;
+  }//while
+}
+
+/* creates the metatable for type with the given method lists and leaves it on
+   the stack; expects the __eq function on top of the stack
+*/
+void createHandleMetatable(lua_State *L, const HandleType type,
+                           const HandleMethod* first, const HandleMethod* second,
+                           const HandleMethod* third, const HandleMethod* fourth)
+{
+  const int eqFunction = lua_gettop(L);
+  luaL_newmetatable(L, cHandleMetatables[type]);
+  lua_pushlightuserdata(L, const_cast<char*>(&cHandleMarker));
+  lua_rawseti(L, -2, cHandleMarkerIndex);
+  //All metatables need the same function for __eq, otherwise Lua does not
+  // use it to compare handles of different types.
+  lua_pushstring(L, "__eq");
+  lua_pushvalue(L, eqFunction);
+  lua_rawset(L, -3);
+  //the method table
+  lua_pushstring(L, "__index");
+  lua_newtable(L);
+  addMethods(L, first);
+  if (second!=NULL) addMethods(L, second);
+  if (third!=NULL) addMethods(L, third);
+  if (fourth!=NULL) addMethods(L, fourth);
+  LuaProfiler::getSingleton().instrumentTable(L, -1, std::string(cHandleMetatables[type])+":");
+  lua_rawset(L, -3);
+  //remove metatable
+  lua_pop(L, 1);
+}
+
+void registerHandles(lua_State *L)
+{
+  lua_pushcfunction(L, HandleEqual);
+  createHandleMetatable(L, htObject, cObjectMethods, NULL, NULL, NULL);
+  createHandleMetatable(L, htUniformMotion, cObjectMethods,
+                        cUniformMotionMethods, NULL, NULL);
+  createHandleMetatable(L, htAnimated, cObjectMethods, cAnimatedMethods,
+                        NULL, NULL);
+  //NPCs are animated objects and waypoint objects, so they can move, too
+  createHandleMetatable(L, htNPC, cObjectMethods, cUniformMotionMethods,
+                        cAnimatedMethods, cNPCMethods);
+  //remove __eq function
+  lua_pop(L, 1);
+}
+
+int pushHandleMetatables(lua_State *L)
+{
+  int type;
+  for (type=htObject; type<=htNPC; ++type)
+  {
+    luaL_getmetatable(L, cHandleMetatables[type]);
+  }
+  return htNPC+1;
+}
+
+} //namespace Lua
+
+} //namespace Dusk
@@ -0,0 +1,198 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: typed object handles for Lua scripts
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+     - 2026-10-19           - resolve*() functions for callers without a
+                              lua_State, e.g. the FFI entry points
+     - 2026-10-19           - handles carry a magic value, which resolve*()
+                              checks
+     - 2026-10-19           - to*() functions raise an error for light
+                              userdata instead of casting it
+     - 2026-10-19           - pushHandleMetatables() added
+
+ ToDo list:
+     - handles for other object types (items, lights, ...)
+
+ Bugs:
+     - Untested. If you find any bugs, then tell me please.
+
+ --------------------------------------------------------------------------*/
+
+#ifndef LUAOBJECTHANDLES_H
+#define LUAOBJECTHANDLES_H
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+//forward declarations
+class DuskObject;
+class UniformMotionObject;
+class AnimatedObject;
+class NPC;
+
+namespace Lua
+{
+  /* Objects are passed to Lua scripts as full userdata handles. A handle does
+     not keep the object alive: it refers to a slot in ObjectHandleTable, and
+     the generation counter of that slot is increased when the object is
+     destroyed. Handles of destroyed objects are therefore recognized as
+     invalid without any lookup by ID.
+
+     Each handle type has its own metatable, so scripts can use method syntax
+     like npc:getHealth() or obj:setPosition(x, y, z) in addition to the
+     global functions like GetHealth(npc).
+  */
+
+  /* types of object handles, determines the available methods */
+  enum HandleType {htObject, htUniformMotion, htAnimated, htNPC};
+
+  /* value of ObjectHandle::Magic in every handle */
+  const uint32_t cHandleMagic = 0x4C444E48; //"HNDL" in little endian
+
+  /* the data of a handle, as stored in the Lua userdata */
+  struct ObjectHandle
+  {
+    uint32_t Magic; //always cHandleMagic; tells handles from other data
+    void* Pointer; //the object, already cast to the class of the handle type
+    uint32_t Slot;
+    uint32_t Generation;
+    HandleType Type;
+  };
+
+  class ObjectHandleTable
+  {
+    public:
+      /* singleton access method */
+      static ObjectHandleTable& getSingleton();
+
+      /* destructor */
+      ~ObjectHandleTable();
+
+      /* returns the slot of the given object, and assigns a new slot, if the
+         object has none yet
+
+         parameters:
+             obj        - the object (must not be NULL)
+             generation - receives the current generation of the slot
+      */
+      uint32_t acquire(DuskObject* obj, uint32_t& generation);
+
+      /* returns the object in slot, or NULL, if the slot is unknown or the
+         object of that generation does not exist any more
+      */
+      DuskObject* resolve(const uint32_t slot, const uint32_t generation) const;
+
+      /* returns the number of objects that currently have a slot */
+      unsigned int getNumberOfObjects() const;
+
+      /* invalidates all handles of the given object. Called by the destructor
+         of DuskObject.
+
+         remarks:
+             Does nothing, if the table is already destroyed or the object has
+             no slot.
+      */
+      static void objectDestroyed(const DuskObject* obj);
+    private:
+      /* constructor - private, because it's a singleton */
+      ObjectHandleTable();
+
+      /* empty, private copy constructor due to singleton pattern */
+      ObjectHandleTable(const ObjectHandleTable& op) {}
+
+      /* frees the slot of obj, if any */
+      void release(const DuskObject* obj);
+
+      struct HandleSlot
+      {
+        DuskObject* Object; //NULL, if the slot is free
+        uint32_t Generation;
+      };
+
+      std::vector<HandleSlot> m_Slots;
+      std::vector<uint32_t> m_FreeSlots;
+      std::map<const DuskObject*, uint32_t> m_SlotOfObject;
+
+      static ObjectHandleTable* s_HandleInstance;
+  }; //class
+
+  /* push a handle of the given type for obj onto the stack, or nil, if obj is
+     NULL
+  */
+  void pushObject(lua_State *L, DuskObject* obj);
+  void pushUniformMotion(lua_State *L, UniformMotionObject* obj);
+  void pushAnimated(lua_State *L, AnimatedObject* obj);
+  void pushNPC(lua_State *L, NPC* obj);
+
+  /* return the object at the given stack index, or NULL, if the value there
+     is not a handle, the handle's object does not exist any more or is not of
+     the requested class
+
+     remarks:
+         Light userdata raises a Lua error (luaL_argerror()), because there is
+         no way to check its type or whether its object still exists. Only
+         call these functions from C functions that are called by Lua.
+  */
+  DuskObject* toObject(lua_State *L, const int index);
+  UniformMotionObject* toUniformMotion(lua_State *L, const int index);
+  AnimatedObject* toAnimated(lua_State *L, const int index);
+  NPC* toNPC(lua_State *L, const int index);
+
+  /* return the object of the given handle, or NULL, if handle is NULL, the
+     handle's object does not exist any more or is not of the requested class
+
+     remarks:
+         handle is usually the data of a userdata that was passed through
+         LuaJIT's FFI as a pointer. Data that does not start with cHandleMagic
+         or has an unknown handle type is rejected, but handle still has to
+         point to readable memory of at least sizeof(ObjectHandle) bytes.
+  */
+  DuskObject* resolveObject(const ObjectHandle* handle);
+  UniformMotionObject* resolveUniformMotion(const ObjectHandle* handle);
+  AnimatedObject* resolveAnimated(const ObjectHandle* handle);
+  NPC* resolveNPC(const ObjectHandle* handle);
+
+  /* creates the metatables for the handles. Has to be called after all other
+     bindings have been registered.
+  */
+  void registerHandles(lua_State *L);
+
+  /* pushes the metatables of all handle types onto the stack and returns
+     their number; registerHandles() has to be called before
+  */
+  int pushHandleMetatables(lua_State *L);
+
+} //namespace Lua
+
+} //namespace Dusk
+
+#endif // LUAOBJECTHANDLES_H
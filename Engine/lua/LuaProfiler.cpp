@@ -0,0 +1,306 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "LuaProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include "../Messages.h"
+
+namespace Dusk
+{
+
+LuaProfiler::LuaProfiler()
+: m_Running(false),
+  m_Instructions(cDefaultInstructions),
+  m_TotalWeight(0)
+{
+  m_Bindings.clear();
+  m_Chunks.clear();
+  m_FlatSamples.clear();
+  m_FoldedStacks.clear();
+}
+
+LuaProfiler::~LuaProfiler()
+{
+  m_Bindings.clear();
+  m_Chunks.clear();
+  m_FlatSamples.clear();
+  m_FoldedStacks.clear();
+}
+
+LuaProfiler& LuaProfiler::getSingleton()
+{
+  static LuaProfiler Instance;
+  return Instance;
+}
+
+void LuaProfiler::start(lua_State* L, const int instructions)
+{
+  m_Instructions = (instructions>0) ? instructions : cDefaultInstructions;
+  lua_sethook(L, profileHook, LUA_MASKCOUNT, m_Instructions);
+  m_Running = true;
+  DuskLog() << "LuaProfiler: started, one sample every " << m_Instructions
+            << " instructions.\n";
+}
+
+void LuaProfiler::stop(lua_State* L)
+{
+  lua_sethook(L, NULL, 0, 0);
+  m_Running = false;
+  DuskLog() << "LuaProfiler: stopped.\n";
+}
+
+bool LuaProfiler::isRunning() const
+{
+  return m_Running;
+}
+
+void LuaProfiler::reset()
+{
+  unsigned int i;
+  for (i=0; i<m_Bindings.size(); ++i)
+  {
+    m_Bindings[i].Time.Calls = 0;
+    m_Bindings[i].Time.TotalTime = 0;
+    m_Bindings[i].Time.MaxTime = 0;
+  }//for
+  m_Chunks.clear();
+  m_FlatSamples.clear();
+  m_FoldedStacks.clear();
+  m_TotalWeight = 0;
+}
+
+void LuaProfiler::instrumentTable(lua_State* L, const int index, const std::string& prefix, const std::set<std::string>* skip)
+{
+  //collect names first, changing the table while traversing it is not safe
+  std::vector<std::string> names;
+  lua_pushnil(L);
+  while (lua_next(L, index)!=0)
+  {
+    //key at -2, value at -1
+    if ((lua_type(L, -2)==LUA_TSTRING) and lua_iscfunction(L, -1)
+        and (lua_tocfunction(L, -1)!=profiledBinding))
+    {
+      const std::string name = lua_tostring(L, -2);
+      if ((skip==NULL) or (skip->find(name)==skip->end()))
+      {
+        names.push_back(name);
+      }
+    }
+    lua_pop(L, 1);
+  }//while
+
+  //pseudo-indices and negative indices change when values are pushed
+  const int table = ((index<0) and (index>LUA_REGISTRYINDEX)) ? lua_gettop(L)+index+1 : index;
+  unsigned int i;
+  for (i=0; i<names.size(); ++i)
+  {
+    lua_pushstring(L, names[i].c_str());
+    lua_rawget(L, table);
+    Binding b;
+    b.Name = prefix+names[i];
+    b.Function = lua_tocfunction(L, -1);
+    b.Time.Calls = 0;
+    b.Time.TotalTime = 0;
+    b.Time.MaxTime = 0;
+    lua_pop(L, 1);
+    //the closures only get C functions without upvalues
+    if (b.Function==NULL)
+      continue;
+    m_Bindings.push_back(b);
+    lua_pushstring(L, names[i].c_str());
+    lua_pushnumber(L, m_Bindings.size()-1);
+    lua_pushcclosure(L, profiledBinding, 1);
+    lua_rawset(L, table);
+  }//for
+}
+
+int LuaProfiler::profiledBinding(lua_State* L)
+{
+  LuaProfiler& profiler = getSingleton();
+  Binding& b = profiler.m_Bindings[static_cast<unsigned int>(lua_tonumber(L, lua_upvalueindex(1)))];
+  if (!profiler.m_Running)
+  {
+    return b.Function(L);
+  }
+  //Calls are counted before, because functions that raise a Lua error do
+  // not return here. Their time is not recorded.
+  ++b.Time.Calls;
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const int results = b.Function(L);
+  const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now()-start).count();
+  b.Time.TotalTime += ns;
+  if (ns>b.Time.MaxTime)
+    b.Time.MaxTime = ns;
+  return results;
+}
+
+void LuaProfiler::profileHook(lua_State* L, lua_Debug* ar)
+{
+  LuaProfiler& profiler = getSingleton();
+  profiler.sample(L, profiler.m_Instructions);
+}
+
+void LuaProfiler::sample(lua_State* L, const unsigned int weight)
+{
+  if (!m_Running)
+    return;
+  lua_Debug ar;
+  std::string folded = "";
+  std::string top = "";
+  int level = 0;
+  while ((level<cMaxStackDepth) and (lua_getstack(L, level, &ar)!=0))
+  {
+    lua_getinfo(L, "Sln", &ar);
+    const std::string name = (ar.name!=NULL) ? ar.name : "?";
+    std::stringstream frame;
+    if (ar.what!=NULL and (std::string(ar.what)=="C"))
+    {
+      frame << name << " [C]";
+      if (level==0)
+        top = frame.str();
+    }
+    else
+    {
+      frame << name << "@" << ar.short_src << ":" << ar.linedefined;
+      if (level==0)
+      {
+        std::stringstream line;
+        line << name << " (" << ar.short_src << ":" << ar.currentline << ")";
+        top = line.str();
+      }
+    }
+    //innermost frame comes last in the folded format
+    std::string f = frame.str();
+    std::replace(f.begin(), f.end(), ';', ':');
+    folded = (level==0) ? f : f+";"+folded;
+    ++level;
+  }//while
+  if (level==0)
+    return;
+  m_FlatSamples[top] += weight;
+  m_FoldedStacks[folded] += weight;
+  m_TotalWeight += weight;
+}
+
+void LuaProfiler::addTime(Timing& t, const uint64_t nanoseconds)
+{
+  ++t.Calls;
+  t.TotalTime += nanoseconds;
+  if (nanoseconds>t.MaxTime)
+    t.MaxTime = nanoseconds;
+}
+
+void LuaProfiler::recordChunk(const std::string& name, const uint64_t nanoseconds)
+{
+  std::map<std::string, Timing>::iterator iter = m_Chunks.find(name);
+  if (iter==m_Chunks.end())
+  {
+    Timing t;
+    t.Calls = 0;
+    t.TotalTime = 0;
+    t.MaxTime = 0;
+    iter = m_Chunks.insert(std::pair<std::string, Timing>(name, t)).first;
+  }
+  addTime(iter->second, nanoseconds);
+}
+
+void LuaProfiler::logProfile(const unsigned int maxEntries) const
+{
+  unsigned int i;
+  //flat profile, sorted by weight
+  std::vector<std::pair<uint64_t, std::string> > sorted;
+  std::map<std::string, uint64_t>::const_iterator s_iter = m_FlatSamples.begin();
+  while (s_iter!=m_FlatSamples.end())
+  {
+    sorted.push_back(std::pair<uint64_t, std::string>(s_iter->second, s_iter->first));
+    ++s_iter;
+  }//while
+  std::sort(sorted.rbegin(), sorted.rend());
+  DuskLog() << "Lua profile: " << m_TotalWeight << " sampled instructions\n";
+  for (i=0; (i<sorted.size()) and (i<maxEntries); ++i)
+  {
+    DuskLog() << "  " << sorted[i].first*100.0/m_TotalWeight << "%  "
+              << sorted[i].second << "\n";
+  }//for
+
+  //bindings, sorted by total time
+  std::vector<std::pair<uint64_t, unsigned int> > bindings;
+  for (i=0; i<m_Bindings.size(); ++i)
+  {
+    if (m_Bindings[i].Time.Calls>0)
+      bindings.push_back(std::pair<uint64_t, unsigned int>(m_Bindings[i].Time.TotalTime, i));
+  }//for
+  std::sort(bindings.rbegin(), bindings.rend());
+  DuskLog() << "C functions called from Lua:\n";
+  for (i=0; (i<bindings.size()) and (i<maxEntries); ++i)
+  {
+    const Binding& b = m_Bindings[bindings[i].second];
+    DuskLog() << "  " << b.Name << ": " << b.Time.Calls << " calls, "
+              << b.Time.TotalTime/1000000.0 << " ms total, "
+              << b.Time.TotalTime/1000.0/b.Time.Calls << " us average, "
+              << b.Time.MaxTime/1000.0 << " us max\n";
+  }//for
+
+  //chunks, sorted by total time
+  std::vector<std::pair<uint64_t, std::string> > chunks;
+  std::map<std::string, Timing>::const_iterator c_iter = m_Chunks.begin();
+  while (c_iter!=m_Chunks.end())
+  {
+    chunks.push_back(std::pair<uint64_t, std::string>(c_iter->second.TotalTime, c_iter->first));
+    ++c_iter;
+  }//while
+  std::sort(chunks.rbegin(), chunks.rend());
+  DuskLog() << "Lua chunks:\n";
+  for (i=0; (i<chunks.size()) and (i<maxEntries); ++i)
+  {
+    const Timing& t = m_Chunks.find(chunks[i].second)->second;
+    DuskLog() << "  \"" << chunks[i].second << "\": " << t.Calls << " runs, "
+              << t.TotalTime/1000000.0 << " ms total, "
+              << t.MaxTime/1000.0 << " us max\n";
+  }//for
+}
+
+bool LuaProfiler::writeFoldedStacks(const std::string& fileName) const
+{
+  std::ofstream output;
+  output.open(fileName.c_str(), std::ios::out | std::ios::trunc);
+  if (!output)
+  {
+    DuskLog() << "LuaProfiler::writeFoldedStacks: ERROR: could not open file \""
+              << fileName << "\" for writing.\n";
+    return false;
+  }
+  std::map<std::string, uint64_t>::const_iterator iter = m_FoldedStacks.begin();
+  while (iter!=m_FoldedStacks.end())
+  {
+    output << iter->first << " " << iter->second << "\n";
+    ++iter;
+  }//while
+  const bool success = output.good();
+  output.close();
+  return success;
+}
+
+} //namespace
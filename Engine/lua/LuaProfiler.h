@@ -0,0 +1,169 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: LuaProfiler Singleton class
+          sampling profiler for Lua scripts, and call counts and timing for
+          the C functions that are available in Lua
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - If you find one (or more), then tell me please. I'll try to fix it as
+       soon as possible.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUAPROFILER_H
+#define LUAPROFILER_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+class LuaProfiler
+{
+  public:
+    /* destructor */
+    ~LuaProfiler();
+
+    /* singleton access */
+    static LuaProfiler& getSingleton();
+
+    /* starts profiling
+
+       parameters:
+           L            - the main Lua state
+           instructions - number of Lua instructions between two samples
+
+       remarks:
+           The threads of scripts started by LuaEngine::processScripts() have
+           their own hook, which calls sample() in its place.
+    */
+    void start(lua_State* L, const int instructions=cDefaultInstructions);
+
+    /* stops profiling, the collected data is kept */
+    void stop(lua_State* L);
+
+    /* returns true, if the profiler is running */
+    bool isRunning() const;
+
+    /* removes all collected data */
+    void reset();
+
+    /* replaces every C function in the table at index by a closure that
+       counts and times calls to that function, while the profiler is running
+
+       parameters:
+           L      - the Lua state
+           index  - stack index of the table, may be LUA_GLOBALSINDEX
+           prefix - prefix for the names of the functions in the profile
+           skip   - names of fields which shall not be instrumented (may be
+                    NULL)
+    */
+    void instrumentTable(lua_State* L, const int index, const std::string& prefix, const std::set<std::string>* skip=NULL);
+
+    /* records a sample of the call stack of L
+
+       parameters:
+           L      - the Lua state or thread whose stack is sampled
+           weight - number of instructions that the sample stands for
+    */
+    void sample(lua_State* L, const unsigned int weight);
+
+    /* records the time that a chunk (string or file) needed to run
+
+       parameters:
+           name        - name of the chunk, e.g. a file name
+           nanoseconds - time in nanoseconds
+    */
+    void recordChunk(const std::string& name, const uint64_t nanoseconds);
+
+    /* writes the flat profile, the binding calls and the chunk timing to the
+       log, at most maxEntries lines each
+    */
+    void logProfile(const unsigned int maxEntries=30) const;
+
+    /* writes the sampled stacks in the folded format ("a;b;c count") that
+       flame graph tools expect, and returns true on success
+    */
+    bool writeFoldedStacks(const std::string& fileName) const;
+
+    /* default number of instructions between two samples */
+    static const int cDefaultInstructions = 1000;
+
+    /* maximum number of stack levels in a sample */
+    static const int cMaxStackDepth = 64;
+  private:
+    /* constructor - private, because it's a singleton */
+    LuaProfiler();
+
+    /* empty, private copy constructor due to singleton pattern */
+    LuaProfiler(const LuaProfiler& op) {}
+
+    /* the count hook for the main state */
+    static void profileHook(lua_State* L, lua_Debug* ar);
+
+    /* the closure that replaces an instrumented C function - its upvalue is
+       the index in m_Bindings
+    */
+    static int profiledBinding(lua_State* L);
+
+    struct Timing
+    {
+      unsigned long Calls;
+      uint64_t TotalTime; //nanoseconds
+      uint64_t MaxTime; //nanoseconds
+    };
+
+    struct Binding
+    {
+      std::string Name;
+      lua_CFunction Function;
+      Timing Time;
+    };
+
+    /* adds a time to t */
+    static void addTime(Timing& t, const uint64_t nanoseconds);
+
+    bool m_Running;
+    int m_Instructions;
+    uint64_t m_TotalWeight;
+    std::vector<Binding> m_Bindings;
+    std::map<std::string, Timing> m_Chunks;
+    std::map<std::string, uint64_t> m_FlatSamples; //function and line -> weight
+    std::map<std::string, uint64_t> m_FoldedStacks; //folded stack -> weight
+}; //class
+
+} //namespace
+
+#endif // LUAPROFILER_H
@@ -0,0 +1,43 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "LuaTimeSlice.h"
+#include <cstring>
+
+namespace Dusk
+{
+
+#ifdef DUSK_LUA51
+bool canYieldFromHook(lua_State* L)
+{
+  lua_Debug ar;
+  if (lua_getstack(L, 0, &ar)==0)
+    return false;
+  //any frame below the current one (including the pseudo frame of a tail
+  // call) means that the current function was called by someone
+  lua_Debug below;
+  if (lua_getstack(L, 1, &below)!=0)
+    return false;
+  lua_getinfo(L, "S", &ar);
+  return ((ar.what!=NULL) and (std::strcmp(ar.what, "C")!=0));
+}
+#endif
+
+} //namespace
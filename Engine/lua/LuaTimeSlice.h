@@ -0,0 +1,67 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: canYieldFromHook()
+          decides where a count hook may pre-empt a Lua script, used by the
+          time slices of LuaEngine
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+
+ ToDo list:
+     - ???
+
+ Bugs:
+     - If you find one (or more), then tell me please. I'll try to fix it as
+       soon as possible.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUATIMESLICE_H
+#define LUATIMESLICE_H
+
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+#ifdef DUSK_LUA51
+/* returns true, if a hook may yield the thread L, i.e. if L runs the function
+   that was started by lua_resume() itself and nothing that it called.
+
+   remarks:
+       Lua 5.1 cannot yield across C functions (pcall, table.sort, gsub, ...)
+       or across functions that the interpreter calls itself (metamethods,
+       iterators of generic for loops). The debug interface cannot tell the
+       latter from ordinary calls reliably - an iterator has the namewhat
+       "local", for example -, so only the bottom frame of the thread counts
+       as safe. There, no call boundary can be below the hook.
+       A script that spends all its time in one called function is never
+       pre-empted and is left to the runaway limit of LuaEngine.
+*/
+bool canYieldFromHook(lua_State* L);
+#endif
+
+} //namespace
+
+#endif // LUATIMESLICE_H
@@ -0,0 +1,409 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+#include "LuaWorkerPool.h"
+#include <chrono>
+#include "LuaEngine.h"
+#include "../ThreadPool.h"
+#include "../Messages.h"
+
+namespace Dusk
+{
+
+//end of the time limit of the job that runs on this thread
+thread_local std::chrono::steady_clock::time_point tl_JobDeadline;
+
+//globals that jobs may use - nothing that loads code (loadstring, require),
+// touches files (dofile, loadfile) or reaches the real globals (getfenv)
+const char* const cWorkerGlobals[] = {
+  "assert", "error", "ipairs", "next", "pairs", "pcall", "rawequal", "rawget",
+  "rawset", "select", "setmetatable", "getmetatable", "tonumber", "tostring",
+  "type", "unpack", "xpcall", "_VERSION", "string", "math", "bit", NULL
+};
+
+/* LuaValue functions */
+
+LuaValue::LuaValue()
+: Type(lvNil),
+  Boolean(false),
+  Number(0),
+  String("")
+{
+}
+
+void LuaValue::push(lua_State* L) const
+{
+  switch (Type)
+  {
+    case lvBoolean:
+         lua_pushboolean(L, Boolean ? 1 : 0);
+         break;
+    case lvNumber:
+         lua_pushnumber(L, Number);
+         break;
+    case lvString:
+         lua_pushlstring(L, String.c_str(), String.length());
+         break;
+    default:
+         lua_pushnil(L);
+         break;
+  }//swi
+}
+
+bool LuaValue::read(lua_State* L, const int index)
+{
+  switch (lua_type(L, index))
+  {
+    case LUA_TNIL:
+    case LUA_TNONE:
+         Type = lvNil;
+         return true;
+    case LUA_TBOOLEAN:
+         Type = lvBoolean;
+         Boolean = (lua_toboolean(L, index)!=0);
+         return true;
+    case LUA_TNUMBER:
+         Type = lvNumber;
+         Number = lua_tonumber(L, index);
+         return true;
+    case LUA_TSTRING:
+         Type = lvString;
+         String = std::string(lua_tostring(L, index), lua_strlen(L, index));
+         return true;
+    default:
+         Type = lvNil;
+         return false;
+  }//swi
+}
+
+/* LuaWorkerPool functions */
+
+LuaWorkerPool::LuaWorkerPool()
+: m_Pool(NULL),
+  m_Pending(0),
+  m_RunawayLimit(2000.0f),
+  m_Stopping(false)
+{
+  m_States.clear();
+  m_FreeStates.clear();
+  m_Results.clear();
+}
+
+LuaWorkerPool::~LuaWorkerPool()
+{
+  //Deleting the pool waits for all jobs that are still queued or running.
+  // The hook stops them, so that endless loops cannot block the shutdown.
+  m_Stopping = true;
+  delete m_Pool;
+  m_Pool = NULL;
+  unsigned int i;
+  for (i=0; i<m_States.size(); ++i)
+  {
+    lua_close(m_States[i].Lua);
+  }//for
+  m_States.clear();
+  m_FreeStates.clear();
+  //callbacks of unprocessed results are not called any more
+  m_Results.clear();
+}
+
+LuaWorkerPool& LuaWorkerPool::getSingleton()
+{
+  static LuaWorkerPool Instance;
+  return Instance;
+}
+
+bool LuaWorkerPool::start(const unsigned int threads)
+{
+  if (m_Pool!=NULL)
+    return true;
+  ThreadPool* pool = new ThreadPool(threads);
+  //one Lua state per thread, so a job always finds a free state
+  const unsigned int count = pool->getNumberOfThreads();
+  m_States.reserve(count);
+  unsigned int i;
+  for (i=0; i<count; ++i)
+  {
+    WorkerState ws;
+    ws.Lua = lua_open();
+    if (ws.Lua==NULL)
+    {
+      DuskLog() << "LuaWorkerPool::start: ERROR: lua_open() failed!\n";
+      delete pool;
+      for (i=0; i<m_States.size(); ++i)
+      {
+        lua_close(m_States[i].Lua);
+      }//for
+      m_States.clear();
+      return false;
+    }
+    //only libraries that do not touch files or the game
+    #ifdef DUSK_LUAJIT
+    const luaL_Reg cLibraries[] = {
+      {"", luaopen_base},
+      {LUA_STRLIBNAME, luaopen_string},
+      {LUA_MATHLIBNAME, luaopen_math},
+      {LUA_BITLIBNAME, luaopen_bit},
+      {NULL, NULL}
+    };
+    openJITLibraries(ws.Lua, cLibraries);
+    #else
+    luaopen_base(ws.Lua);
+    luaopen_string(ws.Lua);
+    luaopen_math(ws.Lua);
+    #endif
+    lua_settop(ws.Lua, 0);
+    //jobs get copies of these globals only, see pushEnvironment()
+    lua_newtable(ws.Lua);
+    const char* const * name = cWorkerGlobals;
+    while (*name!=NULL)
+    {
+      lua_pushstring(ws.Lua, *name);
+      lua_pushstring(ws.Lua, *name);
+      lua_gettable(ws.Lua, LUA_GLOBALSINDEX);
+      lua_rawset(ws.Lua, -3);
+      ++name;
+    }//while
+    ws.Globals = luaL_ref(ws.Lua, LUA_REGISTRYINDEX);
+    #ifdef DUSK_LUA51
+    //Methods of strings use the string library through the metatable of
+    // strings, so getmetatable("") must not give jobs access to it.
+    lua_pushstring(ws.Lua, "");
+    if (lua_getmetatable(ws.Lua, -1)!=0)
+    {
+      lua_pushstring(ws.Lua, "__metatable");
+      lua_pushboolean(ws.Lua, 0);
+      lua_rawset(ws.Lua, -3);
+      lua_pop(ws.Lua, 1);
+    }
+    lua_pop(ws.Lua, 1);
+    #endif
+    lua_sethook(ws.Lua, runawayHook, LUA_MASKCOUNT, cHookInstructions);
+    lua_newtable(ws.Lua);
+    ws.ChunkCache = luaL_ref(ws.Lua, LUA_REGISTRYINDEX);
+    ws.CachedChunks = 0;
+    m_States.push_back(ws);
+  }//for
+  m_FreeStates.clear();
+  for (i=0; i<m_States.size(); ++i)
+  {
+    m_FreeStates.push_back(&m_States[i]);
+  }//for
+  m_Pool = pool;
+  DuskLog() << "LuaWorkerPool: started " << count << " worker states.\n";
+  return true;
+}
+
+unsigned int LuaWorkerPool::getNumberOfWorkers() const
+{
+  return m_States.size();
+}
+
+void LuaWorkerPool::run(const std::string& code, const std::vector<LuaValue>& input, const LuaJobCallback& callback)
+{
+  if ((m_Pool==NULL) and !start())
+  {
+    std::vector<LuaValue> error(1);
+    error[0].Type = LuaValue::lvString;
+    error[0].String = "Lua worker states could not be started";
+    callback(false, error);
+    return;
+  }
+  ++m_Pending;
+  m_Pool->enqueue(std::bind(&LuaWorkerPool::runJob, this, code, input, callback));
+}
+
+void LuaWorkerPool::runJob(const std::string& code, const std::vector<LuaValue>& input, const LuaJobCallback& callback)
+{
+  WorkerState* state = NULL;
+  {
+    std::lock_guard<std::mutex> lock(m_StateMutex);
+    state = m_FreeStates.back();
+    m_FreeStates.pop_back();
+  }
+  JobResult result;
+  result.Callback = callback;
+  tl_JobDeadline = std::chrono::steady_clock::now()
+      + std::chrono::microseconds(static_cast<long>(m_RunawayLimit.load()*1000.0f));
+  result.Success = execute(*state, code, input, result.Results);
+  {
+    std::lock_guard<std::mutex> lock(m_StateMutex);
+    m_FreeStates.push_back(state);
+  }
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  m_Results.push_back(result);
+}
+
+bool LuaWorkerPool::execute(WorkerState& state, const std::string& code,
+                            const std::vector<LuaValue>& input, std::vector<LuaValue>& results)
+{
+  lua_State* L = state.Lua;
+  results.clear();
+  //get the compiled chunk from the cache
+  lua_rawgeti(L, LUA_REGISTRYINDEX, state.ChunkCache);
+  lua_pushlstring(L, code.c_str(), code.length());
+  lua_rawget(L, -2);
+  if (!lua_isfunction(L, -1))
+  {
+    lua_pop(L, 1);
+    if (state.CachedChunks>=cMaxCachedChunks)
+    {
+      lua_pop(L, 1);
+      luaL_unref(L, LUA_REGISTRYINDEX, state.ChunkCache);
+      lua_newtable(L);
+      state.ChunkCache = luaL_ref(L, LUA_REGISTRYINDEX);
+      state.CachedChunks = 0;
+      lua_rawgeti(L, LUA_REGISTRYINDEX, state.ChunkCache);
+    }
+    #ifdef DUSK_LUA51
+    const int errCode = luaL_loadstring(L, code.c_str());
+    #elif defined(DUSK_LUA50)
+    const int errCode = luaL_loadbuffer(L, code.c_str(), code.length(), code.c_str());
+    #else
+      #error "LuaWorkerPool could not detect a known Lua version!"
+    #endif
+    if (errCode!=0)
+    {
+      results.resize(1);
+      results[0].read(L, -1);
+      lua_settop(L, 0);
+      return false;
+    }
+    lua_pushlstring(L, code.c_str(), code.length());
+    lua_pushvalue(L, -2);
+    lua_rawset(L, -4);
+    ++state.CachedChunks;
+  }
+  //remove the cache table, keep the function
+  lua_remove(L, -2);
+
+  //globals of earlier jobs are not visible in the new environment
+  pushEnvironment(state, input);
+  lua_setfenv(L, -2);
+
+  const bool success = (lua_pcall(L, 0, LUA_MULTRET, 0)==0);
+  //results (or the error message) are the whole stack now
+  const int top = lua_gettop(L);
+  results.resize(top);
+  int idx;
+  for (idx=1; idx<=top; ++idx)
+  {
+    //tables, functions etc. cannot be passed and become nil
+    results[idx-1].read(L, idx);
+  }//for
+  lua_settop(L, 0);
+  return success;
+}
+
+void LuaWorkerPool::pushEnvironment(WorkerState& state, const std::vector<LuaValue>& input)
+{
+  lua_State* L = state.Lua;
+  lua_newtable(L);
+  lua_rawgeti(L, LUA_REGISTRYINDEX, state.Globals);
+  lua_pushnil(L);
+  while (lua_next(L, -2)!=0)
+  {
+    //stack: environment, globals, key, value
+    if (lua_istable(L, -1))
+    {
+      //libraries are copied, so that changes do not reach the next job
+      lua_newtable(L);
+      lua_pushnil(L);
+      while (lua_next(L, -3)!=0)
+      {
+        lua_pushvalue(L, -2);
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+      }//while
+      lua_remove(L, -2);
+    }
+    lua_pushvalue(L, -2);
+    lua_insert(L, -2);
+    lua_rawset(L, -5);
+  }//while
+  lua_pop(L, 1);
+  lua_pushstring(L, "_G");
+  lua_pushvalue(L, -2);
+  lua_rawset(L, -3);
+  //input values
+  lua_pushstring(L, "input");
+  lua_newtable(L);
+  unsigned int i;
+  for (i=0; i<input.size(); ++i)
+  {
+    input[i].push(L);
+    lua_rawseti(L, -2, i+1);
+  }//for
+  lua_rawset(L, -3);
+}
+
+unsigned int LuaWorkerPool::processResults()
+{
+  std::deque<JobResult> finished;
+  {
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    if (m_Results.empty())
+      return 0;
+    finished.swap(m_Results);
+  }
+  const unsigned int count = finished.size();
+  while (!finished.empty())
+  {
+    const JobResult& r = finished.front();
+    if (r.Callback)
+      r.Callback(r.Success, r.Results);
+    finished.pop_front();
+    --m_Pending;
+  }//while
+  return count;
+}
+
+unsigned int LuaWorkerPool::getNumberOfPendingJobs() const
+{
+  return m_Pending;
+}
+
+void LuaWorkerPool::setRunawayLimit(const float milliseconds)
+{
+  if (milliseconds>0.0f)
+    m_RunawayLimit = milliseconds;
+}
+
+float LuaWorkerPool::getRunawayLimit() const
+{
+  return m_RunawayLimit;
+}
+
+void LuaWorkerPool::runawayHook(lua_State* L, lua_Debug* ar)
+{
+  if (getSingleton().m_Stopping)
+  {
+    luaL_error(L, "job was stopped, because the worker states are closed");
+    return;
+  }
+  if (std::chrono::steady_clock::now()>=tl_JobDeadline)
+  {
+    luaL_error(L, "job ran for more than %d ms and was stopped",
+               static_cast<int>(getSingleton().getRunawayLimit()));
+  }
+}
+
+} //namespace
@@ -0,0 +1,214 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+
+/*---------------------------------------------------------------------------
+ Author:  thoronador
+ Date:    2026-10-19
+ Purpose: LuaWorkerPool Singleton class
+          runs pure Lua computations on separate Lua states in worker threads
+
+ History:
+     - 2026-10-19           - initial version (by thoronador)
+     - 2026-10-19           - jobs are stopped after a time limit, see
+                              setRunawayLimit(); dofile and loadfile removed
+                            - LuaJIT's libraries are opened through Lua
+     - 2026-10-19           - jobs only get an allowlist of globals and run
+                              in a fresh environment each
+
+ ToDo list:
+     - allow tables as input and result values
+
+ Bugs:
+     - If you find one (or more), then tell me please. I'll try to fix it as
+       soon as possible.
+ --------------------------------------------------------------------------*/
+
+#ifndef LUAWORKERPOOL_H
+#define LUAWORKERPOOL_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "LuaIncludes.h"
+
+namespace Dusk
+{
+
+//forward declaration
+class ThreadPool;
+
+/* a value that can be passed between Lua states */
+struct LuaValue
+{
+  enum ValueType {lvNil, lvBoolean, lvNumber, lvString};
+
+  ValueType Type;
+  bool Boolean;
+  lua_Number Number;
+  std::string String;
+
+  /* constructor - creates nil */
+  LuaValue();
+
+  /* pushes the value onto the stack of L */
+  void push(lua_State* L) const;
+
+  /* reads the value at index of the stack of L and returns true, if it has a
+     type that can be passed (nil, boolean, number or string)
+  */
+  bool read(lua_State* L, const int index);
+};
+
+/* function that gets the results of a job on the main thread
+
+   parameters:
+       success - true, if the code ran without errors
+       results - values returned by the code, or the error message
+*/
+typedef std::function<void(const bool success, const std::vector<LuaValue>& results)> LuaJobCallback;
+
+/*class LuaWorkerPool:
+        Every worker thread has its own Lua state with the string and math
+        libraries and the base functions that cannot load code or touch files
+        (see cWorkerGlobals in LuaWorkerPool.cpp), but without any of Dusk's
+        functions. Each job runs in a fresh environment with copies of these
+        globals, so jobs cannot see the globals of earlier jobs or change the
+        libraries for later ones. Code that runs there can only compute
+        something from the values it gets, and return values. Anything that changes the game has
+        to be done by the callback, which is called on the main thread by
+        processResults().
+        A job that runs longer than the runaway limit is stopped with an error.
+*/
+class LuaWorkerPool
+{
+  public:
+    /* destructor - waits for running jobs */
+    ~LuaWorkerPool();
+
+    /* singleton access */
+    static LuaWorkerPool& getSingleton();
+
+    /* starts the worker threads and their Lua states and returns true on
+       success. Does nothing, if the workers are already running.
+
+       parameters:
+           threads - number of workers; zero means one per hardware thread
+    */
+    bool start(const unsigned int threads=0);
+
+    /* returns the number of workers, zero if not started */
+    unsigned int getNumberOfWorkers() const;
+
+    /* queues Lua code to run on a worker state, starts the workers with the
+       default number of threads, if needed
+
+       parameters:
+           code     - Lua code; the input values are in the global table input
+                      (input[1], input[2], ...), and the values returned by the
+                      code are passed to the callback
+           input    - values for the code
+           callback - function that gets the results on the main thread
+    */
+    void run(const std::string& code, const std::vector<LuaValue>& input, const LuaJobCallback& callback);
+
+    /* calls the callbacks of finished jobs and returns their number. Has to
+       be called by the main thread, e.g. once per frame.
+    */
+    unsigned int processResults();
+
+    /* returns the number of jobs that are queued, running, or whose results
+       were not processed yet
+    */
+    unsigned int getNumberOfPendingJobs() const;
+
+    /* sets the time after which a running job is stopped with an error
+
+       parameters:
+           milliseconds - the new limit, has to be more than zero
+    */
+    void setRunawayLimit(const float milliseconds);
+
+    /* returns the time in milliseconds after which a job is stopped */
+    float getRunawayLimit() const;
+
+    /* maximum number of compiled chunks cached per worker state */
+    static const unsigned int cMaxCachedChunks = 256;
+  private:
+    /* constructor - private, because it's a singleton */
+    LuaWorkerPool();
+
+    /* empty, private copy constructor due to singleton pattern */
+    LuaWorkerPool(const LuaWorkerPool& op) {}
+
+    /* a Lua state of a worker */
+    struct WorkerState
+    {
+      lua_State* Lua;
+      int ChunkCache; //registry reference of the table of compiled chunks
+      int Globals; //registry reference of the table of allowed globals
+      unsigned int CachedChunks;
+    };
+
+    /* a finished job */
+    struct JobResult
+    {
+      LuaJobCallback Callback;
+      bool Success;
+      std::vector<LuaValue> Results;
+    };
+
+    /* runs one job on a free worker state - called by the worker threads */
+    void runJob(const std::string& code, const std::vector<LuaValue>& input, const LuaJobCallback& callback);
+
+    /* pushes a new environment for a job onto the stack of state: a copy of
+       the allowed globals (library tables are copied, too), _G and input
+    */
+    static void pushEnvironment(WorkerState& state, const std::vector<LuaValue>& input);
+
+    /* runs code on state and returns true on success */
+    static bool execute(WorkerState& state, const std::string& code,
+                        const std::vector<LuaValue>& input, std::vector<LuaValue>& results);
+
+    /* count hook of the worker states, which stops jobs that exceed the
+       runaway limit or still run while the pool shuts down
+    */
+    static void runawayHook(lua_State* L, lua_Debug* ar);
+
+    /* number of instructions between two calls of runawayHook() */
+    static const int cHookInstructions = 1000;
+
+    ThreadPool* m_Pool; //created by start()
+    std::vector<WorkerState> m_States;
+    std::vector<WorkerState*> m_FreeStates;
+    std::mutex m_StateMutex;
+    std::deque<JobResult> m_Results;
+    std::mutex m_ResultMutex;
+    std::atomic<unsigned int> m_Pending;
+    std::atomic<float> m_RunawayLimit; //milliseconds per job
+    std::atomic<bool> m_Stopping; //set by the destructor
+}; //class
+
+} //namespace
+
+#endif // LUAWORKERPOOL_H
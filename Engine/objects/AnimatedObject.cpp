@@ -22,6 +22,7 @@
 #include "../database/ObjectRecord.h" //should possibly replace this one later
 #include "../database/Database.h"
 #include <OgreAnimationState.h>
+#include <OgreCamera.h>
 #include "../DuskConstants.h"
 #include "../VertexDataFunc.h"
 #include "../Messages.h"
@@ -41,16 +42,31 @@ AnimRecord::AnimRecord(const float pos, const bool loop)
 {
 }
 
+const Ogre::Camera* AnimatedObject::s_LODCamera = NULL;
+float AnimatedObject::s_LODNearSquared = 0.0f;
+float AnimatedObject::s_LODFarSquared = 0.0f;
+unsigned int AnimatedObject::s_NextAnimationFrame = 0;
+
 //ctor
 AnimatedObject::AnimatedObject()
 : InjectionObject(),
-  m_Anims(std::map<std::string, AnimRecord>())
+  m_Anims(std::map<std::string, AnimRecord>()),
+  m_ActiveStates(std::vector<Ogre::AnimationState*>()),
+  m_ActiveStatesValid(false),
+  m_PendingAnimationTime(0.0f),
+  m_AnimationFrame(s_NextAnimationFrame++),
+  m_InstanceBucket(NULL)
 {
 }
 
 AnimatedObject::AnimatedObject(const std::string& _ID, const Ogre::Vector3& pos, const Ogre::Quaternion& rot, const float Scale)
 : InjectionObject(_ID, pos, rot, Scale),
-  m_Anims(std::map<std::string, AnimRecord>())
+  m_Anims(std::map<std::string, AnimRecord>()),
+  m_ActiveStates(std::vector<Ogre::AnimationState*>()),
+  m_ActiveStatesValid(false),
+  m_PendingAnimationTime(0.0f),
+  m_AnimationFrame(s_NextAnimationFrame++),
+  m_InstanceBucket(NULL)
 {
 }
 
@@ -89,6 +105,8 @@ bool AnimatedObject::enable(Ogre::SceneManager* scm)
   ent_node->setOrientation(m_Rotation);
   //set user defined object to this object as reverse link
   entity->setUserAny(Ogre::Any(this));
+  m_ActiveStatesValid = false;
+  m_PendingAnimationTime = 0.0f;
   //restore saved or queued animations
   if (!m_Anims.empty())
   {
@@ -128,8 +146,12 @@ bool AnimatedObject::disable()
   {
     return true;
   }
+  leaveAnimationInstance();
   //synchro list
+  applyPendingAnimationTime();
   synchronizeAnimationList();
+  m_ActiveStates.clear();
+  m_ActiveStatesValid = false;
   //disable it
   Ogre::SceneNode* ent_node = entity->getParentSceneNode();
   Ogre::SceneManager * scm;
@@ -249,11 +271,16 @@ bool AnimatedObject::startAnimation(const std::string& AnimName, const bool DoLo
                   << "animation named \"" <<AnimName<<"\"!\n";
         return false;
       }
+      leaveAnimationInstance();
+      //other animations have to catch up before they are joined by this one
+      applyPendingAnimationTime();
       Ogre::AnimationState* state = entity->getAnimationState(AnimName);
       state->setTimePosition(0.0f);
       state->setLoop(DoLoop);
       state->setEnabled(true);
       m_Anims[AnimName] = AnimRecord(0.0f, DoLoop);
+      m_ActiveStatesValid = false;
+      m_Modified = true;
       return true;
     }//animation set given
   }
@@ -276,10 +303,13 @@ bool AnimatedObject::stopAnimation(const std::string& AnimName)
                 << "animation named \"" <<AnimName<<"\"!\n";
       return false;
     }
+    leaveAnimationInstance();
     Ogre::AnimationState* state = entity->getAnimationState(AnimName);
     state->setTimePosition(0.0f);
     state->setEnabled(false);
     m_Anims.erase(AnimName);
+    m_ActiveStatesValid = false;
+    m_Modified = true;
     return true;
   }//animation set given
   return false;
@@ -289,6 +319,7 @@ unsigned int AnimatedObject::stopAllAnimations()
 {
   if (entity==NULL)  // no entitiy -> no animation, so basically
     return 0;        // all animations are already "stopped" :P
+  leaveAnimationInstance();
   const Ogre::AnimationStateSet * anim_set = entity->getAllAnimationStates();
   if (NULL==anim_set)
   {
@@ -312,6 +343,13 @@ unsigned int AnimatedObject::stopAllAnimations()
     easIter = anim_set->getEnabledAnimationStateIterator();
   }//while
   m_Anims.clear();
+  m_ActiveStates.clear();
+  m_ActiveStatesValid = true;
+  m_PendingAnimationTime = 0.0f;
+  if (result!=0)
+  {
+    m_Modified = true;
+  }
   return result;
 }
 
@@ -408,20 +446,158 @@ void AnimatedObject::injectTime(const float SecondsPassed)
     return;
   }
   //adjust animation states
-  if (entity!=NULL)
+  if (entity==NULL)
+  {
+    return;
+  }
+  if (m_InstanceBucket!=NULL)
   {
-    const Ogre::AnimationStateSet* animSet = entity->getAllAnimationStates();
-    if (animSet!=NULL)
+    //AnimationInstancing advances the shared animation state
+    if (AnimationInstancing::getSingleton().isEnabled())
     {
-      Ogre::ConstEnabledAnimationStateIterator easIter = animSet->getEnabledAnimationStateIterator();
-      while (easIter.hasMoreElements())
-      {
-        Ogre::AnimationState* as = easIter.getNext();
-        as->addTime(SecondsPassed);
-        m_Anims[as->getAnimationName()].position = as->getTimePosition();
-      }//while
-    }// anim set present
-  }//if
+      return;
+    }
+    leaveAnimationInstance();
+  }
+  if (!m_ActiveStatesValid)
+  {
+    updateActiveStates();
+    joinAnimationInstance();
+  }
+  if (m_ActiveStates.empty())
+  {
+    return;
+  }
+  m_PendingAnimationTime += SecondsPassed;
+  ++m_AnimationFrame;
+  const unsigned int interval = getAnimationUpdateInterval();
+  if ((interval!=0) and ((m_AnimationFrame % interval)==0))
+  {
+    applyPendingAnimationTime();
+  }
+}
+
+void AnimatedObject::setAnimationLOD(const Ogre::Camera* cam, const float nearDistance, const float farDistance)
+{
+  s_LODCamera = cam;
+  s_LODNearSquared = nearDistance*nearDistance;
+  s_LODFarSquared = farDistance*farDistance;
+}
+
+unsigned int AnimatedObject::getAnimationUpdateInterval() const
+{
+  if (s_LODCamera==NULL)
+  {
+    return 1;
+  }
+  //not in view -> no update at all
+  if (!entity->isVisible())
+  {
+    return 0;
+  }
+  //The node's bounding box is the one of the last frame, but it is already
+  // there and needs no computation.
+  const Ogre::SceneNode* node = entity->getParentSceneNode();
+  if ((node==NULL) or !s_LODCamera->isVisible(node->_getWorldAABB()))
+  {
+    return 0;
+  }
+  const float distanceSquared = s_LODCamera->getDerivedPosition().squaredDistance(position);
+  if (distanceSquared<=s_LODNearSquared)
+  {
+    return 1;
+  }
+  if (distanceSquared<=s_LODFarSquared)
+  {
+    return 2;
+  }
+  return 4;
+}
+
+void AnimatedObject::applyPendingAnimationTime()
+{
+  if (m_PendingAnimationTime<=0.0f)
+  {
+    return;
+  }
+  if (!m_ActiveStatesValid)
+  {
+    updateActiveStates();
+  }
+  std::vector<Ogre::AnimationState*>::const_iterator iter;
+  for (iter=m_ActiveStates.begin(); iter!=m_ActiveStates.end(); ++iter)
+  {
+    (*iter)->addTime(m_PendingAnimationTime);
+  }//for
+  m_PendingAnimationTime = 0.0f;
+}
+
+void AnimatedObject::updateActiveStates()
+{
+  m_ActiveStates.clear();
+  m_ActiveStatesValid = true;
+  if (entity==NULL)
+  {
+    return;
+  }
+  const Ogre::AnimationStateSet* animSet = entity->getAllAnimationStates();
+  if (animSet!=NULL)
+  {
+    Ogre::ConstEnabledAnimationStateIterator easIter = animSet->getEnabledAnimationStateIterator();
+    while (easIter.hasMoreElements())
+    {
+      m_ActiveStates.push_back(easIter.getNext());
+    }//while
+  }// anim set present
+}
+
+void AnimatedObject::joinAnimationInstance()
+{
+  if ((m_InstanceBucket!=NULL) or (entity==NULL))
+  {
+    return;
+  }
+  if (!AnimationInstancing::getSingleton().isEnabled())
+  {
+    return;
+  }
+  if ((m_ActiveStates.size()!=1) or !m_ActiveStates[0]->getLoop())
+  {
+    return;
+  }
+  //copy name, because join() destroys the entity's own animation states
+  const std::string animName = m_ActiveStates[0]->getAnimationName();
+  const float timePosition = m_ActiveStates[0]->getTimePosition()+m_PendingAnimationTime;
+  m_InstanceBucket = AnimationInstancing::getSingleton().join(entity,
+                         getObjectMesh(), animName, timePosition);
+  if (m_InstanceBucket!=NULL)
+  {
+    m_PendingAnimationTime = 0.0f;
+    m_ActiveStates.assign(1, m_InstanceBucket->State);
+  }
+}
+
+void AnimatedObject::leaveAnimationInstance()
+{
+  if (m_InstanceBucket==NULL)
+  {
+    return;
+  }
+  const std::string animName = m_InstanceBucket->State->getAnimationName();
+  const float timePosition = m_InstanceBucket->State->getTimePosition();
+  AnimationInstancing::getSingleton().leave(m_InstanceBucket, entity);
+  m_InstanceBucket = NULL;
+  m_ActiveStates.clear();
+  m_ActiveStatesValid = false;
+  m_PendingAnimationTime = 0.0f;
+  if (entity!=NULL)
+  {
+    //continue where the bucket left off
+    Ogre::AnimationState* state = entity->getAnimationState(animName);
+    state->setTimePosition(timePosition);
+    state->setLoop(true);
+    state->setEnabled(true);
+  }
 }
 
 void AnimatedObject::synchronizeAnimationList()
@@ -445,7 +621,7 @@ void AnimatedObject::synchronizeAnimationList()
   }// anim set present
 }
 
-bool AnimatedObject::saveToStream(std::ofstream& OutStream) const
+bool AnimatedObject::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -453,7 +629,7 @@ bool AnimatedObject::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefA" (reference of AnimatedObject)
-  OutStream.write((const char*) &cHeaderRefA, sizeof(uint32_t));
+  OutStream.writeUInt32(cHeaderRefA);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -465,30 +641,36 @@ bool AnimatedObject::saveToStream(std::ofstream& OutStream) const
   return saveAnimatedObjectPart(OutStream);
 }
 
-bool AnimatedObject::saveAnimatedObjectPart(std::ofstream& OutStream) const
+bool AnimatedObject::saveAnimatedObjectPart(BinaryWriter& OutStream) const
 {
   // save new data members from AnimatedObject
   // -- save length
-  unsigned int len = m_Anims.size();
-  OutStream.write((const char*) &len, sizeof(len));
+  OutStream.writeUInt32(m_Anims.size());
   // -- save all animations
+  const Ogre::AnimationStateSet* animSet = (entity!=NULL) ? entity->getAllAnimationStates() : NULL;
   std::map<std::string, AnimRecord>::const_iterator cIter = m_Anims.begin();
   while (cIter != m_Anims.end())
   {
     // -- anim name
-    len = cIter->first.length();
-    OutStream.write((const char*) &len, sizeof(len));
-    OutStream.write(cIter->first.c_str(), len);
-    // -- position
-    OutStream.write((const char*) &(cIter->second.position), sizeof(float));
+    OutStream.writeString(cIter->first);
+    // -- position (m_Anims is not updated while the object is enabled)
+    if ((animSet!=NULL) and animSet->hasAnimationState(cIter->first))
+    {
+      OutStream.writeFloat(animSet->getAnimationState(cIter->first)->getTimePosition()
+                          +m_PendingAnimationTime);
+    }
+    else
+    {
+      OutStream.writeFloat(cIter->second.position);
+    }
     // -- loop mode
-    OutStream.write((const char*) &(cIter->second.DoLoop), sizeof(bool));
+    OutStream.writeBool(cIter->second.DoLoop);
     ++cIter;
   }//while
   return OutStream.good();
 }
 
-bool AnimatedObject::loadFromStream(std::ifstream& InStream)
+bool AnimatedObject::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -503,7 +685,7 @@ bool AnimatedObject::loadFromStream(std::ifstream& InStream)
   }
   //read header "RefA"
   uint32_t Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefA)
   {
     DuskLog() << "AnimatedObject::loadFromStream: ERROR: Stream contains "
@@ -521,13 +703,13 @@ bool AnimatedObject::loadFromStream(std::ifstream& InStream)
   return loadAnimatedObjectPart(InStream);
 }
 
-bool AnimatedObject::loadAnimatedObjectPart(std::ifstream& InStream)
+bool AnimatedObject::loadAnimatedObjectPart(BinaryReader& InStream)
 {
   //load data members from AnimatedObject
   //animation data
-  unsigned int count = 0;
+  uint32_t count = 0;
   //number of animations
-  InStream.read((char*) &count, sizeof(unsigned int));
+  InStream.readUInt32(count);
   if (count>100)
   {
     DuskLog() << "AnimatedObject::loadAnimatedObjectPart: ERROR: object seems "
@@ -536,38 +718,30 @@ bool AnimatedObject::loadAnimatedObjectPart(std::ifstream& InStream)
   }
   //clear animation list
   m_Anims.clear();
-  char ID_Buffer[256];
+  std::string animName;
   AnimRecord tempRec;
-  unsigned int i, len;
+  unsigned int i;
   for (i=0; i<count; ++i)
   {
-    // -- length of animation name
-    InStream.read((char*) &len, sizeof(unsigned int));
-    if (len>255)
-    {
-      DuskLog() << "AnimatedObject::loadAnimatedObjectPart: ERROR: animation "
-                << "name cannot be longer than 255 characters.\n";
-      return false;
-    }
-    InStream.read(ID_Buffer, len);
-    ID_Buffer[len] = '\0';
-    if (!InStream.good())
+    // -- animation name
+    if (!InStream.readString(animName))
     {
       DuskLog() << "AnimatedObject::loadAnimatedObjectPart: ERROR while reading "
-                << "animation name.\n";
+                << "animation name. (Name cannot be longer than 255 "
+                << "characters.)\n";
       return false;
     }
     // -- position
-    InStream.read((char*) &(tempRec.position), sizeof(float));
+    InStream.readFloat(tempRec.position);
     // -- loop mode
-    InStream.read((char*) &(tempRec.DoLoop), sizeof(bool));
+    InStream.readBool(tempRec.DoLoop);
     if (!InStream.good())
     {
       DuskLog() << "AnimatedObject::loadAnimatedObjectPart: ERROR while reading"
                 << " animation data.\n";
       return false;
     }
-    m_Anims[std::string(ID_Buffer)] = tempRec;
+    m_Anims[animName] = tempRec;
   }//for
   return (InStream.good());
 }
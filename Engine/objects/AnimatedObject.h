@@ -69,6 +69,13 @@
      - 2012-06-30 (rev 308) - update of getObjectMesh() definition
      - 2012-07-02 (rev 310) - update of getObjectMesh() and canCollide() to use
                               Database instead of ObjectBase
+     - 2026-10-19           - animation level of detail, see setAnimationLOD()
+                            - injectTime() uses a list of the enabled animation
+                              states instead of writing to m_Anims every frame
+                            - objects that play a single looping animation join
+                              an AnimationInstancing bucket, if it's turned on
+                            - starting or stopping animations marks the object
+                              as modified
 
  ToDo list:
      - review implementation of canCollide() at a later stage of development
@@ -84,7 +91,9 @@
 #include <OgreSceneManager.h>
 #include <vector>
 #include <map>
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
+#include "../AnimationInstancing.h"
 #include "InjectionObject.h"
 
 namespace Dusk
@@ -238,6 +247,29 @@ namespace Dusk
         */
         virtual void injectTime(const float SecondsPassed);
 
+        /* sets the animation level of detail (LOD) for all animated objects.
+           Objects within nearDistance of the camera are animated every frame,
+           objects within farDistance every second frame and objects that are
+           farther away every fourth frame. Objects outside of the camera's
+           view are not animated at all, until they get into view again. The
+           skipped time is added at the next update, so animations stay in
+           phase.
+
+           parameters:
+               cam          - the camera whose view and position are used; NULL
+                              turns the LOD off, i.e. every object will be
+                              animated every frame
+               nearDistance - distance up to which objects are animated in
+                              every frame
+               farDistance  - distance up to which objects are animated in
+                              every second frame
+
+           remarks:
+               As Ogre only evaluates a skeleton after its animation states
+               have changed, skipped updates save the evaluation, too.
+        */
+        static void setAnimationLOD(const Ogre::Camera* cam, const float nearDistance, const float farDistance);
+
         /* Saves the object to the given stream. Returns true on success, false
            otherwise.
 
@@ -248,7 +280,7 @@ namespace Dusk
                Every derived class has to have its own implementation of this
                function to ensure the object is saved properly.
         */
-        virtual bool saveToStream(std::ofstream& OutStream) const;
+        virtual bool saveToStream(BinaryWriter& OutStream) const;
 
         /* Tries to load an object from the given stream. Returns true on
            success, false otherwise.
@@ -262,7 +294,7 @@ namespace Dusk
                If the function returns false, the data within the object may be
                corrupted. It's advised not to use the object in this case.
         */
-        virtual bool loadFromStream(std::ifstream& InStream);
+        virtual bool loadFromStream(BinaryReader& InStream);
     protected:
         /* returns the name/path of the mesh that is used during enabling this
            object
@@ -283,7 +315,7 @@ namespace Dusk
              Derived classes will (most likely) call this function as part of
              their implementation of SaveToStream().
         */
-        bool saveAnimatedObjectPart(std::ofstream& OutStream) const;
+        bool saveAnimatedObjectPart(BinaryWriter& OutStream) const;
 
         /* Utility function which loads all data that is specific to an
            AnimatedObject from the given stream. Returns true on success.
@@ -295,15 +327,55 @@ namespace Dusk
              Derived classes will (most likely) call this function as part of
              their implementation of LoadFromStream().
         */
-        bool loadAnimatedObjectPart(std::ifstream& InStream);
+        bool loadAnimatedObjectPart(BinaryReader& InStream);
 
         /* updates the information about anims listed in m_Anims with currently
            playing animations
         */
         void synchronizeAnimationList();
 
+        /* returns the number of frames between two updates of the animation
+           states according to the LOD, or zero, if the object is not in view
+        */
+        unsigned int getAnimationUpdateInterval() const;
+
+        /* adds the time that has been skipped due to the LOD to the enabled
+           animation states
+        */
+        void applyPendingAnimationTime();
+
+        /* fills m_ActiveStates with the enabled animation states of entity */
+        void updateActiveStates();
+
+        /* lets the entity share the skeleton of other objects that play the
+           same animation, if animation instancing is turned on and the object
+           plays exactly one looping animation
+        */
+        void joinAnimationInstance();
+
+        /* lets the entity stop sharing its skeleton and continues the shared
+           animation on the entity's own animation states. Has to be called
+           before the animation states are changed.
+        */
+        void leaveAnimationInstance();
+
         //map that holds the animations while object is disabled
         std::map<std::string, AnimRecord> m_Anims;
+        //enabled animation states of the entity, valid if m_ActiveStatesValid
+        std::vector<Ogre::AnimationState*> m_ActiveStates;
+        bool m_ActiveStatesValid;
+        //time that has not been added to the animation states yet
+        float m_PendingAnimationTime;
+        //counts calls of injectTime(), starts at different values for
+        // different objects, so that throttled updates are spread evenly
+        unsigned int m_AnimationFrame;
+        //bucket whose skeleton is shared, or NULL
+        AnimationInstancing::Bucket* m_InstanceBucket;
+
+        static const Ogre::Camera* s_LODCamera;
+        static float s_LODNearSquared;
+        static float s_LODFarSquared;
+        static unsigned int s_NextAnimationFrame;
     }; //class AnimatedObject
 
 } //namespace
@@ -58,6 +58,7 @@ void Container::transferAllItemsTo(Inventory& target)
   m_Contents.addAllItemsTo(target);
   m_Contents.makeEmpty();
   m_Changed = true;
+  m_Modified = true;
 }
 
 void Container::addItem(const std::string& ItemID, const unsigned int count)
@@ -68,6 +69,7 @@ void Container::addItem(const std::string& ItemID, const unsigned int count)
   }
   m_Contents.addItem(ItemID, count);
   m_Changed = true;
+  m_Modified = true;
 }
 
 unsigned int Container::removeItem(const std::string& ItemID, const unsigned int count)
@@ -77,6 +79,7 @@ unsigned int Container::removeItem(const std::string& ItemID, const unsigned int
     return 0;
   }
   m_Changed = true;
+  m_Modified = true;
   return m_Contents.removeItem(ItemID, count);
 }
 
@@ -100,7 +103,7 @@ ObjectTypes Container::getDuskType() const
   return otContainer;
 }
 
-bool Container::saveToStream(std::ofstream& OutStream) const
+bool Container::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -108,7 +111,7 @@ bool Container::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefC" (reference of Container)
-  OutStream.write((const char*) &cHeaderRefC, sizeof(uint32_t)); //header
+  OutStream.writeUInt32(cHeaderRefC); //header
   //write data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -117,7 +120,7 @@ bool Container::saveToStream(std::ofstream& OutStream) const
   }
   //write inventory
   // -- flags
-  OutStream.write((const char*) &m_Changed, sizeof(bool));
+  OutStream.writeBool(m_Changed);
   // -- inventory (only if necessary)
   if (m_Changed)
   {
@@ -130,7 +133,7 @@ bool Container::saveToStream(std::ofstream& OutStream) const
   return (OutStream.good());
 }
 
-bool Container::loadFromStream(std::ifstream& InStream)
+bool Container::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -146,7 +149,7 @@ bool Container::loadFromStream(std::ifstream& InStream)
 
   //read header "RefC"
   uint32_t Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefC)
   {
     DuskLog() << "Container::loadFromStream: ERROR: Stream contains invalid "
@@ -162,7 +165,7 @@ bool Container::loadFromStream(std::ifstream& InStream)
   //Container's own stuff
   //load inventory
   // -- flags
-  InStream.read((char*) &m_Changed, sizeof(bool));
+  InStream.readBool(m_Changed);
   if (m_Changed)
   { //load it from stream, contents were changed
     if (!m_Contents.loadFromStream(InStream))
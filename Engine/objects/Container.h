@@ -126,7 +126,7 @@ namespace Dusk
          parameters:
                OutStream - the output stream to which the object will be saved
       */
-      virtual bool saveToStream(std::ofstream& OutStream) const;
+      virtual bool saveToStream(BinaryWriter& OutStream) const;
 
       /* Tries to load the container data from stream InStream and returns true
          on success, false otherwise.
@@ -137,7 +137,7 @@ namespace Dusk
          remarks:
              The container may have inconsistent data, if the function fails.
       */
-      virtual bool loadFromStream(std::ifstream& InStream);
+      virtual bool loadFromStream(BinaryReader& InStream);
     protected:
       /* returns the name/path of the mesh that is used during enabling this
          object
@@ -26,6 +26,10 @@
 #include <sstream>
 #include <OgreSceneNode.h>
 #include "../VertexDataFunc.h"
+#include "../lua/LuaObjectHandles.h"
+#ifndef DUSK_EDITOR
+  #include "../SoundEmitterManager.h"
+#endif
 
 namespace Dusk{
 
@@ -43,7 +47,9 @@ DuskObject::DuskObject()
   entity(NULL),
   position(Ogre::Vector3::ZERO),
   m_Rotation(Ogre::Quaternion::IDENTITY),
-  m_Scale(1.0f)
+  m_Scale(1.0f),
+  m_BaseIndex(cNoBaseIndex),
+  m_Modified(false)
 {
 }
 
@@ -52,7 +58,9 @@ DuskObject::DuskObject(const std::string& _ID, const Ogre::Vector3& pos, const O
   entity(NULL),
   position(pos),
   m_Rotation(rot),
-  m_Scale( (Scale>0.0f) ? Scale : 1.0f)
+  m_Scale( (Scale>0.0f) ? Scale : 1.0f),
+  m_BaseIndex(cNoBaseIndex),
+  m_Modified(false)
 {
 }
 
@@ -60,6 +68,12 @@ DuskObject::~DuskObject()
 {
   //deletes related Ogre entity and scene node, if present
   disable();
+  #ifndef DUSK_EDITOR
+  //sources must not follow an object that is gone
+  SoundEmitterManager::ownerDestroyed(this);
+  #endif
+  //handles in Lua scripts become invalid
+  Lua::ObjectHandleTable::objectDestroyed(this);
 }
 
 const Ogre::Vector3& DuskObject::getPosition() const
@@ -81,7 +95,11 @@ void DuskObject::setPosition(const Ogre::Vector3& pos)
       entity->getParentSceneNode()->setPosition(pos);
     }
   }
-  position = pos;
+  if (pos!=position)
+  {
+    position = pos;
+    m_Modified = true;
+  }
 }
 
 void DuskObject::setRotation(const Ogre::Quaternion& rot)
@@ -93,7 +111,11 @@ void DuskObject::setRotation(const Ogre::Quaternion& rot)
       entity->getParentSceneNode()->setOrientation(rot);
     }
   }
-  m_Rotation = rot;
+  if (rot!=m_Rotation)
+  {
+    m_Rotation = rot;
+    m_Modified = true;
+  }
 }
 
 float DuskObject::getScale() const
@@ -113,6 +135,7 @@ bool DuskObject::setScale(const float newScale)
   if (newScale>= cMinimumScaleBound)
   {
     m_Scale = newScale;
+    m_Modified = true;
     return true;
   }
   DuskLog() << "DuskObject::setScale: Error: new scaling factor ("<<newScale
@@ -131,6 +154,7 @@ bool DuskObject::changeID(const std::string& newID)
   if (newID!="" and entity==NULL)
   {
     ID = newID;
+    m_Modified = true;
     return true;
   }
   DuskLog() << "DuskObject::changeID: Error: Don't change ID of enabled object!\n";
@@ -281,7 +305,27 @@ bool DuskObject::isHitByRay(const Ogre::Ray& ray, Ogre::Vector3& impact) const
   return false;
 }
 
-bool DuskObject::saveToStream(std::ofstream& OutStream) const
+uint32_t DuskObject::getBaseIndex() const
+{
+  return m_BaseIndex;
+}
+
+void DuskObject::setBaseIndex(const uint32_t idx)
+{
+  m_BaseIndex = idx;
+}
+
+bool DuskObject::isModified() const
+{
+  return m_Modified;
+}
+
+void DuskObject::setModified(const bool modified)
+{
+  m_Modified = modified;
+}
+
+bool DuskObject::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -289,41 +333,32 @@ bool DuskObject::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefO" (reference of Object)
-  OutStream.write((const char*) &cHeaderRefO, sizeof(uint32_t)); //header
+  OutStream.writeUInt32(cHeaderRefO); //header
   //write all data members, i.e. ID, position and rotation, and scale
   return saveDuskObjectPart(OutStream);
 }
 
-bool DuskObject::saveDuskObjectPart(std::ofstream& output) const
+bool DuskObject::saveDuskObjectPart(BinaryWriter& output) const
 {
   //write ID
-  const unsigned int len = ID.length();
-  output.write((const char*) &len, sizeof(unsigned int));
-  output.write(ID.c_str(), len);
+  output.writeString(ID);
 
   //write position and rotation, and scale
   // -- position
-  float xyz = position.x;
-  output.write((const char*) &xyz, sizeof(float));
-  xyz = position.y;
-  output.write((const char*) &xyz, sizeof(float));
-  xyz = position.z;
-  output.write((const char*) &xyz, sizeof(float));
+  output.writeFloat(position.x);
+  output.writeFloat(position.y);
+  output.writeFloat(position.z);
   // -- rotation
-  xyz = m_Rotation.w;
-  output.write((const char*) &xyz, sizeof(float));
-  xyz = m_Rotation.x;
-  output.write((const char*) &xyz, sizeof(float));
-  xyz = m_Rotation.y;
-  output.write((const char*) &xyz, sizeof(float));
-  xyz = m_Rotation.z;
-  output.write((const char*) &xyz, sizeof(float));
+  output.writeFloat(m_Rotation.w);
+  output.writeFloat(m_Rotation.x);
+  output.writeFloat(m_Rotation.y);
+  output.writeFloat(m_Rotation.z);
   // -- scale
-  output.write((const char*) &m_Scale, sizeof(float));
+  output.writeFloat(m_Scale);
   return output.good();
 }
 
-bool DuskObject::loadFromStream(std::ifstream& InStream)
+bool DuskObject::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -341,7 +376,7 @@ bool DuskObject::loadFromStream(std::ifstream& InStream)
 
   //read header "RefO"
   Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefO)
   {
     DuskLog() << "DuskObject::loadFromStream: ERROR: Stream contains invalid "
@@ -352,46 +387,35 @@ bool DuskObject::loadFromStream(std::ifstream& InStream)
   return loadDuskObjectPart(InStream);
 }
 
-bool DuskObject::loadDuskObjectPart(std::ifstream& InStream)
+bool DuskObject::loadDuskObjectPart(BinaryReader& InStream)
 {
   //read ID
-  unsigned int len;
-  InStream.read((char*) &len, sizeof(unsigned int));
-  if (len>255)
-  {
-    DuskLog() << "DuskObject::loadDuskObjectPart: ERROR: ID cannot be longer "
-              << "than 255 characters.\n";
-    return false;
-  }
-  char ID_Buffer[256];
-  InStream.read(ID_Buffer, len);
-  ID_Buffer[len] = '\0';
-  if (!InStream.good())
+  if (!InStream.readString(ID))
   {
-    DuskLog() << "DuskObject::loadDuskObjectPart: ERROR while reading ID.\n";
+    DuskLog() << "DuskObject::loadDuskObjectPart: ERROR while reading ID. ID "
+              << "cannot be longer than 255 characters.\n";
     return false;
   }
-  ID = std::string(ID_Buffer);
 
   float f_temp;
   //position
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.z = f_temp;
   //rotation
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.w = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.z = f_temp;
   //scale
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Scale = f_temp;
   return InStream.good();
 }
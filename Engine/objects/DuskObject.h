@@ -83,6 +83,11 @@
      - 2012-07-02 (rev 310) - update of getObjectMesh() and canCollide() to use
                               Database instead of ObjectBase
      - 2013-05-30           - remove OgreUserDefinedObject dependency
+     - 2026-10-19           - base index and modification flag added, so that
+                              save games only need to contain references that
+                              differ from the data files
+     - 2026-10-19           - bindings to sound sources are removed on destruction
+     - 2026-10-19           - Lua handles are invalidated on destruction
 
  ToDo list:
      - ???
@@ -95,7 +100,8 @@
 #define DUSKOBJECT_H
 
 #include <string>
-#include <fstream>
+#include "../BinaryReader.h"
+#include "../BinaryWriter.h"
 #include <OgreEntity.h>
 #include <OgreSceneManager.h>
 #include <OgreQuaternion.h>
@@ -110,6 +116,11 @@ enum ObjectTypes {otUndefined, otStatic, otItem, otAnimated, otWaypoint,
 
 unsigned int GenerateUniqueObjectID();
 
+/* base index of references that were not loaded from a data file, i.e. those
+   that were created during the game
+*/
+const uint32_t cNoBaseIndex = 0xFFFFFFFF;
+
 class DuskObject
 {
     public:
@@ -230,6 +241,39 @@ class DuskObject
         */
         virtual bool isHitByRay(const Ogre::Ray& ray, Ogre::Vector3& impact) const;
 
+        /* returns the index of the reference within the loaded data files, or
+           cNoBaseIndex, if the object was created during the game
+        */
+        uint32_t getBaseIndex() const;
+
+        /* sets the index of the reference within the loaded data files
+
+           parameters:
+               idx - the new base index (cNoBaseIndex for created objects)
+
+           remarks:
+               This function is usually only called by ObjectManager and
+               InjectionManager during loading.
+        */
+        void setBaseIndex(const uint32_t idx);
+
+        /* returns true, if the object was changed since it was loaded from the
+           data file, i.e. if it has to be written to a save game
+
+           remarks:
+               Progress of animations does not count as modification, because
+               animations are restarted by the objects anyway. Otherwise every
+               enabled NPC would end up in the save game.
+        */
+        bool isModified() const;
+
+        /* sets the modification flag of the object
+
+           parameters:
+               modified - true, if the object differs from its data file state
+        */
+        void setModified(const bool modified);
+
         /* Saves the object to the given stream. Returns true on success, false
            otherwise.
 
@@ -240,7 +284,7 @@ class DuskObject
                Every derived class has to have its own implementation of this
                function to ensure the object is saved properly.
         */
-        virtual bool saveToStream(std::ofstream& OutStream) const;
+        virtual bool saveToStream(BinaryWriter& OutStream) const;
 
         /* Tries to load an object from the given stream. Returns true on
            success, false otherwise.
@@ -254,7 +298,7 @@ class DuskObject
                If the function returns false, the data within the object may be
                corrupted. It's advised not to use the object in this case.
         */
-        virtual bool loadFromStream(std::ifstream& InStream);
+        virtual bool loadFromStream(BinaryReader& InStream);
     protected:
         /* returns the name/path of the mesh that is used during enabling this
            object
@@ -275,7 +319,7 @@ class DuskObject
                Derived classes will (most likely) call this function as part of
                their implementation of SaveToStream().
         */
-        bool saveDuskObjectPart(std::ofstream& output) const;
+        bool saveDuskObjectPart(BinaryWriter& output) const;
 
         /* Helper function which loads all data in a DuskObject from the given
            stream. Returns true on success.
@@ -287,13 +331,15 @@ class DuskObject
                Derived classes will (most likely) call this function as part of
                their implementation of LoadFromStream().
         */
-        bool loadDuskObjectPart(std::ifstream& InStream);
+        bool loadDuskObjectPart(BinaryReader& InStream);
 
         std::string ID;
         Ogre::Entity *entity;
         Ogre::Vector3 position;
         Ogre::Quaternion m_Rotation;
         float m_Scale;
+        uint32_t m_BaseIndex;
+        bool m_Modified;
 };
 
 }//namespace
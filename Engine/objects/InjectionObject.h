@@ -79,9 +79,9 @@ class InjectionObject: virtual public DuskObject
     */
     virtual bool canCollide() const = 0;
 
-    virtual bool saveToStream(std::ofstream& OutStream) const = 0;
+    virtual bool saveToStream(BinaryWriter& OutStream) const = 0;
 
-    virtual bool loadFromStream(std::ifstream& InStream) = 0;
+    virtual bool loadFromStream(BinaryReader& InStream) = 0;
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
@@ -122,7 +122,7 @@ bool Item::canPickUp() const
   return !m_Equipped;
 }
 
-bool Item::saveToStream(std::ofstream& OutStream) const
+bool Item::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -130,7 +130,7 @@ bool Item::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefI" (reference of Item)
-  OutStream.write((char*) &cHeaderRefI, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderRefI);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -147,7 +147,7 @@ bool Item::saveToStream(std::ofstream& OutStream) const
   return true;
 }
 
-bool Item::loadFromStream(std::ifstream& InStream)
+bool Item::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -162,7 +162,7 @@ bool Item::loadFromStream(std::ifstream& InStream)
   }
   //read header "RefI"
   unsigned int Header = 0;
-  InStream.read((char*) &Header, sizeof(unsigned int));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefI)
   {
     DuskLog() << "Item::loadFromStream: ERROR: Stream contains invalid "
@@ -185,17 +185,17 @@ bool Item::loadFromStream(std::ifstream& InStream)
   return true;
 }
 
-bool Item::saveItemPart(std::ofstream& output) const
+bool Item::saveItemPart(BinaryWriter& output) const
 {
   // -- equipped
-  output.write((char*) &m_Equipped, sizeof(bool));
+  output.writeBool(m_Equipped);
   return output.good();
 }
 
-bool Item::loadItemPart(std::ifstream& input)
+bool Item::loadItemPart(BinaryReader& input)
 {
   // -- equipped
-  input.read((char*) &m_Equipped, sizeof(bool));
+  input.readBool(m_Equipped);
   return input.good();
 }
 
@@ -207,6 +207,7 @@ bool Item::isEquipped() const
 void Item::setEquipped(const bool value)
 {
   m_Equipped = value;
+  m_Modified = true;
 }
 
 Ogre::Entity* Item::exposeEntity() const
@@ -119,7 +119,7 @@ class Item: public DuskObject
            Every derived class has to have its own implementation of this
            function to ensure the derived object is saved properly.
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Tries to load an item from the given stream. Returns true on
        success, false otherwise.
@@ -133,7 +133,7 @@ class Item: public DuskObject
            If the function returns false, the data within the item may be
            corrupted. It's advised not to use the item in this case.
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
 
     /* returns the Ogre entity which is used to display that object */
     Ogre::Entity* exposeEntity() const;
@@ -157,7 +157,7 @@ class Item: public DuskObject
            Derived classes will (most likely) call this function as part of
            their implementation of SaveToStream().
     */
-    bool saveItemPart(std::ofstream& output) const;
+    bool saveItemPart(BinaryWriter& output) const;
 
     /* Helper function which loads all data in an Item from the given stream.
        Returns true on success.
@@ -169,7 +169,7 @@ class Item: public DuskObject
            Derived classes will (most likely) call this function as part of
            their implementation of LoadFromStream().
     */
-    bool loadItemPart(std::ifstream& input);
+    bool loadItemPart(BinaryReader& input);
 
     //indicates whether an NPC has this item equipped
     bool m_Equipped;
@@ -123,6 +123,7 @@ void Light::setDirection(const Ogre::Vector3& dir)
     entity->setDirection(dir);
   }
   m_Direction = dir;
+  m_Modified = true;
 }
 
 Ogre::Vector3 Light::getDirection() const
@@ -130,7 +131,7 @@ Ogre::Vector3 Light::getDirection() const
   return m_Direction;
 }
 
-bool Light::saveToStream(std::ofstream& OutStream) const
+bool Light::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -140,41 +141,39 @@ bool Light::saveToStream(std::ofstream& OutStream) const
   float xyz;
 
   //write header "RefL" (reference of Light)
-  OutStream.write((const char*) &cHeaderRefL, sizeof(uint32_t)); //header
+  OutStream.writeUInt32(cHeaderRefL); //header
   //write ID
-  uint32_t len = ID.length();
-  OutStream.write((const char*) &len, sizeof(uint32_t));
-  OutStream.write(ID.c_str(), len);
+  OutStream.writeString(ID);
 
   //write position and rotation, and direction
   // -- position
   xyz = position.x;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = position.y;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = position.z;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   // -- rotation
   xyz = m_Rotation.w;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = m_Rotation.x;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = m_Rotation.y;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = m_Rotation.z;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   //(We don't need scale for lights, so don't write it to stream.)
   // -- direction
   xyz = m_Direction.x;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = m_Direction.y;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   xyz = m_Direction.z;
-  OutStream.write((const char*) &xyz, sizeof(float));
+  OutStream.writeFloat(xyz);
   return (OutStream.good());
 }
 
-bool Light::loadFromStream(std::ifstream& InStream)
+bool Light::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -188,13 +187,11 @@ bool Light::loadFromStream(std::ifstream& InStream)
     return false;
   }
 
-  char ID_Buffer[256];
   float f_temp;
-  uint32_t len;
 
   //read header "RefL"
   uint32_t Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefL)
   {
     DuskLog() << "Light::loadFromStream: ERROR: Stream contains invalid "
@@ -202,46 +199,37 @@ bool Light::loadFromStream(std::ifstream& InStream)
     return false;
   }
   //read ID
-  InStream.read((char*) &len, sizeof(uint32_t));
-  if (len>255)
+  if (!InStream.readString(ID))
   {
-    DuskLog() << "Light::loadFromStream: ERROR: ID cannot be longer than "
-              << "255 characters.\n";
+    DuskLog() << "Light::loadFromStream: ERROR while reading data (ID). ID "
+              << "cannot be longer than 255 characters.\n";
     return false;
   }
-  InStream.read(ID_Buffer, len);
-  ID_Buffer[len] = '\0';
-  if (!InStream.good())
-  {
-    DuskLog() << "Light::loadFromStream: ERROR while reading data (ID).\n";
-    return false;
-  }
-  ID = std::string(ID_Buffer);
 
   //position
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   position.z = f_temp;
   //rotation
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.w = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Rotation.z = f_temp;
   //scale is not needed / always 1.0f
   m_Scale = 1.0f;
   //direction
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.z = f_temp;
   return (InStream.good());
 }
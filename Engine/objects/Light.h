@@ -111,7 +111,7 @@ namespace Dusk
          parameters:
              OutStream - the output stream that is used to save the object
       */
-      virtual bool saveToStream(std::ofstream& OutStream) const;
+      virtual bool saveToStream(BinaryWriter& OutStream) const;
 
       /* Tries to load an object from the given stream. Returns true on
          success, false otherwise.
@@ -123,7 +123,7 @@ namespace Dusk
              If the function returns false, the data within the light object may
              be corrupted. It's advised not to use the object in this case.
       */
-      virtual bool loadFromStream(std::ifstream& InStream);
+      virtual bool loadFromStream(BinaryReader& InStream);
     protected:
       /* contrary to DuskObject, this entity member is of type Light and not of
          type Ogre::Entity. Might possibly cause problems.
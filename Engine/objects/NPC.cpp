@@ -136,6 +136,7 @@ void NPC::jump(void)
     m_Jump = true;
     m_JumpVelocity = 30.0f; //only a guess; maybe we should adjust that
                             //  value later
+    m_Modified = true;
     startJumpAnimation();
   }//if
 }
@@ -159,6 +160,7 @@ void NPC::move(const float SecondsPassed)
     return;
   }
   WaypointObject::injectTime(SecondsPassed);
+  const Ogre::Vector3 old_position = position;
   //now check for height
   const float land_height = Landscape::getSingleton().getHeightAtPosition(position.x, position.z)
                                     /*+cAboveGroundLevel*/;
@@ -229,6 +231,10 @@ void NPC::move(const float SecondsPassed)
   {
     position = Ogre::Vector3(position.x, hit_level, position.z);
   }
+  if (m_Jump or position!=old_position)
+  {
+    m_Modified = true;
+  }
   //adjust position of scene node/ entity in Ogre
   if (isEnabled())
   {
@@ -317,6 +323,7 @@ void NPC::setHealth(const float new_health)
   {
     m_Health = new_health;
   }
+  m_Modified = true;
 }
 
 void NPC::inflictDamage(const float damage_amount)
@@ -385,42 +392,50 @@ uint8_t NPC::getLuck() const
 void NPC::setLevel(const uint8_t new_level)
 {
   m_Level = new_level;
+  m_Modified = true;
 }
 
 
 void NPC::setStrength(const uint8_t str)
 {
   m_Strength = str;
+  m_Modified = true;
 }
 
 void NPC::setAgility(const uint8_t agi)
 {
   m_Agility = agi;
+  m_Modified = true;
 }
 
 void NPC::setVitality(const uint8_t vit)
 {
   m_Vitality = vit;
+  m_Modified = true;
 }
 
 void NPC::setIntelligence(const uint8_t intelligence)
 {
   m_Intelligence = intelligence;
+  m_Modified = true;
 }
 
 void NPC::setWillpower(const uint8_t wil)
 {
   m_Willpower = wil;
+  m_Modified = true;
 }
 
 void NPC::setCharisma(const uint8_t cha)
 {
   m_Charisma = cha;
+  m_Modified = true;
 }
 
 void NPC::setLuck(const uint8_t luck)
 {
   m_Luck = luck;
+  m_Modified = true;
 }
 
 bool NPC::isFemale() const
@@ -438,6 +453,26 @@ const Inventory& NPC::getConstInventory() const
   return m_Inventory;
 }
 
+void NPC::addItem(const std::string& ItemID, const unsigned int count)
+{
+  if (count==0 or ItemID.empty())
+  {
+    return;
+  }
+  m_Inventory.addItem(ItemID, count);
+  m_Modified = true;
+}
+
+unsigned int NPC::removeItem(const std::string& ItemID, const unsigned int count)
+{
+  const unsigned int removed = m_Inventory.removeItem(ItemID, count);
+  if (removed!=0)
+  {
+    m_Modified = true;
+  }
+  return removed;
+}
+
 unsigned int NPC::getCurrentEncumbrance() const
 {
   const float w = m_Inventory.getTotalWeight();
@@ -488,6 +523,7 @@ bool NPC::pickUp(Item* target)
   if (ObjectManager::getSingleton().removeItemReference(target))
   {
     m_Inventory.addItem(ItemID, 1);
+    m_Modified = true;
     return true;
   }
   return false;
@@ -561,6 +597,7 @@ bool NPC::equip(const std::string& ItemID, const SlotType slot)
   pItem->enableWithoutSceneNode(entity->getParentSceneNode()->getCreator());
   entity->attachObjectToBone(bone_name, pItem->exposeEntity());
   pItem->setEquipped(true);
+  m_Modified = true;
   if (slot==stLeftHand)
   {
     m_EquippedLeft = pItem;
@@ -631,6 +668,7 @@ bool NPC::unequip(const SlotType slot)
          m_EquippedLeft = NULL;
          //reset left attack bit
          m_AttackFlags = m_AttackFlags & ~Flag_CanLeftAttack;
+         m_Modified = true;
          if (!canAttackRight()) stopAttack();
          return true;
          break;
@@ -641,6 +679,7 @@ bool NPC::unequip(const SlotType slot)
          m_EquippedRight = NULL;
          //reset right attack bit
          m_AttackFlags = m_AttackFlags & ~Flag_CanRightAttack;
+         m_Modified = true;
          if (!canAttackLeft()) stopAttack();
          return true;
          break;
@@ -666,6 +705,7 @@ bool NPC::startAttack()
   {
     //we have at least one weapon -> attack
     m_AttackFlags = m_AttackFlags | Flag_DoesAttack;
+    m_Modified = true;
     startAttackAnimation();
     return true;
   }
@@ -679,6 +719,7 @@ bool NPC::stopAttack()
   {
     stopAttackAnimation();
     m_AttackFlags &= compl Flag_DoesAttack;
+    m_Modified = true;
     //m_TimeToNextAttack = 0.0f;
   }
   return true;
@@ -698,7 +739,7 @@ bool NPC::enable(Ogre::SceneManager* scm)
   return AnimatedObject::enable(scm);
 }
 
-bool NPC::saveNPCPart(std::ofstream& output) const
+bool NPC::saveNPCPart(BinaryWriter& output) const
 {
   if (!output.good())
   {
@@ -706,17 +747,17 @@ bool NPC::saveNPCPart(std::ofstream& output) const
     return false;
   }
   //health
-  output.write((char*) &m_Health, sizeof(float));
+  output.writeFloat(m_Health);
   //level
-  output.write((char*) &m_Level, 1);
+  output.writeUInt8(m_Level);
   //attributes
-  output.write((char*) &m_Strength, 1);
-  output.write((char*) &m_Agility, 1);
-  output.write((char*) &m_Vitality, 1);
-  output.write((char*) &m_Intelligence, 1);
-  output.write((char*) &m_Willpower, 1);
-  output.write((char*) &m_Charisma, 1);
-  output.write((char*) &m_Luck, 1);
+  output.writeUInt8(m_Strength);
+  output.writeUInt8(m_Agility);
+  output.writeUInt8(m_Vitality);
+  output.writeUInt8(m_Intelligence);
+  output.writeUInt8(m_Willpower);
+  output.writeUInt8(m_Charisma);
+  output.writeUInt8(m_Luck);
 
   if (!output.good())
   {
@@ -730,36 +771,32 @@ bool NPC::saveNPCPart(std::ofstream& output) const
   }
 
   //attack flags and times
-  output.write((char*) &m_AttackFlags, sizeof(unsigned char));
-  output.write((char*) &m_TimeToNextAttackRight, sizeof(float));
-  output.write((char*) &m_TimeToNextAttackLeft, sizeof(float));
+  output.writeUInt8(m_AttackFlags);
+  output.writeFloat(m_TimeToNextAttackRight);
+  output.writeFloat(m_TimeToNextAttackLeft);
   if (!output.good())
   {
     DuskLog() << "NPC::saveNPCPart: ERROR while writing attack data.\n";
     return false;
   }
   //equipped items
-  unsigned int equipCount = 0;
+  uint32_t equipCount = 0;
   if (m_EquippedRight!=NULL) equipCount = 1;
   if (m_EquippedLeft!=NULL) ++equipCount;
-  output.write((char*) &equipCount, sizeof(unsigned int));
+  output.writeUInt32(equipCount);
   if (m_EquippedRight!=NULL)
   {
     //write ID of right hand item
-    equipCount = m_EquippedRight->getID().length();
-    output.write((char*) &equipCount, sizeof(unsigned int));
-    output.write(m_EquippedRight->getID().c_str(), equipCount);
+    output.writeString(m_EquippedRight->getID());
   }
   if (m_EquippedLeft!=NULL)
   {
     //write ID of left hand item
-    equipCount = m_EquippedLeft->getID().length();
-    output.write((char*) &equipCount, sizeof(unsigned int));
-    output.write(m_EquippedLeft->getID().c_str(), equipCount);
+    output.writeString(m_EquippedLeft->getID());
   }
   //jumping info
-  output.write((char*) &m_Jump, sizeof(bool));
-  output.write((char*) &m_JumpVelocity, sizeof(float));
+  output.writeBool(m_Jump);
+  output.writeFloat(m_JumpVelocity);
   if (!output.good())
   {
     DuskLog() << "NPC::saveNPCPart: ERROR while writing equipped items or "
@@ -769,7 +806,7 @@ bool NPC::saveNPCPart(std::ofstream& output) const
   return output.good();
 }
 
-bool NPC::saveToStream(std::ofstream& OutStream) const
+bool NPC::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -777,7 +814,7 @@ bool NPC::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefN" (reference of NPC)
-  OutStream.write((char*) &cHeaderRefN, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderRefN);
   //save stuff inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -811,7 +848,7 @@ bool NPC::saveToStream(std::ofstream& OutStream) const
   return OutStream.good();
 }
 
-bool NPC::loadNPCPart(std::ifstream& InStream)
+bool NPC::loadNPCPart(BinaryReader& InStream)
 {
   if (!InStream.good())
   {
@@ -819,17 +856,17 @@ bool NPC::loadNPCPart(std::ifstream& InStream)
     return false;
   }
   //health
-  InStream.read((char*) &m_Health, sizeof(float));
+  InStream.readFloat(m_Health);
   //level
-  InStream.read((char*) &m_Level, 1);
+  InStream.readUInt8(m_Level);
   //attributes
-  InStream.read((char*) &m_Strength, 1);
-  InStream.read((char*) &m_Agility, 1);
-  InStream.read((char*) &m_Vitality, 1);
-  InStream.read((char*) &m_Intelligence, 1);
-  InStream.read((char*) &m_Willpower, 1);
-  InStream.read((char*) &m_Charisma, 1);
-  InStream.read((char*) &m_Luck, 1);
+  InStream.readUInt8(m_Strength);
+  InStream.readUInt8(m_Agility);
+  InStream.readUInt8(m_Vitality);
+  InStream.readUInt8(m_Intelligence);
+  InStream.readUInt8(m_Willpower);
+  InStream.readUInt8(m_Charisma);
+  InStream.readUInt8(m_Luck);
 
   if (!InStream.good())
   {
@@ -843,39 +880,28 @@ bool NPC::loadNPCPart(std::ifstream& InStream)
   }
 
   //attack flags and times
-  InStream.read((char*) &m_AttackFlags, sizeof(unsigned char));
-  InStream.read((char*) &m_TimeToNextAttackRight, sizeof(float));
-  InStream.read((char*) &m_TimeToNextAttackLeft, sizeof(float));
+  InStream.readUInt8(m_AttackFlags);
+  InStream.readFloat(m_TimeToNextAttackRight);
+  InStream.readFloat(m_TimeToNextAttackLeft);
   if (!InStream.good())
   {
     DuskLog() << "NPC::loadNPCPart: ERROR while reading attack data.\n";
     return false;
   }
   //equipped items
-  unsigned int equipCount = 0;
-  InStream.read((char*) &equipCount, sizeof(unsigned int));
+  uint32_t equipCount = 0;
+  InStream.readUInt32(equipCount);
   if (equipCount>0)
   {
     //read ID of right hand item
-    unsigned int len = 0;
-    InStream.read((char*) &len, sizeof(unsigned int));
-    if (len>255)
-    {
-      DuskLog() << "NPC::loadNPCPart: ERROR: ID of right hand item seems "
-                << "to be longer than 255 characters.\n";
-      return false;
-    }
-    char Buffer[256];
-    Buffer[0] = Buffer[255] = '\0';
-    InStream.read(Buffer, len);
-    Buffer[len] = '\0';
-    if (!InStream.good())
+    std::string itemID;
+    if (!InStream.readString(itemID))
     {
       DuskLog() << "NPC::loadNPCPart: ERROR while reading ID of right hand "
-                << "item.\n";
+                << "item. (ID must not be longer than 255 characters.)\n";
       return false;
     }
-    if (!equip(std::string(Buffer)))
+    if (!equip(itemID))
     {
       DuskLog() << "NPC::loadNPCPart: ERROR while equipping right hand item.\n";
       return false;
@@ -884,24 +910,13 @@ bool NPC::loadNPCPart(std::ifstream& InStream)
     if (equipCount>1)
     {
       //read ID of left hand item
-      len = 0;
-      InStream.read((char*) &len, sizeof(unsigned int));
-      if (len>255)
-      {
-        DuskLog() << "NPC::loadNPCPart: ERROR: ID of left hand item seems "
-                  << "to be longer than 255 characters.\n";
-        return false;
-      }
-      Buffer[0] = Buffer[255] = '\0';
-      InStream.read(Buffer, len);
-      Buffer[len] = '\0';
-      if (!InStream.good())
+      if (!InStream.readString(itemID))
       {
         DuskLog() << "NPC::loadNPCPart: ERROR while reading ID of left hand "
-                  << "item.\n";
+                  << "item. (ID must not be longer than 255 characters.)\n";
         return false;
       }
-      if (!equip(std::string(Buffer)))
+      if (!equip(itemID))
       {
         DuskLog() << "NPC::loadNPCPart: ERROR while equipping left hand item.\n";
         return false;
@@ -909,12 +924,12 @@ bool NPC::loadNPCPart(std::ifstream& InStream)
     }//second item
   }//have something equipped
   //jumping info
-  InStream.read((char*) &m_Jump, sizeof(bool));
-  InStream.read((char*) &m_JumpVelocity, sizeof(float));
+  InStream.readBool(m_Jump);
+  InStream.readFloat(m_JumpVelocity);
   return InStream.good();
 }
 
-bool NPC::loadFromStream(std::ifstream& InStream)
+bool NPC::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -929,7 +944,7 @@ bool NPC::loadFromStream(std::ifstream& InStream)
   }
   //read header "RefN"
   unsigned int Header = 0;
-  InStream.read((char*) &Header, sizeof(unsigned int));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefN)
   {
     DuskLog() << "NPC::loadFromStream: ERROR: Stream contains invalid reference"
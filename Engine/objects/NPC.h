@@ -70,6 +70,8 @@
      - 2012-06-30 (rev 308) - update of getObjectMesh() definition
      - 2012-07-02 (rev 310) - update to use Database instead of ItemBase
      - 2012-07-07 (rev 316) - update to use Database instead of WeaponBase
+     - 2026-10-19           - addItem() and removeItem() added, which mark the
+                              NPC as modified
 
  ToDo list:
      - add possibility to equip weapons, clothes, armour, etc.
@@ -199,11 +201,25 @@ namespace Dusk
       /* returns true, if the NPC is female */
       bool isFemale() const;
 
-      /* inventory access method */
+      /* inventory access method
+
+         remarks:
+           Changes made through the returned reference do not mark the NPC as
+           modified, so they might not be saved. Use addItem() and removeItem()
+           instead, where possible.
+      */
       Inventory& getInventory();
 
       const Inventory& getConstInventory() const;
 
+      /* adds count items of ID ItemID to the NPC's inventory */
+      void addItem(const std::string& ItemID, const unsigned int count);
+
+      /* removes up to count items of ID ItemID from the NPC's inventory and
+         returns the number of items that were actually removed
+      */
+      unsigned int removeItem(const std::string& ItemID, const unsigned int count);
+
       /* current encumbrance */
       unsigned int getCurrentEncumbrance() const;
 
@@ -294,7 +310,7 @@ namespace Dusk
          parameters:
              OutStream - the output stream that is used to save the NPC
       */
-      virtual bool saveToStream(std::ofstream& OutStream) const;
+      virtual bool saveToStream(BinaryWriter& OutStream) const;
 
       /* Loads NPC from stream and returns true on success, false otherwise.
          The NPC's data is probably inconsistent after that function failed, so
@@ -303,7 +319,7 @@ namespace Dusk
          parameters:
              InStream - the input stream that is used to load the NPC from
       */
-      virtual bool loadFromStream(std::ifstream& InStream);
+      virtual bool loadFromStream(BinaryReader& InStream);
 
       /* the maximum distance an item can be away from the NPC while being
          picked up
@@ -429,7 +445,7 @@ namespace Dusk
              Derived classes will (most likely) call this function as part of
              their implementation of saveToStream().
       */
-      bool saveNPCPart(std::ofstream& output) const;
+      bool saveNPCPart(BinaryWriter& output) const;
 
       /* Utility function which loads all data that is specific to an NPC object
          from the given stream. Returns true on success.
@@ -441,7 +457,7 @@ namespace Dusk
              Derived classes will (most likely) call this function as part of
              their implementation of loadFromStream().
       */
-      bool loadNPCPart(std::ifstream& InStream);
+      bool loadNPCPart(BinaryReader& InStream);
   }; //class
 
 } //namespace
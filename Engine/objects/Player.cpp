@@ -178,7 +178,7 @@ bool Player::enable(Ogre::SceneManager* scm)
   return true;
 }
 
-bool Player::saveToStream(std::ofstream& OutStream) const
+bool Player::saveToStream(BinaryWriter& OutStream) const
 {
   /*This function is basically copied from NPC::saveToStream(). The only
     difference is the different header ("Play" instead of "RefN"). */
@@ -188,7 +188,7 @@ bool Player::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "Play" (Player)
-  OutStream.write((const char*) &cHeaderPlay, sizeof(uint32_t));
+  OutStream.writeUInt32(cHeaderPlay);
   //save stuff inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -222,7 +222,7 @@ bool Player::saveToStream(std::ofstream& OutStream) const
   return OutStream.good();
 }
 
-bool Player::loadFromStream(std::ifstream& InStream)
+bool Player::loadFromStream(BinaryReader& InStream)
 {
   /*This function is basically copied from NPC::loadFromStream(). The only
     difference is the different header ("Play" instead of "RefN"). */
@@ -233,7 +233,7 @@ bool Player::loadFromStream(std::ifstream& InStream)
   }
   //read header "Play"
   uint32_t Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderPlay)
   {
     DuskLog() << "Player::loadFromStream: ERROR: Stream contains invalid "
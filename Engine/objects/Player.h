@@ -113,7 +113,7 @@ namespace Dusk
          remarks:
             In its current state, this function does nothing but return false.
       */
-      virtual bool saveToStream(std::ofstream& OutStream) const;
+      virtual bool saveToStream(BinaryWriter& OutStream) const;
 
       /* Loads NPC from stream and returns true on success, false otherwise.
          The NPC's data is probably inconsistent after that function failed, so
@@ -125,7 +125,7 @@ namespace Dusk
          remarks:
             In its current state, this function does nothing but return false.
       */
-      virtual bool loadFromStream(std::ifstream& InStream);
+      virtual bool loadFromStream(BinaryReader& InStream);
     protected:
       /* returns the name/path of the mesh that is used during enabling this
          object
@@ -74,6 +74,7 @@ bool Projectile::canCollide() const
 void Projectile::setTTL(const float newTTL)
 {
   m_TTL = newTTL;
+  m_Modified = true;
 }
 
 float Projectile::getTTL() const
@@ -84,6 +85,7 @@ float Projectile::getTTL() const
 void Projectile::setEmitter(DuskObject* emitter)
 {
   m_Emitter = emitter;
+  m_Modified = true;
 }
 
 DuskObject* Projectile::getEmitter() const
@@ -239,6 +241,7 @@ void Projectile::injectTime(const float SecondsPassed)
   if (m_TTL>0.0f)
   {
     m_TTL = m_TTL - SecondsPassed;
+    m_Modified = true;
     if (m_TTL<=0.0f)
     {
       //we are done here, so delete this object
@@ -260,7 +263,7 @@ void Projectile::travelToDestination(const Ogre::Vector3& dest)
   setDirection(dest-getPosition());
 }
 
-bool Projectile::saveToStream(std::ofstream& OutStream) const
+bool Projectile::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -268,7 +271,7 @@ bool Projectile::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefP" (reference of Projectile)
-  OutStream.write((char*) &cHeaderRefP, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderRefP);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -282,11 +285,11 @@ bool Projectile::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write TTL
-  OutStream.write((char*) &m_TTL, sizeof(float));
+  OutStream.writeFloat(m_TTL);
   return OutStream.good();
 }
 
-bool Projectile::loadFromStream(std::ifstream& InStream)
+bool Projectile::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -301,7 +304,7 @@ bool Projectile::loadFromStream(std::ifstream& InStream)
   }
   //read header "RefP"
   unsigned int Header = 0;
-  InStream.read((char*) &Header, sizeof(unsigned int));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefP)
   {
     DuskLog() << "Projectile::loadFromStream: ERROR: Stream contains invalid "
@@ -322,7 +325,7 @@ bool Projectile::loadFromStream(std::ifstream& InStream)
     return false;
   }
   //TTL
-  InStream.read((char*) &m_TTL, sizeof(m_TTL));
+  InStream.readFloat(m_TTL);
   return InStream.good();
 }
 
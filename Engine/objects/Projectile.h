@@ -139,7 +139,7 @@ class Projectile: public UniformMotionObject
        parameters:
            OutStream - the output stream that will be used to save the projectile
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Tries to load a projectile from the given stream. Returns true on
        success, false otherwise.
@@ -147,7 +147,7 @@ class Projectile: public UniformMotionObject
        parameters:
            InStream - the input stream that will be used to load the projectile
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
@@ -67,6 +67,7 @@ void Resource::injectTime(const float SecondsPassed)
   if (!m_Spawned)
   {
     m_RespawnTime -= SecondsPassed;
+    m_Modified = true;
     if (m_RespawnTime<=0.0f)
     {
       m_Spawned = true;
@@ -80,7 +81,7 @@ void Resource::injectTime(const float SecondsPassed)
   }
 }
 
-bool Resource::saveToStream(std::ofstream& outStream) const
+bool Resource::saveToStream(BinaryWriter& outStream) const
 {
   if (!outStream.good())
   {
@@ -88,7 +89,7 @@ bool Resource::saveToStream(std::ofstream& outStream) const
     return false;
   }
   //write header "RefR" (reference of Resource)
-  outStream.write((const char*) &cHeaderRefR, sizeof(uint32_t));
+  outStream.writeUInt32(cHeaderRefR);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(outStream))
   {
@@ -97,8 +98,8 @@ bool Resource::saveToStream(std::ofstream& outStream) const
     return false;
   }
   //write all data from Resource
-  outStream.write((const char*) &m_Spawned, sizeof(bool));
-  outStream.write((const char*) &m_RespawnTime, sizeof(float));
+  outStream.writeBool(m_Spawned);
+  outStream.writeFloat(m_RespawnTime);
   if (!outStream.good())
   {
     DuskLog() << "Resource::saveToStream: ERROR while writing data!\n";
@@ -107,7 +108,7 @@ bool Resource::saveToStream(std::ofstream& outStream) const
   return true;
 }
 
-bool Resource::loadFromStream(std::ifstream& inStream)
+bool Resource::loadFromStream(BinaryReader& inStream)
 {
   if (isEnabled())
   {
@@ -122,7 +123,7 @@ bool Resource::loadFromStream(std::ifstream& inStream)
   }
   //read header "RefR"
   uint32_t Header = 0;
-  inStream.read((char*) &Header, sizeof(uint32_t));
+  inStream.readUInt32(Header);
   if (Header!=cHeaderRefR)
   {
     DuskLog() << "Resource::loadFromStream: ERROR: Stream contains invalid "
@@ -137,8 +138,8 @@ bool Resource::loadFromStream(std::ifstream& inStream)
     return false;
   }//if
   //read all stuff from Resource
-  inStream.read((char*) &m_Spawned, sizeof(bool));
-  inStream.read((char*) &m_RespawnTime, sizeof(float));
+  inStream.readBool(m_Spawned);
+  inStream.readFloat(m_RespawnTime);
   if ((m_RespawnTime!=m_RespawnTime) or !inStream.good())
   {
     DuskLog() << "Resource::loadFromToStream: ERROR while reading data!\n";
@@ -79,7 +79,7 @@ class Resource: public InjectionObject
        parameters:
            outStream - the output stream that will be used to save the resource
     */
-    virtual bool saveToStream(std::ofstream& outStream) const;
+    virtual bool saveToStream(BinaryWriter& outStream) const;
 
     /* Tries to load a resource from the given stream. Returns true on
        success, false otherwise.
@@ -87,7 +87,7 @@ class Resource: public InjectionObject
        parameters:
            inStream - the input stream that will be used to load the resource
     */
-    virtual bool loadFromStream(std::ifstream& inStream);
+    virtual bool loadFromStream(BinaryReader& inStream);
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
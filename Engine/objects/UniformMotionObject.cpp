@@ -59,6 +59,7 @@ void UniformMotionObject::setDirection(const Ogre::Vector3& direc)
 {
   m_Direction = direc;
   m_Direction.normalise();
+  m_Modified = true;
 }
 
 float UniformMotionObject::getSpeed() const
@@ -70,6 +71,7 @@ void UniformMotionObject::setSpeed(const float v)
 {
   m_Speed = v;
   if (v<0.0f) m_Speed = 0.0f;
+  m_Modified = true;
 }
 
 bool UniformMotionObject::isMoving() const
@@ -82,6 +84,7 @@ void UniformMotionObject::travelToDestination(const Ogre::Vector3& dest)
   m_Destination = dest;
   m_Travel = true;
   setDirection(dest-getPosition());
+  m_Modified = true;
 }
 
 Ogre::Vector3 UniformMotionObject::getDestination() const
@@ -114,11 +117,13 @@ void UniformMotionObject::injectTime(const float SecondsPassed)
     else
     {
       position = position + SecondsPassed*m_Speed*m_Direction;
+      m_Modified = true;
     }
   }
-  else if (m_Direction!=Ogre::Vector3::ZERO)
+  else if (m_Direction!=Ogre::Vector3::ZERO and m_Speed>0.0f)
   {
     position = position + SecondsPassed*m_Speed*m_Direction;
+    m_Modified = true;
   }
   //adjust position of scene node/ entity in Ogre
   if (isEnabled())
@@ -127,7 +132,7 @@ void UniformMotionObject::injectTime(const float SecondsPassed)
   }
 }
 
-bool UniformMotionObject::saveUniformMotionObjectPart(std::ofstream& output) const
+bool UniformMotionObject::saveUniformMotionObjectPart(BinaryWriter& output) const
 {
   if (!output.good())
   {
@@ -138,26 +143,26 @@ bool UniformMotionObject::saveUniformMotionObjectPart(std::ofstream& output) con
   //write direction and destination, and speed
   // -- direction
   float xyz = m_Direction.x;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   xyz = m_Direction.y;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   xyz = m_Direction.z;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   // -- destination
   xyz = m_Destination.x;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   xyz = m_Destination.y;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   xyz = m_Destination.z;
-  output.write((char*) &xyz, sizeof(float));
+  output.writeFloat(xyz);
   // -- speed
-  output.write((char*) &m_Speed, sizeof(float));
+  output.writeFloat(m_Speed);
   // -- travelling flag
-  output.write((char*) &m_Travel, sizeof(bool));
+  output.writeBool(m_Travel);
   return output.good();
 }
 
-bool UniformMotionObject::loadUniformMotionObjectPart(std::ifstream& InStream)
+bool UniformMotionObject::loadUniformMotionObjectPart(BinaryReader& InStream)
 {
   if (!InStream.good())
   {
@@ -167,23 +172,23 @@ bool UniformMotionObject::loadUniformMotionObjectPart(std::ifstream& InStream)
   }
   float f_temp;
   // -- direction
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Direction.z = f_temp;
   // -- destination
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Destination.x = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Destination.y = f_temp;
-  InStream.read((char*) &f_temp, sizeof(float));
+  InStream.readFloat(f_temp);
   m_Destination.z = f_temp;
   //  -- speed
-  InStream.read((char*) &m_Speed, sizeof(float));
+  InStream.readFloat(m_Speed);
   // -- travelling flag
-  InStream.read((char*) &m_Travel, sizeof(float));
+  InStream.readBool(m_Travel);
   return InStream.good();
 }
 
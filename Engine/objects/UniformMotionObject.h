@@ -152,7 +152,7 @@ class UniformMotionObject: virtual public InjectionObject
            Derived classes will (most likely) call this function as part of
            their implementation of SaveToStream().
     */
-    bool saveUniformMotionObjectPart(std::ofstream& output) const;
+    bool saveUniformMotionObjectPart(BinaryWriter& output) const;
 
     /* Utility function which loads all data that is specific to an
        UniformMotionObject from the given stream. Returns true on success.
@@ -164,7 +164,7 @@ class UniformMotionObject: virtual public InjectionObject
            Derived classes will (most likely) call this function as part of
            their implementation of LoadFromStream().
     */
-    bool loadUniformMotionObjectPart(std::ifstream& InStream);
+    bool loadUniformMotionObjectPart(BinaryReader& InStream);
 }; //class
 
 } //namespace
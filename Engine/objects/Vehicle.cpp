@@ -238,7 +238,7 @@ unsigned int Vehicle::getPassengerCount() const
   return m_Passengers.size();
 }
 
-bool Vehicle::saveToStream(std::ofstream& OutStream) const
+bool Vehicle::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -246,7 +246,7 @@ bool Vehicle::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RefV" (reference of Vehicle)
-  OutStream.write((char*) &cHeaderRefV, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderRefV);
   //save stuff inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -286,7 +286,7 @@ bool Vehicle::saveToStream(std::ofstream& OutStream) const
   return OutStream.good();
 }
 
-bool Vehicle::loadFromStream(std::ifstream& InStream)
+bool Vehicle::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -301,7 +301,7 @@ bool Vehicle::loadFromStream(std::ifstream& InStream)
   }
   //read header "RefV"
   unsigned int Header = 0;
-  InStream.read((char*) &Header, sizeof(unsigned int));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRefV)
   {
     DuskLog() << "Vehicle::loadFromStream: ERROR: Stream contains invalid "
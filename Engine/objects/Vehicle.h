@@ -180,7 +180,7 @@ class Vehicle: public AnimatedObject, public WaypointObject
        parameters:
            OutStream - the output stream that is used to save the vehicle
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Loads vehicle from stream and returns true on success, false otherwise.
        The vehicle's data is probably inconsistent after that function failed,
@@ -189,7 +189,7 @@ class Vehicle: public AnimatedObject, public WaypointObject
        parameters:
            InStream - the input stream that is used to load the vehicle from
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
@@ -57,12 +57,14 @@ unsigned int WaypointObject::addWaypoint(const Ogre::Vector3& waypoint)
   if (m_Waypoints.empty())
   {
     m_Waypoints.push_back(waypoint);
+    m_Modified = true;
     return 1;
   }
   //avoid having the same waypoint twice in a row
   if (m_Waypoints.back()!=waypoint)
   {
     m_Waypoints.push_back(waypoint);
+    m_Modified = true;
   }
   return m_Waypoints.size();
 }
@@ -70,6 +72,7 @@ unsigned int WaypointObject::addWaypoint(const Ogre::Vector3& waypoint)
 void WaypointObject::setUseWaypoints(const bool doUse)
 {
   m_WaypointTravel = doUse;
+  m_Modified = true;
   if (doUse && m_currentWaypoint<m_Waypoints.size())
   { //we have points and want movement, so start it
     travelToDestination(m_Waypoints.at(m_currentWaypoint));
@@ -82,11 +85,13 @@ void WaypointObject::clearWaypoints()
   m_WaypointTravel = false;
   m_Patrol = false;
   m_currentWaypoint = 0;
+  m_Modified = true;
 }
 
 void WaypointObject::setPatrolMode(const bool doPatrol)
 {
   m_Patrol = doPatrol;
+  m_Modified = true;
   if (doPatrol and m_Waypoints.size()<2)
   { //patrol mode not useful, if there is only one waypoint or none at all
     m_Patrol = false;
@@ -159,11 +164,13 @@ void WaypointObject::injectTime(const float SecondsPassed)
     else
     {
       position = position + SecondsPassed*m_Speed*m_Direction;
+      m_Modified = true;
     }
   }
-  else
+  else if (m_Direction!=Ogre::Vector3::ZERO and m_Speed>0.0f)
   {
     position = position + SecondsPassed*m_Speed*m_Direction;
+    m_Modified = true;
   }
   //adjust position of scene node/ entity in Ogre
   if (isEnabled())
@@ -172,54 +179,54 @@ void WaypointObject::injectTime(const float SecondsPassed)
   }
 }
 
-bool WaypointObject::saveWaypointObjectPart(std::ofstream& OutStream) const
+bool WaypointObject::saveWaypointObjectPart(BinaryWriter& OutStream) const
 {
   // save data members from WaypointObject
   //waypoint data
   // -- waypoint travel enabled?
-  OutStream.write((const char*) &m_WaypointTravel, sizeof(bool));
+  OutStream.writeBool(m_WaypointTravel);
   // -- patrol mode?
-  OutStream.write((const char*) &m_Patrol, sizeof(bool));
+  OutStream.writeBool(m_Patrol);
   // -- current waypoint
-  OutStream.write((const char*) &m_currentWaypoint, sizeof(m_currentWaypoint));
+  OutStream.writeUInt32(m_currentWaypoint);
   // -- waypoints themselves
   // ---- number of WPs
   unsigned int len = m_Waypoints.size();
-  OutStream.write((const char*) &len, sizeof(unsigned int));
+  OutStream.writeUInt32(len);
   // ---- waypoint data
   float xyz;
   unsigned int i;
   for (i=0; i<len; i=i+1)
   {
     xyz = m_Waypoints.at(i).x;
-    OutStream.write((const char*) &xyz, sizeof(float));
+    OutStream.writeFloat(xyz);
     xyz = m_Waypoints.at(i).y;
-    OutStream.write((const char*) &xyz, sizeof(float));
+    OutStream.writeFloat(xyz);
     xyz = m_Waypoints.at(i).z;
-    OutStream.write((const char*) &xyz, sizeof(float));
+    OutStream.writeFloat(xyz);
   } //for
   return OutStream.good();
 }
 
-bool WaypointObject::loadWaypointObjectPart(std::ifstream& InStream)
+bool WaypointObject::loadWaypointObjectPart(BinaryReader& InStream)
 {
   //load data members from WaypointObject
   //waypoint data
   // -- waypoint travel enabled?
-  InStream.read((char*) &m_WaypointTravel, sizeof(bool));
+  InStream.readBool(m_WaypointTravel);
   // -- patrol mode?
-  InStream.read((char*) &m_Patrol, sizeof(bool));
+  InStream.readBool(m_Patrol);
   if (!InStream.good())
   {
     DuskLog() << "WaypointObject::loadWaypointObjectPart: ERROR while reading flags.\n";
     return false;
   }
   // -- current waypoint
-  InStream.read((char*) &m_currentWaypoint, sizeof(m_currentWaypoint));
+  InStream.readUInt32(m_currentWaypoint);
   // -- waypoints themselves
   // ---- number of WPs
   unsigned int wp_count = 0;
-  InStream.read((char*) &wp_count, sizeof(unsigned int));
+  InStream.readUInt32(wp_count);
   if (wp_count>100)
   {
     DuskLog() << "WaypointObject::loadWaypointObjectPart: ERROR: There are "
@@ -233,11 +240,11 @@ bool WaypointObject::loadWaypointObjectPart(std::ifstream& InStream)
   unsigned int len;
   for (len=0; len<wp_count; len=len+1)
   {
-    InStream.read((char*) &f_temp, sizeof(float));
+    InStream.readFloat(f_temp);
     temp_vec.x = f_temp;
-    InStream.read((char*) &f_temp, sizeof(float));
+    InStream.readFloat(f_temp);
     temp_vec.y = f_temp;
-    InStream.read((char*) &f_temp, sizeof(float));
+    InStream.readFloat(f_temp);
     temp_vec.z = f_temp;
     if (!(InStream.good()))
     {
@@ -250,7 +257,7 @@ bool WaypointObject::loadWaypointObjectPart(std::ifstream& InStream)
   return (InStream.good());
 }
 
-bool WaypointObject::saveToStream(std::ofstream& OutStream) const
+bool WaypointObject::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -258,7 +265,7 @@ bool WaypointObject::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RfWP" (reference of WaypointObject)
-  OutStream.write((char*) &cHeaderRfWP, sizeof(unsigned int));
+  OutStream.writeUInt32(cHeaderRfWP);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -277,7 +284,7 @@ bool WaypointObject::saveToStream(std::ofstream& OutStream) const
   return saveWaypointObjectPart(OutStream);
 }
 
-bool WaypointObject::loadFromStream(std::ifstream& InStream)
+bool WaypointObject::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -292,7 +299,7 @@ bool WaypointObject::loadFromStream(std::ifstream& InStream)
   }
   //read header "RfWP"
   unsigned int Header = 0;
-  InStream.read((char*) &Header, sizeof(unsigned int));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRfWP)
   {
     DuskLog() << "WaypointObject::loadFromStream: ERROR: Stream contains "
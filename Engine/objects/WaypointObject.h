@@ -136,7 +136,7 @@ class WaypointObject: public UniformMotionObject
            Every derived class has to have its own implementation of this
            function to ensure the object is saved properly.
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Tries to load an object from the given stream. Returns true on
        success, false otherwise.
@@ -150,7 +150,7 @@ class WaypointObject: public UniformMotionObject
            If the function returns false, the data within the object may be
            corrupted. It's advised not to use the object in this case.
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
@@ -171,7 +171,7 @@ class WaypointObject: public UniformMotionObject
          Derived classes will (most likely) call this function as part of
          their implementation of SaveToStream().
     */
-    bool saveWaypointObjectPart(std::ofstream& OutStream) const;
+    bool saveWaypointObjectPart(BinaryWriter& OutStream) const;
 
     /* Utility function which loads all data that is specific to an
        WaypointObject from the given stream. Returns true on success.
@@ -183,7 +183,7 @@ class WaypointObject: public UniformMotionObject
          Derived classes will (most likely) call this function as part of
          their implementation of loadFromStream().
     */
-    bool loadWaypointObjectPart(std::ifstream& InStream);
+    bool loadWaypointObjectPart(BinaryReader& InStream);
 
     bool m_WaypointTravel;
     bool m_Patrol;
@@ -65,7 +65,7 @@ bool Weapon::canPickUp() const
   return !m_Equipped;
 }
 
-bool Weapon::saveToStream(std::ofstream& OutStream) const
+bool Weapon::saveToStream(BinaryWriter& OutStream) const
 {
   if (!OutStream.good())
   {
@@ -73,7 +73,7 @@ bool Weapon::saveToStream(std::ofstream& OutStream) const
     return false;
   }
   //write header "RfWe" (reference of Weapon)
-  OutStream.write((const char*) &cHeaderRfWe, sizeof(uint32_t));
+  OutStream.writeUInt32(cHeaderRfWe);
   //write all data inherited from DuskObject
   if (!saveDuskObjectPart(OutStream))
   {
@@ -91,7 +91,7 @@ bool Weapon::saveToStream(std::ofstream& OutStream) const
   return OutStream.good();
 }
 
-bool Weapon::loadFromStream(std::ifstream& InStream)
+bool Weapon::loadFromStream(BinaryReader& InStream)
 {
   if (entity!=NULL)
   {
@@ -106,7 +106,7 @@ bool Weapon::loadFromStream(std::ifstream& InStream)
   }
   //read header "RfWe"
   uint32_t Header = 0;
-  InStream.read((char*) &Header, sizeof(uint32_t));
+  InStream.readUInt32(Header);
   if (Header!=cHeaderRfWe)
   {
     DuskLog() << "Weapon::loadFromStream: ERROR: Stream contains invalid "
@@ -84,7 +84,7 @@ class Weapon: public Item
        parameters:
            OutStream - the output stream that is used to save the weapon
     */
-    virtual bool saveToStream(std::ofstream& OutStream) const;
+    virtual bool saveToStream(BinaryWriter& OutStream) const;
 
     /* Tries to load a weapon from the given stream. Returns true on
        success, false otherwise.
@@ -96,7 +96,7 @@ class Weapon: public Item
            If the function returns false, the data within the weapon may be
            corrupted. It's advised not to use the weapon in this case.
     */
-    virtual bool loadFromStream(std::ifstream& InStream);
+    virtual bool loadFromStream(BinaryReader& InStream);
   protected:
     /* returns the name/path of the mesh that is used during enabling this
        object
@@ -0,0 +1,418 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+#include "AudioThread.h"
+#include <chrono>
+#include "../Messages.h"
+#include "MediaOggVorbisStream.h"
+#include "SoundStatistics.h"
+
+namespace Dusk
+{
+
+/* time the audio thread waits for new commands before it refills the streams
+   and publishes the voice states anyway (in milliseconds)
+*/
+const unsigned int cAudioThreadInterval = 10;
+
+/* maximum number of sample frames that are rendered for a loopback device at
+   once - if the thread was delayed for longer, the rest is skipped
+*/
+const unsigned int cMaxRenderFrames = 8192;
+
+AudioCommand::AudioCommand()
+: type(acStop),
+  voice(0),
+  buffers(),
+  stream(NULL),
+  call()
+{
+  unsigned int i;
+  for (i=0; i<6; ++i)
+  {
+    values[i] = 0.0f;
+  }
+}
+
+AudioThread::AudioThread(const std::vector<ALuint>& voices, ALCdevice* loopback,
+                         LoopbackRenderFunction render, const unsigned int frequency)
+: m_Voices(voices),
+  m_States(new VoiceState[voices.size()]),
+  m_Streams(std::map<ALuint, StreamVoice>()),
+  m_Queue(cQueueCapacity),
+  m_Pushed(0),
+  m_Executed(0),
+  m_Quit(false),
+  m_Mutex(),
+  m_Wake(),
+  m_Done(),
+  m_LoopbackDevice(loopback),
+  m_Render((loopback!=NULL) ? render : NULL),
+  m_Frequency(frequency),
+  m_RenderStart(std::chrono::steady_clock::now()),
+  m_RenderedFrames(0),
+  m_RenderBuffer(),
+  m_DiscardMutex(),
+  m_Discarded(),
+  m_Thread()
+{
+  unsigned int i;
+  for (i=0; i<m_Voices.size(); ++i)
+  {
+    m_States[i].state = AL_INITIAL;
+    m_States[i].offset = 0.0f;
+  }
+  m_Thread = std::thread(&AudioThread::run, this);
+}
+
+AudioThread::~AudioThread()
+{
+  m_Quit = true;
+  wake();
+  if (m_Thread.joinable())
+  {
+    m_Thread.join();
+  }
+  //buffers that were discarded after the last iteration
+  deleteDiscardedBuffers();
+}
+
+uint64_t AudioThread::push(const AudioCommand& cmd)
+{
+  while (!m_Queue.push(cmd))
+  {
+    //queue is full, let the audio thread catch up
+    wake();
+    std::this_thread::yield();
+  }
+  return ++m_Pushed;
+}
+
+void AudioThread::wake()
+{
+  {
+    //makes sure the thread is either waiting or will see the new commands
+    std::lock_guard<std::mutex> lock(m_Mutex);
+  }
+  m_Wake.notify_one();
+}
+
+void AudioThread::flush()
+{
+  wake();
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Done.wait(lock, [this]() { return m_Executed.load()>=m_Pushed; });
+}
+
+bool AudioThread::isAudioThread() const
+{
+  return (std::this_thread::get_id()==m_Thread.get_id());
+}
+
+void AudioThread::discardBuffers(const std::vector<ALuint>& buffers, const std::shared_ptr<MappedFile>& staticData)
+{
+  std::lock_guard<std::mutex> lock(m_DiscardMutex);
+  m_Discarded.push_back(std::make_pair(buffers, staticData));
+}
+
+bool AudioThread::getVoiceState(const ALuint voice, const uint64_t sequence, ALint& state, float& offset) const
+{
+  if (m_Executed.load(std::memory_order_acquire)<sequence)
+  {
+    return false;
+  }
+  unsigned int i;
+  for (i=0; i<m_Voices.size(); ++i)
+  {
+    if (m_Voices[i]==voice)
+    {
+      state = m_States[i].state.load(std::memory_order_relaxed);
+      offset = m_States[i].offset.load(std::memory_order_relaxed);
+      return true;
+    }
+  }//for
+  return false;
+}
+
+void AudioThread::run()
+{
+  uint64_t executed = 0;
+  AudioCommand cmd;
+  while (true)
+  {
+    while (m_Queue.pop(cmd))
+    {
+      SoundStatistics::Timer timer(SoundStatistics::opCommand);
+      execute(cmd);
+      ++executed;
+    }
+    //release the buffers and the function of the last command, they may be
+    // deleted soon
+    cmd.buffers.reset();
+    cmd.call = nullptr;
+    deleteDiscardedBuffers();
+    if (m_Render!=NULL)
+    {
+      renderLoopback();
+    }
+    updateStreams();
+    publishStates();
+    m_Executed.store(executed, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Done.notify_all();
+    }
+    if (m_Quit and m_Queue.empty())
+    {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Wake.wait_for(lock, std::chrono::milliseconds(cAudioThreadInterval),
+                    [this]() { return m_Quit.load() or !m_Queue.empty(); });
+  }//while
+}
+
+void AudioThread::execute(AudioCommand& cmd)
+{
+  if (cmd.type==AudioCommand::acCall)
+  {
+    try
+    {
+      if (cmd.call)
+        cmd.call();
+    }
+    catch (...)
+    {
+      //most likely std::bad_alloc, the caller sees that its call failed
+      DuskLog() << "AudioThread::execute: ERROR: exception in called function.\n";
+    }
+    return;
+  }
+  alGetError(); //clear error state
+  switch (cmd.type)
+  {
+    case AudioCommand::acGain:
+         alSourcef(cmd.voice, AL_GAIN, cmd.values[0]);
+         break;
+    case AudioCommand::acPosition:
+         alSource3f(cmd.voice, AL_POSITION, cmd.values[0], cmd.values[1], cmd.values[2]);
+         break;
+    case AudioCommand::acVelocity:
+         alSource3f(cmd.voice, AL_VELOCITY, cmd.values[0], cmd.values[1], cmd.values[2]);
+         break;
+    case AudioCommand::acLooping:
+         alSourcei(cmd.voice, AL_LOOPING, (cmd.values[0]!=0.0f) ? AL_TRUE : AL_FALSE);
+         break;
+    case AudioCommand::acOffset:
+         alSourcef(cmd.voice, AL_SEC_OFFSET, cmd.values[0]);
+         break;
+    case AudioCommand::acPlay:
+         {
+           const std::map<ALuint, StreamVoice>::iterator iter = m_Streams.find(cmd.voice);
+           if (iter!=m_Streams.end())
+           {
+             ALint source_state = AL_INITIAL;
+             alGetSourcei(cmd.voice, AL_SOURCE_STATE, &source_state);
+             //start over unless the stream is fresh or paused, just like a
+             // static media
+             if ((source_state!=AL_INITIAL) and (source_state!=AL_PAUSED)
+                 and !iter->second.stream->rewind(cmd.voice))
+             {
+               DuskLog() << "AudioThread::execute: ERROR: could not rewind "
+                         << "stream of voice " << cmd.voice << ".\n";
+               iter->second.active = false;
+               return;
+             }
+             iter->second.active = true;
+           }
+           alSourcePlay(cmd.voice);
+         }
+         break;
+    case AudioCommand::acPause:
+         alSourcePause(cmd.voice);
+         break;
+    case AudioCommand::acStop:
+         {
+           const std::map<ALuint, StreamVoice>::iterator iter = m_Streams.find(cmd.voice);
+           if (iter!=m_Streams.end())
+           {
+             iter->second.active = false;
+           }
+           alSourceStop(cmd.voice);
+         }
+         break;
+    case AudioCommand::acQueue:
+         if (cmd.stream!=NULL)
+         {
+           alSourcei(cmd.voice, AL_LOOPING, AL_FALSE);
+           //fills the first buffers and queues them
+           if (!cmd.stream->rewind(cmd.voice))
+           {
+             DuskLog() << "AudioThread::execute: ERROR while queueing buffers "
+                       << "of streamed media \"" << cmd.stream->getIdentifier()
+                       << "\" to voice " << cmd.voice << ".\n";
+             return;
+           }
+           StreamVoice sv;
+           sv.stream = cmd.stream;
+           sv.active = false;
+           m_Streams[cmd.voice] = sv;
+         }
+         else if (cmd.buffers.get()!=NULL)
+         {
+           alSourceQueueBuffers(cmd.voice, cmd.buffers->getNumberOfBuffers(),
+                                cmd.buffers->getBufferPointer());
+         }
+         break;
+    case AudioCommand::acUnqueue:
+         {
+           m_Streams.erase(cmd.voice);
+           alSourceStop(cmd.voice);
+           //after stopping, all buffers are processed
+           ALint queued = 0;
+           alGetSourcei(cmd.voice, AL_BUFFERS_QUEUED, &queued);
+           if (queued>0)
+           {
+             std::vector<ALuint> unqueued(queued, 0);
+             alSourceUnqueueBuffers(cmd.voice, queued, &unqueued[0]);
+           }
+         }
+         break;
+    case AudioCommand::acListenerPosition:
+         alListener3f(AL_POSITION, cmd.values[0], cmd.values[1], cmd.values[2]);
+         break;
+    case AudioCommand::acListenerVelocity:
+         alListener3f(AL_VELOCITY, cmd.values[0], cmd.values[1], cmd.values[2]);
+         break;
+    case AudioCommand::acListenerOrientation:
+         alListenerfv(AL_ORIENTATION, cmd.values);
+         break;
+    case AudioCommand::acCall:
+         //handled above
+         break;
+  }//swi
+  const ALenum error_state = alGetError();
+  if (error_state!=AL_NO_ERROR)
+  {
+    DuskLog() << "AudioThread::execute: ERROR: command " << (int)cmd.type
+              << " for voice " << cmd.voice << " failed. Error code: "
+              << (int)error_state << ".\n";
+  }
+}
+
+void AudioThread::updateStreams()
+{
+  std::map<ALuint, StreamVoice>::iterator iter = m_Streams.begin();
+  while (iter!=m_Streams.end())
+  {
+    if (!iter->second.active)
+    {
+      ++iter;
+      continue;
+    }
+    const ALuint voice = iter->first;
+    ALint queued = 0;
+    bool refilled = false;
+    {
+      SoundStatistics::Timer timer(SoundStatistics::opStreamRefill);
+      refilled = iter->second.stream->refill(voice, queued);
+    }
+    if (!refilled)
+    {
+      DuskLog() << "AudioThread::updateStreams: ERROR: could not refill "
+                << "buffers of voice " << voice << ".\n";
+      iter->second.active = false;
+    }
+    else if (queued==0)
+    {
+      //all data was played, otherwise the decoder is late
+      if (iter->second.stream->hasEnded())
+        iter->second.active = false;
+    }
+    else
+    {
+      ALint source_state = AL_PLAYING;
+      alGetSourcei(voice, AL_SOURCE_STATE, &source_state);
+      if (source_state==AL_STOPPED)
+      {
+        //source ran out of buffers before they were refilled (buffer underrun)
+        alSourcePlay(voice);
+      }
+    }
+    ++iter;
+  }//while
+}
+
+void AudioThread::publishStates()
+{
+  unsigned int i;
+  for (i=0; i<m_Voices.size(); ++i)
+  {
+    ALint source_state = AL_INITIAL;
+    ALfloat seconds = 0.0f;
+    alGetSourcei(m_Voices[i], AL_SOURCE_STATE, &source_state);
+    alGetSourcef(m_Voices[i], AL_SEC_OFFSET, &seconds);
+    const std::map<ALuint, StreamVoice>::const_iterator iter = m_Streams.find(m_Voices[i]);
+    if ((source_state==AL_STOPPED) and (iter!=m_Streams.end()) and iter->second.active)
+    {
+      //stream only waits for the decoder
+      source_state = AL_PLAYING;
+    }
+    m_States[i].state.store(source_state, std::memory_order_relaxed);
+    m_States[i].offset.store(seconds, std::memory_order_relaxed);
+  }//for
+}
+
+void AudioThread::deleteDiscardedBuffers()
+{
+  std::vector<std::pair<std::vector<ALuint>, std::shared_ptr<MappedFile> > > discarded;
+  {
+    std::lock_guard<std::mutex> lock(m_DiscardMutex);
+    discarded.swap(m_Discarded);
+  }
+  unsigned int i;
+  for (i=0; i<discarded.size(); ++i)
+  {
+    MediaBuffers::deleteBuffers(discarded[i].first);
+  }//for
+  //the mappings of static buffers are released with discarded
+}
+
+void AudioThread::renderLoopback()
+{
+  const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now()-m_RenderStart;
+  const uint64_t due = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+                       * m_Frequency / 1000000;
+  if (due<=m_RenderedFrames)
+  {
+    return;
+  }
+  uint64_t frames = due-m_RenderedFrames;
+  if (frames>cMaxRenderFrames)
+  {
+    //thread was delayed, do not try to catch up with all of it
+    m_RenderedFrames += frames-cMaxRenderFrames;
+    frames = cMaxRenderFrames;
+  }
+  m_RenderBuffer.resize(2*frames);
+  m_Render(m_LoopbackDevice, &m_RenderBuffer[0], frames);
+  m_RenderedFrames += frames;
+}
+
+} //namespace
@@ -0,0 +1,219 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+#ifndef SOUND_AUDIOTHREAD_H_INCLUDED
+#define SOUND_AUDIOTHREAD_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+  #include "openal/al.h" //OpenAL header
+  #include "openal/alc.h" //OpenAL header
+#elif defined(__linux__) || defined(linux)
+  #include <AL/al.h> //OpenAL header
+  #include <AL/alc.h> //OpenAL header
+#else
+  #error "Unknown operating system!"
+#endif
+
+#include "../SPSCQueue.h"
+#include "Media.h"
+
+namespace Dusk
+{
+
+//forward declaration
+class MediaOggVorbisStream;
+
+/* signature of alcRenderSamplesSOFT() from the ALC_SOFT_loopback extension */
+typedef void (*LoopbackRenderFunction)(ALCdevice* device, ALCvoid* buffer, ALCsizei samples);
+
+/* a single request to the audio thread */
+struct AudioCommand
+{
+  enum Type {acGain, acPosition, acVelocity, acLooping, acOffset, acPlay,
+             acPause, acStop, acQueue, acUnqueue, acListenerPosition,
+             acListenerVelocity, acListenerOrientation, acCall};
+
+  /* constructor */
+  AudioCommand();
+
+  Type type;
+  ALuint voice; //AL source the command is for (not used by listener commands)
+  float values[6]; //parameters, e.g. position or orientation
+  std::shared_ptr<MediaBuffers> buffers; //buffers to queue (acQueue only)
+  MediaOggVorbisStream * stream; //stream to queue instead of buffers (acQueue)
+  std::function<void()> call; //function to run (acCall only), e.g. to create
+                              //AL buffers; it has to check AL errors itself
+};
+
+/* class AudioThread:
+       thread that does all the work with OpenAL once the sound system is
+       initialised - changing source and listener properties, starting and
+       stopping playback, refilling the queues of streamed media, and
+       creating, filling and deleting AL buffers. OpenAL keeps one error state
+       per context, so no other thread may call OpenAL while it runs. The game
+       thread sends commands through a lock-free queue, so it never waits for
+       the audio driver, unless it needs a result (see flush()).
+       Once per iteration the thread publishes the state and offset of every
+       voice, which can be read with getVoiceState().
+       If the sound system uses a loopback device (see Sound::init()), the
+       thread also renders the mix in real time and discards it, because
+       nothing would play otherwise.
+
+       remarks:
+           Only one thread (the game thread) may call push(), wake() and
+           flush(). discardBuffers() may be called by any thread.
+*/
+class AudioThread
+{
+  public:
+    /* constructor - starts the thread
+
+       parameters:
+           voices    - all AL sources the commands may refer to
+           loopback  - loopback device whose mix the thread renders, or NULL
+                       for a normal output device
+           render    - alcRenderSamplesSOFT(), only used with loopback
+           frequency - sampling rate of the loopback device
+    */
+    AudioThread(const std::vector<ALuint>& voices, ALCdevice* loopback=NULL,
+                LoopbackRenderFunction render=NULL, const unsigned int frequency=0);
+
+    /* destructor - executes all remaining commands and stops the thread */
+    ~AudioThread();
+
+    /* Appends a command to the queue and returns its sequence number. The
+       command is executed with the next iteration of the thread.
+
+       remarks:
+           If the queue is full, the function waits until the thread has taken
+           some commands. This only happens, if more than cQueueCapacity
+           commands are sent without calling wake().
+    */
+    uint64_t push(const AudioCommand& cmd);
+
+    /* lets the thread execute the queued commands right away instead of
+       after its next timeout
+    */
+    void wake();
+
+    /* blocks until all commands which were pushed so far are executed, e.g.
+       before buffers or streams are deleted that queued commands refer to
+    */
+    void flush();
+
+    /* returns true, if the calling thread is the audio thread */
+    bool isAudioThread() const;
+
+    /* Lets the thread delete the given AL buffers with its next iteration.
+       Unlike push(), this can be called by any thread, because the last
+       reference to a MediaBuffers instance may be released anywhere.
+
+       parameters:
+           buffers    - the AL buffers
+           staticData - mapping that the buffers use as static data, kept
+                        until the buffers are deleted (may be NULL)
+    */
+    void discardBuffers(const std::vector<ALuint>& buffers, const std::shared_ptr<MappedFile>& staticData);
+
+    /* Retrieves the state (AL_PLAYING, AL_STOPPED, ...) and the offset of the
+       given voice, as published by the thread. Returns false, if the command
+       with the given sequence number has not been executed yet or if voice is
+       unknown, because the published state would be outdated then.
+
+       parameters:
+           voice    - the AL source
+           sequence - sequence number of the last command for that voice
+           state    - receives the state of the voice
+           offset   - receives the playback offset of the voice in seconds
+    */
+    bool getVoiceState(const ALuint voice, const uint64_t sequence, ALint& state, float& offset) const;
+
+    /* maximum number of queued commands */
+    static const std::size_t cQueueCapacity = 4096;
+  private:
+    /* the function the thread runs */
+    void run();
+
+    /* does the OpenAL calls for cmd */
+    void execute(AudioCommand& cmd);
+
+    /* refills the queues of all playing streams */
+    void updateStreams();
+
+    /* stores the current state of all voices for getVoiceState() */
+    void publishStates();
+
+    /* renders the samples of the loopback device up to the current time */
+    void renderLoopback();
+
+    /* deletes the buffers passed to discardBuffers() */
+    void deleteDiscardedBuffers();
+
+    /* private copy constructor - threads cannot be copied */
+    AudioThread(const AudioThread& op) : m_Queue(0) {}
+
+    /* state of a voice, as seen by the game thread */
+    struct VoiceState
+    {
+      std::atomic<ALint> state;
+      std::atomic<float> offset;
+    };
+
+    /* stream that is queued to a voice */
+    struct StreamVoice
+    {
+      MediaOggVorbisStream * stream;
+      bool active; //true while the stream shall keep playing
+    };
+
+    std::vector<ALuint> m_Voices;
+    std::unique_ptr<VoiceState[]> m_States; //same order as m_Voices
+    std::map<ALuint, StreamVoice> m_Streams; //used by the audio thread only
+    SPSCQueue<AudioCommand> m_Queue;
+    uint64_t m_Pushed; //number of pushed commands, used by game thread only
+    std::atomic<uint64_t> m_Executed; //number of executed commands
+    std::atomic<bool> m_Quit;
+    std::mutex m_Mutex; //only used for waiting, never while calling OpenAL
+    std::condition_variable m_Wake;
+    std::condition_variable m_Done;
+    ALCdevice* m_LoopbackDevice;
+    LoopbackRenderFunction m_Render;
+    unsigned int m_Frequency;
+    std::chrono::steady_clock::time_point m_RenderStart;
+    uint64_t m_RenderedFrames; //sample frames rendered since m_RenderStart
+    std::vector<int16_t> m_RenderBuffer; //stereo, 16 bit
+    std::mutex m_DiscardMutex; //guards m_Discarded, never held while calling OpenAL
+    std::vector<std::pair<std::vector<ALuint>, std::shared_ptr<MappedFile> > > m_Discarded;
+    std::thread m_Thread;
+}; //class
+
+} //namespace
+
+#endif // SOUND_AUDIOTHREAD_H_INCLUDED
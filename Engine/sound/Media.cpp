@@ -19,33 +19,269 @@
 */
 
 #include "Media.h"
-#include <cstdlib>
+#include "../MappedFile.h"
 #include "../Messages.h"
+#include "Sound.h"
 
 namespace Dusk
 {
 
 const unsigned int Media::MaxMediaSize_MB = 30;
 
-Media::Media(const std::string& identifier, const std::string& PathToMedia)
-: m_Name(identifier),
-  m_FileName(PathToMedia),
-  num_buffers(0),
-  buffers(NULL),
-  attached_to(std::vector<std::string>())
+//signature of alBufferDataStatic() from the AL_EXT_STATIC_BUFFER extension
+typedef ALvoid (AL_APIENTRY *BufferDataStaticFunction)(const ALint, ALenum, ALvoid*, ALsizei, ALsizei);
+
+DecodedMedia::DecodedMedia()
+: channels(0),
+  bitsPerSample(0),
+  sampleRate(0),
+  data(std::vector<char>()),
+  file(),
+  offset(0),
+  length(0),
+  chunkSize(0)
 {
-  //empty
 }
 
-Media::~Media()
+const char* DecodedMedia::getPCM() const
+{
+  if (file.get()!=NULL)
+    return file->data() + offset;
+  if (data.empty())
+    return NULL;
+  return &data[offset];
+}
+
+void DecodedMedia::clear()
+{
+  data.clear();
+  file.reset();
+  offset = 0;
+  length = 0;
+}
+
+MediaBuffers::MediaBuffers(const ALuint count, const std::string& FileName)
+: m_Buffers(std::vector<ALuint>()),
+  m_DataSize(0),
+  m_Duration(0.0f),
+  m_StaticData()
+{
+  bool success = false;
+  Sound::get().runOnAudioThread([&]() { success = generate(count, FileName); }, true);
+  if (!success)
+  {
+    throw MediaCreationException();
+  }
+}
+
+MediaBuffers::MediaBuffers(const DecodedMedia& pcm, const std::string& FileName)
+: m_Buffers(std::vector<ALuint>()),
+  m_DataSize(0),
+  m_Duration(0.0f),
+  m_StaticData()
+{
+  bool success = false;
+  Sound::get().runOnAudioThread([&]() { success = upload(pcm, FileName); }, true);
+  if (!success)
+  {
+    throw MediaCreationException();
+  }
+}
+
+bool MediaBuffers::generate(const ALuint count, const std::string& FileName)
+{
+  m_Buffers.resize(count, 0);
+  alGetError();//clear error state
+  alGenBuffers(count, &m_Buffers[0]);
+  const ALenum error_state = alGetError();
+  if (error_state != AL_NO_ERROR)
+  {
+    DuskLog() << "MediaBuffers::generate: ERROR while generating buffers "
+              << "for \"" << FileName << "\".\n";
+    switch (error_state)
+    {
+      case AL_INVALID_VALUE:
+           DuskLog() << "    The provided buffer array is not large enough to "
+                     << "hold the requested number of buffers.\n";
+           break;
+      case AL_OUT_OF_MEMORY:
+           DuskLog() << "    Not enough memory to generate the buffers.\n";
+           break;
+      default:
+           DuskLog()<<"    Unknown error occured. Error code: "
+                    <<(int)error_state<<".\n"; break;
+    }//swi
+    m_Buffers.clear();
+    return false;
+  }
+  return true;
+}
+
+bool MediaBuffers::upload(const DecodedMedia& pcm, const std::string& FileName)
+{
+  //determine format
+  ALenum format_type = 0;
+  if (pcm.bitsPerSample==16)
+  {
+    switch(pcm.channels)
+    {
+      case 4:
+        format_type = alGetEnumValue("AL_FORMAT_QUAD16");
+        break;
+      case 2:
+        format_type = AL_FORMAT_STEREO16;
+        break;
+      case 1:
+        format_type = AL_FORMAT_MONO16;
+        break;
+    }//swi
+  }
+  else if (pcm.bitsPerSample==8)
+  {
+    switch(pcm.channels)
+    {
+      case 4:
+        format_type = alGetEnumValue("AL_FORMAT_QUAD8");
+        break;
+      case 2:
+        format_type = AL_FORMAT_STEREO8;
+        break;
+      case 1:
+        format_type = AL_FORMAT_MONO8;
+        break;
+    }//swi
+  }
+  //check for valid format enumeration value
+  if (format_type == 0)
+  {
+    DuskLog() << "MediaBuffers::upload: ERROR: Could not find a valid OpenAL "
+              << "format enumeration value. Most likely the format of \""
+              << FileName<<"\" (channels: "<<pcm.channels<<"; bits per "
+              << "sample: "<<pcm.bitsPerSample<<") is not supported.\n";
+    return false;
+  }
+  const char * pcm_data = pcm.getPCM();
+  if ((pcm_data==NULL) || (pcm.length==0))
+  {
+    DuskLog() << "MediaBuffers::upload: ERROR: There is no data for file \""
+              << FileName << "\".\n";
+    return false;
+  }
+  const std::size_t chunk_size = (pcm.chunkSize!=0) ? pcm.chunkSize : pcm.length;
+
+  //Mapped files can be used in place, if OpenAL supports static buffers.
+  BufferDataStaticFunction bufferDataStatic = NULL;
+  if ((pcm.file.get()!=NULL) && (alIsExtensionPresent("AL_EXT_STATIC_BUFFER")==AL_TRUE))
+  {
+    bufferDataStatic = (BufferDataStaticFunction) alGetProcAddress("alBufferDataStatic");
+  }
+
+  //allocate memory for the ALuint variables
+  const ALuint buffer_num = (pcm.length+chunk_size-1) / chunk_size;
+  m_Buffers.resize(buffer_num, 0);
+  alGetError();//clear error state
+  alGenBuffers(buffer_num, &m_Buffers[0]);
+  ALenum error_state = alGetError();
+  if (error_state !=AL_NO_ERROR) //error occured
+  {
+    DuskLog() << "MediaBuffers::upload: ERROR while generating buffers for \""
+              <<FileName<< "\".\n";
+    switch (error_state)
+    {
+      case AL_INVALID_VALUE:
+           DuskLog() << "    The provided buffer array is not large enough to "
+                     << "hold the requested number of buffers.\n";
+           break;
+      case AL_OUT_OF_MEMORY:
+           DuskLog() << "    Not enough memory to generate the buffers.\n";
+           break;
+      default:
+           DuskLog()<<"    Unknown error occured. Error code: "
+                    <<(int)error_state<<".\n";
+           break;
+    }//swi
+    m_Buffers.clear();
+    return false;
+  }
+
+  //now pass the data to OpenAL
+  ALuint i;
+  for (i=0; i<buffer_num; i=i+1)
+  {
+    //last buffer may be smaller than the others
+    const std::size_t this_size = (i+1<buffer_num) ? chunk_size
+                                 : pcm.length - i*chunk_size;
+    if (bufferDataStatic!=NULL)
+    {
+      bufferDataStatic(m_Buffers[i], format_type,
+                       const_cast<char*>(pcm_data + i*chunk_size), this_size,
+                       pcm.sampleRate);
+    }
+    else
+    {
+      alBufferData(m_Buffers[i], format_type, pcm_data + i*chunk_size, this_size,
+                   pcm.sampleRate);
+    }
+    error_state = alGetError();
+    if (error_state!= AL_NO_ERROR)
+    {
+      DuskLog() << "MediaBuffers::upload: ERROR while buffering data of \""
+                << FileName << "\".\n";
+      switch (error_state)
+      {
+        case AL_INVALID_ENUM:
+             DuskLog() <<"    The specified format does not exist.\n";
+             break;
+        case AL_INVALID_VALUE:
+             DuskLog() <<"    The size parameter is not valid for the given format"
+                       <<" or the buffer is already in use.\n";
+             break;
+        case AL_OUT_OF_MEMORY:
+             DuskLog() <<"    Not enough memory to create the buffer.\n";
+             break;
+        default:
+             DuskLog() <<"    Unknown error. Error code: "<<(int)error_state
+                       <<".\n";
+             break;
+      }//swi
+      //delete all previously generated buffers
+      alDeleteBuffers(buffer_num, &m_Buffers[0]);
+      m_Buffers.clear();
+      return false;
+    }//if
+  }//for
+  m_DataSize = pcm.length;
+  const std::size_t bytesPerSecond = static_cast<std::size_t>(pcm.channels)
+                                   * (pcm.bitsPerSample/8) * pcm.sampleRate;
+  if (bytesPerSecond!=0)
+  {
+    m_Duration = static_cast<float>(pcm.length) / bytesPerSecond;
+  }
+  if (bufferDataStatic!=NULL)
+  {
+    //buffers refer to the mapped data, so it has to stay
+    m_StaticData = pcm.file;
+  }
+  return true;
+}
+
+MediaBuffers::~MediaBuffers()
+{
+  if (!m_Buffers.empty())
+  {
+    //static buffers still use the mapping until they are deleted
+    Sound::get().discardBuffers(m_Buffers, m_StaticData);
+  }
+}
+
+void MediaBuffers::deleteBuffers(const std::vector<ALuint>& buffers)
 {
-  //delete buffers
   alGetError(); //clear error state
-  alDeleteBuffers(num_buffers, buffers);
+  alDeleteBuffers(buffers.size(), buffers.empty() ? NULL : &buffers[0]);
   const ALenum error_state = alGetError();
   if (error_state != AL_NO_ERROR)
   {
-    DuskLog() << "Media::~Media: ERROR: could not delete buffers.\n";
+    DuskLog() << "MediaBuffers::deleteBuffers: ERROR: could not delete buffers.\n";
     switch(error_state)
     {
       case AL_INVALID_OPERATION:
@@ -60,10 +296,43 @@ Media::~Media()
            DuskLog()<<"    Unknown error occured. Error code: "
                     <<(int)error_state<<".\n"; break;
     }//swi
-    throw MediaDestructionException();
   }//if
-  free(buffers);
-  buffers = NULL;
+}
+
+ALuint MediaBuffers::getNumberOfBuffers() const
+{
+  return m_Buffers.size();
+}
+
+ALuint * MediaBuffers::getBufferPointer() const
+{
+  if (m_Buffers.empty())
+    return NULL;
+  return const_cast<ALuint*>(&m_Buffers[0]);
+}
+
+std::size_t MediaBuffers::getDataSize() const
+{
+  return m_DataSize;
+}
+
+float MediaBuffers::getDuration() const
+{
+  return m_Duration;
+}
+
+Media::Media(const std::string& identifier, const std::string& PathToMedia)
+: m_Name(identifier),
+  m_FileName(PathToMedia),
+  attached_to(std::vector<std::string>()),
+  m_Buffers()
+{
+  //empty
+}
+
+Media::~Media()
+{
+  //buffers are deleted by MediaBuffers, as soon as no media uses them any more
 }
 
 const std::string& Media::getIdentifier() const
@@ -78,17 +347,23 @@ const std::string& Media::getFileName() const
 
 ALuint Media::getNumberOfBuffers() const
 {
-  return num_buffers;
+  if (m_Buffers.get()==NULL)
+    return 0;
+  return m_Buffers->getNumberOfBuffers();
 }
 
 const ALuint * Media::getBufferPointer() const
 {
-  return buffers;
+  if (m_Buffers.get()==NULL)
+    return NULL;
+  return m_Buffers->getBufferPointer();
 }
 
 ALuint * Media::getNonConstBufferPointer() const
 {
-  return buffers;
+  if (m_Buffers.get()==NULL)
+    return NULL;
+  return m_Buffers->getBufferPointer();
 }
 
 void Media::notifyAttached(const std::string& sourceID)
@@ -115,6 +390,56 @@ const std::vector<std::string>& Media::getRelatedSources() const
   return attached_to;
 }
 
+void Media::createBuffers(const DecodedMedia& pcm)
+{
+  m_Buffers.reset(new MediaBuffers(pcm, m_FileName));
+}
+
+bool Media::isStreaming() const
+{
+  return false;
+}
+
+float Media::getDuration() const
+{
+  if (m_Buffers.get()==NULL)
+    return 0.0f;
+  return m_Buffers->getDuration();
+}
+
+bool Media::isLoaded() const
+{
+  return (m_Buffers.get()!=NULL);
+}
+
+const std::shared_ptr<MediaBuffers>& Media::getBuffers() const
+{
+  return m_Buffers;
+}
+
+void Media::setBuffers(const std::shared_ptr<MediaBuffers>& newBuffers)
+{
+  m_Buffers = newBuffers;
+}
+
+void Media::unload()
+{
+  if (!attached_to.empty())
+  {
+    DuskLog() << "Media::unload: ERROR: Media \"" << m_Name << "\" is still "
+              << "attached to " << attached_to.size() << " source(s).\n";
+    return;
+  }
+  m_Buffers.reset();
+}
+
+bool Media::reload()
+{
+  DuskLog() << "Media::reload: ERROR: Media \"" << m_Name << "\" cannot be "
+            << "reloaded, because its file format is unknown.\n";
+  return false;
+}
+
 const char* MediaCreationException::what() const throw()
 {
   return "Media::Media: Error while creating media.\n";
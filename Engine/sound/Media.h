@@ -22,6 +22,8 @@
 #define SOUND_MEDIA_H_INCLUDED
 
 #include <exception>
+#include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -36,6 +38,118 @@
 namespace Dusk
 {
 
+//forward declaration
+class MappedFile;
+
+/* PCM data of a sound file which has been read (and decoded, if needed), but
+   not been handed to OpenAL yet. The data is either held in memory (data) or
+   used in place from the mapped file (file).
+*/
+struct DecodedMedia
+{
+  /* constructor */
+  DecodedMedia();
+
+  /* returns a pointer to the first byte of the PCM data */
+  const char* getPCM() const;
+
+  /* frees the PCM data */
+  void clear();
+
+  uint16_t channels;
+  uint16_t bitsPerSample;
+  uint32_t sampleRate;
+  std::vector<char> data; //PCM data, if it had to be decoded into memory
+  std::shared_ptr<MappedFile> file; //mapped file, if the PCM data is used in place
+  std::size_t offset; //start of the PCM data within data or file
+  std::size_t length; //length of the PCM data in bytes
+  std::size_t chunkSize; //bytes per AL buffer; zero means one buffer for all
+};
+
+/* AL buffers which hold the PCM data of a media. Media that were created
+   from the same file share one instance (see Sound's media cache), and the
+   buffers are deleted together with the last reference.
+   All OpenAL calls for the buffers are done by the audio thread (see
+   Sound::runOnAudioThread()), because the error state of OpenAL is shared by
+   all threads that use the context.
+*/
+class MediaBuffers
+{
+  public:
+    /* Generates count empty AL buffers. Throws MediaCreationException on
+       failure.
+
+       parameters:
+           count    - number of buffers
+           FileName - name of the file the buffers are for (for error messages)
+
+       remarks:
+           Waits for the audio thread, unless it is called by the audio
+           thread itself.
+    */
+    MediaBuffers(const ALuint count, const std::string& FileName);
+
+    /* Generates one AL buffer per chunk of pcm and fills it with the chunk's
+       data. Throws MediaCreationException on failure.
+
+       parameters:
+           pcm      - the decoded data
+           FileName - name of the file the data was read from
+
+       remarks:
+           Waits for the audio thread, which uploads the data, unless it is
+           called by the audio thread itself.
+           If pcm uses a mapped file and the OpenAL implementation supports
+           the AL_EXT_STATIC_BUFFER extension, the buffers use the mapped data
+           directly and keep the mapping until they are deleted.
+    */
+    MediaBuffers(const DecodedMedia& pcm, const std::string& FileName);
+
+    /* destructor - lets the audio thread delete the AL buffers; can be called
+       by any thread
+    */
+    ~MediaBuffers();
+
+    /* returns the number of AL buffers */
+    ALuint getNumberOfBuffers() const;
+
+    /* returns a pointer to the first AL buffer name */
+    ALuint * getBufferPointer() const;
+
+    /* returns the number of bytes of PCM data in the buffers */
+    std::size_t getDataSize() const;
+
+    /* returns the playing time of the PCM data in the buffers in seconds
+       (zero for empty buffers, e.g. the ones of a stream)
+    */
+    float getDuration() const;
+
+    /* deletes the given AL buffers and logs errors
+
+       remarks:
+           Must be called by the audio thread (or when there is none).
+    */
+    static void deleteBuffers(const std::vector<ALuint>& buffers);
+  private:
+    /* copy constructor - not allowed */
+    MediaBuffers(const MediaBuffers& op) {}
+
+    /* generates count AL buffers and returns true on success; runs on the
+       audio thread
+    */
+    bool generate(const ALuint count, const std::string& FileName);
+
+    /* generates the AL buffers for pcm, fills them and returns true on
+       success; runs on the audio thread
+    */
+    bool upload(const DecodedMedia& pcm, const std::string& FileName);
+
+    std::vector<ALuint> m_Buffers;
+    std::size_t m_DataSize;
+    float m_Duration; //playing time in seconds
+    std::shared_ptr<MappedFile> m_StaticData; //mapping used by static buffers
+};//class
+
 //buffer management type
 class Media
 {
@@ -90,12 +204,52 @@ class Media
 
     /* returns a vector of names of sources to which this media is attached */
     const std::vector<std::string>& getRelatedSources() const;
+
+    /* returns true, if the media does not hold all of its data in its buffers,
+       but streams it from the file while playing (see MediaOggVorbisStream)
+    */
+    virtual bool isStreaming() const;
+
+    /* returns the playing time of the media in seconds, or zero, if it is not
+       known (e.g. because the media is not loaded)
+    */
+    virtual float getDuration() const;
+
+    // **buffer sharing and unloading** - used by Sound's media cache
+    /* returns true, if the media has its buffers */
+    bool isLoaded() const;
+
+    /* returns the buffers of the media (NULL, if not loaded) */
+    const std::shared_ptr<MediaBuffers>& getBuffers() const;
+
+    /* replaces the buffers of the media, e.g. by the buffers of another media
+       that was created from the same file
+    */
+    void setBuffers(const std::shared_ptr<MediaBuffers>& newBuffers);
+
+    /* releases the buffers of the media; they are deleted, if no other media
+       shares them
+
+       remarks:
+           Must not be called while the media is attached to a source.
+    */
+    void unload();
+
+    /* Reads the file again and creates new buffers for it. Returns true on
+       success. The default implementation always fails, because Media does
+       not know how to read any file format.
+    */
+    virtual bool reload();
   protected:
+    /* Creates the buffers of the media from pcm. Throws MediaCreationException
+       on failure. (See the MediaBuffers constructor for details.)
+    */
+    void createBuffers(const DecodedMedia& pcm);
+
     std::string m_Name; //unique name, case sensitive
-    std::string m_FileName; //pro forma, not really needed after file is loaded
-    ALuint num_buffers;
-    ALuint * buffers;
+    std::string m_FileName; //needed to reload the media after unload()
     std::vector<std::string> attached_to;
+    std::shared_ptr<MediaBuffers> m_Buffers;
 }; //class
 
 class MediaCreationException: public std::exception
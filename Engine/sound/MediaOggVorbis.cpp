@@ -20,6 +20,7 @@
 
 #include "MediaOggVorbis.h"
 #include "../Messages.h"
+#include "SoundStatistics.h"
 #include <cstdlib>
 
 #if defined(_WIN32)
@@ -35,6 +36,46 @@ namespace Dusk
 
 MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia)
 : Media(identifier, PathToMedia)
+{
+  DecodedMedia pcm;
+  if (!decode(PathToMedia, pcm))
+  {
+    throw MediaCreationException();
+  }
+  createBuffers(pcm);
+}
+
+MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia, const DecodedMedia& pcm)
+: Media(identifier, PathToMedia)
+{
+  createBuffers(pcm);
+}
+
+MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia, const std::shared_ptr<MediaBuffers>& shared)
+: Media(identifier, PathToMedia)
+{
+  m_Buffers = shared;
+}
+
+bool MediaOggVorbis::reload()
+{
+  DecodedMedia pcm;
+  if (!decode(m_FileName, pcm))
+  {
+    return false;
+  }
+  try
+  {
+    createBuffers(pcm);
+  }
+  catch (...)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool MediaOggVorbis::decode(const std::string& PathToMedia, DecodedMedia& result)
 {
   OggVorbis_File ov;
   vorbis_info * vinfo;
@@ -42,19 +83,20 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
   int section, ret;
   double time_total;
   ogg_int64_t pcm_samples;
+  SoundStatistics::Timer timer(SoundStatistics::opDecode);
 
   dat = fopen(PathToMedia.c_str(), "rb");
   if (dat==NULL)
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: Could not open file \""
+    DuskLog() << "MediaOggVorbis::decode: ERROR: Could not open file \""
               << PathToMedia << "\" via fopen properly.\n";
-    throw MediaCreationException();
+    return false;
   }//if
 
   ret = ov_open_callbacks(dat, &ov, NULL, 0, OV_CALLBACKS_DEFAULT);
   if (ret<0)
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: Could not open file \""
+    DuskLog() << "MediaOggVorbis::decode: ERROR: Could not open file \""
               << PathToMedia << "\" via callbacks properly.\n";
     switch(ret)
     {
@@ -73,19 +115,19 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
            DuskLog() << "    Unknown error. Code: " << ret <<".\n"; break;
     }//switch
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }//if
-  DuskLog() << "MediaOggVorbis::MediaOggVorbis: Debug info: File \""<< PathToMedia
+  DuskLog() << "MediaOggVorbis::decode: Debug info: File \""<< PathToMedia
              << "\" opened properly.\n";
 
   vinfo = ov_info(&ov, -1);
-  DuskLog() <<"MediaOggVorbis::MediaOggVorbis: Information for \""<<PathToMedia<<"\":\n";
+  DuskLog() <<"MediaOggVorbis::decode: Information for \""<<PathToMedia<<"\":\n";
   if (vinfo == NULL)
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: Warning: Could not get file "
+    DuskLog() << "MediaOggVorbis::decode: Warning: Could not get file "
               << "information for \"" << PathToMedia << "\".\n";
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }
 
   DuskLog() << "    Vorbis encoder version: " << vinfo->version <<"\n"
@@ -98,11 +140,11 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
 
   if ((vinfo->channels!=1) && (vinfo->channels!=2))
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: File \""<<PathToMedia<<"\" has "
+    DuskLog() << "MediaOggVorbis::decode: ERROR: File \""<<PathToMedia<<"\" has "
               <<vinfo->channels<< " audio channels, however only one (mono) or "
               << "two (stereo) are supported.\n";
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }
   time_total = ov_time_total(&ov, -1);
   if (time_total == OV_EINVAL)
@@ -117,10 +159,10 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
   pcm_samples = ov_pcm_total(&ov, -1);
   if (pcm_samples == OV_EINVAL)
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: Couldn't get total sample count"
+    DuskLog() << "MediaOggVorbis::decode: ERROR: Couldn't get total sample count"
               <<" for stream. Stream does not exist or is unseekable.\n";
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }
   DuskLog() << "    PCM samples: "<<pcm_samples<<" samples.\n";
 
@@ -131,16 +173,21 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
 
   if ((data_size>MaxMediaSize_MB*1024*1024)/*MaxMediaSize_MB MB (currently 30 MB)*/ || (data_size<=0))
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: Size of uncompressed stream "
+    DuskLog() << "MediaOggVorbis::decode: ERROR: Size of uncompressed stream "
               << "from file \""<<PathToMedia<<"\" would be larger than "
               << MaxMediaSize_MB << " MB. Aborting to avoid abusive memory "
               << "allocation.\n";
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }
 
-  char * buffer = new char[data_size];
-  DuskLog() << "MediaOggVorbis::MediaOggVorbis: Debug: "<<data_size<<" bytes allocated "
+  result.channels = vinfo->channels;
+  result.bitsPerSample = 16;
+  result.sampleRate = vinfo->rate;
+  result.clear();
+  std::vector<char>& buffer = result.data;
+  buffer.resize(data_size);
+  DuskLog() << "MediaOggVorbis::decode: Debug: "<<data_size<<" bytes allocated "
               <<"for uncompressed data from file \""<<PathToMedia<<"\".\n";
   section = 0;
   total_read = 0;
@@ -152,7 +199,7 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
                          1 /*signed data*/, &section);
     if (bytes_read<0)
     {
-      DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR while reading from file \""
+      DuskLog() << "MediaOggVorbis::decode: ERROR while reading from file \""
                 << PathToMedia << "\".\n";
       switch(bytes_read)
       {
@@ -175,103 +222,29 @@ MediaOggVorbis::MediaOggVorbis(const std::string& identifier, const std::string&
 
   if (bytes_read<0)
   {
-    delete[] buffer;
+    result.clear();
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }
-  DuskLog() << "MediaOggVorbis::MediaOggVorbis: Debug: "<<total_read<<" bytes read, "
+  DuskLog() << "MediaOggVorbis::decode: Debug: "<<total_read<<" bytes read, "
             <<data_size<<" bytes were assumed.\n";
   if (total_read!=data_size)
   {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR: Size miscalculations in file \""
+    DuskLog() << "MediaOggVorbis::decode: ERROR: Size miscalculations in file \""
                 << PathToMedia << "\". Read "<<total_read<<" bytes, but assumed"
                 <<" "<<data_size<<" bytes. Aborting.\n";
-    delete[] buffer;
+    result.clear();
     ov_clear(&ov);
-    throw MediaCreationException();
+    return false;
   }//if
 
-  //all is read, now pass it to OpenAL
-  ALenum format;
-  if (vinfo->channels==2)
-  {
-    format = AL_FORMAT_STEREO16;
-  }
-  else
-  {
-    format = AL_FORMAT_MONO16;
-  }
-
-  //initialise media's values
-  m_Name = identifier;
-  m_FileName = PathToMedia;
-  num_buffers = 1;
-  buffers = NULL;
-  attached_to.clear();
-
-  //allocate memory for ALuint variable
-  buffers = (ALuint*) malloc(sizeof(ALuint));
-  alGetError();//clear error state
-  alGenBuffers(1, buffers);
-  ALenum error_state = alGetError();
-  if (error_state !=AL_NO_ERROR) //error occured
-  {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR while generating buffers for \""
-              <<PathToMedia<<"\".\n";
-    switch (error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The provided buffer array is not large enough to "
-                     << "hold the requested number of buffers.\n";
-           break;
-      case AL_OUT_OF_MEMORY:
-           DuskLog() << "    Not enough memory to generate the buffers.\n";
-           break;
-      default:
-           DuskLog()<<"    Unknown error occured. Error code: "
-                    <<(int)error_state<<".\n"; break;
-    }//swi
-    ov_clear(&ov);
-    delete[] buffer;
-    alDeleteBuffers(1, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }
-
-  error_state = alGetError();//clear error state
-  alBufferData(buffers[0], format, buffer, data_size, vinfo->rate);
-  error_state = alGetError();
-  if (error_state !=AL_NO_ERROR) //error occured
-  {
-    DuskLog() << "MediaOggVorbis::MediaOggVorbis: ERROR while filling buffers for \""
-              <<PathToMedia<<"\".\n";
-    switch (error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The provided buffer array size is not valid for "
-                     << "the given format, or the data pointer is NULL.\n";
-           break;
-      case AL_OUT_OF_MEMORY:
-           DuskLog() << "    Not enough memory to generate the buffers.\n";
-           break;
-      case AL_INVALID_ENUM:
-           DuskLog() << "    The specified format does not exist.\n"; break;
-      default:
-           DuskLog()<<"    Unknown error occured. Error code: "
-                    <<(int)error_state<<".\n"; break;
-    }//swi
-    ov_clear(&ov);
-    delete[] buffer;
-    alDeleteBuffers(1, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }
-
-  //finally, we are through
-  delete[] buffer;
+  //all is read, OpenAL buffers are created by the caller (one buffer)
+  result.offset = 0;
+  result.length = data_size;
+  result.chunkSize = 0;
   ov_clear(&ov);
+  timer.setBytes(data_size);
+  return true;
 }
 
 } //namespace
@@ -36,6 +36,37 @@ class MediaOggVorbis: public Media
            PathToMedia - path to the Ogg Vorbis file
     */
     MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia);
+
+    /* constructor for data that was already decoded by decode()
+
+       parameters:
+           identifier  - unique identifier
+           PathToMedia - path to the Ogg Vorbis file
+           pcm         - the decoded data of the file
+    */
+    MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia, const DecodedMedia& pcm);
+
+    /* constructor for a media that shares the buffers of another media which
+       was created from the same file
+
+       parameters:
+           identifier  - unique identifier
+           PathToMedia - path to the Ogg Vorbis file
+           shared      - the buffers of the other media
+    */
+    MediaOggVorbis(const std::string& identifier, const std::string& PathToMedia, const std::shared_ptr<MediaBuffers>& shared);
+
+    /* reads the file again and creates new buffers, returns true on success */
+    virtual bool reload();
+
+    /* Decodes the Ogg Vorbis file PathToMedia completely into result and
+       returns true on success, false on failure.
+
+       remarks:
+           This function does not use OpenAL, so it may be called from any
+           thread.
+    */
+    static bool decode(const std::string& PathToMedia, DecodedMedia& result);
 }; //class MediaOggVorbis
 
 } //namespace
@@ -0,0 +1,458 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "MediaOggVorbisStream.h"
+#include "../Messages.h"
+#include "SoundStatistics.h"
+#include <cstdio>
+
+namespace Dusk
+{
+
+const unsigned int MediaOggVorbisStream::cStreamBufferCount = 4;
+const unsigned int MediaOggVorbisStream::cStreamBufferSize = 64*1024;
+
+MediaOggVorbisStream::MediaOggVorbisStream(const std::string& identifier, const std::string& PathToMedia)
+: Media(identifier, PathToMedia),
+  m_Format(AL_FORMAT_MONO16),
+  m_Rate(0),
+  m_Duration(0.0f),
+  m_Idle(std::vector<ALuint>()),
+  m_Ready(std::deque<std::vector<char> >()),
+  m_EndOfStream(true), //decoder stays idle until the first rewind()
+  m_Quit(false),
+  m_Generation(0),
+  m_Loop(false)
+{
+  FILE * dat = fopen(PathToMedia.c_str(), "rb");
+  if (dat==NULL)
+  {
+    DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: ERROR: Could not "
+              << "open file \"" << PathToMedia << "\" via fopen properly.\n";
+    throw MediaCreationException();
+  }//if
+
+  //the file stays open as long as the stream exists, ov_clear() closes it
+  const int ret = ov_open_callbacks(dat, &m_File, NULL, 0, OV_CALLBACKS_DEFAULT);
+  if (ret<0)
+  {
+    DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: ERROR: Could not "
+              << "open file \"" << PathToMedia << "\" via callbacks properly.\n";
+    switch(ret)
+    {
+      case OV_EREAD:
+           DuskLog() << "    A read from the media returned an error.\n"; break;
+      case OV_ENOTVORBIS:
+           DuskLog() << "    Bitstream does not contain any Vorbis data.\n";
+           break;
+      case OV_EVERSION:
+           DuskLog() << "    Version mismatch.\n"; break;
+      case OV_EBADHEADER:
+           DuskLog() << "    Invalid Vorbis header.\n"; break;
+      case OV_EFAULT:
+           DuskLog() << "    Internal logic error/ bug.\n"; break;
+      default:
+           DuskLog() << "    Unknown error. Code: " << ret <<".\n"; break;
+    }//switch
+    //ov_open_callbacks() does not close the file on failure
+    fclose(dat);
+    throw MediaCreationException();
+  }//if
+
+  vorbis_info * vinfo = ov_info(&m_File, -1);
+  if (vinfo == NULL)
+  {
+    DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: ERROR: Could not "
+              << "get file information for \"" << PathToMedia << "\".\n";
+    ov_clear(&m_File);
+    throw MediaCreationException();
+  }
+  if ((vinfo->channels!=1) && (vinfo->channels!=2))
+  {
+    DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: ERROR: File \""
+              << PathToMedia << "\" has " << vinfo->channels << " audio "
+              << "channels, however only one (mono) or two (stereo) are "
+              << "supported.\n";
+    ov_clear(&m_File);
+    throw MediaCreationException();
+  }
+  if (ov_seekable(&m_File)==0)
+  {
+    DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: ERROR: Stream of "
+              << "file \"" << PathToMedia << "\" is not seekable.\n";
+    ov_clear(&m_File);
+    throw MediaCreationException();
+  }
+  m_Format = (vinfo->channels==2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+  m_Rate = vinfo->rate;
+  m_Duration = static_cast<float>(ov_time_total(&m_File, -1));
+  if (m_Duration<0.0f)
+  {
+    //OV_EINVAL - should not happen for a seekable stream
+    m_Duration = 0.0f;
+  }
+
+  //generate the buffers of the queue
+  try
+  {
+    m_Buffers.reset(new MediaBuffers(cStreamBufferCount, PathToMedia));
+  }
+  catch (...)
+  {
+    ov_clear(&m_File);
+    throw;
+  }
+
+  DuskLog() << "MediaOggVorbisStream::MediaOggVorbisStream: Debug info: File \""
+            << PathToMedia << "\" opened for streaming ("<< vinfo->channels
+            << " channel(s), " << m_Rate << " Hz).\n";
+  m_Decoder = std::thread(&MediaOggVorbisStream::decodeLoop, this);
+}
+
+MediaOggVorbisStream::~MediaOggVorbisStream()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    m_Quit = true;
+  }
+  m_Wake.notify_all();
+  if (m_Decoder.joinable())
+  {
+    m_Decoder.join();
+  }
+  ov_clear(&m_File);
+  //buffers are deleted by MediaBuffers
+}
+
+bool MediaOggVorbisStream::isStreaming() const
+{
+  return true;
+}
+
+float MediaOggVorbisStream::getDuration() const
+{
+  return m_Duration;
+}
+
+void MediaOggVorbisStream::setLooping(const bool doLoop)
+{
+  m_Loop = doLoop;
+}
+
+bool MediaOggVorbisStream::isLooping() const
+{
+  return m_Loop;
+}
+
+bool MediaOggVorbisStream::rewind(const ALuint sourceID)
+{
+  //remove all buffers from the source - after stopping, all are processed
+  alGetError();//clear error state
+  alSourceStop(sourceID);
+  ALint queued = 0;
+  alGetSourcei(sourceID, AL_BUFFERS_QUEUED, &queued);
+  if (queued>0)
+  {
+    std::vector<ALuint> unqueued(queued, 0);
+    alSourceUnqueueBuffers(sourceID, queued, &unqueued[0]);
+  }
+  ALenum error_state = alGetError();
+  if (error_state != AL_NO_ERROR)
+  {
+    DuskLog() << "MediaOggVorbisStream::rewind: ERROR: Could not clear the "
+              << "buffer queue of the source for media \"" << m_Name
+              << "\". Error code: " << (int)error_state << ".\n";
+    return false;
+  }
+  m_Idle.clear();
+
+  std::vector<ALuint> filled;
+  bool endReached = false;
+  {
+    std::lock_guard<std::mutex> fileLock(m_FileMutex);
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      m_Ready.clear();
+      m_EndOfStream = false;
+      ++m_Generation;
+    }
+    if (ov_pcm_seek(&m_File, 0)!=0)
+    {
+      DuskLog() << "MediaOggVorbisStream::rewind: ERROR: Could not seek to "
+                << "the beginning of file \"" << m_FileName << "\".\n";
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      m_EndOfStream = true;
+      return false;
+    }
+    //decode the first buffers right here, so that playback can start at once
+    std::vector<char> chunk;
+    const ALuint * buffers = getBufferPointer();
+    ALuint i;
+    for (i=0; i<getNumberOfBuffers(); ++i)
+    {
+      chunk.clear();
+      if (!endReached and !decodeChunk(chunk, endReached))
+      {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_EndOfStream = true;
+        return false;
+      }
+      if (chunk.empty())
+      {
+        m_Idle.push_back(buffers[i]);
+      }
+      else
+      {
+        if (!uploadChunk(buffers[i], chunk))
+          return false;
+        filled.push_back(buffers[i]);
+      }
+    }//for
+    if (endReached)
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      m_EndOfStream = true;
+    }
+  }
+  if (filled.empty())
+  {
+    DuskLog() << "MediaOggVorbisStream::rewind: ERROR: File \"" << m_FileName
+              << "\" does not contain any audio data.\n";
+    return false;
+  }
+
+  alSourceQueueBuffers(sourceID, filled.size(), &filled[0]);
+  error_state = alGetError();
+  if (error_state != AL_NO_ERROR)
+  {
+    DuskLog() << "MediaOggVorbisStream::rewind: ERROR: Could not queue the "
+              << "buffers of media \"" << m_Name << "\". Error code: "
+              << (int)error_state << ".\n";
+    return false;
+  }
+  //let the decoder work ahead
+  m_Wake.notify_one();
+  return true;
+}
+
+bool MediaOggVorbisStream::refill(const ALuint sourceID, ALint& queued)
+{
+  alGetError();//clear error state
+  ALint processed = 0;
+  alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed);
+  if (processed>0)
+  {
+    std::vector<ALuint> unqueued(processed, 0);
+    alSourceUnqueueBuffers(sourceID, processed, &unqueued[0]);
+    m_Idle.insert(m_Idle.end(), unqueued.begin(), unqueued.end());
+  }
+  ALenum error_state = alGetError();
+  if (error_state != AL_NO_ERROR)
+  {
+    DuskLog() << "MediaOggVorbisStream::refill: ERROR: Could not unqueue "
+              << "processed buffers of media \"" << m_Name << "\". Error code: "
+              << (int)error_state << ".\n";
+    return false;
+  }
+
+  std::vector<char> chunk;
+  bool took_chunk = false;
+  while (!m_Idle.empty())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      if (m_Ready.empty())
+        break;
+      chunk.swap(m_Ready.front());
+      m_Ready.pop_front();
+    }
+    took_chunk = true;
+    if (!uploadChunk(m_Idle.back(), chunk))
+      return false;
+    alSourceQueueBuffers(sourceID, 1, &m_Idle.back());
+    error_state = alGetError();
+    if (error_state != AL_NO_ERROR)
+    {
+      DuskLog() << "MediaOggVorbisStream::refill: ERROR: Could not queue "
+                << "buffer of media \"" << m_Name << "\". Error code: "
+                << (int)error_state << ".\n";
+      return false;
+    }
+    m_Idle.pop_back();
+  }//while
+  if (took_chunk)
+  {
+    //there is room for more decoded data now
+    m_Wake.notify_one();
+  }
+
+  queued = 0;
+  alGetSourcei(sourceID, AL_BUFFERS_QUEUED, &queued);
+  return (alGetError() == AL_NO_ERROR);
+}
+
+bool MediaOggVorbisStream::hasEnded() const
+{
+  std::lock_guard<std::mutex> lock(m_QueueMutex);
+  return (m_EndOfStream and m_Ready.empty());
+}
+
+void MediaOggVorbisStream::decodeLoop()
+{
+  std::vector<char> chunk;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_QueueMutex);
+      while (!m_Quit and (m_EndOfStream or (m_Ready.size()>=cStreamBufferCount)))
+      {
+        m_Wake.wait(lock);
+      }
+      if (m_Quit)
+        return;
+    }
+
+    bool endReached = false;
+    bool success = false;
+    unsigned int generation = 0;
+    {
+      std::lock_guard<std::mutex> fileLock(m_FileMutex);
+      {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        generation = m_Generation;
+      }
+      SoundStatistics::Timer timer(SoundStatistics::opDecode);
+      success = decodeChunk(chunk, endReached);
+      timer.setBytes(chunk.size());
+    }
+
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    if (generation!=m_Generation)
+    {
+      //stream was rewound while decoding, so the data is outdated
+      continue;
+    }
+    if (!success)
+    {
+      //error was already logged, stop decoding until the next rewind
+      m_EndOfStream = true;
+      continue;
+    }
+    if (!chunk.empty())
+    {
+      m_Ready.push_back(std::vector<char>());
+      m_Ready.back().swap(chunk);
+    }
+    if (endReached)
+    {
+      m_EndOfStream = true;
+    }
+  }//while
+}
+
+bool MediaOggVorbisStream::decodeChunk(std::vector<char>& chunk, bool& endOfStream)
+{
+  chunk.resize(cStreamBufferSize);
+  endOfStream = false;
+  unsigned int total_read = 0;
+  bool justRewound = false;
+  int section = 0;
+  while (total_read<cStreamBufferSize)
+  {
+    const long int bytes_read = ov_read(&m_File, &chunk[total_read],
+                                   cStreamBufferSize-total_read /*buffer length*/,
+                                   0 /*little endian*/, 2 /*16 bit data*/,
+                                   1 /*signed data*/, &section);
+    if (bytes_read<0)
+    {
+      DuskLog() << "MediaOggVorbisStream::decodeChunk: ERROR while reading "
+                << "from file \"" << m_FileName << "\".\n";
+      switch(bytes_read)
+      {
+        case OV_HOLE:
+             DuskLog() << "    Interruption in data stream.\n"; break;
+        case OV_EBADLINK:
+             DuskLog() << "    Invalid stream section supplied.\n"; break;
+        case OV_EINVAL:
+             DuskLog() << "    File headers couldn't be read or are corrupt; or"
+                       << " open call for supplied file failed.\n"; break;
+        default:
+             DuskLog() << "    Unknown error code: "<<bytes_read<<".\n"; break;
+      }//switch
+      chunk.resize(total_read);
+      return false;
+    }//if
+    if (bytes_read==0)
+    {
+      //end of file - start over, if looping (but not for empty streams)
+      if (!m_Loop or justRewound)
+      {
+        endOfStream = true;
+        break;
+      }
+      if (ov_pcm_seek(&m_File, 0)!=0)
+      {
+        DuskLog() << "MediaOggVorbisStream::decodeChunk: ERROR: Could not seek "
+                  << "to the beginning of file \"" << m_FileName << "\".\n";
+        chunk.resize(total_read);
+        return false;
+      }
+      justRewound = true;
+    }
+    else
+    {
+      total_read = total_read + bytes_read;
+      justRewound = false;
+    }
+  }//while
+  chunk.resize(total_read);
+  return true;
+}
+
+bool MediaOggVorbisStream::uploadChunk(const ALuint buffer, const std::vector<char>& chunk)
+{
+  alGetError();//clear error state
+  alBufferData(buffer, m_Format, &chunk[0], chunk.size(), m_Rate);
+  const ALenum error_state = alGetError();
+  if (error_state != AL_NO_ERROR)
+  {
+    DuskLog() << "MediaOggVorbisStream::uploadChunk: ERROR while filling buffer"
+              << " of media \"" << m_Name << "\".\n";
+    switch (error_state)
+    {
+      case AL_INVALID_VALUE:
+           DuskLog() << "    The provided buffer size is not valid for the "
+                     << "given format, or the data pointer is NULL.\n";
+           break;
+      case AL_OUT_OF_MEMORY:
+           DuskLog() << "    Not enough memory to fill the buffer.\n";
+           break;
+      case AL_INVALID_ENUM:
+           DuskLog() << "    The specified format does not exist.\n"; break;
+      default:
+           DuskLog()<<"    Unknown error occured. Error code: "
+                    <<(int)error_state<<".\n"; break;
+    }//swi
+    return false;
+  }
+  return true;
+}
+
+} //namespace
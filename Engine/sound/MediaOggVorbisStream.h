@@ -0,0 +1,158 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#ifndef SOUND_MEDIAOGGVORBISSTREAM_H_INCLUDED
+#define SOUND_MEDIAOGGVORBISSTREAM_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "Media.h"
+
+#if defined(_WIN32)
+  #include "oggvorbis/vorbisfile.h" //Vorbis header
+#elif defined(__linux__) || defined(linux)
+  #include <vorbis/vorbisfile.h> //Vorbis header
+#else
+  #error "Unknown operating system!"
+#endif
+
+namespace Dusk
+{
+
+/* class MediaOggVorbisStream:
+       Ogg Vorbis media that is not decoded completely at creation time, but
+       streamed instead. Only a few small AL buffers exist, which are rotated
+       through the queue of the source: a background thread decodes the next
+       chunks of the file in advance, and refill() (called regularly by the
+       audio thread, see AudioThread) unqueues processed buffers, fills them
+       with the decoded data and queues them again. Memory usage is therefore
+       constant and independent of the length of the file, which makes this
+       media type suitable for music and long ambient sounds.
+
+       remarks:
+           Since the buffer queue belongs to the source, a streamed media can
+           only be attached to one source at a time.
+           Source offsets (Source::setOffset(), Source::getOffset()) are
+           relative to the currently queued buffers, not to the whole file.
+*/
+class MediaOggVorbisStream: public Media
+{
+  public:
+    /* constructor
+
+       parameters:
+           identifier  - unique identifier
+           PathToMedia - path to the Ogg Vorbis file
+    */
+    MediaOggVorbisStream(const std::string& identifier, const std::string& PathToMedia);
+
+    /* destructor */
+    virtual ~MediaOggVorbisStream();
+
+    /* number of AL buffers in the queue of a streamed media */
+    static const unsigned int cStreamBufferCount;
+
+    /* size of a single streaming buffer in bytes */
+    static const unsigned int cStreamBufferSize;
+
+    /* returns true, because this media streams its data */
+    virtual bool isStreaming() const;
+
+    /* returns the playing time of the whole file in seconds */
+    virtual float getDuration() const;
+
+    /* sets whether the stream starts over at the beginning when it reaches the
+       end of the file
+
+       remarks:
+           Streamed media cannot use AL_LOOPING, because that would only loop
+           the buffers which are currently queued.
+    */
+    void setLooping(const bool doLoop);
+
+    /* returns true, if the stream starts over when it reaches the end */
+    bool isLooping() const;
+
+    /* Stops the source, removes all buffers from its queue, restarts decoding
+       at the beginning of the file and queues the first buffers. Returns true
+       on success, false on failure.
+
+       parameters:
+           sourceID - AL name of the source the media is attached to
+    */
+    bool rewind(const ALuint sourceID);
+
+    /* Unqueues all processed buffers from the source, fills them with the
+       data that was decoded in the background and queues them again. Returns
+       true on success, false on failure.
+
+       parameters:
+           sourceID - AL name of the source the media is attached to
+           queued   - receives the number of buffers that are queued at the
+                      source after the refill
+    */
+    bool refill(const ALuint sourceID, ALint& queued);
+
+    /* returns true, if the whole file has been decoded and all decoded data
+       has been handed to OpenAL
+    */
+    bool hasEnded() const;
+  private:
+    /* empty copy constructor - copying a stream is not allowed */
+    MediaOggVorbisStream(const MediaOggVorbisStream& op);
+
+    /* main function of the decoder thread */
+    void decodeLoop();
+
+    /* Decodes up to cStreamBufferSize bytes of PCM data into chunk and returns
+       true on success. endOfStream will be set to true, if the end of the file
+       was reached (and looping is off).
+
+       remarks:
+           The caller has to hold m_FileMutex.
+    */
+    bool decodeChunk(std::vector<char>& chunk, bool& endOfStream);
+
+    /* copies the data of chunk into the AL buffer and returns true on success */
+    bool uploadChunk(const ALuint buffer, const std::vector<char>& chunk);
+
+    OggVorbis_File m_File;
+    ALenum m_Format;
+    long int m_Rate;
+    float m_Duration; //playing time of the whole file in seconds
+    std::vector<ALuint> m_Idle; //unqueued buffers which still need new data
+
+    std::mutex m_FileMutex; //guards m_File
+    mutable std::mutex m_QueueMutex; //guards m_Ready, m_EndOfStream, m_Generation and m_Quit
+    std::condition_variable m_Wake;
+    std::deque<std::vector<char> > m_Ready; //decoded chunks, not uploaded yet
+    bool m_EndOfStream;
+    bool m_Quit;
+    unsigned int m_Generation; //incremented on every rewind
+    std::atomic<bool> m_Loop;
+    std::thread m_Decoder;
+}; //class MediaOggVorbisStream
+
+} //namespace
+
+#endif // SOUND_MEDIAOGGVORBISSTREAM_H_INCLUDED
@@ -19,151 +19,226 @@
 */
 
 #include "MediaWave.h"
-#include <fstream>
-#include <cstdlib>
+#include <cstring>
+#include "../MappedFile.h"
 #include "../Messages.h"
+#include "SoundStatistics.h"
 
 namespace Dusk
 {
 
 MediaWave::MediaWave(const std::string& identifier, const std::string& PathToMedia)
 : Media(identifier, PathToMedia)
+{
+  DecodedMedia pcm;
+  if (!decode(PathToMedia, pcm))
+  {
+    throw MediaCreationException();
+  }
+  createBuffers(pcm);
+}
+
+MediaWave::MediaWave(const std::string& identifier, const std::string& PathToMedia, const DecodedMedia& pcm)
+: Media(identifier, PathToMedia)
+{
+  createBuffers(pcm);
+}
+
+MediaWave::MediaWave(const std::string& identifier, const std::string& PathToMedia, const std::shared_ptr<MediaBuffers>& shared)
+: Media(identifier, PathToMedia)
+{
+  m_Buffers = shared;
+}
+
+bool MediaWave::reload()
+{
+  DecodedMedia pcm;
+  if (!decode(m_FileName, pcm))
+  {
+    return false;
+  }
+  try
+  {
+    createBuffers(pcm);
+  }
+  catch (...)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool MediaWave::decode(const std::string& PathToMedia, DecodedMedia& result)
 {
   TRiffChunk riff_c;
-  TFmtChunk fmt_c;
-  TDataChunk data_c;
-  std::ifstream dat;
-  char * temp;
+  TFmtChunk fmt_c = TFmtChunk();
+  TDataChunk data_c = TDataChunk();
+  SoundStatistics::Timer timer(SoundStatistics::opDecode);
 
-  dat.open(PathToMedia.c_str(), std::ios::in | std::ios::binary);
-  if(!dat)
+  //map the file, the PCM data will be used in place
+  std::shared_ptr<MappedFile> file(new MappedFile);
+  if (!file->open(PathToMedia))
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: Unable to open stream for reading.\n"
+    DuskLog() << "MediaWave::decode: ERROR: Unable to map file for reading.\n"
               << "       File: \"" <<PathToMedia<<"\".\n\n";
-    throw MediaCreationException();
+    return false;
+  }
+  const char * const base = file->data();
+  const std::size_t file_size = file->size();
+  if (file_size<12)
+  {
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia<<"\" is too "
+              <<"short to be a Wave file.\n";
+    return false;
   }
-  dat.read(riff_c.Riff, 4); // "RIFF"
+
+  memcpy(riff_c.Riff, base, 4); // "RIFF"
   if ((riff_c.Riff[0]!='R') || (riff_c.Riff[1]!='I') || (riff_c.Riff[2]!='F')
        || (riff_c.Riff[3]!='F'))
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: File \""<<PathToMedia<<"\" has incorrect"
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia<<"\" has incorrect"
               <<" RIFF header.\n";
-    dat.close();
-    throw MediaCreationException();
+    return false;
   }
-  dat.read((char*) &(riff_c.len), 4); //file size - 8 (in Bytes)
-  dat.read(riff_c.Wave, 4); // "WAVE"
+  memcpy(&(riff_c.len), base+4, 4); //file size - 8 (in Bytes)
+  memcpy(riff_c.Wave, base+8, 4); // "WAVE"
   if ((riff_c.Wave[0]!='W') || (riff_c.Wave[1]!='A') || (riff_c.Wave[2]!='V')
        || (riff_c.Wave[3]!='E'))
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: File \""<<PathToMedia<<"\" has incorrect"
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia<<"\" has incorrect"
               <<" WAVE header.\n";
-    dat.close();
-    throw MediaCreationException();
+    return false;
   }
-  //Format chunk
-  dat.read(fmt_c.fmt_, 4); // "fmt "
-  if ((fmt_c.fmt_[0]!='f') || (fmt_c.fmt_[1]!='m') || (fmt_c.fmt_[2]!='t')
-       || (fmt_c.fmt_[3]!=' '))
+
+  //walk through the chunks: format chunk has to come before the data chunk,
+  // all other chunks (e.g. "LIST") are skipped
+  bool hasFormat = false;
+  bool hasData = false;
+  std::size_t data_offset = 0;
+  std::size_t pos = 12;
+  while (!hasData && (file_size-pos>=8))
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: File \""<<PathToMedia
-              <<"\" has incorrect format chunk header signature.\n";
-    dat.close();
-    throw MediaCreationException();
-  }
-  dat.read((char*) &(fmt_c.chunk_size), 4); //should have value of exactly 16
-  //In case the format chunk is larger than that, everything after the 16th byte
-  // will be ignored.
-  if (fmt_c.chunk_size<16)
+    char chunk_id[4];
+    uint32_t chunk_size;
+    memcpy(chunk_id, base+pos, 4);
+    memcpy(&chunk_size, base+pos+4, 4);
+    pos = pos + 8;
+    if (memcmp(chunk_id, "fmt ", 4)==0)
+    {
+      memcpy(fmt_c.fmt_, chunk_id, 4);
+      fmt_c.chunk_size = chunk_size; //should have value of exactly 16
+      //In case the format chunk is larger than that, everything after the
+      // 16th byte will be ignored.
+      if ((fmt_c.chunk_size<16) || (fmt_c.chunk_size>file_size-pos))
+      {
+        DuskLog() << "MediaWave::decode: ERROR: Format chunk of file \""
+                  <<PathToMedia<<"\" has incorrect size of "<<fmt_c.chunk_size
+                  <<" bytes. (Should be 16 instead.)\n";
+        return false;
+      }
+      else if (fmt_c.chunk_size>16)
+      {
+        DuskLog() << "MediaWave::decode: Warning: Format chunk of file \""
+                  <<PathToMedia<<"\" is larger than 16 bytes. Actual size is "
+                  <<fmt_c.chunk_size<<" bytes. Everything after 16th byte will "
+                  <<"be ignored.\n";
+      }
+      memcpy(&(fmt_c.FormatTag), base+pos, 2); //should have value of 1 for PCM
+      memcpy(&(fmt_c.Channels), base+pos+2, 2);  // 1 for mono, 2 for stereo
+      memcpy(&(fmt_c.SamplesPerSecond), base+pos+4, 4);
+      memcpy(&(fmt_c.BytesPerSecond), base+pos+8, 4);
+      memcpy(&(fmt_c.BlockAlign), base+pos+12, 2);
+      memcpy(&(fmt_c.BitsPerSample), base+pos+14, 2);
+      hasFormat = true;
+    }
+    else if (memcmp(chunk_id, "data", 4)==0)
+    {
+      if (!hasFormat)
+      {
+        DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia
+                  <<"\" has its data chunk before the format chunk.\n";
+        return false;
+      }
+      memcpy(data_c.data, chunk_id, 4);
+      data_c.length_of_data = chunk_size; //Lnge des folgenden Datenblocks
+      data_offset = pos;
+      hasData = true;
+      break;
+    }
+    //skip chunk; chunks are padded to an even number of bytes
+    const std::size_t skip = chunk_size + (chunk_size & 1);
+    if (skip>file_size-pos)
+      break;
+    pos = pos + skip;
+  }//while
+  if (!hasFormat)
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: Format chunk of file \""
-              <<PathToMedia<<"\" has incorrect size of "<<fmt_c.chunk_size
-              <<" bytes. (Should be 16 instead.)\n";
-    dat.close();
-    throw MediaCreationException();
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia
+              <<"\" has no format chunk.\n";
+    return false;
   }
-  else if (fmt_c.chunk_size>16)
+  if (!hasData)
   {
-    DuskLog() << "MediaWave::MediaWave: Warning: Format chunk of file \""
-              <<PathToMedia<<"\" is larger than 16 bytes. Actual size is "
-              <<fmt_c.chunk_size<<" bytes. Everything after 16th byte will be "
-              <<"ignored.\n";
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia
+              <<"\" has no data chunk.\n";
+    return false;
   }
-  dat.read((char*) &(fmt_c.FormatTag), 2); //should have value of 1 for PCM
-                                        //(this is what we have for typical .wav)
+
   if (fmt_c.FormatTag!=1)
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: File \""<<PathToMedia<<"\" is "
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia<<"\" is "
               << "not of PCM format. Format index: " <<fmt_c.FormatTag<<".\n";
-    dat.close();
-    throw MediaCreationException();
+    return false;
   }
-  dat.read((char*) &(fmt_c.Channels), 2);  // 1 for mono, 2 for stereo
-  dat.read((char*) &(fmt_c.SamplesPerSecond), 4);
-  dat.read((char*) &(fmt_c.BytesPerSecond), 4);
-  dat.read((char*) &(fmt_c.BlockAlign), 2);
-  dat.read((char*) &(fmt_c.BitsPerSample), 2);
-
-  //for larger format chunks: read rest of chunk into temp buffer and discard it
-  if (fmt_c.chunk_size > 16)
+  //check channels and bits per sample - OpenAL only knows some of them
+  if ((fmt_c.Channels!=1) && (fmt_c.Channels!=2) && (fmt_c.Channels!=4))
   {
-    //check for size, again, to avoid to allocate immense amount of memory
-    if (fmt_c.chunk_size <= 1024)
-    {
-      temp = (char*) malloc(fmt_c.chunk_size -16);
-      dat.read(temp, fmt_c.chunk_size -16);
-      free(temp);
-    }
-    else //chunk is larger than 1 KB; quite unnormal
-    {
-      DuskLog() << "MediaWave::MediaWave: ERROR: Format chunk is much too big ("
-                << fmt_c.chunk_size << " bytes). Exiting.\n";
-      dat.close();
-      throw MediaCreationException();
-    }
-  }//if
-
-  //read the data chunk
-  dat.read(data_c.data, 4); // "data"
-  if ((data_c.data[0]!='d') || (data_c.data[1]!='a') || (data_c.data[2]!='t')
-       || (data_c.data[3]!='a'))
+    DuskLog() << "MediaWave::decode: ERROR: File \"" <<PathToMedia
+              <<"\" seems to have "<<fmt_c.Channels<<" channels. However, "
+              <<"only four, two (stereo) or one (mono) channels are "
+              <<"supported.\n";
+    return false;
+  }
+  if ((fmt_c.BitsPerSample!=16) && (fmt_c.BitsPerSample!=8))
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: File \""<<PathToMedia
-              <<"\" has incorrect data chunk header signature.\n";
-    dat.close();
-    throw MediaCreationException();
+    DuskLog() << "MediaWave::decode: ERROR: The sample rate of \""
+              <<PathToMedia<<"\" ("<<fmt_c.BitsPerSample<< " bits per sample) "
+              <<"is not supported. OpenAL supports only 8 and 16 bit samples.\n";
+    return false;
+  }
+  if (fmt_c.BlockAlign==0)
+  {
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia
+              << "\" has a block align of zero.\n";
+    return false;
   }
-  dat.read((char*) &(data_c.length_of_data), 4); //Lnge des folgenden Datenblocks
-                                                 //bzw. der restlichen Datei
 
   //check if data length is valid
   if (data_c.length_of_data<fmt_c.BlockAlign)
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: Data chunk of file \""<<PathToMedia
+    DuskLog() << "MediaWave::decode: ERROR: Data chunk of file \""<<PathToMedia
               << "\" is too short to contain valid data. Exiting.\n";
-    dat.close();
-    throw MediaCreationException();
+    return false;
+  }
+  if (data_c.length_of_data>file_size-data_offset)
+  {
+    DuskLog() << "MediaWave::decode: ERROR: File \""<<PathToMedia<<"\" is "
+              << "shorter than its data chunk claims.\n";
+    return false;
   }
 
   //length check for high bound
   if (data_c.length_of_data>MaxMediaSize_MB*1024*1024)
   {
-    DuskLog() << "MediaWave::MediaWave: ERROR: Size of PCM data from file \""
+    DuskLog() << "MediaWave::decode: ERROR: Size of PCM data from file \""
               <<PathToMedia<<"\" would be larger than "<< MaxMediaSize_MB
               << " MB. Aborting to avoid abusive memory allocation.\n";
-    dat.close();
-    throw MediaCreationException();
+    return false;
   }//if
 
-  //for calculations of number and size of buffers
-  unsigned long buffer_size=0, buffer_num=0, i=0;
-  unsigned long last_buffer_size=0;
-  ALenum error_state;//return value from alGetError();
-  ALenum format_type;//format of data
-
   //Not sure about what is a good buffer size for WAVE/PCM file
   //Following line may need to be adjusted :?
-  buffer_size =  32* fmt_c.BlockAlign *1024;
+  unsigned long buffer_size =  32* fmt_c.BlockAlign *1024;
   //assure that buffer is not larger than amount of available data
   if (buffer_size>data_c.length_of_data)
   {
@@ -179,207 +254,18 @@ MediaWave::MediaWave(const std::string& identifier, const std::string& PathToMed
       buffer_size = fmt_c.BlockAlign;
     }
   }
-  last_buffer_size = buffer_size;
-
-  //determine number of buffers
-  buffer_num = data_c.length_of_data/ buffer_size;
-  if ((data_c.length_of_data % buffer_size)!=0)
-  {
-    buffer_num = buffer_num +1; //increase number of buffers
-    last_buffer_size = data_c.length_of_data % buffer_size; //size of last buffer
-                                                    //is diff. from regular size
-  }
-  //initialise values
-  m_Name = identifier;
-  m_FileName = PathToMedia;
-  num_buffers = buffer_num;
-  buffers = NULL;
-  //attached_to.clear();
-
-  //allocate memory for buffer_num ALuint variables
-  buffers = (ALuint*) malloc(sizeof(ALuint)*buffer_num);
-  alGetError();//clear error state
-  alGenBuffers(buffer_num, buffers);
-  error_state = alGetError();
-  if (error_state !=AL_NO_ERROR) //error occured
-  {
-    DuskLog() << "MediaWave::MediaWave: ERROR while generating buffers for \""
-              <<PathToMedia<<"\".\n";
-    switch (error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The provided buffer array is not large enough to "
-                     << "hold the requested number of buffers.\n";
-           break;
-      case AL_OUT_OF_MEMORY:
-           DuskLog() << "    Not enough memory to generate the buffers.\n";
-           break;
-      default:
-           DuskLog()<<"    Unknown error occured. Error code: "
-                    <<(int)error_state<<".\n";
-           break;
-    }//swi
-    dat.close();
-    alDeleteBuffers(buffer_num, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }
-
-  //determine format
-  if (fmt_c.BitsPerSample==16)
-  {
-    switch(fmt_c.Channels)
-    {
-      case 4:
-        format_type = alGetEnumValue("AL_FORMAT_QUAD16");
-        break;
-      case 2:
-        format_type = AL_FORMAT_STEREO16;
-        break;
-      case 1:
-        format_type = AL_FORMAT_MONO16;
-        break;
-      default:
-        DuskLog() << "MediaWave::MediaWave: ERROR: File \"" <<PathToMedia
-                  <<"\" seems to have "<<fmt_c.Channels<<" channels. However, "
-                  <<"only four, two (stereo) or one (mono) channels are "
-                  <<"supported.\n";
-        dat.close();
-        alDeleteBuffers(num_buffers, buffers);
-        free(buffers);
-        buffers = NULL;
-        throw MediaCreationException();
-        break; //pro forma :P
-    }//swi
-  }
-  else if (fmt_c.BitsPerSample==8)
-  {
-    switch(fmt_c.Channels)
-    {
-      case 4:
-        format_type = alGetEnumValue("AL_FORMAT_QUAD8");
-        break;
-      case 2:
-        format_type = AL_FORMAT_STEREO8;
-        break;
-      case 1:
-        format_type = AL_FORMAT_MONO8;
-        break;
-      default:
-        DuskLog() << "MediaWave::MediaWave: ERROR: File \"" <<PathToMedia
-                  <<"\" seems to have "<<fmt_c.Channels<<" channels. However, "
-                  <<"only four, two (stereo) or one (mono) channels are "
-                  <<"supported. Creation aborted.\n";
-        dat.close();
-        alDeleteBuffers(num_buffers, buffers);
-        free(buffers);
-        buffers = NULL;
-        throw MediaCreationException();
-    }//swi
-  }
-  else //Bits per Sample neither 16 nor 8, thus unsupported by OpenAL
-  {
-    DuskLog() << "MediaWave::MediaWave: ERROR: The sample rate of \""
-              <<PathToMedia<<"\" ("<<fmt_c.BitsPerSample<< " bits per sample) "
-              <<"is not supported. OpenAL supports only 8 and 16 bit samples.\n";
-    dat.close();
-    alDeleteBuffers(num_buffers, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }
-  //check for valid format enumeration value
-  if (format_type == 0) //call to alGetEnumValue could not get a proper result
-  {
-    DuskLog() << "MediaWave::MediaWave: ERROR: Could not find a valid OpenAL "
-              << "format enumeration value. Most likely the format of \""
-              <<PathToMedia<<"\" (channels: "<<fmt_c.Channels<<"; bits per sample: "
-              <<fmt_c.BitsPerSample<<") is not supported.\n";
-    dat.close();
-    alDeleteBuffers(num_buffers, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }
-
-  //now read the data into OpenAL buffers
-  temp = (char*) malloc(buffer_size);
-  for (i=0; i<buffer_num-1; i=i+1)
-  {
-    dat.read(temp, buffer_size);
-    alGetError(); //clear error state
-    alBufferData(buffers[i], format_type, temp, buffer_size, fmt_c.SamplesPerSecond);
-    error_state = alGetError();
-    if (error_state!= AL_NO_ERROR)
-    {
-      DuskLog() << "MediaWave::MediaWave: ERROR while buffering data.\n";
-      switch (error_state)
-      {
-        case AL_INVALID_ENUM:
-             DuskLog() <<"    The specified format does not exist.\n";
-             break;
-        case AL_INVALID_VALUE:
-             DuskLog() <<"    The size parameter is not valid for the given format"
-                       <<" or the buffer is already in use.\n";
-             break;
-        case AL_OUT_OF_MEMORY:
-             DuskLog() <<"    Not enough memory to create the buffer.\n";
-             break;
-        default:
-             DuskLog() <<"    Unknown error. Error code: "<<(int)error_state
-                       <<".\n";
-             break;
-      }//swi
-      dat.close();
-      free(temp);
-      //delete all previously generated buffers
-      alDeleteBuffers(num_buffers, buffers);
-      free(buffers);
-      buffers = NULL;
-      throw MediaCreationException();
-    }//if
-  }//for
-
-  //read last buffer
-  dat.read(temp, last_buffer_size);
-  alGetError(); //clear error state
-  alBufferData(buffers[buffer_num-1], format_type, temp, last_buffer_size, fmt_c.SamplesPerSecond);
-  error_state = alGetError();
-  if (error_state!= AL_NO_ERROR)
-  {
-    DuskLog() << "MediaWave::MediaWave: ERROR while buffering data.\n";
-    switch (error_state)
-    {
-      case AL_INVALID_ENUM:
-           DuskLog() <<"    The specified format does not exist.\n";
-           break;
-      case AL_INVALID_VALUE:
-           DuskLog() <<"    The size parameter is not valid for the given format"
-                     <<" or the buffer is already in use.\n";
-           break;
-      case AL_OUT_OF_MEMORY:
-           DuskLog() <<"    Not enough memory to create the buffer.\n";
-           break;
-      default:
-           DuskLog() <<"    Unknown error. Error code: "<<(int)error_state<<".\n";
-           break;
-    }//swi
-    dat.close();
-    free(temp);
-    //delete all previously generated buffers
-    alDeleteBuffers(num_buffers, buffers);
-    free(buffers);
-    buffers = NULL;
-    throw MediaCreationException();
-  }//if
-  else
-  { //in case of no error we still need to close the stream and free the pointer
-    dat.close();
-    free(temp);
-  }//else
 
-  //we're finally done with reading the data
+  //no copy here - the buffers are filled directly from the mapped pages
+  result.clear();
+  result.channels = fmt_c.Channels;
+  result.bitsPerSample = fmt_c.BitsPerSample;
+  result.sampleRate = fmt_c.SamplesPerSecond;
+  result.file = file;
+  result.offset = data_offset;
+  result.length = data_c.length_of_data;
+  result.chunkSize = buffer_size;
+  timer.setBytes(result.length);
+  return true;
 }
 
 
@@ -61,6 +61,37 @@ class MediaWave: public Media
            PathToMedia - path to the Wave file
     */
     MediaWave(const std::string& identifier, const std::string& PathToMedia);
+
+    /* constructor for data that was already decoded by decode()
+
+       parameters:
+           identifier  - unique identifier
+           PathToMedia - path to the Wave file
+           pcm         - the decoded data of the file
+    */
+    MediaWave(const std::string& identifier, const std::string& PathToMedia, const DecodedMedia& pcm);
+
+    /* constructor for a media that shares the buffers of another media which
+       was created from the same file
+
+       parameters:
+           identifier  - unique identifier
+           PathToMedia - path to the Wave file
+           shared      - the buffers of the other media
+    */
+    MediaWave(const std::string& identifier, const std::string& PathToMedia, const std::shared_ptr<MediaBuffers>& shared);
+
+    /* reads the file again and creates new buffers, returns true on success */
+    virtual bool reload();
+
+    /* Reads the PCM data of the Wave file PathToMedia into result and returns
+       true on success, false on failure.
+
+       remarks:
+           This function does not use OpenAL, so it may be called from any
+           thread.
+    */
+    static bool decode(const std::string& PathToMedia, DecodedMedia& result);
 }; //class MediaWave
 
 } //namespace
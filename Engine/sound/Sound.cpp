@@ -23,10 +23,23 @@
 #include <cmath> //needed for rotation calculations
 #include <cstdio> //required for opening files for Ogg (since it's a C lib)
 #include <fstream>
+#include <limits>
 #include <stdexcept>
 #include "../Messages.h"
+#include "../ThreadPool.h"
+#include "AudioThread.h"
 #include "MediaWave.h"
 #include "MediaOggVorbis.h"
+#include "MediaOggVorbisStream.h"
+#include "SoundStatistics.h"
+
+//constants of the ALC_SOFT_loopback extension, in case alext.h is missing
+#ifndef ALC_SOFT_loopback
+  #define ALC_FORMAT_CHANNELS_SOFT 0x1990
+  #define ALC_FORMAT_TYPE_SOFT     0x1991
+  #define ALC_SHORT_SOFT           0x1402
+  #define ALC_STEREO_SOFT          0x1501
+#endif
 
 namespace Dusk
 {
@@ -36,11 +49,36 @@ namespace Dusk
 Sound::Sound()
 : m_MediaList(std::map<std::string, Media*>()),
   m_SourceList(std::map<std::string, Source*>()),
+  m_PendingMedia(std::map<std::string, std::shared_ptr<PendingMedia> >()),
+  m_Loader(NULL),
+  m_Voices(std::vector<ALuint>()),
+  m_FreeVoices(std::vector<ALuint>()),
+  m_BufferCache(std::map<std::string, CachedBuffers>()),
+  m_CacheSize(0),
+  m_CacheBudget(cDefaultCacheBudget),
+  m_CacheClock(0),
+  m_AudioThread(NULL),
+  m_ListenerDirty(0),
   pDevice(NULL),
   pContext(NULL),
+  m_Loopback(false),
   AL_Ready(false),
   InitInProgress(false)
-{ }
+{
+  //default values of OpenAL
+  unsigned int i;
+  for (i=0; i<3; ++i)
+  {
+    m_ListenerPosition[i] = 0.0f;
+    m_ListenerVelocity[i] = 0.0f;
+  }
+  m_ListenerOrientation[0] = 0.0f;
+  m_ListenerOrientation[1] = 0.0f;
+  m_ListenerOrientation[2] = -1.0f;
+  m_ListenerOrientation[3] = 0.0f;
+  m_ListenerOrientation[4] = 1.0f;
+  m_ListenerOrientation[5] = 0.0f;
+}
 
 //destructor
 Sound::~Sound()
@@ -49,6 +87,8 @@ Sound::~Sound()
   {
     exit();
   }
+  delete m_Loader;
+  m_Loader = NULL;
 }
 
 Sound& Sound::get()
@@ -59,7 +99,7 @@ Sound& Sound::get()
 
 //Initializes OpenAL, device and context for our application;
 //returns: true, if initialization of OpenAL was successful; false otherwise
-bool Sound::init(std::string PathToLib_AL, std::string PathToLib_Vorbisfile, const bool needVorbis)
+bool Sound::init(std::string PathToLib_AL, std::string PathToLib_Vorbisfile, const bool needVorbis, const bool loopback)
 {
   if (AL_Ready || InitInProgress)
   {
@@ -70,16 +110,42 @@ bool Sound::init(std::string PathToLib_AL, std::string PathToLib_Vorbisfile, con
   InitInProgress = true;
 
   //Initialization of device
-  pDevice = alcOpenDevice(NULL); //opens default device
-  //later: should possibly be modified to open a selected device instead of default
+  LoopbackRenderFunction render = NULL;
+  if (loopback)
+  {
+    if (alcIsExtensionPresent(NULL, "ALC_SOFT_loopback")==ALC_FALSE)
+    {
+      DuskLog() << "Sound::init: ERROR: Loopback device requested, but the "
+                << "extension ALC_SOFT_loopback is not available.\n";
+      InitInProgress = false;
+      return false;
+    }
+    typedef ALCdevice* (*LoopbackOpenFunction)(const ALCchar* deviceName);
+    const LoopbackOpenFunction openLoopback = reinterpret_cast<LoopbackOpenFunction>(
+                          alcGetProcAddress(NULL, "alcLoopbackOpenDeviceSOFT"));
+    render = reinterpret_cast<LoopbackRenderFunction>(
+                          alcGetProcAddress(NULL, "alcRenderSamplesSOFT"));
+    pDevice = ((openLoopback!=NULL) and (render!=NULL)) ? openLoopback(NULL) : NULL;
+  }
+  else
+  {
+    pDevice = alcOpenDevice(NULL); //opens default device
+    //later: should possibly be modified to open a selected device instead of default
+  }
   if (pDevice == NULL)
   {
-    DuskLog() << "Sound::init: ERROR: Could not open default device.\n";
+    DuskLog() << "Sound::init: ERROR: Could not open "
+              << (loopback ? "loopback" : "default") << " device.\n";
     InitInProgress = false;
     return false;
   }
-  //create context
-  pContext = alcCreateContext(pDevice, NULL);
+  //create context - a loopback device needs to know the format of the mix
+  const ALCint loopbackAttributes[] = {
+      ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+      ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+      ALC_FREQUENCY, (ALCint) cLoopbackFrequency,
+      0};
+  pContext = alcCreateContext(pDevice, loopback ? loopbackAttributes : NULL);
   if (pContext == NULL)
   {
     DuskLog() << "Sound::init: ERROR: ";
@@ -121,12 +187,8 @@ bool Sound::init(std::string PathToLib_AL, std::string PathToLib_Vorbisfile, con
     InitInProgress = false;
     return false;
   }
-  //the AL part is done here, so we can already set AL_Ready to true
-  AL_Ready = true;
-
-  DuskLog() << "Sound::init: Info: OpenAL functions loaded, device opened, "
-            << "and context created successfully.\n";
-  //just for curiosity/ debug reasons: get extension string
+  //just for curiosity/ debug reasons: get extension string - this has to be
+  // done before the audio thread starts, which does all later OpenAL calls
   DuskLog() << "Debug: Available AL extensions are:\n"
             << alGetString(AL_EXTENSIONS) << "\nEnd of extension list.\n"
             << "Available ALC extensions are:\n"
@@ -134,6 +196,57 @@ bool Sound::init(std::string PathToLib_AL, std::string PathToLib_Vorbisfile, con
             <<"alIsExtensionPresent(AL_EXT_VORBIS): "<<(int)alIsExtensionPresent("AL_EXT_VORBIS")
             << "\nEnum of AL_FORMAT_VORBIS_EXT: "<<alGetEnumValue("AL_FORMAT_VORBIS_EXT")
             << "\n";
+  //create the pool of voices - as many as the implementation allows, but not
+  // more than cMaxVoices
+  m_Voices.clear();
+  m_FreeVoices.clear();
+  alGetError();//clear error state
+  while (m_Voices.size()<cMaxVoices)
+  {
+    ALuint voice = 0;
+    alGenSources(1, &voice);
+    if (alGetError()!=AL_NO_ERROR)
+    {
+      break;
+    }
+    m_Voices.push_back(voice);
+  }//while
+  if (!m_Voices.empty())
+  {
+    try
+    {
+      m_AudioThread = new AudioThread(m_Voices, loopback ? pDevice : NULL,
+                                      render, cLoopbackFrequency);
+    }
+    catch (...)
+    {
+      DuskLog() << "Sound::init: ERROR: Could not start the audio thread.\n";
+      m_AudioThread = NULL;
+      alDeleteSources(m_Voices.size(), &m_Voices[0]);
+      m_Voices.clear();
+    }
+  }
+  else
+  {
+    DuskLog() << "Sound::init: ERROR: Could not create any AL source.\n";
+  }
+  if (m_AudioThread==NULL)
+  {
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(pContext);
+    alcCloseDevice(pDevice);
+    InitInProgress = false;
+    return false;
+  }
+  //hand out the voices in the order of creation
+  m_FreeVoices.assign(m_Voices.rbegin(), m_Voices.rend());
+  DuskLog() << "Sound::init: Info: " << m_Voices.size() << " voices created.\n";
+  //the AL part is done here, so we can already set AL_Ready to true
+  m_Loopback = loopback;
+  AL_Ready = true;
+
+  DuskLog() << "Sound::init: Info: OpenAL functions loaded, device opened, "
+            << "and context created successfully.\n";
   //the basic initialization is done here, we can return true (for now,
   //  more will be done later)
   InitInProgress = false;
@@ -157,6 +270,11 @@ bool Sound::exit()
   }
   InitInProgress = true;
 
+  //wait for media that are still loading, they are not needed any more
+  delete m_Loader;
+  m_Loader = NULL;
+  m_PendingMedia.clear();
+
   unsigned int i;
   std::vector<std::string> object_list;
   //try to free all AL sources
@@ -172,6 +290,20 @@ bool Sound::exit()
     //frees resources of given media
     destroyMedia(object_list.at(i));
   }
+  //no media uses the cached buffers any more, so the audio thread can delete
+  // them
+  m_BufferCache.clear();
+  m_CacheSize = 0;
+  //all commands are executed by the destructor
+  delete m_AudioThread;
+  m_AudioThread = NULL;
+  //all sources are gone, so all voices are free again
+  if (!m_Voices.empty())
+  {
+    alDeleteSources(m_Voices.size(), &m_Voices[0]);
+  }
+  m_Voices.clear();
+  m_FreeVoices.clear();
 
 
   //standard clean-up
@@ -180,6 +312,7 @@ bool Sound::exit()
   alcDestroyContext(pContext);
   alcCloseDevice(pDevice);
 
+  m_Loopback = false;
   AL_Ready = false;
   InitInProgress = false;
   return true;
@@ -190,6 +323,62 @@ bool Sound::isInitialized() const
   return AL_Ready;
 }
 
+bool Sound::isLoopback() const
+{
+  return m_Loopback;
+}
+
+void Sound::logStatistics() const
+{
+  const SoundStatistics& stats = SoundStatistics::get();
+  if (!stats.isEnabled())
+  {
+    DuskLog() << "Sound::logStatistics: Warning: recording of statistics is "
+              << "disabled, the numbers below may be outdated.\n";
+  }
+  DuskLog() << "Sound statistics:\n";
+  unsigned int i;
+  for (i=0; i<SoundStatistics::opCount; ++i)
+  {
+    const SoundStatistics::Operation op = static_cast<SoundStatistics::Operation>(i);
+    const uint64_t count = stats.getCount(op);
+    if (count==0)
+      continue;
+    DuskLog() << "  " << SoundStatistics::getName(op) << ": " << count
+              << " calls, " << stats.getTotalTime(op)/1000000.0 << " ms total, "
+              << stats.getTotalTime(op)/1000.0/count << " us average, "
+              << stats.getMaxTime(op)/1000.0 << " us max\n";
+  }//for
+  const uint64_t decodeTime = stats.getTotalTime(SoundStatistics::opDecode);
+  if (decodeTime>0)
+  {
+    //bytes per nanosecond equals 1000 MB per second (with MB = 10^6 bytes)
+    DuskLog() << "  decode throughput: "
+              << stats.getBytes(SoundStatistics::opDecode)*1000.0/decodeTime
+              << " MB/s (" << stats.getBytes(SoundStatistics::opDecode)
+              << " bytes)\n";
+  }
+  //memory usage
+  unsigned int streams = 0;
+  std::map<std::string, Media*>::const_iterator m_iter = m_MediaList.begin();
+  while (m_iter!=m_MediaList.end())
+  {
+    if (m_iter->second->isStreaming())
+      ++streams;
+    ++m_iter;
+  }//while
+  //each stream has its AL buffers plus as many decoded chunks
+  const std::size_t streamBytes = 2 * streams * MediaOggVorbisStream::cStreamBufferCount
+                                  * MediaOggVorbisStream::cStreamBufferSize;
+  DuskLog() << "  media: " << m_MediaList.size() << " (" << streams
+            << " streamed, " << m_PendingMedia.size() << " loading)\n"
+            << "  sources: " << m_SourceList.size() << ", voices in use: "
+            << m_Voices.size()-m_FreeVoices.size() << " of " << m_Voices.size() << "\n"
+            << "  cached buffers: " << m_CacheSize << " of " << m_CacheBudget
+            << " bytes, " << m_BufferCache.size() << " files\n"
+            << "  stream buffers: " << streamBytes << " bytes (at most)\n";
+}
+
 bool Sound::isMediaPresent(const std::string& mediaIdentifier) const
 {
   //no check for AL_Ready or InitInProgress, since it should work in every state
@@ -204,6 +393,11 @@ bool Sound::isSourcePresent(const std::string& sourceIdentifier) const
   return m_SourceList.find(sourceIdentifier)!=m_SourceList.end();
 }
 
+bool Sound::isMediaPending(const std::string& mediaIdentifier) const
+{
+  return m_PendingMedia.find(mediaIdentifier)!=m_PendingMedia.end();
+}
+
 Media & Sound::getMedia(const std::string& mediaIdentifier) const
 {
   std::map<std::string, Media*>::const_iterator iter = m_MediaList.find(mediaIdentifier);
@@ -279,6 +473,7 @@ std::vector<std::string> Sound::getMediaList(const bool with_file_names) const
 
 bool Sound::createSource(const std::string& identifier)
 {
+  SoundStatistics::Timer timer(SoundStatistics::opCreateSource);
   if (!AL_Ready || InitInProgress)
   {
     DuskLog() << "Sound::createSource: ERROR: OpenAL is not initialized, or"
@@ -309,6 +504,7 @@ bool Sound::createSource(const std::string& identifier)
 
 bool Sound::destroySource(const std::string& identifier)
 {
+  SoundStatistics::Timer timer(SoundStatistics::opDestroySource);
   if (!AL_Ready)
   {
     DuskLog() << "Sound::DestroyNoise: ERROR: OpenAL is not initialized, thus "
@@ -341,8 +537,9 @@ bool Sound::destroySource(const std::string& identifier)
 
 //media management routines
 
-bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& PathToMedia)
+bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& PathToMedia, const bool streamed)
 {
+  SoundStatistics::Timer timer(SoundStatistics::opCreateMedia);
   if (!AL_Ready)
   {
     DuskLog() << "Sound::createMedia: Warning: OpenAL is not initialized, thus "
@@ -355,7 +552,7 @@ bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& P
               << "progress, thus we cannot load a media file.\n";
     return false;
   }
-  if (isMediaPresent(MediaIdentifier))
+  if (isMediaPresent(MediaIdentifier) || isMediaPending(MediaIdentifier))
   {
     DuskLog() << "Sound::createMedia: ERROR: A media named\""<<MediaIdentifier
               <<"\" already exists. Creation stopped.\n";
@@ -365,12 +562,17 @@ bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& P
   //check file for extension (and so for the implied file format)
   std::string ending = PathToMedia.substr(PathToMedia.length()-4);
   std::transform(ending.begin(), ending.end(), ending.begin(), tolower);
+  //files in the cache do not need to be decoded again
+  const std::map<std::string, CachedBuffers>::const_iterator cached = m_BufferCache.find(PathToMedia);
   Media * temp = NULL;
   if (ending==".wav")
   {
     try
     {
-      temp = new MediaWave(MediaIdentifier, PathToMedia);
+      if (cached!=m_BufferCache.end())
+        temp = new MediaWave(MediaIdentifier, PathToMedia, cached->second.buffers);
+      else
+        temp = new MediaWave(MediaIdentifier, PathToMedia);
     }
     catch (...)
     {
@@ -381,7 +583,18 @@ bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& P
   {
     try
     {
-      temp = new MediaOggVorbis(MediaIdentifier, PathToMedia);
+      if (streamed)
+      {
+        temp = new MediaOggVorbisStream(MediaIdentifier, PathToMedia);
+      }
+      else if (cached!=m_BufferCache.end())
+      {
+        temp = new MediaOggVorbis(MediaIdentifier, PathToMedia, cached->second.buffers);
+      }
+      else
+      {
+        temp = new MediaOggVorbis(MediaIdentifier, PathToMedia);
+      }
     }
     catch (...)
     {
@@ -396,11 +609,122 @@ bool Sound::createMedia(const std::string& MediaIdentifier, const std::string& P
     return false;
   }
   m_MediaList[MediaIdentifier] = temp;
+  if (!temp->isStreaming())
+  {
+    addToCache(*temp);
+  }
+  return true;
+}
+
+bool Sound::createMediaAsync(const std::string& MediaIdentifier, const std::string& PathToMedia)
+{
+  if (!AL_Ready)
+  {
+    DuskLog() << "Sound::createMediaAsync: Warning: OpenAL is not initialized, "
+              << "thus we cannot load a media file yet.\n";
+    return false;
+  }
+  if (InitInProgress)
+  {
+    DuskLog() << "Sound::createMediaAsync: Warning: (De-)Initialization of "
+              << "OpenAL is in progress, thus we cannot load a media file.\n";
+    return false;
+  }
+  if (isMediaPresent(MediaIdentifier) || isMediaPending(MediaIdentifier))
+  {
+    DuskLog() << "Sound::createMediaAsync: ERROR: A media named\""
+              << MediaIdentifier << "\" already exists. Creation stopped.\n";
+    return false;
+  }
+
+  //check file for extension (and so for the implied file format)
+  if (PathToMedia.length()<4)
+  {
+    DuskLog() << "Sound::createMediaAsync: ERROR: \""<<PathToMedia<<"\" is not "
+              << "a valid file name for a media.\n";
+    return false;
+  }
+  std::string ending = PathToMedia.substr(PathToMedia.length()-4);
+  std::transform(ending.begin(), ending.end(), ending.begin(), tolower);
+  if ((ending!=".wav") && (ending!=".ogg"))
+  {
+    DuskLog() << "Sound::createMediaAsync: Error: File \""<<PathToMedia<<"\" "
+              << "does not seem to be a Wave or a Ogg-Vorbis file. File cannot "
+              << "be loaded.\n";
+    return false;
+  }
+  if (m_BufferCache.find(PathToMedia)!=m_BufferCache.end())
+  {
+    //no decoding needed, the media can be created right now
+    return createMedia(MediaIdentifier, PathToMedia);
+  }
+
+  std::shared_ptr<PendingMedia> pending(new PendingMedia);
+  pending->path = PathToMedia;
+  pending->isOgg = (ending==".ogg");
+  pending->success = false;
+  pending->done = false;
+  pending->uploading = false;
+  pending->uploaded = false;
+  m_PendingMedia[MediaIdentifier] = pending;
+
+  if (m_Loader==NULL)
+  {
+    m_Loader = new ThreadPool(1);
+  }
+  //the job only decodes, the AL buffers are created by the audio thread (see
+  // finishPendingMedia())
+  m_Loader->enqueue([pending]()
+    {
+      try
+      {
+        if (pending->isOgg)
+          pending->success = MediaOggVorbis::decode(pending->path, pending->pcm);
+        else
+          pending->success = MediaWave::decode(pending->path, pending->pcm);
+      }
+      catch (...)
+      {
+        //most likely std::bad_alloc
+        pending->success = false;
+        pending->pcm.clear();
+      }
+      pending->done = true;
+    });
+  return true;
+}
+
+bool Sound::attachWhenReady(const std::string& SourceIdentifier, const std::string& MediaIdentifier, const bool autoPlay)
+{
+  if (!isSourcePresent(SourceIdentifier))
+  {
+    DuskLog() << "Sound::attachWhenReady: ERROR: There is no source named \""
+              << SourceIdentifier << "\".\n";
+    return false;
+  }
+  if (isMediaPresent(MediaIdentifier))
+  {
+    //media is already there, so there is no need to wait
+    Source& src = getSource(SourceIdentifier);
+    if (!src.attach(getMedia(MediaIdentifier)))
+      return false;
+    return (!autoPlay || src.play());
+  }
+  std::map<std::string, std::shared_ptr<PendingMedia> >::iterator iter = m_PendingMedia.find(MediaIdentifier);
+  if (iter==m_PendingMedia.end())
+  {
+    DuskLog() << "Sound::attachWhenReady: ERROR: A media named \""
+              << MediaIdentifier << "\" does neither exist nor is it being "
+              << "loaded.\n";
+    return false;
+  }
+  iter->second->requests.push_back(std::make_pair(SourceIdentifier, autoPlay));
   return true;
 }
 
 bool Sound::destroyMedia(const std::string& MediaIdentifier)
 {
+  SoundStatistics::Timer timer(SoundStatistics::opDestroyMedia);
   if (!AL_Ready)
   {
     DuskLog() << "Sound::destroyMedia: ERROR: OpenAL is not initialized, thus "
@@ -410,6 +734,12 @@ bool Sound::destroyMedia(const std::string& MediaIdentifier)
   //no check for InitInProgress, since this should work in every state of the
   //class instance, where AL is ready; and it's called during Exit(), so a check
   //would prevent proper exit.
+  if (isMediaPending(MediaIdentifier))
+  {
+    //worker thread may still decode it, but the result will be discarded
+    m_PendingMedia.erase(MediaIdentifier);
+    return true;
+  }
   if (!isMediaPresent(MediaIdentifier))
   {
     DuskLog() << "Sound::destroyMedia: ERROR: A media named \""<<MediaIdentifier
@@ -418,13 +748,16 @@ bool Sound::destroyMedia(const std::string& MediaIdentifier)
   }
 
   Media * temp = m_MediaList[MediaIdentifier];
-  const std::vector<std::string> & tempList = temp->getRelatedSources();
+  //copy of the list, because detach() removes the source from it
+  const std::vector<std::string> tempList = temp->getRelatedSources();
   //detach media. Result does not matter, media will be deleted anyway
   unsigned int i;
   for (i=0; i<tempList.size(); i=i+1)
   {
     m_SourceList[tempList[i]]->detach();
   }//for
+  //the audio thread must not use the media's buffers any more
+  m_AudioThread->flush();
 
   try
   {
@@ -438,6 +771,393 @@ bool Sound::destroyMedia(const std::string& MediaIdentifier)
   }
 }
 
+void Sound::update()
+{
+  SoundStatistics::Timer timer(SoundStatistics::opUpdate);
+  if (!AL_Ready || InitInProgress)
+  {
+    return;
+  }
+  if (!m_PendingMedia.empty())
+  {
+    finishPendingMedia();
+  }
+  updateVoices();
+  //send the changes of this frame at once
+  std::map<std::string, Source*>::const_iterator iter = m_SourceList.begin();
+  while (iter!=m_SourceList.end())
+  {
+    iter->second->flushProperties();
+    ++iter;
+  }//while
+  flushListener();
+  m_AudioThread->wake();
+}
+
+void Sound::flushListener()
+{
+  AudioCommand cmd;
+  if ((m_ListenerDirty & 1)!=0)
+  {
+    cmd.type = AudioCommand::acListenerPosition;
+    std::copy(m_ListenerPosition, m_ListenerPosition+3, cmd.values);
+    m_AudioThread->push(cmd);
+  }
+  if ((m_ListenerDirty & 2)!=0)
+  {
+    cmd.type = AudioCommand::acListenerVelocity;
+    std::copy(m_ListenerVelocity, m_ListenerVelocity+3, cmd.values);
+    m_AudioThread->push(cmd);
+  }
+  if ((m_ListenerDirty & 4)!=0)
+  {
+    cmd.type = AudioCommand::acListenerOrientation;
+    std::copy(m_ListenerOrientation, m_ListenerOrientation+6, cmd.values);
+    m_AudioThread->push(cmd);
+  }
+  m_ListenerDirty = 0;
+}
+
+uint64_t Sound::pushAudioCommand(const AudioCommand& cmd)
+{
+  if (m_AudioThread==NULL)
+  {
+    return 0;
+  }
+  return m_AudioThread->push(cmd);
+}
+
+void Sound::runOnAudioThread(const std::function<void()>& function, const bool wait) const
+{
+  if ((m_AudioThread==NULL) or m_AudioThread->isAudioThread())
+  {
+    function();
+    return;
+  }
+  AudioCommand cmd;
+  cmd.type = AudioCommand::acCall;
+  cmd.call = function;
+  m_AudioThread->push(cmd);
+  if (wait)
+  {
+    m_AudioThread->flush();
+  }
+}
+
+void Sound::discardBuffers(const std::vector<ALuint>& buffers, const std::shared_ptr<MappedFile>& staticData) const
+{
+  if ((m_AudioThread==NULL) or m_AudioThread->isAudioThread())
+  {
+    MediaBuffers::deleteBuffers(buffers);
+    return;
+  }
+  m_AudioThread->discardBuffers(buffers, staticData);
+}
+
+bool Sound::getVoiceState(const ALuint voice, const uint64_t sequence, ALint& state, float& offset) const
+{
+  if (m_AudioThread==NULL)
+  {
+    return false;
+  }
+  return m_AudioThread->getVoiceState(voice, sequence, state, offset);
+}
+
+
+bool Sound::acquireVoice(ALuint& voice)
+{
+  if (m_FreeVoices.empty())
+  {
+    return false;
+  }
+  voice = m_FreeVoices.back();
+  m_FreeVoices.pop_back();
+  return true;
+}
+
+void Sound::returnVoice(const ALuint voice)
+{
+  if (std::find(m_Voices.begin(), m_Voices.end(), voice)==m_Voices.end())
+  {
+    DuskLog() << "Sound::returnVoice: ERROR: " << voice << " is not a voice "
+              << "of the pool.\n";
+    return;
+  }
+  m_FreeVoices.push_back(voice);
+}
+
+void Sound::updateVoices()
+{
+  const std::vector<float> listener = getListenerPosition();
+  //collect all sources which would like to be heard
+  std::vector<std::pair<float, Source*> > candidates;
+  std::map<std::string, Source*>::const_iterator iter = m_SourceList.begin();
+  while (iter!=m_SourceList.end())
+  {
+    Source* src = iter->second;
+    src->updatePlayState();
+    if (src->needsVoice())
+    {
+      float audibility = src->getAudibility(listener);
+      //sources which already have a voice get a small bonus, so that two
+      // sources of similar audibility do not take turns every frame
+      if (src->hasVoice() and (audibility<std::numeric_limits<float>::max()/cVoiceHysteresis))
+      {
+        audibility *= cVoiceHysteresis;
+      }
+      candidates.push_back(std::make_pair(audibility, src));
+    }
+    else if (src->hasVoice())
+    {
+      //stopped or paused sources do not need their voice
+      returnVoice(src->releaseVoice());
+    }
+    ++iter;
+  }//while
+
+  //only the most audible sources get a voice
+  const unsigned int audible = std::min<std::size_t>(candidates.size(), m_Voices.size());
+  std::partial_sort(candidates.begin(), candidates.begin()+audible, candidates.end(),
+                    [](const std::pair<float, Source*>& a, const std::pair<float, Source*>& b)
+                    { return a.first > b.first; });
+  //cull the rest first to free their voices
+  unsigned int i;
+  for (i=audible; i<candidates.size(); ++i)
+  {
+    if (candidates[i].second->hasVoice())
+    {
+      returnVoice(candidates[i].second->releaseVoice());
+    }
+  }//for
+  for (i=0; i<audible; ++i)
+  {
+    Source* src = candidates[i].second;
+    ALuint voice = 0;
+    if (!src->hasVoice() and acquireVoice(voice))
+    {
+      if (!src->bindVoice(voice))
+      {
+        DuskLog() << "Sound::updateVoices: ERROR: Could not bind a voice to "
+                  << "source \"" << src->getIdentifier() << "\".\n";
+        returnVoice(src->releaseVoice());
+      }
+    }
+  }//for
+}
+
+void Sound::setCacheBudget(const std::size_t bytes)
+{
+  m_CacheBudget = bytes;
+  trimCache("");
+}
+
+std::size_t Sound::getCacheBudget() const
+{
+  return m_CacheBudget;
+}
+
+std::size_t Sound::getCacheSize() const
+{
+  return m_CacheSize;
+}
+
+bool Sound::acquireMediaBuffers(Media& media)
+{
+  if (media.isStreaming())
+  {
+    //streams have their own buffers
+    return true;
+  }
+  std::map<std::string, CachedBuffers>::iterator iter = m_BufferCache.find(media.getFileName());
+  if (iter==m_BufferCache.end())
+  {
+    //buffers were deleted by trimCache()
+    if (!media.isLoaded() && !media.reload())
+    {
+      DuskLog() << "Sound::acquireMediaBuffers: ERROR: Could not reload media \""
+                << media.getIdentifier() << "\" from file \""
+                << media.getFileName() << "\".\n";
+      return false;
+    }
+    addToCache(media);
+    iter = m_BufferCache.find(media.getFileName());
+  }
+  else if (media.getBuffers()!=iter->second.buffers)
+  {
+    media.setBuffers(iter->second.buffers);
+  }
+  ++(iter->second.references);
+  iter->second.lastUse = ++m_CacheClock;
+  return true;
+}
+
+void Sound::releaseMediaBuffers(const Media& media)
+{
+  if (media.isStreaming())
+  {
+    return;
+  }
+  const std::map<std::string, CachedBuffers>::iterator iter = m_BufferCache.find(media.getFileName());
+  if (iter==m_BufferCache.end())
+  {
+    return;
+  }
+  if (iter->second.references>0)
+  {
+    --(iter->second.references);
+  }
+  iter->second.lastUse = ++m_CacheClock;
+  trimCache("");
+}
+
+void Sound::addToCache(const Media& media)
+{
+  std::map<std::string, CachedBuffers>::iterator iter = m_BufferCache.find(media.getFileName());
+  if (iter!=m_BufferCache.end())
+  {
+    iter->second.lastUse = ++m_CacheClock;
+    return;
+  }
+  if (!media.isLoaded())
+  {
+    return;
+  }
+  CachedBuffers entry;
+  entry.buffers = media.getBuffers();
+  entry.references = 0;
+  entry.lastUse = ++m_CacheClock;
+  m_BufferCache[media.getFileName()] = entry;
+  m_CacheSize += entry.buffers->getDataSize();
+  trimCache(media.getFileName());
+}
+
+void Sound::trimCache(const std::string& keepPath)
+{
+  while (m_CacheSize>m_CacheBudget)
+  {
+    //find the least recently used buffers that are not attached anywhere
+    std::map<std::string, CachedBuffers>::iterator victim = m_BufferCache.end();
+    std::map<std::string, CachedBuffers>::iterator iter = m_BufferCache.begin();
+    while (iter!=m_BufferCache.end())
+    {
+      if ((iter->second.references==0) && (iter->first!=keepPath)
+          && ((victim==m_BufferCache.end()) || (iter->second.lastUse<victim->second.lastUse)))
+      {
+        victim = iter;
+      }
+      ++iter;
+    }//while
+    if (victim==m_BufferCache.end())
+    {
+      //all remaining buffers are in use
+      return;
+    }
+    //a voice may still be about to unqueue the buffers
+    if (m_AudioThread!=NULL)
+    {
+      m_AudioThread->flush();
+    }
+    //unload all media which use these buffers, so that they get deleted
+    std::map<std::string, Media*>::iterator media_iter = m_MediaList.begin();
+    while (media_iter!=m_MediaList.end())
+    {
+      if (media_iter->second->getBuffers()==victim->second.buffers)
+      {
+        media_iter->second->unload();
+      }
+      ++media_iter;
+    }//while
+    DuskLog() << "Sound::trimCache: Debug: buffers of \"" << victim->first
+              << "\" removed from cache.\n";
+    m_CacheSize -= victim->second.buffers->getDataSize();
+    m_BufferCache.erase(victim);
+  }//while
+}
+
+void Sound::finishPendingMedia()
+{
+  std::map<std::string, std::shared_ptr<PendingMedia> >::iterator iter = m_PendingMedia.begin();
+  while (iter!=m_PendingMedia.end())
+  {
+    const std::shared_ptr<PendingMedia> pending = iter->second;
+    if (!pending->done or (pending->uploading and !pending->uploaded))
+    {
+      ++iter;
+      continue;
+    }
+    //file may have been loaded by createMedia() in the meantime
+    std::map<std::string, CachedBuffers>::const_iterator cached = m_BufferCache.find(pending->path);
+    if (pending->success and !pending->uploading and (cached==m_BufferCache.end()))
+    {
+      //let the audio thread create the buffers, the media is created in a
+      // later frame
+      pending->uploading = true;
+      runOnAudioThread([pending]()
+        {
+          try
+          {
+            pending->buffers.reset(new MediaBuffers(pending->pcm, pending->path));
+          }
+          catch (...)
+          {
+            //reason was already logged by MediaBuffers
+            pending->buffers.reset();
+          }
+          //PCM data was handed to OpenAL, so release it right away
+          pending->pcm.clear();
+          pending->uploaded = true;
+        }, false);
+      ++iter;
+      continue;
+    }
+    const std::string MediaIdentifier = iter->first;
+    m_PendingMedia.erase(iter++);
+    pending->pcm.clear();
+    std::shared_ptr<MediaBuffers> buffers = (cached!=m_BufferCache.end())
+                                          ? cached->second.buffers : pending->buffers;
+    if (!pending->success or (buffers.get()==NULL))
+    {
+      //reason was already logged by the decode function or by MediaBuffers
+      DuskLog() << "Sound::finishPendingMedia: ERROR: Could not load media \""
+                << MediaIdentifier << "\" from file \"" << pending->path
+                << "\".\n";
+      continue;
+    }
+    //if the file was cached in the meantime, the uploaded buffers are not
+    // needed, the audio thread deletes them
+    pending->buffers.reset();
+    Media * temp = NULL;
+    try
+    {
+      if (pending->isOgg)
+        temp = new MediaOggVorbis(MediaIdentifier, pending->path, buffers);
+      else
+        temp = new MediaWave(MediaIdentifier, pending->path, buffers);
+    }
+    catch (...)
+    {
+      continue;
+    }
+    m_MediaList[MediaIdentifier] = temp;
+    addToCache(*temp);
+
+    //attach (and play) the media at sources that are waiting for it
+    unsigned int i;
+    for (i=0; i<pending->requests.size(); ++i)
+    {
+      const std::map<std::string, Source*>::iterator src_iter = m_SourceList.find(pending->requests[i].first);
+      if (src_iter==m_SourceList.end())
+      {
+        //source was destroyed in the meantime
+        continue;
+      }
+      if (src_iter->second->attach(*temp) && pending->requests[i].second)
+      {
+        src_iter->second->play();
+      }
+    }//for
+  }//while
+}
 
 //state retrieval
 
@@ -457,11 +1177,14 @@ float Sound::getSpeedOfSound() const
               << "is in progress. No state query possbile.\n";
     return 0.0f;
   }
-  ALenum error_state;
+  ALenum error_state = AL_NO_ERROR;
   ALfloat result=0.0f;
-  alGetError();//clear error state
-  result = alGetFloat(AL_SPEED_OF_SOUND);
-  error_state = alGetError();
+  runOnAudioThread([&]()
+    {
+      alGetError();//clear error state
+      result = alGetFloat(AL_SPEED_OF_SOUND);
+      error_state = alGetError();
+    }, true);
   if (error_state!=AL_NO_ERROR)
   {
     DuskLog() << "Sound::GetSpeedOfSound: ERROR: Could not query state var.\n";
@@ -504,10 +1227,13 @@ bool Sound::setSpeedOfSound(const float new_value)
     return false;
   }
 
-  ALenum error_state;
-  alGetError();//clear error state
-  alSpeedOfSound(new_value);
-  error_state = alGetError();
+  ALenum error_state = AL_NO_ERROR;
+  runOnAudioThread([&]()
+    {
+      alGetError();//clear error state
+      alSpeedOfSound(new_value);
+      error_state = alGetError();
+    }, true);
   if (error_state!=AL_NO_ERROR)
   {
     DuskLog() << "Sound::SetSpeedOfSound: ERROR: Could not set new value.\n";
@@ -544,145 +1270,27 @@ bool Sound::setListenerPostion(const float x, const float y, const float z)
               << "OpenAL is in progress, thus we cannot set position here.\n";
     return false;
   }
-
-  ALenum error_state;
-  alGetError(); //clear error state
-  alListener3f(AL_POSITION, x, y, z);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::SetListenerPosition: ERROR: Could not set listener's "
-              << "position!\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM: //should never happen here, since param is constant
-           DuskLog() << "    Invalid enum parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value, possible NaN or Inf?\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     <<".\n"; break;
-    }//swi
-    return false;
-  }//if
+  //sent to the audio thread with the next update()
+  m_ListenerPosition[0] = x;
+  m_ListenerPosition[1] = y;
+  m_ListenerPosition[2] = z;
+  m_ListenerDirty |= 1;
   return true;
 }
 
-//retrieves listener's position, if possible
-//otherwise, return value is vector of zeroes
+//retrieves listener's position
 std::vector<float> Sound::getListenerPosition() const
 {
-  if (!AL_Ready)
-  {
-    DuskLog() << "Sound::GetListenerPostion: Warning: OpenAL is not initialized"
-              << ", thus we cannot get the listener's position yet.\n";
-    return std::vector<float>(3, 0.0f);
-  }
-  if (InitInProgress)
-  {
-    DuskLog() << "Sound::GetListenerPostion: ERROR: (De-)Initialization of "
-              << "OpenAL is in progress, thus we cannot get a position here.\n";
-    return std::vector<float>(3, 0.0f);
-  }
-
-  std::vector<float> result(3, 0.0f); //declare vector and initialize it with
-                                      // three zeros (better than thrice push_b)
-  ALenum error_state;
-
-  alGetError(); //clear error state
-  alGetListener3f(AL_POSITION, &result[0], &result[1], &result[2]);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::GetListenerPosition: ERROR: Could not get listener's "
-              << "position.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n";
-           break;
-      case AL_INVALID_ENUM: //should not happen here
-           DuskLog() << "    Invalid enumeration value.\n";
-           break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer values.\n";
-           break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n";
-           break;
-    }//swi
-    //Normally we would return "false" here, but since there is no bool, we can
-    //use the content of the result vector as well.
-  }//if
-  return result;
+  return std::vector<float>(m_ListenerPosition, m_ListenerPosition+3);
 }
 
 //changes listener's position relative to current listener's postion, i.e.
 // simple vector addition of current pos. and parameter vector
 bool Sound::translateListenerPostion(const float delta_x, const float delta_y, const float delta_z)
 {
-  if (!AL_Ready)
-  {
-    DuskLog() << "Sound::ListenerTranslatePostion: Warning: OpenAL is not init"
-              << "ialized, thus we cannot set the listener's position yet.\n";
-    return false;
-  }
-  if (InitInProgress)
-  {
-    DuskLog() << "Sound::ListenerTranslatePostion: ERROR: (De-)Initialization "
-              << "of OpenAL is in progress, thus we cannot set position here.\n";
-    return false;
-  }
-
-  ALenum error_state;
-  ALfloat current_x, current_y, current_z; //will hold current listener pos.
-  alGetError(); //clear error state
-  //get current position of listener
-  alGetListener3f(AL_POSITION, &current_x, &current_y, &current_z);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::ListenerTranslatePosition: ERROR: Could not get the "
-              << "current listener position.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_ENUM: //should never happen here
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context. :(\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer values.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
-  //now set the new position
-  alListener3f(AL_POSITION, current_x+delta_x, current_y+delta_y, current_z+delta_z);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::ListenerTranslatePosition: ERROR: Could not set new "
-              << "listener position. :(\n";
-    switch/*reloaded*/(error_state)
-    {
-      case AL_INVALID_ENUM: //should not happen
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context, so what?\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid position value, maybe NaN or Inf?"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     <<".\n"; break;
-    }//swi
-    return false;
-  }//if
-  return true;
+  return setListenerPostion(m_ListenerPosition[0]+delta_x,
+                            m_ListenerPosition[1]+delta_y,
+                            m_ListenerPosition[2]+delta_z);
 }
 
 //sets listener's velocity and returns true on success, false on error
@@ -700,131 +1308,23 @@ bool Sound::setListenerVelocity(const float x, const float y, const float z)
               << "OpenAL is in progress, thus we cannot set a velocity here.\n";
     return false;
   }
-
-  ALenum error_state;
-
-  alGetError(); //clear error state
-  alListener3f(AL_VELOCITY, x, y, z);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::SetListenerVelocity: ERROR: Could not set velocity!\n";
-    switch(error_state)
-    {
-      case AL_INVALID_ENUM: //unlikely to happen
-           DuskLog() << "    Invalid enumeration token.\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value given, possibly NaN? (Values: x: "<<x
-                     << "; y: "<<y<<"; z: "<<z<<")\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+  m_ListenerVelocity[0] = x;
+  m_ListenerVelocity[1] = y;
+  m_ListenerVelocity[2] = z;
+  m_ListenerDirty |= 2;
   return true;
 }//function SetListenerVelocity
 
-/*retrieves listener's velocity,
-  returns (0.0, 0.0, 0.0), if velocity could not be determined. However, a return
-  value of (0.0, 0.0, 0.0) does not necessarily indicate an error, since this
-  is also a legal return value for a non-moving listener.
-
-  Note to self: Maybe we should use NaN instead of (0.0, 0.0, 0.0) in case of
-                error. However, this might cause problems if retrieved values
-                are not checked for possible occurence of NaN. */
+//retrieves listener's velocity
 std::vector<float> Sound::getListenerVelocity() const
 {
-  if (!AL_Ready)
-  {
-    DuskLog() << "Sound::GetListenerVelocity: Warning: OpenAL is not "
-              << "initialized, we cannot have a listener velocity yet.\n";
-    return std::vector<float>(3, 0.0f);
-  }
-  if (InitInProgress)
-  {
-    DuskLog() << "Sound::GetListenerVelocity: ERROR: (De-)Initialization of "
-              << "OpenAL is in progress, thus we cannot get a velocity here.\n";
-    return std::vector<float>(3, 0.0f);
-  }
-
-  ALenum error_state;
-  std::vector<float> result(3, 0.0f);
-
-  alGetError();//clears error state
-  alGetListener3f(AL_VELOCITY, &result[0], &result[1], &result[2]);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::GetListenerVelocity: ERROR: Could not retrieve "
-              << "velocity value of listener!\n";
-    switch(error_state)
-    {
-      case AL_INVALID_ENUM: //unlikely
-           DuskLog() << "    Invalid enumeration token.\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value(s) given.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return std::vector<float>(3, 0.0f);
-  }//if
-  return result;
+  return std::vector<float>(m_ListenerVelocity, m_ListenerVelocity+3);
 }//function GetListenerVelocity
 
 //Gets the direction and the "up" vector of the Listener as a pair of 3-tuples
-//returns two 3-dimensional zero vectors on failure
 std::vector<float> Sound::getListenerOrientation() const
 {
-  if (!AL_Ready)
-  {
-    DuskLog() << "Sound::GetListenerOrientation: Warning: OpenAL is not init"
-              << "ialized, thus we cannot set the listener's position yet.\n";
-    return std::vector<float>(6, 0.0f);
-  }
-  if (InitInProgress)
-  {
-    DuskLog() << "Sound::GetListenerOrientation: ERROR: (De-)Initialization "
-              << "of OpenAL is in progress, thus we cannot set position here.\n";
-    return std::vector<float>(6, 0.0f);
-  }
-
-  ALenum error_state;
-  ALfloat orientation[6];
-  std::vector<float> result;
-
-  alGetError(); //clear error state
-  alGetListenerfv(AL_ORIENTATION, &orientation[0]);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::GetListenerOrientation: ERROR: Could not get listener "
-              << "orientation.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM:
-           DuskLog() << "    The enumeration parameter is not valid.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The value pointer is invalid.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return std::vector<float>(6, 0.0f); //"return false"
-  }//if
-  //fill vector (ALenum directly converts to int)
-  for (error_state=0; error_state<6; error_state++)
-  {
-    result.push_back(orientation[error_state]);
-  }
-  return result;
+  return std::vector<float>(m_ListenerOrientation, m_ListenerOrientation+6);
 }
 
 //rotate Listener orientation around x-, y- or z-axis... ONLY ONE OF THEM
@@ -844,41 +1344,13 @@ bool Sound::rotateListener(const float x_axis, const float y_axis, const float z
     return false;
   }
 
-  ALenum error_state;
-  ALfloat orientation[6];
-  ALfloat new_orientation[6];
-
-  alGetError(); //clear error state
-  alGetListenerfv(AL_ORIENTATION, &orientation[0]);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Sound::ListenerRotate: ERROR: Could not get listener's "
-              << "orientation, thus we cannot rotate.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n";
-           break;
-      case AL_INVALID_ENUM:
-           DuskLog() << "    The enum parameter is invalid.\n";
-           break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value.\n";
-           break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n";
-           break;
-    }//swi
-    return false;
-  }//if
-
+  const float * orientation = m_ListenerOrientation;
+  float new_orientation[6];
+  unsigned int i;
   //initialisation of new values with old values
-  //note: error_state is of ALenum, but ALenum directly converts to int
-  for (error_state=0; error_state<6; error_state++)
+  for (i=0; i<6; i++)
   {
-    new_orientation[error_state] = orientation[error_state];
+    new_orientation[i] = orientation[i];
   }//for
 
 
@@ -919,27 +1391,12 @@ bool Sound::rotateListener(const float x_axis, const float y_axis, const float z
     new_orientation[3] = orientation[3]*cosinus - orientation[4]*sinus;//up-vector,x
     new_orientation[4] = orientation[3]*sinus + orientation[4]*cosinus;//up-vector,y
   }//if z_axis
-  //set new values for at- & up-vector
-  alListenerfv(AL_ORIENTATION, &new_orientation[0]);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  //set new values for at- & up-vector, sent with the next update()
+  for (i=0; i<6; i++)
   {
-    DuskLog() << "Sound::ListenerRotate: ERROR: Could not set new orientation "
-              << "of listener.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM:
-           DuskLog() << "    Invalid enum parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value pointer given.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    m_ListenerOrientation[i] = new_orientation[i];
+  }//for
+  m_ListenerDirty |= 4;
   return true; //seems like wie made it :)
 }
 
@@ -71,6 +71,17 @@
      - 2011-08-05 (rev 296) - function to retrieve default device name added
      - 2011-08-13 (rev 297) - minor fix in getAvailableDevices() function
      - 2013-05-30           - adjustment of some types for non-32bit-architectures
+     - 2026-10-19           - streamed Ogg Vorbis media; updateStreams() added
+     - 2026-10-19           - asynchronous media loading (createMediaAsync());
+                              updateStreams() replaced by update()
+     - 2026-10-19           - fixed pool of voices for the virtual sources
+     - 2026-10-19           - cache for the buffers of media (per file)
+     - 2026-10-19           - OpenAL calls for sources and listener are done by
+                              a separate audio thread
+     - 2026-10-19           - loopback device and logStatistics() added
+     - 2026-10-19           - all OpenAL calls after init() are done by the
+                              audio thread, including buffer creation and
+                              deletion; runOnAudioThread() added
 
  ToDo list:
      - ???
@@ -82,7 +93,11 @@
 #ifndef SOUND_H
 #define SOUND_H
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 #if defined(_WIN32)
@@ -105,6 +120,11 @@
 namespace Dusk
 {
 
+//forward declarations
+class ThreadPool;
+class AudioThread;
+struct AudioCommand;
+
 //Klasse Sound
 class Sound
 {
@@ -121,11 +141,16 @@ class Sound
           PathToLib_Vorbisfile - path to libvorbisfile.so/vorbisfile.dll
                          if empty string or string literal "NULL" is given, a
                          predefined, platform-dependent value will be used.
+          loopback     - if set to true, a loopback device (extension
+                         ALC_SOFT_loopback of OpenAL Soft) is used instead of
+                         the default output device. Its mix is rendered by the
+                         audio thread and discarded, so no audio hardware is
+                         needed, e.g. for measurements on a headless machine.
       remarks:
           You need to call this function once before you can use any other
           functionality of this class.
     */
-    bool init(std::string PathToLib_AL="NULL", std::string PathToLib_Vorbisfile="NULL", const bool needVorbis=false);//initializes OpenAL
+    bool init(std::string PathToLib_AL="NULL", std::string PathToLib_Vorbisfile="NULL", const bool needVorbis=false, const bool loopback=false);//initializes OpenAL
 
     /* De-initialises the Sund class and returns true on success. */
     bool exit();//deinitializes OpenAL
@@ -133,6 +158,17 @@ class Sound
     /* Returns true, if Sound is initialised. */
     bool isInitialized() const;
 
+    /* Returns true, if Sound was initialised with a loopback device. */
+    bool isLoopback() const;
+
+    /* Writes the number, duration and throughput of the recorded operations
+       (see SoundStatistics) and the current memory usage to the log.
+    */
+    void logStatistics() const;
+
+    /* sampling rate of the loopback device */
+    static const unsigned int cLoopbackFrequency = 44100;
+
     // **presence checks**
     /* Returns true, if a Media named mediaIdentifier is present */
     bool isMediaPresent(const std::string& mediaIdentifier) const;
@@ -140,6 +176,11 @@ class Sound
     /* Returns true, if a Source named sourceIdentifier is present */
     bool isSourcePresent(const std::string& sourceIdentifier) const;
 
+    /* Returns true, if a media named mediaIdentifier is still being loaded
+       after a call to createMediaAsync()
+    */
+    bool isMediaPending(const std::string& mediaIdentifier) const;
+
     /* returns reference to the requested media, if present.
        If the media is not present, the function will throw an exception.
     */
@@ -179,16 +220,142 @@ class Sound
     /* Tries to create a media named MediaIdentifier from the file at
        PathToMedia and returns true on success.
 
+      parameters:
+          MediaIdentifier - unique name of the new media
+          PathToMedia     - path to the Wave or Ogg Vorbis file
+          streamed        - if set to true, Ogg Vorbis files will not be
+                            decoded completely, but streamed while playing,
+                            which keeps memory usage small for long files like
+                            music. Wave files are always loaded completely.
+
       remarks:
           Only Wave and OggVorbis files are currently accepted as media files.
     */
-    bool createMedia(const std::string& MediaIdentifier, const std::string& PathToMedia);
+    bool createMedia(const std::string& MediaIdentifier, const std::string& PathToMedia, const bool streamed=false);
+
+    /* Starts to load the media named MediaIdentifier from the file at
+       PathToMedia in the background and returns immediately. Returns true, if
+       loading could be started, false otherwise.
+
+      remarks:
+          The file is read and decoded by a worker thread, the AL buffers are
+          created and filled by the audio thread, and the media is created by
+          a later call of update(). Until then, the media is not
+          present (see isMediaPending()), but attachWhenReady() can be used to
+          attach it to sources as soon as it is available.
+          Only Wave and OggVorbis files are currently accepted as media files.
+    */
+    bool createMediaAsync(const std::string& MediaIdentifier, const std::string& PathToMedia);
+
+    /* Attaches the media named MediaIdentifier to the source named
+       SourceIdentifier and, if autoPlay is true, starts playback. If the
+       media is still being loaded, this will be done as soon as the media is
+       ready. Returns true on success, or if the request was recorded for a
+       pending media.
+    */
+    bool attachWhenReady(const std::string& SourceIdentifier, const std::string& MediaIdentifier, const bool autoPlay=true);
 
     /* Tries to destroy the media named MediaIdentifier and returns true on
        success, false on failure.
+
+      remarks:
+          Destroying a pending media cancels its creation.
     */
     bool destroyMedia(const std::string& MediaIdentifier);
 
+    /* Creates the buffers of media which were loaded in the background,
+       assigns the voices to the most audible sources and sends the changes of
+       source and listener properties to the audio thread.
+       This function should be called once per frame.
+
+      remarks:
+          There is only a limited number of real OpenAL sources (voices, see
+          cMaxVoices). If more sources are playing, only those with the highest
+          priority * volume * distance attenuation are heard. The others keep
+          their playback offset and continue from there, when they get a voice
+          again.
+          All OpenAL calls for sources and the listener are done by a separate
+          audio thread, which also refills the buffer queues of streamed media.
+          Changes of volume, position and velocity are only sent once per
+          frame, no matter how often they were set.
+    */
+    void update();
+
+    /* maximum number of voices, i.e. sources that can be heard at the same
+       time (the OpenAL implementation may allow less)
+    */
+    static const unsigned int cMaxVoices = 32;
+
+    // **voice pool** - used by Source
+    /* takes a free voice from the pool and returns true, or returns false, if
+       all voices are in use
+    */
+    bool acquireVoice(ALuint& voice);
+
+    /* puts a voice that was taken by acquireVoice() back into the pool */
+    void returnVoice(const ALuint voice);
+
+    // **media cache**
+    /* Sets the memory budget of the media cache in bytes.
+
+      remarks:
+          The buffers of all media that were created from the same file are
+          shared, so every file is only decoded once. Buffers stay in the cache
+          after their media was destroyed, until the cache exceeds its budget.
+          Then the least recently used buffers that are not attached to any
+          source are deleted, and the media that used them are unloaded. An
+          unloaded media is loaded again when it is attached to a source.
+    */
+    void setCacheBudget(const std::size_t bytes);
+
+    /* returns the memory budget of the media cache in bytes */
+    std::size_t getCacheBudget() const;
+
+    /* returns the number of bytes in the buffers of all cached files */
+    std::size_t getCacheSize() const;
+
+    /* default memory budget of the media cache in bytes */
+    static const std::size_t cDefaultCacheBudget = 64*1024*1024;
+
+    /* Makes sure that media has its buffers and increases the number of
+       references to them. Returns false, if the media could not be loaded.
+       Used by Source::attach().
+    */
+    bool acquireMediaBuffers(Media& media);
+
+    /* decreases the number of references to the buffers of media; used by
+       Source::detach()
+    */
+    void releaseMediaBuffers(const Media& media);
+
+    // **audio thread** - used by Source and MediaBuffers
+    /* sends cmd to the audio thread and returns its sequence number */
+    uint64_t pushAudioCommand(const AudioCommand& cmd);
+
+    /* Runs function on the audio thread, which does all OpenAL calls once
+       the sound system is initialised. If wait is true, the call returns
+       after function was executed, so function can pass results back through
+       variables it captured by reference. Otherwise it runs with the next
+       iteration of the audio thread.
+       If there is no audio thread, or if the audio thread calls this itself,
+       function is executed right away.
+
+      remarks:
+          Must only be called by the game thread or the audio thread.
+    */
+    void runOnAudioThread(const std::function<void()>& function, const bool wait) const;
+
+    /* Lets the audio thread delete the given AL buffers (see
+       AudioThread::discardBuffers()). Can be called by any thread.
+    */
+    void discardBuffers(const std::vector<ALuint>& buffers, const std::shared_ptr<MappedFile>& staticData) const;
+
+    /* Retrieves the state and offset of a voice as last published by the
+       audio thread. Returns false, if the command with the given sequence
+       number was not executed yet. (See AudioThread::getVoiceState().)
+    */
+    bool getVoiceState(const ALuint voice, const uint64_t sequence, ALint& state, float& offset) const;
+
     // **general state query/set functions**
     /* Returns the speed of sound in world units per second, or zero if there
        was an error.
@@ -243,11 +410,75 @@ class Sound
     /* empty copy constructor */
     Sound(const Sound& op){}
 
+    /* state of a media that is loaded via createMediaAsync() */
+    struct PendingMedia
+    {
+      std::string path;
+      bool isOgg;
+      DecodedMedia pcm; //written by the worker thread until done is set
+      bool success;     //written by the worker thread until done is set
+      std::atomic<bool> done;
+      bool uploading; //whether the audio thread was asked to create buffers
+      std::shared_ptr<MediaBuffers> buffers; //written by the audio thread
+                                             //until uploaded is set
+      std::atomic<bool> uploaded;
+      std::vector<std::pair<std::string, bool> > requests; //source name and
+                                      //autoPlay flag of attachWhenReady() calls
+    };
+
+    /* lets the audio thread create the buffers for media whose data was
+       loaded by the worker thread, creates the media once their buffers are
+       ready and handles the requests for them
+    */
+    void finishPendingMedia();
+
+    /* binds the voices to the most audible sources */
+    void updateVoices();
+
+    /* sends the listener properties to the audio thread, if they changed */
+    void flushListener();
+
+    /* entry of the media cache */
+    struct CachedBuffers
+    {
+      std::shared_ptr<MediaBuffers> buffers;
+      unsigned int references; //number of attachments of media using buffers
+      unsigned long int lastUse; //value of m_CacheClock at the last use
+    };
+
+    /* adds the buffers of media to the cache, if its file is not cached yet */
+    void addToCache(const Media& media);
+
+    /* Deletes the least recently used buffers which are not referenced, until
+       the cache is within its budget.
+
+       parameters:
+           keepPath - file name whose buffers shall not be deleted
+    */
+    void trimCache(const std::string& keepPath);
+
+    /* factor for the audibility of sources that already have a voice */
+    static constexpr float cVoiceHysteresis = 1.2f;
+
     std::map<std::string, Media*> m_MediaList;
     std::map<std::string, Source*> m_SourceList;
+    std::map<std::string, std::shared_ptr<PendingMedia> > m_PendingMedia;
+    ThreadPool* m_Loader; //created on first use
+    std::vector<ALuint> m_Voices; //all voices
+    std::vector<ALuint> m_FreeVoices; //voices which are not bound to a source
+    std::map<std::string, CachedBuffers> m_BufferCache; //key: file name
+    std::size_t m_CacheSize;
+    std::size_t m_CacheBudget;
+    unsigned long int m_CacheClock;
+    AudioThread* m_AudioThread;
+    float m_ListenerPosition[3];
+    float m_ListenerVelocity[3];
+    float m_ListenerOrientation[6]; //"at" vector followed by "up" vector
+    unsigned int m_ListenerDirty; //properties that changed since the last flush
 
     ALCdevice *pDevice;
     ALCcontext *pContext;
+    bool m_Loopback;
     bool AL_Ready;
     bool InitInProgress;
 };//class Sound
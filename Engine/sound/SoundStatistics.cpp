@@ -0,0 +1,154 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#include "SoundStatistics.h"
+
+namespace Dusk
+{
+
+SoundStatistics::SoundStatistics()
+: m_Enabled(false)
+{
+  reset();
+}
+
+SoundStatistics& SoundStatistics::get()
+{
+  static SoundStatistics Instance;
+  return Instance;
+}
+
+void SoundStatistics::setEnabled(const bool enabled)
+{
+  m_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool SoundStatistics::isEnabled() const
+{
+  return m_Enabled.load(std::memory_order_relaxed);
+}
+
+void SoundStatistics::reset()
+{
+  unsigned int i;
+  for (i=0; i<opCount; ++i)
+  {
+    m_Counters[i].count = 0;
+    m_Counters[i].totalTime = 0;
+    m_Counters[i].maxTime = 0;
+    m_Counters[i].bytes = 0;
+  }//for
+}
+
+void SoundStatistics::record(const Operation op, const uint64_t nanoseconds, const uint64_t bytes)
+{
+  if ((op>=opCount) or !isEnabled())
+  {
+    return;
+  }
+  Counter& c = m_Counters[op];
+  c.count.fetch_add(1, std::memory_order_relaxed);
+  c.totalTime.fetch_add(nanoseconds, std::memory_order_relaxed);
+  c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  uint64_t current = c.maxTime.load(std::memory_order_relaxed);
+  while ((nanoseconds>current)
+         and !c.maxTime.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+  {
+    //current has been reloaded, try again
+  }
+}
+
+uint64_t SoundStatistics::getCount(const Operation op) const
+{
+  if (op>=opCount) return 0;
+  return m_Counters[op].count.load(std::memory_order_relaxed);
+}
+
+uint64_t SoundStatistics::getTotalTime(const Operation op) const
+{
+  if (op>=opCount) return 0;
+  return m_Counters[op].totalTime.load(std::memory_order_relaxed);
+}
+
+uint64_t SoundStatistics::getMaxTime(const Operation op) const
+{
+  if (op>=opCount) return 0;
+  return m_Counters[op].maxTime.load(std::memory_order_relaxed);
+}
+
+uint64_t SoundStatistics::getBytes(const Operation op) const
+{
+  if (op>=opCount) return 0;
+  return m_Counters[op].bytes.load(std::memory_order_relaxed);
+}
+
+const char* SoundStatistics::getName(const Operation op)
+{
+  switch (op)
+  {
+    case opCreateMedia:
+         return "createMedia";
+    case opDestroyMedia:
+         return "destroyMedia";
+    case opCreateSource:
+         return "createSource";
+    case opDestroySource:
+         return "destroySource";
+    case opUpdate:
+         return "update";
+    case opCommand:
+         return "audio command";
+    case opDecode:
+         return "decode";
+    case opStreamRefill:
+         return "stream refill";
+    default:
+         return "unknown";
+  }//swi
+}
+
+SoundStatistics::Timer::Timer(const Operation op)
+: m_Operation(op),
+  m_Active(SoundStatistics::get().isEnabled()),
+  m_Bytes(0),
+  m_Start()
+{
+  if (m_Active)
+  {
+    m_Start = std::chrono::steady_clock::now();
+  }
+}
+
+SoundStatistics::Timer::~Timer()
+{
+  if (m_Active)
+  {
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now()-m_Start;
+    SoundStatistics::get().record(m_Operation,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), m_Bytes);
+  }
+}
+
+void SoundStatistics::Timer::setBytes(const uint64_t bytes)
+{
+  m_Bytes = bytes;
+}
+
+} //namespace
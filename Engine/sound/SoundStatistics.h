@@ -0,0 +1,133 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+#ifndef SOUND_SOUNDSTATISTICS_H_INCLUDED
+#define SOUND_SOUNDSTATISTICS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+namespace Dusk
+{
+
+/* class SoundStatistics:
+       collects the number and duration of the costly operations of the sound
+       system, e.g. decoding, media creation or the commands executed by the
+       audio thread. Recording is off by default and costs only one atomic
+       load per operation then. All functions are thread-safe, because the
+       operations happen on the game thread, the loader thread and the audio
+       thread.
+       Sound::logStatistics() writes a report including the memory usage.
+*/
+class SoundStatistics
+{
+  public:
+    /* kinds of recorded operations */
+    enum Operation {opCreateMedia, opDestroyMedia, opCreateSource,
+                    opDestroySource, opUpdate, opCommand, opDecode,
+                    opStreamRefill, opCount};
+
+    /* singleton access method */
+    static SoundStatistics& get();
+
+    /* turns recording on or off */
+    void setEnabled(const bool enabled);
+
+    /* returns true, if operations are recorded */
+    bool isEnabled() const;
+
+    /* sets all counters to zero */
+    void reset();
+
+    /* records a single operation
+
+       parameters:
+           op          - kind of the operation
+           nanoseconds - duration of the operation
+           bytes       - amount of processed data, e.g. decoded PCM bytes
+    */
+    void record(const Operation op, const uint64_t nanoseconds, const uint64_t bytes=0);
+
+    /* returns the number of recorded operations of the given kind */
+    uint64_t getCount(const Operation op) const;
+
+    /* returns the total duration of all operations of the given kind in
+       nanoseconds
+    */
+    uint64_t getTotalTime(const Operation op) const;
+
+    /* returns the duration of the slowest operation of the given kind in
+       nanoseconds
+    */
+    uint64_t getMaxTime(const Operation op) const;
+
+    /* returns the number of bytes processed by operations of the given kind */
+    uint64_t getBytes(const Operation op) const;
+
+    /* returns a readable name for the operation */
+    static const char* getName(const Operation op);
+
+    /* class Timer:
+           measures the time between its construction and destruction and
+           records it as one operation, if recording is enabled
+    */
+    class Timer
+    {
+      public:
+        /* constructor - starts the measurement */
+        Timer(const Operation op);
+
+        /* destructor - records the operation */
+        ~Timer();
+
+        /* sets the amount of processed data that will be recorded */
+        void setBytes(const uint64_t bytes);
+      private:
+        /* private copy constructor - a timer measures one operation only */
+        Timer(const Timer& op) {}
+
+        Operation m_Operation;
+        bool m_Active;
+        uint64_t m_Bytes;
+        std::chrono::steady_clock::time_point m_Start;
+    };//class Timer
+  private:
+    /* constructor - private due to singleton pattern */
+    SoundStatistics();
+
+    /* empty copy constructor */
+    SoundStatistics(const SoundStatistics& op) {}
+
+    struct Counter
+    {
+      std::atomic<uint64_t> count;
+      std::atomic<uint64_t> totalTime;
+      std::atomic<uint64_t> maxTime;
+      std::atomic<uint64_t> bytes;
+    };
+
+    Counter m_Counters[opCount];
+    std::atomic<bool> m_Enabled;
+};//class
+
+} //namespace
+
+#endif // SOUND_SOUNDSTATISTICS_H_INCLUDED
@@ -19,39 +19,38 @@
 */
 
 #include "Source.h"
+#include <cmath>
+#include <limits>
 #include "../Messages.h"
+#include "AudioThread.h"
+#include "MediaOggVorbisStream.h"
+#include "Sound.h"
 
 namespace Dusk
 {
 
+//flags for the properties that changed since the last flushProperties()
+const unsigned int cDirtyGain     = 1;
+const unsigned int cDirtyPosition = 2;
+const unsigned int cDirtyVelocity = 4;
+
 Source::Source(const std::string& identifier)
 : m_Name(identifier),
   sourceID(0),
-  attachedMedia(NULL)
+  m_HasVoice(false),
+  attachedMedia(NULL),
+  m_State(psStopped),
+  m_Offset(0.0f),
+  m_OffsetTime(std::chrono::steady_clock::now()),
+  m_Volume(1.0f),
+  m_Looping(false),
+  m_Priority(1.0f),
+  m_Dirty(0),
+  m_LastCommand(0)
 {
-  alGetError(); //clear error state
-  alGenSources(1, &sourceID);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::Source: Error while creating AL source.\n";
-    switch (error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The provided array pointer is not valid.\n";
-           break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n";
-           break;
-      case AL_OUT_OF_MEMORY:
-           DuskLog() << "    Not enough memory to generate the source.\n";
-           break;
-      default:
-           DuskLog()<<"    Unknown error occured. Error code: "
-                    <<(int)error_state<<".\n"; break;
-    }//swi
-    throw SourceCreationException();
-  }
+  //no AL source here - voices are taken from the pool of Sound when needed
+  m_Position[0] = m_Position[1] = m_Position[2] = 0.0f;
+  m_Velocity[0] = m_Velocity[1] = m_Velocity[2] = 0.0f;
 }
 
 Source::~Source()
@@ -62,26 +61,11 @@ Source::~Source()
     //detach media. Result does not matter, source will be deleted anyway
     detach();
   }//if
-  //delete source
-  alGetError(); //clear error state
-  alDeleteSources(1, &sourceID);
-  const ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::~Source: ERROR: could not delete source.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt structure?\n";
-           break;
-      default:
-           DuskLog()<<"    Unknown error occured. Error code: "
-                    <<(int)error_state<<".\n"; break;
-    }//swi
-    throw SourceDestructionException();
-  }//if
+  //give voice back to the pool
+  if (m_HasVoice)
+  {
+    Sound::get().returnVoice(releaseVoice());
+  }
 }
 
 const std::string& Source::getIdentifier() const
@@ -103,33 +87,54 @@ bool Source::attach(Media& theMedia)
     }
   }
 
-  alGetError();//clear error state
-  //queue all of media's buffers to the source
-  alSourceQueueBuffers(sourceID, theMedia.getNumberOfBuffers(), theMedia.getBufferPointer());
-  ALenum error_state = alGetError();
-  if (error_state!= AL_NO_ERROR)
+  if (theMedia.isStreaming())
   {
-    DuskLog() << "Source::attach: ERROR while queueing buffers to source.\n";
-    switch (error_state)
+    //the buffer queue of a stream belongs to exactly one source
+    if (!theMedia.getRelatedSources().empty())
     {
-      case AL_INVALID_NAME:
-           DuskLog() <<"    The source name or one of the buffer names is not "
-                     <<"valid.\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() <<"    There is no context, the source has already a static"
-                     <<" buffer attached or the new buffer has not the same "
-                     <<"format as the other buffers in the queue.\n"; break;
-      default:
-           DuskLog() <<"    Unknown error. Error code: "<<(int)error_state<<".\n";
-           break;
-    }//swi
+      DuskLog() << "Source::attach: ERROR: Streamed media \""
+                << theMedia.getIdentifier() << "\" is already attached to "
+                << "source \"" << theMedia.getRelatedSources().front()
+                << "\" and cannot be attached to \"" << m_Name << "\".\n";
+      return false;
+    }
+    //AL_LOOPING would only loop the queued buffers, so the stream loops instead
+    static_cast<MediaOggVorbisStream&>(theMedia).setLooping(m_Looping);
+  }
+  //media may have been unloaded by the cache of Sound
+  if (!Sound::get().acquireMediaBuffers(theMedia))
+  {
+    DuskLog() << "Source::attach: ERROR: Buffers of media \""
+              << theMedia.getIdentifier() << "\" are not available.\n";
     return false;
-  }//if
+  }
+  //without a voice, the buffers will be queued when the source gets one
+  if (m_HasVoice)
+  {
+    queueMedia(theMedia);
+  }
   attachedMedia = &theMedia;
+  m_State = psStopped;
+  m_Offset = 0.0f;
   theMedia.notifyAttached(m_Name);
   return true;
 }
 
+void Source::queueMedia(Media& theMedia)
+{
+  AudioCommand cmd;
+  cmd.type = AudioCommand::acQueue;
+  if (theMedia.isStreaming())
+  {
+    cmd.stream = static_cast<MediaOggVorbisStream*>(&theMedia);
+  }
+  else
+  {
+    cmd.buffers = theMedia.getBuffers();
+  }
+  sendCommand(cmd);
+}
+
 bool Source::detach()
 {
   if (attachedMedia==NULL)
@@ -137,37 +142,17 @@ bool Source::detach()
     //no attached media present, we don't need detach here and are done :)
     return true;
   }
-  //stop playback of source, in case it is playing (or paused)
-  alSourceStop(sourceID);
-
-  alGetError();//clear error state
-  //actual detach
-  alSourceUnqueueBuffers(sourceID, attachedMedia->getNumberOfBuffers(),
-                         attachedMedia->getNonConstBufferPointer());
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  if (m_HasVoice)
   {
-    DuskLog() << "Source::detach: ERROR: couldn't detach buffers from source \""
-              << m_Name<<"\" (attached media: \""<<attachedMedia->getIdentifier()
-              <<"\").\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name ("<<sourceID
-                     << "). Corrupt data structure?\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    At least one buffer is still being processed and "
-                     << "could not be detached.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    AudioCommand cmd;
+    cmd.type = AudioCommand::acUnqueue;
+    sendCommand(cmd);
+  }
+  m_State = psStopped;
+  m_Offset = 0.0f;
   //notify media about being detached
   attachedMedia->notifyDetached(m_Name);
+  Sound::get().releaseMediaBuffers(*attachedMedia);
   //source
   attachedMedia = NULL;
   return true;
@@ -190,518 +175,396 @@ const Media& Source::getAttachedMedia() const
 
 bool Source::play()
 {
-  alGetError(); //clear error state
-  alSourcePlay(sourceID);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  if (m_State==psPlaying)
   {
-    DuskLog() << "Source::play: ERROR: could not play source.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    //playing sources start over, like OpenAL does it
+    m_Offset = 0.0f;
+  }
+  m_State = psPlaying;
+  if (!m_HasVoice)
+  {
+    m_OffsetTime = std::chrono::steady_clock::now();
+    //if all voices are taken, the next Sound::update() decides whether this
+    //source is audible enough to get one
+    return tryBindVoice();
+  }
+  //changed properties have to arrive before the playback starts
+  flushProperties();
+  AudioCommand cmd;
+  cmd.type = AudioCommand::acPlay;
+  sendCommand(cmd);
   return true;
 }
 
 bool Source::pause()
 {
-  alGetError();//clear error state
-  alSourcePause(sourceID);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  if (m_State!=psPlaying)
   {
-    DuskLog() << "Source::pause: could not pause source object.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    //legal no-op
+    return true;
+  }
+  m_State = psPaused;
+  if (m_HasVoice)
+  {
+    AudioCommand cmd;
+    cmd.type = AudioCommand::acPause;
+    sendCommand(cmd);
+  }
   return true;
 }
 
 bool Source::unPause()
 {
-  ALenum error_state;
-  ALint source_state;
-
-  alGetError();//clear error state
-  alGetSourcei(sourceID, AL_SOURCE_STATE, &source_state);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::unPause: ERROR unable to check source state.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM: //should never occur, since AL_SOURCE_STATE is hardcoded
-           DuskLog() << "    Specified parameter is not valid.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
-
-  //check state
-  if (source_state == AL_PLAYING)
+  if (m_State!=psPaused)
   {
     DuskLog() << "Source::unPause: Hint: Source \""<<m_Name
-              <<"\" is already playing.\n";
+              << "\" was not paused yet, thus we do nothing here.\n";
+    return true;
   }
-  else if (source_state == AL_PAUSED)
-  {
-    alSourcePlay(sourceID);
-    error_state = alGetError();
-    if (error_state != AL_NO_ERROR)
-    {
-      DuskLog() << "Source::unPause: ERROR: unable to play source.\n";
-      switch(error_state)
-      {
-        case AL_INVALID_OPERATION:
-             DuskLog() << "    There is no current context.\n"; break;
-        case AL_INVALID_NAME:
-             DuskLog() << "    Invalid source name. Data corruption?\n"; break;
-        default:
-             DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                       << ".\n"; break;
-      }//swi
-      return false;
-    }//if
-  }//else if AL_PAUSED
-  else
+  m_State = psPlaying;
+  if (!m_HasVoice)
   {
-    DuskLog() << "Source::unPause: Hint: Source \""<<m_Name
-              << "\" was not paused yet, thus we do nothing here.\n";
-  }//else
+    m_OffsetTime = std::chrono::steady_clock::now();
+    return tryBindVoice();
+  }
+  flushProperties();
+  //playing a paused source continues at the current offset
+  AudioCommand cmd;
+  cmd.type = AudioCommand::acPlay;
+  sendCommand(cmd);
   return true;
 }
 
 bool Source::stop()
 {
-  alGetError();//clear error state
-  alSourceStop(sourceID);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  m_State = psStopped;
+  m_Offset = 0.0f;
+  if (m_HasVoice)
   {
-    DuskLog() << "Source::stop: could not stop source object.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    AudioCommand cmd;
+    cmd.type = AudioCommand::acStop;
+    sendCommand(cmd);
+  }
   return true;
 }
 
 bool Source::loop(const bool doLoop)
 {
-  alGetError();//clear error state
-  alSourcei(sourceID, AL_LOOPING, doLoop ? AL_TRUE : AL_FALSE);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  m_Looping = doLoop;
+  if ((attachedMedia!=NULL) and attachedMedia->isStreaming())
   {
-    DuskLog() << "Source::loop: ERROR: unable to set loop mode for source \""
-              << m_Name << "\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Data corruption?\n"; break;
-      case AL_INVALID_ENUM: //should never occur, AL_LOOPING is allowed enum type
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_VALUE: //should never occur, since AL_TRUE/AL_FALSE is valid
-           DuskLog() << "    Given value is out of range.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
+    static_cast<MediaOggVorbisStream*>(attachedMedia)->setLooping(doLoop);
+    return true;
+  }
+  if (m_HasVoice)
+  {
+    AudioCommand cmd;
+    cmd.type = AudioCommand::acLooping;
+    cmd.values[0] = doLoop ? 1.0f : 0.0f;
+    sendCommand(cmd);
+  }
   return true;
 }
 
 bool Source::setOffset(const float seconds)
 {
-  alGetError();//clear error state
-  alSourcef(sourceID, AL_SEC_OFFSET, seconds);
-  ALenum error_state = alGetError();
-  if (error_state!=AL_NO_ERROR)
+  if (seconds<0.0f)
   {
     DuskLog() << "Source::setOffset: ERROR: Unable to set offset for \""
-              << m_Name << "\" to "<<seconds<<" seconds.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM: //shouldn't happen, at least not with OpenAL 1.1
-           DuskLog() << "    Invalid enumeration parameter. Make sure you have"
-                     << " OpenAL 1.1 or higher installed.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    The given offset value is out of range.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Internal data corruption?\n";
-           break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//switch
+              << m_Name << "\" to "<<seconds<<" seconds.\n"
+              << "    The given offset value is out of range.\n";
     return false;
-  }//if
+  }
+  m_Offset = seconds;
+  m_OffsetTime = std::chrono::steady_clock::now();
+  if (m_HasVoice)
+  {
+    AudioCommand cmd;
+    cmd.type = AudioCommand::acOffset;
+    cmd.values[0] = seconds;
+    sendCommand(cmd);
+  }
   return true;
 }
 
 float Source::getOffset() const
 {
-  alGetError();//clear error state
-  ALfloat seconds;
-  alGetSourcef(sourceID, AL_SEC_OFFSET, &seconds);
-  ALenum error_state = alGetError();
-  if (error_state!=AL_NO_ERROR)
+  ALint source_state = AL_INITIAL;
+  float seconds = 0.0f;
+  if (m_HasVoice and (m_State!=psStopped)
+      and Sound::get().getVoiceState(sourceID, m_LastCommand, source_state, seconds))
   {
-    DuskLog() << "Source::getOffset: ERROR: Unable to get offset for \""
-              << m_Name << "\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_ENUM: //shouldn't happen, at least not with OpenAL 1.1
-           DuskLog() << "    Invalid enumeration parameter. Make sure you have"
-                     << " OpenAL 1.1 or higher.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Internal data corruption?\n";
-           break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//switch
-    return -1.0;
-  }//if
-  return seconds;
+    return seconds;
+  }
+  //no voice, or the audio thread did not get that far yet
+  return m_Offset;
 }
 
 bool Source::isPlaying() const
 {
-  ALint source_state;
-  alGetError(); //clear error state
-  alGetSourcei(sourceID, AL_SOURCE_STATE, &source_state);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::isPlaying: ERROR: unable to retrieve source state.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Data corruption?\n"; break;
-      case AL_INVALID_ENUM: //should never occur, AL_SOURCE_STATE is valid enum
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
-  return (source_state==AL_PLAYING);
+  return (m_State==psPlaying);
 }
 
 bool Source::isLooping() const
 {
-  alGetError(); //clear error state
-  ALint loop_state;
-  alGetSourcei(sourceID, AL_LOOPING, &loop_state);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  if ((attachedMedia!=NULL) and attachedMedia->isStreaming())
   {
-    DuskLog() << "Source::isLooping: ERROR: unable to retrieve source state.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Data corruption?\n"; break;
-      case AL_INVALID_ENUM: //should never occur, AL_LOOPING is valid enum
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer value.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return false;
-  }//if
-  return (loop_state==AL_TRUE);
+    return static_cast<const MediaOggVorbisStream*>(attachedMedia)->isLooping();
+  }
+  return m_Looping;
 }
 
 bool Source::setVolume(const float volume)
 {
-  alGetError(); //clear error state
-  alSourcef(sourceID, AL_GAIN, volume);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  //negative values would be refused by OpenAL
+  if (volume<0.0f)
   {
     DuskLog() << "Source::setVolume: ERROR: Could not set volume for "
-              << "source \""<<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Value out of range.\n"; break;
-      case AL_INVALID_ENUM: //should never occur, because AL_GAIN is valid
-           DuskLog() << "    Invalid parameter.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source("<<sourceID<<"). Corrupt "
-                     << "source list?\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
+              << "source \""<<m_Name<<"\".\n    Value out of range.\n";
     return false;
-  }//if
+  }
   if (volume >1.0f)
   {
     DuskLog() << "Source::setVolume: Warning: Some OpenAL implementations cut "
               << "volume values larger than 1.0 down to 1.0.\n";
   }//if
+  m_Volume = volume;
+  m_Dirty |= cDirtyGain;
   return true;
 }
 
 float Source::getVolume(const bool consider_MinMax) const
 {
-  alGetError(); //clear error state
-  ALfloat volume_info;
-  alGetSourcef(sourceID, AL_GAIN, &volume_info);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  //default bounds of OpenAL are 0.0 and 1.0
+  if (consider_MinMax and (m_Volume>1.0f))
   {
-    DuskLog() << "Source::getVolume: ERROR: Could not retrieve source state "
-              << "for \""<<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value pointer.\n"; break;
-      case AL_INVALID_ENUM: //should never occur here, AL_GAIN is valid
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    The specified source ("<<sourceID<<") is"
-                     << " not valid. Corrupt list?\n"; break;
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return 0.0f; //assume something
-  }//if
-  //no error so far
-  if (!consider_MinMax)
+    return 1.0f;
+  }
+  return m_Volume;
+}
+
+bool Source::setPosition(const float x, const float y, const float z)
+{
+  m_Position[0] = x;
+  m_Position[1] = y;
+  m_Position[2] = z;
+  m_Dirty |= cDirtyPosition;
+  return true;
+}
+
+std::vector<float> Source::getPosition() const
+{
+  return std::vector<float>(m_Position, m_Position+3);
+}
+
+bool Source::setVelocity(const float x, const float y, const float z)
+{
+  m_Velocity[0] = x;
+  m_Velocity[1] = y;
+  m_Velocity[2] = z;
+  m_Dirty |= cDirtyVelocity;
+  return true;
+}
+
+std::vector<float> Source::getVelocity() const
+{
+  return std::vector<float>(m_Velocity, m_Velocity+3);
+}
+
+void Source::setPriority(const float priority)
+{
+  m_Priority = (priority>0.0f) ? priority : 0.0f;
+}
+
+float Source::getPriority() const
+{
+  return m_Priority;
+}
+
+bool Source::hasVoice() const
+{
+  return m_HasVoice;
+}
+
+bool Source::needsVoice() const
+{
+  if (attachedMedia==NULL)
+  {
+    return false;
+  }
+  //a paused stream keeps its voice, because it cannot resume at an offset
+  return (m_State==psPlaying)
+      or ((m_State==psPaused) and m_HasVoice and attachedMedia->isStreaming());
+}
+
+float Source::getAudibility(const std::vector<float>& listener) const
+{
+  if ((attachedMedia!=NULL) and attachedMedia->isStreaming())
   {
-    return volume_info;
+    //streams (usually music) are never culled
+    return std::numeric_limits<float>::max();
   }
-  ALfloat bound_on_gain =0.0f;
-  alGetSourcef(sourceID, AL_MIN_GAIN, &bound_on_gain);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  const float dx = m_Position[0]-listener.at(0);
+  const float dy = m_Position[1]-listener.at(1);
+  const float dz = m_Position[2]-listener.at(2);
+  const float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
+  //inverse distance clamped model with a reference distance of 1.0, which is
+  //the default model of OpenAL
+  if (distance<=1.0f)
+  {
+    return m_Priority * m_Volume;
+  }
+  return m_Priority * m_Volume / distance;
+}
+
+void Source::updatePlayState()
+{
+  if ((m_State!=psPlaying) or (attachedMedia==NULL))
   {
-    DuskLog() << "Source::getVolume: ERROR: Could not retrieve minimum "
-              << "bound on volume for source \"" <<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value pointer.\n"; break;
-      case AL_INVALID_ENUM: //should never occur here
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      /*AL_INVALID_NAME or AL_INVALID_OPERATION should not occur here, cause
-        they would have already occured on the last call to alGetSourcef and
-        we would not even get this far. ;)*/
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return volume_info; //return the gain value, though it might be beyond
-                      // the minimum value. But we don't have a choice here.
-  }//if
-  //correct volume value, if below minimum
-  if (bound_on_gain>volume_info)
-  {
-    volume_info = bound_on_gain;
-  }//if min_gain > actual gain
-  alGetSourcef(sourceID, AL_MAX_GAIN, &bound_on_gain);
-  error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::getVolume: ERROR: Could not retrieve maximum "
-              << "bound on volume for source \"" <<m_Name<<"\".\n";
-    switch(error_state)
+    return;
+  }
+  if (!m_HasVoice)
+  {
+    //nobody plays a virtual source, so the time has to pass here - sources
+    // have no pitch, so they always play at normal speed
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    m_Offset += std::chrono::duration<float>(now - m_OffsetTime).count();
+    m_OffsetTime = now;
+    const float duration = attachedMedia->getDuration();
+    if ((duration>0.0f) and (m_Offset>=duration))
     {
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid value pointer.\n"; break;
-      case AL_INVALID_ENUM: //should never occur here
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      /*AL_INVALID_NAME or AL_INVALID_OPERATION should not occur here, cause
-        they would have already occured on the last call to alGetSourcef and
-        we would not even get this far. ;)*/
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return volume_info; //return the gain value, though it might be beyond
-                        // the maximum value. But we don't have a choice here.
-  }//if
-  //correct volume value, if above maximum
-  if (bound_on_gain<volume_info)
+      if (m_Looping)
+      {
+        m_Offset = std::fmod(m_Offset, duration);
+      }
+      else
+      {
+        m_State = psStopped;
+        m_Offset = 0.0f;
+      }
+    }//if end reached
+    return;
+  }
+  ALint source_state = AL_PLAYING;
+  float seconds = 0.0f;
+  if (Sound::get().getVoiceState(sourceID, m_LastCommand, source_state, seconds)
+      and (source_state==AL_STOPPED))
+  {
+    //end of a non-looping media or of a stream was reached
+    m_State = psStopped;
+    m_Offset = 0.0f;
+  }
+}
+
+void Source::flushProperties()
+{
+  if (!m_HasVoice or (m_Dirty==0))
+  {
+    return;
+  }
+  AudioCommand cmd;
+  if ((m_Dirty & cDirtyGain)!=0)
+  {
+    cmd.type = AudioCommand::acGain;
+    cmd.values[0] = m_Volume;
+    sendCommand(cmd);
+  }
+  if ((m_Dirty & cDirtyPosition)!=0)
   {
-    volume_info = bound_on_gain;
-  }//if max < actual gain
-  return volume_info;
+    cmd.type = AudioCommand::acPosition;
+    cmd.values[0] = m_Position[0];
+    cmd.values[1] = m_Position[1];
+    cmd.values[2] = m_Position[2];
+    sendCommand(cmd);
+  }
+  if ((m_Dirty & cDirtyVelocity)!=0)
+  {
+    cmd.type = AudioCommand::acVelocity;
+    cmd.values[0] = m_Velocity[0];
+    cmd.values[1] = m_Velocity[1];
+    cmd.values[2] = m_Velocity[2];
+    sendCommand(cmd);
+  }
+  m_Dirty = 0;
 }
 
-bool Source::setPosition(const float x, const float y, const float z)
+bool Source::bindVoice(const ALuint voice)
 {
-  alGetError(); //clear error state
-  alSource3f(sourceID, AL_POSITION, x, y, z);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  sourceID = voice;
+  m_HasVoice = true;
+  const bool streamed = (attachedMedia!=NULL) and attachedMedia->isStreaming();
+
+  //transfer the whole state to the voice
+  m_Dirty = cDirtyGain | cDirtyPosition | cDirtyVelocity;
+  flushProperties();
+  AudioCommand cmd;
+  cmd.type = AudioCommand::acLooping;
+  cmd.values[0] = (m_Looping and !streamed) ? 1.0f : 0.0f;
+  sendCommand(cmd);
+  if (attachedMedia==NULL)
   {
-    DuskLog() << "Source::setPosition: ERROR: could not set position.\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Data corruption?\n"; break;
-      case AL_INVALID_ENUM: //should never happen, since AL_POSITION is valid
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Given values are out of range (x: "<<x<<"; y: "<<y
-                     << "; z: "<<z<<").\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//switch
-    return false;
-  }//if
+    return true;
+  }
+  queueMedia(*attachedMedia);
+  if (m_State!=psPlaying)
+  {
+    return true;
+  }
+  if (!streamed and (m_Offset>0.0f))
+  {
+    //continue where the source was culled
+    cmd.type = AudioCommand::acOffset;
+    cmd.values[0] = m_Offset;
+    sendCommand(cmd);
+  }
+  cmd.type = AudioCommand::acPlay;
+  sendCommand(cmd);
   return true;
 }
 
-std::vector<float> Source::getPosition() const
+ALuint Source::releaseVoice()
 {
-  std::vector<float> result(3, 0.0f);
-  alGetError(); //clear error state
-  alGetSource3f(sourceID, AL_POSITION, &result[0], &result[1], &result[2]);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  if (!m_HasVoice)
   {
-    DuskLog() << "Source::getPosition: ERROR: could not retrieve source "
-              << "state of \""<<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      case AL_INVALID_ENUM: //should never happen, AL_POSITION is valid
-           DuskLog() << "    Invalid enumeration parameter.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    At least one value pointer is invalid.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
-    return std::vector<float>(3, 0.0f);
-  }//if
-  return result;
+    return 0;
+  }
+  if ((m_State!=psStopped) and (attachedMedia!=NULL)
+      and !attachedMedia->isStreaming())
+  {
+    //keep the offset, so that playback can continue with the next voice
+    m_Offset = getOffset();
+  }
+  m_OffsetTime = std::chrono::steady_clock::now();
+  AudioCommand cmd;
+  cmd.type = (attachedMedia!=NULL) ? AudioCommand::acUnqueue : AudioCommand::acStop;
+  sendCommand(cmd);
+  const ALuint voice = sourceID;
+  sourceID = 0;
+  m_HasVoice = false;
+  m_Dirty = 0;
+  return voice;
 }
 
-bool Source::setVelocity(const float x, const float y, const float z)
+bool Source::tryBindVoice()
 {
-  alGetError(); //clear error state
-  alSource3f(sourceID, AL_VELOCITY, x, y, z);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
+  ALuint voice = 0;
+  if ((attachedMedia==NULL) or !Sound::get().acquireVoice(voice))
   {
-    DuskLog() << "Source::setVelocity: ERROR: could not set position for "
-              << "source \""<<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corruption of data?\n"; break;
-      case AL_INVALID_ENUM: //should never occur, AL_VELOCITY is valid enum
-           DuskLog() << "    Invalid enumeration value given.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Given values are out of range (x: "<<x<<"; y: "<<y
-                     << "; z: "<<z<<").\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//swi
+    //stays virtual for now
+    return true;
+  }
+  if (!bindVoice(voice))
+  {
+    Sound::get().returnVoice(releaseVoice());
     return false;
-  }//if
+  }
   return true;
 }
 
-std::vector<float> Source::getVelocity() const
+void Source::sendCommand(AudioCommand& cmd)
 {
-  std::vector<float> result(3, 0.0);
-
-  alGetError(); //clear error state
-  alGetSource3f(sourceID, AL_VELOCITY, &result[0], &result[1], &result[2]);
-  ALenum error_state = alGetError();
-  if (error_state != AL_NO_ERROR)
-  {
-    DuskLog() << "Source::getVelocity: ERROR: could not retrieve source "
-              << "velocity for \""<<m_Name<<"\".\n";
-    switch(error_state)
-    {
-      case AL_INVALID_OPERATION:
-           DuskLog() << "    There is no current context.\n"; break;
-      case AL_INVALID_NAME:
-           DuskLog() << "    Invalid source name. Corrupt data?\n"; break;
-      case AL_INVALID_ENUM: //should never occur, AL_VELOCITY is valid enum
-           DuskLog() << "    Invalid enumeration value.\n"; break;
-      case AL_INVALID_VALUE:
-           DuskLog() << "    Invalid pointer values supplied.\n"; break;
-      default:
-           DuskLog() << "    Unknown error. Error code: "<<(int)error_state
-                     << ".\n"; break;
-    }//switch
-    return std::vector<float>(3, 0.0);
-  }//if
-  return result;
+  cmd.voice = sourceID;
+  m_LastCommand = Sound::get().pushAudioCommand(cmd);
 }
 
 const char* SourceCreationException::what() const throw()
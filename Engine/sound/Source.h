@@ -26,6 +26,13 @@
 
  History:
      - 2013-06-12 - initial version (by thoronador)
+     - 2026-10-19 - support for streamed media (updateStream())
+     - 2026-10-19 - sources are virtual and only get an AL source (voice) from
+                    the pool of Sound while they are audible enough
+     - 2026-10-19 - OpenAL calls are done by the audio thread; updateStream()
+                    removed, flushProperties() added
+     - 2026-10-19 - updatePlayState() advances the offset of sources without
+                    a voice
 
  ToDo list:
      - ???
@@ -37,7 +44,9 @@
 #ifndef SOUND_SOURCE_H_INCLUDED
 #define SOUND_SOURCE_H_INCLUDED
 
+#include <chrono>
 #include <exception>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -54,12 +63,48 @@
 namespace Dusk
 {
 
+//forward declaration
+struct AudioCommand;
+
+/*class Source:
+        A source is virtual: its state (volume, position, offset, ...) is kept
+        in the object, and it only gets a real OpenAL source (a voice) from the
+        fixed pool of Sound while it is among the most audible sources. See
+        Sound::update() for details.
+        No function of Source calls OpenAL directly, all changes are sent to
+        the audio thread (see AudioThread) instead. Volume, position and
+        velocity changes are collected and sent only once per frame.
+*/
 class Source
 {
   private:
+    enum PlayState {psStopped, psPlaying, psPaused};
+
     std::string m_Name; //unique name, case sensitive
-    ALuint sourceID;
+    ALuint sourceID; //voice, only valid if m_HasVoice is true
+    bool m_HasVoice;
     Media * attachedMedia;
+    PlayState m_State;
+    float m_Offset; //offset in seconds, used while there is no voice
+    std::chrono::steady_clock::time_point m_OffsetTime; //time of the last change of m_Offset without a voice
+    float m_Volume;
+    bool m_Looping;
+    float m_Position[3];
+    float m_Velocity[3];
+    float m_Priority;
+    unsigned int m_Dirty; //properties that were changed since the last flush
+    uint64_t m_LastCommand; //sequence number of the last command for the voice
+
+    /* queues the buffers of theMedia to the voice */
+    void queueMedia(Media& theMedia);
+
+    /* sends cmd for the voice of the source to the audio thread */
+    void sendCommand(AudioCommand& cmd);
+
+    /* gets a free voice from Sound, if there is one, and binds it. Returns
+       false, if binding failed, and true otherwise - even if no voice was free.
+    */
+    bool tryBindVoice();
   public:
     /* constructor
 
@@ -74,7 +119,12 @@ class Source
     /* returns the name */
     const std::string& getIdentifier() const;
 
-    /* Attach: associates existing Source with a Media */
+    /* Attach: associates existing Source with a Media
+
+       remarks:
+           A streamed media (see Media::isStreaming()) can only be attached to
+           one source at a time.
+    */
     bool attach(Media& theMedia);
 
     /* Detach: revokes association between Source and its attached Media */
@@ -124,16 +174,23 @@ class Source
 
     /* Sets a source into looping mode if doLoop==true, otherwise it gets the
        source out of looping mode. Returns true on success, false otherwise.
+
+       remarks:
+           For streamed media the loop is done by the media's decoder instead
+           of OpenAL, so the looping mode is a property of the media then.
     */
     bool loop(const bool doLoop = true);
 
     /* Sets the offset of the source to the given amount of seconds and returns
-       true on success. Trying to set an offset beyond the length of the
-       attached media will result in failure.
+       true on success. Negative offsets will result in failure, an offset
+       beyond the length of the attached media is only reported by the audio
+       thread.
     */
     bool setOffset(const float seconds);
 
-    /* Retrieves source offset in seconds. On error, -1.0 is returned. */
+    /* Retrieves source offset in seconds, as last published by the audio
+       thread.
+    */
     float getOffset() const;
 
     //   state retrieval functions
@@ -152,6 +209,63 @@ class Source
     // velocity of sources
     bool setVelocity(const float x, const float y, const float z);
     std::vector<float> getVelocity() const;
+
+    /* Sets the priority of the source. Sources with higher priority are more
+       likely to get one of the limited voices, if there are more playing
+       sources than voices. The default priority is 1.0, negative values are
+       treated as zero.
+    */
+    void setPriority(const float priority);
+
+    /* returns the priority of the source */
+    float getPriority() const;
+
+    // **voice management** - used by Sound
+    /* returns true, if the source is currently bound to a voice */
+    bool hasVoice() const;
+
+    /* returns true, if the source would like to have a voice, i.e. it is
+       playing or it is a paused stream
+    */
+    bool needsVoice() const;
+
+    /* Returns the audibility of the source for the listener at the given
+       position, i.e. priority * volume * distance attenuation. Streamed media
+       always have the highest possible audibility.
+
+       parameters:
+           listener - position of the listener (three elements)
+    */
+    float getAudibility(const std::vector<float>& listener) const;
+
+    /* sets the source into stopped state, if its voice reached the end of the
+       media. Sources without a voice advance their offset by the time that
+       passed since the last call instead, start over at the beginning, if they
+       are looping, or stop at the end of the media otherwise.
+    */
+    void updatePlayState();
+
+    /* sends the volume, position and velocity to the voice, if they were
+       changed since the last call; called once per frame by Sound::update()
+    */
+    void flushProperties();
+
+    /* Binds the source to the given voice, transfers the source's state to it
+       and continues playback at the stored offset, if the source is playing.
+       Returns true on success.
+
+       remarks:
+           If the function fails, the voice is still bound to the source and
+           has to be released via releaseVoice(). Errors of OpenAL are only
+           logged by the audio thread.
+    */
+    bool bindVoice(const ALuint voice);
+
+    /* Releases the voice of the source and returns it. The current offset is
+       kept, so that playback can continue when the source gets a voice again.
+       Returns zero, if the source had no voice.
+    */
+    ALuint releaseVoice();
 }; //class
 
 class SourceCreationException: public std::exception
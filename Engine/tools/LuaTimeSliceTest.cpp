@@ -0,0 +1,180 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+// ----------------------------------------------------------------------------
+// LuaTimeSliceTest - runs scripts that take longer than a time slice as
+// coroutines, with a count hook that pre-empts them the way LuaEngine does.
+// Every script has to finish with the right result, and none may be stopped
+// by an "attempt to yield across metamethod/C-call boundary" error.
+// Returns zero on success. Builds with Lua 5.0 do not pre-empt scripts, so
+// there is nothing to test there.
+//
+// usage: LuaTimeSliceTest
+// ----------------------------------------------------------------------------
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../lua/LuaIncludes.h"
+#include "../lua/LuaTimeSlice.h"
+
+using namespace Dusk;
+
+#ifdef DUSK_LUA51
+namespace
+{
+
+/* length of a time slice (milliseconds) */
+const int cSliceLength = 1;
+/* number of instructions between two calls of the hook, as in LuaEngine */
+const int cHookInstructions = 1000;
+
+lua_State* g_Thread = NULL;
+std::chrono::steady_clock::time_point g_Deadline;
+unsigned int g_Yields = 0;
+
+void sliceHook(lua_State* L, lua_Debug* ar)
+{
+  if ((L==g_Thread) and (std::chrono::steady_clock::now()>=g_Deadline)
+      and canYieldFromHook(L))
+  {
+    ++g_Yields;
+    lua_yield(L, 0);
+  }
+}
+
+struct TestCase
+{
+  const char* Name;
+  const char* Code; //has to set the global variable result
+  double Expected;
+  bool MustYield; //whether the script has to be pre-empted at least once
+};
+
+const TestCase cTests[] = {
+  //The iterator is called by the interpreter, but its name is a local one.
+  {"generic for over a Lua iterator",
+   "local function range(n)\n"
+   "  local i = 0\n"
+   "  return function() i = i + 1; if i<=n then return i end end\n"
+   "end\n"
+   "local sum = 0\n"
+   "for i in range(3000000) do sum = sum + i % 7 end\n"
+   "result = sum\n",
+   8999997.0, true},
+  {"__index metamethod in a loop",
+   "local t = setmetatable({}, {__index = function(t, k) local x = 0\n"
+   "  for j=1,20 do x = x + j end return k % 3 + x - 210 end})\n"
+   "local sum = 0\n"
+   "for i=1,300000 do sum = sum + t[i] end\n"
+   "result = sum\n",
+   300000.0, true},
+  //Most hooks hit the code within pcall, so pre-emption is not guaranteed.
+  {"Lua function called through pcall",
+   "local function work(n) local s = 0 for i=1,n do s = s + i % 5 end return s end\n"
+   "local sum = 0\n"
+   "for i=1,100 do local ok, s = pcall(work, 30000) sum = sum + s end\n"
+   "result = sum\n",
+   6000000.0, false}
+};
+
+/* runs one test case in slices, returns true on success */
+bool runTest(lua_State* L, const TestCase& test)
+{
+  lua_State* thread = lua_newthread(L);
+  if (luaL_loadbuffer(thread, test.Code, std::string(test.Code).length(), test.Name)!=0)
+  {
+    std::cout << test.Name << ": ERROR: " << lua_tostring(thread, -1) << "\n";
+    lua_pop(L, 1);
+    return false;
+  }
+  lua_sethook(thread, sliceHook, LUA_MASKCOUNT, cHookInstructions);
+  g_Thread = thread;
+  g_Yields = 0;
+  int status = LUA_YIELD;
+  while (status==LUA_YIELD)
+  {
+    g_Deadline = std::chrono::steady_clock::now()+std::chrono::milliseconds(cSliceLength);
+    status = lua_resume(thread, 0);
+    lua_settop(thread, 0);
+  }//while
+  g_Thread = NULL;
+  bool success = true;
+  if (status!=0)
+  {
+    std::cout << test.Name << ": ERROR: script failed: " << lua_tostring(thread, -1) << "\n";
+    success = false;
+  }
+  else
+  {
+    lua_getglobal(L, "result");
+    const double result = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    if (result!=test.Expected)
+    {
+      std::cout << test.Name << ": ERROR: result is " << result << ", but "
+                << test.Expected << " was expected.\n";
+      success = false;
+    }
+    if (test.MustYield and (g_Yields==0))
+    {
+      std::cout << test.Name << ": ERROR: script was never pre-empted.\n";
+      success = false;
+    }
+  }
+  if (success)
+    std::cout << test.Name << ": passed, " << g_Yields << " slices.\n";
+  //remove the thread
+  lua_pop(L, 1);
+  return success;
+}
+
+} //namespace
+#endif
+
+int main()
+{
+  #ifdef DUSK_LUA51
+  lua_State* L = lua_open();
+  if (L==NULL)
+  {
+    std::cout << "ERROR: lua_open() failed!\n";
+    return 1;
+  }
+  luaL_openlibs(L);
+  unsigned int failed = 0;
+  unsigned int i;
+  for (i=0; i<sizeof(cTests)/sizeof(cTests[0]); ++i)
+  {
+    if (!runTest(L, cTests[i]))
+      ++failed;
+  }//for
+  lua_close(L);
+  if (failed!=0)
+  {
+    std::cout << failed << " test(s) failed.\n";
+    return 1;
+  }
+  std::cout << "All tests passed.\n";
+  #else
+  std::cout << "Scripts are not pre-empted with " << LUA_VERSION << ", nothing to test.\n";
+  #endif
+  return 0;
+}
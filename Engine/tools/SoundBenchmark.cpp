@@ -0,0 +1,264 @@
+/*
+ -----------------------------------------------------------------------------
+    This file is part of the Dusk Engine.
+    Copyright (C) 2026  Thoronador
+
+    The Dusk Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Dusk Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Dusk Engine.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------
+*/
+
+// ----------------------------------------------------------------------------
+// SoundBenchmark - creates N sources and M media and drives play/stop/attach
+// churn plus listener movement through the sound system, then prints the
+// frame times and the numbers collected by SoundStatistics.
+//
+// usage: SoundBenchmark [sources] [media] [frames] [-device] [file ...]
+//   sources - number of sources (default: 64)
+//   media   - number of media (default: 16)
+//   frames  - number of simulated frames (default: 2000)
+//   -device - use the default output device instead of a loopback device
+//   file    - Wave or Ogg Vorbis files for the media; if none are given,
+//             short Wave files are generated in the current directory
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../BinaryWriter.h"
+#include "../DuskFunctions.h"
+#include "../Messages.h"
+#include "../sound/Sound.h"
+#include "../sound/SoundStatistics.h"
+
+using namespace Dusk;
+
+namespace
+{
+
+void writeUInt16(BinaryWriter& output, const unsigned int value)
+{
+  output.writeUInt8(value & 0xFF);
+  output.writeUInt8((value>>8) & 0xFF);
+}
+
+/* writes a mono 16 bit PCM Wave file with a sine tone of the given frequency
+   and duration; returns true on success
+*/
+bool writeSineWave(const std::string& FileName, const float frequency, const float seconds)
+{
+  const unsigned int rate = 22050;
+  const unsigned int samples = static_cast<unsigned int>(rate*seconds);
+  BinaryWriter output(44+2*samples);
+  output.write("RIFF", 4);
+  output.writeUInt32(36+2*samples);
+  output.write("WAVE", 4);
+  output.write("fmt ", 4);
+  output.writeUInt32(16);
+  writeUInt16(output, 1); //PCM
+  writeUInt16(output, 1); //mono
+  output.writeUInt32(rate);
+  output.writeUInt32(rate*2); //bytes per second
+  writeUInt16(output, 2); //block align
+  writeUInt16(output, 16); //bits per sample
+  output.write("data", 4);
+  output.writeUInt32(2*samples);
+  unsigned int i;
+  for (i=0; i<samples; ++i)
+  {
+    const int value = static_cast<int>(16000.0*std::sin(6.2831853*frequency*i/rate));
+    writeUInt16(output, static_cast<unsigned int>(value) & 0xFFFF);
+  }//for
+  return output.saveToFile(FileName);
+}
+
+bool isOggFile(const std::string& FileName)
+{
+  return (FileName.size()>4) and (FileName.substr(FileName.size()-4)==".ogg");
+}
+
+unsigned int toCount(const char* arg, const unsigned int fallback)
+{
+  const long int value = std::strtol(arg, NULL, 10);
+  return (value>0) ? static_cast<unsigned int>(value) : fallback;
+}
+
+} //anonymous namespace
+
+int main(int argc, char **argv)
+{
+  unsigned int sourceCount = 64;
+  unsigned int mediaCount = 16;
+  unsigned int frameCount = 2000;
+  bool loopback = true;
+  std::vector<std::string> files;
+  unsigned int numbers = 0;
+  int i;
+  for (i=1; i<argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg=="-device")
+    {
+      loopback = false;
+    }
+    else if ((numbers<3) and (arg.find_first_not_of("0123456789")==std::string::npos))
+    {
+      switch (numbers)
+      {
+        case 0: sourceCount = toCount(argv[i], sourceCount); break;
+        case 1: mediaCount = toCount(argv[i], mediaCount); break;
+        default: frameCount = toCount(argv[i], frameCount); break;
+      }//swi
+      ++numbers;
+    }
+    else
+    {
+      files.push_back(arg);
+    }
+  }//for
+
+  //generate media files, if none were given
+  std::vector<std::string> generated;
+  if (files.empty())
+  {
+    unsigned int j;
+    for (j=0; j<mediaCount; ++j)
+    {
+      const std::string name = "SoundBenchmark_"+IntToString(j)+".wav";
+      if (!writeSineWave(name, 220.0f+20.0f*j, 1.0f+0.25f*(j%4)))
+      {
+        std::cout << "Could not write file \"" << name << "\".\n";
+        return 1;
+      }
+      generated.push_back(name);
+    }//for
+    files = generated;
+  }
+  const bool needVorbis = (std::find_if(files.begin(), files.end(), isOggFile)!=files.end());
+
+  Sound& snd = Sound::get();
+  if (!snd.init("NULL", "NULL", needVorbis, loopback))
+  {
+    std::cout << "Could not initialise sound, see the log for details.\n";
+    return 1;
+  }
+  SoundStatistics::get().reset();
+  SoundStatistics::get().setEnabled(true);
+
+  std::cout << "SoundBenchmark: " << sourceCount << " sources, " << mediaCount
+            << " media, " << frameCount << " frames, "
+            << (loopback ? "loopback" : "default") << " device\n";
+
+  std::mt19937 random(1234);
+  unsigned int j;
+  for (j=0; j<mediaCount; ++j)
+  {
+    snd.createMedia("media"+IntToString(j), files[j % files.size()]);
+  }//for
+  for (j=0; j<sourceCount; ++j)
+  {
+    const std::string name = "source"+IntToString(j);
+    if (snd.createSource(name))
+    {
+      snd.getSource(name).setPosition((random()%200)-100.0f, 0.0f, (random()%200)-100.0f);
+    }
+  }//for
+
+  //about one eighth of the sources change their state in each frame
+  const unsigned int churnPerFrame = sourceCount/8+1;
+  unsigned int plays = 0, stops = 0, recreations = 0;
+  double totalFrameTime = 0.0, maxFrameTime = 0.0;
+  unsigned int frame;
+  for (frame=0; frame<frameCount; ++frame)
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    unsigned int k;
+    for (k=0; k<churnPerFrame; ++k)
+    {
+      const std::string sourceName = "source"+IntToString(static_cast<unsigned int>(random()%sourceCount));
+      const std::string mediaName = "media"+IntToString(static_cast<unsigned int>(random()%mediaCount));
+      try
+      {
+        if ((random()%16)==0)
+        {
+          //destroy and recreate the source
+          snd.destroySource(sourceName);
+          snd.createSource(sourceName);
+          snd.getSource(sourceName).setPosition((random()%200)-100.0f, 0.0f, (random()%200)-100.0f);
+          ++recreations;
+        }
+        else
+        {
+          Source& src = snd.getSource(sourceName);
+          if (src.isPlaying())
+          {
+            src.stop();
+            ++stops;
+          }
+          else
+          {
+            src.attach(snd.getMedia(mediaName));
+            src.loop((random()%2)==0);
+            src.play();
+            ++plays;
+          }
+        }
+      }
+      catch (std::runtime_error& e)
+      {
+        //source or media could not be created, e.g. unsupported file
+      }
+    }//for
+    //listener walks in a circle and looks ahead
+    const float angle = 0.01f*frame;
+    snd.setListenerPostion(50.0f*std::cos(angle), 0.0f, 50.0f*std::sin(angle));
+    snd.rotateListener(0.0f, 0.01f, 0.0f);
+    snd.update();
+    const double frameTime = std::chrono::duration<double, std::micro>(
+                                 std::chrono::steady_clock::now()-start).count();
+    totalFrameTime += frameTime;
+    if (frameTime>maxFrameTime) maxFrameTime = frameTime;
+  }//for
+
+  std::cout << "Frames: average " << totalFrameTime/frameCount << " us, maximum "
+            << maxFrameTime << " us\n"
+            << "Plays: " << plays << ", stops: " << stops << ", recreated sources: "
+            << recreations << "\n";
+  Messages::getSingleton().flush();
+  Messages::getSingleton().setOutput(true);
+  snd.logStatistics();
+  Messages::getSingleton().flush();
+
+  //clean up
+  for (j=0; j<sourceCount; ++j)
+  {
+    snd.destroySource("source"+IntToString(j));
+  }//for
+  for (j=0; j<mediaCount; ++j)
+  {
+    snd.destroyMedia("media"+IntToString(j));
+  }//for
+  snd.exit();
+  for (j=0; j<generated.size(); ++j)
+  {
+    std::remove(generated[j].c_str());
+  }//for
+  return 0;
+}
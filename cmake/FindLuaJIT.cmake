@@ -0,0 +1,24 @@
+# Find LuaJIT library
+#
+# LUAJIT_INCLUDE_DIR        where to find the include files
+# LUAJIT_LIBRARY            the LuaJIT library
+# LUAJIT_LIBRARIES          list of libraries to link
+# LUAJIT_FOUND              true if LuaJIT was found
+
+SET( LUAJIT_LIBRARYDIR / CACHE PATH "Alternative library directory" )
+SET( LUAJIT_INCLUDEDIR / CACHE PATH "Alternative include directory" )
+MARK_AS_ADVANCED( LUAJIT_LIBRARYDIR LUAJIT_INCLUDEDIR )
+
+FIND_LIBRARY( LUAJIT_LIBRARY NAMES luajit-5.1 luajit lua51
+              PATHS ${LUAJIT_LIBRARYDIR} )
+FIND_PATH( LUAJIT_INCLUDE_DIR luajit.h
+           HINTS "/usr/include/luajit-2.1" "/usr/include/luajit-2.0"
+                 "/usr/local/include/luajit-2.1" "/usr/local/include/luajit-2.0"
+           PATHS ${LUAJIT_INCLUDEDIR} )
+
+IF( LUAJIT_INCLUDE_DIR AND LUAJIT_LIBRARY )
+    SET( LUAJIT_LIBRARIES ${LUAJIT_LIBRARY} )
+    SET( LUAJIT_FOUND TRUE )
+ELSE( LUAJIT_INCLUDE_DIR AND LUAJIT_LIBRARY )
+    SET( LUAJIT_FOUND FALSE )
+ENDIF( LUAJIT_INCLUDE_DIR AND LUAJIT_LIBRARY )